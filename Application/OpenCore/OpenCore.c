@@ -33,8 +33,10 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/OcConfigurationLib.h>
 #include <Library/OcConsoleLib.h>
 #include <Library/OcCpuLib.h>
+#include <Library/OcCryptoLib.h>
 #include <Library/OcDevicePathLib.h>
 #include <Library/OcStorageLib.h>
+#include <Library/OcTraceLib.h>
 #include <Library/OcVariableLib.h>
 #include <Library/PrintLib.h>
 #include <Library/UefiBootServicesTableLib.h>
@@ -120,6 +122,7 @@ OcMain (
 {
   EFI_STATUS            Status;
   OC_PRIVILEGE_CONTEXT  *Privilege;
+  OC_TRACE_ID           TraceId;
 
   DEBUG ((DEBUG_INFO, "OC: OcMiscEarlyInit...\n"));
   Status = OcMiscEarlyInit (
@@ -152,9 +155,13 @@ OcMain (
   OcMiscLoadSystemReport (&mOpenCoreConfiguration, mStorageHandle);
   DEBUG_CODE_END ();
   DEBUG ((DEBUG_INFO, "OC: OcLoadAcpiSupport...\n"));
+  TraceId = OcTraceBegin ("Acpi");
   OcLoadAcpiSupport (&mOpenCoreStorage, &mOpenCoreConfiguration);
+  OcTraceEnd (TraceId);
   DEBUG ((DEBUG_INFO, "OC: OcLoadPlatformSupport...\n"));
+  TraceId = OcTraceBegin ("Platform");
   OcLoadPlatformSupport (&mOpenCoreConfiguration, &mOpenCoreCpuInfo);
+  OcTraceEnd (TraceId);
   DEBUG ((DEBUG_INFO, "OC: OcLoadDevPropsSupport...\n"));
   OcLoadDevPropsSupport (&mOpenCoreConfiguration);
   DEBUG ((DEBUG_INFO, "OC: OcMiscLateInit...\n"));
@@ -167,6 +174,17 @@ OcMain (
     mOpenCorePrivilege.Hash         = mOpenCoreConfiguration.Misc.Security.PasswordHash;
     mOpenCorePrivilege.Salt         = OC_BLOB_GET (&mOpenCoreConfiguration.Misc.Security.PasswordSalt);
     mOpenCorePrivilege.SaltSize     = mOpenCoreConfiguration.Misc.Security.PasswordSalt.Size;
+    mOpenCorePrivilege.Iterations   = mOpenCoreConfiguration.Misc.Security.PasswordIterations;
+    mOpenCorePrivilege.Lanes        = MAX (mOpenCoreConfiguration.Misc.Security.PasswordLanes, 1);
+
+    if ((mOpenCorePrivilege.Iterations != 0) && (mOpenCorePrivilege.Lanes > OC_PASSWORD_MAX_LANES)) {
+      DEBUG ((
+        DEBUG_ERROR,
+        "OC: PasswordLanes %u exceeds %u, password cannot be verified\n",
+        mOpenCorePrivilege.Lanes,
+        OC_PASSWORD_MAX_LANES
+        ));
+    }
 
     Privilege = &mOpenCorePrivilege;
   } else {
@@ -193,6 +193,21 @@ OcBootPolicyGetAllApfsRecoveryFilePath (
   OUT UINTN       *NumberOfEntries
   );
 
+/**
+  Enable or disable the path cache used when probing booter paths.
+
+  While enabled, file existence checks on every volume are answered from
+  a single listing of each parent directory, keyed by device handle and
+  media ID. Every call drops previously cached listings, so the cache is
+  to be enabled for the duration of one boot entry scan.
+
+  @param[in] Enable  TRUE to start a new cache session, FALSE to stop caching.
+**/
+VOID
+OcBootPolicySetPathCache (
+  IN BOOLEAN  Enable
+  );
+
 extern CONST CHAR16  *gAppleBootPolicyPredefinedPaths[];
 
 ///
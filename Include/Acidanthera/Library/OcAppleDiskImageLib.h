@@ -30,6 +30,10 @@ typedef struct {
 
   UINT32                               BlockCount;
   APPLE_DISK_IMAGE_BLOCK_DATA          **Blocks;
+  //
+  // Plist buffer the blocks were decoded into.
+  //
+  CHAR8                                *PlistData;
 } OC_APPLE_DISK_IMAGE_CONTEXT;
 
 BOOLEAN
@@ -989,20 +989,6 @@ KcInitKextFixupChains (
   IN     UINT32             ReservedSize
   );
 
-/**
-  Indexes all relocations of MachContext into the kernel described by Context.
-
-  @param[in,out] Context      Prelinked context.
-  @param[in]     MachContext  The context of the Mach-O to index. It must have
-                              been prelinked by OcAppleKernelLib. The image
-                              must reside in Segment.
-**/
-VOID
-KcKextIndexFixups (
-  IN OUT PRELINKED_CONTEXT  *Context,
-  IN     OC_MACHO_CONTEXT   *MachContext
-  );
-
 /**
   Retrieves a KC KEXT's virtual size.
 
@@ -1019,18 +1005,21 @@ KcGetKextSize (
   );
 
 /**
-  Apply the delta from KC header to the file's offsets.
+  Integrate a prelinked KEXT into KC in a single pass over its load commands.
+  Its relocations are converted to fixups in the KC fixup chains, and
+  the delta from KC header is applied to the file's offsets.
 
-  @param[in]     PrelinkedContext  Prelinked context.
-  @param[in,out] Context           The context of the KEXT to rebase.
+  @param[in,out] PrelinkedContext  Prelinked context.
+  @param[in,out] Context           The context of the KEXT to integrate. It must
+                                   have been prelinked by OcAppleKernelLib.
   @param[in]     Delta             The offset from KC header the KEXT starts at.
 
-  @retval EFI_SUCCESS  The file has beem rebased successfully.
+  @retval EFI_SUCCESS  The file has been integrated successfully.
   @retval other        An error has occured.
 **/
 EFI_STATUS
-KcKextApplyFileDelta (
-  IN     PRELINKED_CONTEXT  *PrelinkedContext,
+KcKextIndexFixupsAndApplyFileDelta (
+  IN OUT PRELINKED_CONTEXT  *PrelinkedContext,
   IN OUT OC_MACHO_CONTEXT   *Context,
   IN     UINT32             Delta
   );
@@ -874,6 +874,14 @@ typedef struct {
   CONST UINT8           *Salt;
   UINT32                SaltSize;
   CONST UINT8           *Hash;
+  //
+  // PBKDF2 iteration count, 0 for legacy iterated SHA-512.
+  //
+  UINT32                Iterations;
+  //
+  // PBKDF2 lane count, used when Iterations is non-zero.
+  //
+  UINT32                Lanes;
 } OC_PRIVILEGE_CONTEXT;
 
 /**
@@ -1214,6 +1222,15 @@ OcFreeBootContext (
   IN OUT OC_BOOT_CONTEXT  *Context
   );
 
+/**
+  Drop filesystem scan results cached between boot entry scans.
+  Subsequent scans will probe every filesystem again.
+**/
+VOID
+OcFlushBootEntryScanCache (
+  VOID
+  );
+
 /**
   Obtain default entry from picker context.
 
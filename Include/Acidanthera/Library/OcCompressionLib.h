@@ -117,6 +117,94 @@ DecompressZLIB (
   IN  UINTN        SrcLen
   );
 
+/**
+  Incremental ZLIB compression stream.
+**/
+typedef struct OC_ZLIB_STREAM_ OC_ZLIB_STREAM;
+
+/**
+  Get maximum ZLIB compressed size of a buffer.
+
+  @param[in]   SrcLen      Source buffer size.
+
+  @return  Compressed size upper bound, including ZLIB header and trailer.
+**/
+UINTN
+CompressZLIBBound (
+  IN UINTN  SrcLen
+  );
+
+/**
+  Start incremental ZLIB compression.
+
+  @param[in]   Level       Compression level from 1 (fastest) to 9 (best).
+
+  @return  Compression stream on success otherwise NULL.
+**/
+OC_ZLIB_STREAM *
+CompressZLIBStreamInit (
+  IN UINT32  Level
+  );
+
+/**
+  Compress next part of ZLIB stream. All source data is consumed,
+  the output may be delayed until further calls.
+
+  @param[in,out]  Stream   Compression stream.
+  @param[out]     Dst      Destination buffer.
+  @param[in]      DstLen   Destination buffer size.
+  @param[in]      Src      Source buffer.
+  @param[in]      SrcLen   Source buffer size.
+  @param[in]      Finish   Source buffer is the last part of the stream.
+
+  @return  Bytes written to Dst on success otherwise MAX_UINTN.
+**/
+UINTN
+CompressZLIBStream (
+  IN OUT OC_ZLIB_STREAM  *Stream,
+  OUT    UINT8           *Dst,
+  IN     UINTN           DstLen,
+  IN     CONST UINT8     *Src,
+  IN     UINTN           SrcLen,
+  IN     BOOLEAN         Finish
+  );
+
+/**
+  Free ZLIB compression stream.
+
+  @param[in]   Stream      Compression stream.
+**/
+VOID
+CompressZLIBStreamFree (
+  IN OC_ZLIB_STREAM  *Stream
+  );
+
+/**
+  Scratch memory size required by DecompressZLIBScratch.
+**/
+#define OC_ZLIB_SCRATCH_SIZE  SIZE_64KB
+
+/**
+  Decompress buffer with ZLIB algorithm without allocating memory.
+  Unlike DecompressZLIB, this is safe to call from application processors.
+
+  @param[out]  Dst         Destination buffer.
+  @param[in]   DstLen      Destination buffer size.
+  @param[in]   Src         Source buffer.
+  @param[in]   SrcLen      Source buffer size.
+  @param[in]   Scratch     Scratch buffer of OC_ZLIB_SCRATCH_SIZE bytes.
+
+  @return  DecompressedLen on success otherwise 0.
+**/
+UINTN
+DecompressZLIBScratch (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        SrcLen,
+  IN  VOID         *Scratch
+  );
+
 /**
   Decompress buffer with RLE24 algorithm and 8-bit alpha.
   This algorithm is used for encoding IT32/T8MK images in ICNS.
@@ -387,6 +387,8 @@ typedef enum {
   _(BOOLEAN                     , BlacklistAppleUpdate        ,      , FALSE                   , ()) \
   _(BOOLEAN                     , EnablePassword              ,      , FALSE                   , ()) \
   _(UINT8                       , PasswordHash                , [64] , {0}                     , ()) \
+  _(UINT32                      , PasswordIterations          ,      , 0                       , ()) \
+  _(UINT32                      , PasswordLanes               ,      , 0                       , ()) \
   _(OC_DATA                     , PasswordSalt                ,      , OC_EDATA_CONSTR (_, __) , OC_DESTR (OC_DATA)) \
   _(OC_STRING                   , SecureBootModel             ,      , OC_STRING_CONSTR ("Default", _, __), OC_DESTR (OC_STRING) ) \
   _(UINT64                      , ApECID                      ,      , 0                       , ()) \
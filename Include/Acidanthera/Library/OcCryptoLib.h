@@ -93,6 +93,11 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 //
 #define OC_PASSWORD_MAX_RETRIES  3
 
+//
+// Maximum number of independent lanes in PBKDF2 password hashing.
+//
+#define OC_PASSWORD_MAX_LANES  32
+
 //
 // Possible RSA algorithm types supported by OcCryptoLib
 // for RSA digital signature verification
@@ -552,6 +557,7 @@ RsaVerifySigDataFromKeyDynalloc (
   Verify RSA PKCS1.5 signed data against its signature.
   The modulus' size must be a multiple of the configured BIGNUM word size.
   This will be true for any conventional RSA, which use two's potencies.
+  Montgomery parameters of recently used moduli are cached between calls.
 
   @param[in] Modulus        The RSA modulus byte array.
   @param[in] ModulusSize    The size, in bytes, of Modulus.
@@ -577,6 +583,142 @@ RsaVerifySigDataFromData (
   IN OC_SIG_HASH_TYPE  Algorithm
   );
 
+///
+/// Reusable RSA verification context. It keeps the Montgomery parameters of
+/// a public key and the scratch memory to verify with it, so that repeated
+/// verifications neither recompute nor allocate anything.
+/// A context must not be used by several processors at once.
+///
+typedef struct {
+  ///
+  /// The modulus in BIGNUM word order.
+  ///
+  CONST VOID    *N;
+  ///
+  /// Montgomery's R^2 mod N in BIGNUM word order.
+  ///
+  CONST VOID    *RSqrMod;
+  ///
+  /// The Montgomery Inverse in 64-bit space: -1 / N[0] mod 2^64.
+  ///
+  UINT64        N0Inv;
+  ///
+  /// The size, in bytes, of the modulus.
+  ///
+  UINT32        ModulusSize;
+  ///
+  /// The RSA exponent.
+  ///
+  UINT32        Exponent;
+  ///
+  /// Scratch buffer of RSA_SCRATCH_BUFFER_SIZE (ModulusSize) bytes.
+  ///
+  VOID          *Scratch;
+  ///
+  /// Memory owned by the context, NULL when N and RSqrMod belong to a key.
+  ///
+  VOID          *Memory;
+} OC_RSA_VERIFY_CONTEXT;
+
+#ifndef OC_CRYPTO_STATIC_MEMORY_ALLOCATION
+
+/**
+  Initialise a verification context for a preprocessed RSA Public Key.
+  The exponent is always 65537 as per the format specification.
+  Key must stay valid until the context is freed.
+
+  @param[out] Context  The verification context to initialise.
+  @param[in]  Key      The RSA Public Key.
+
+  @returns  Whether the context has been initialised successfully.
+
+**/
+BOOLEAN
+RsaVerifyContextInitFromKey (
+  OUT OC_RSA_VERIFY_CONTEXT    *Context,
+  IN  CONST OC_RSA_PUBLIC_KEY  *Key
+  );
+
+/**
+  Initialise a verification context for an RSA modulus by computing its
+  Montgomery parameters once.
+  The modulus' size must be a multiple of the configured BIGNUM word size.
+
+  @param[out] Context      The verification context to initialise.
+  @param[in]  Modulus      The RSA modulus byte array.
+  @param[in]  ModulusSize  The size, in bytes, of Modulus.
+  @param[in]  Exponent     The RSA exponent.
+
+  @returns  Whether the context has been initialised successfully.
+
+**/
+BOOLEAN
+RsaVerifyContextInitFromData (
+  OUT OC_RSA_VERIFY_CONTEXT  *Context,
+  IN  CONST UINT8            *Modulus,
+  IN  UINTN                  ModulusSize,
+  IN  UINT32                 Exponent
+  );
+
+/**
+  Free the resources of a verification context.
+
+  @param[in,out] Context  The verification context to free.
+
+**/
+VOID
+RsaVerifyContextFree (
+  IN OUT OC_RSA_VERIFY_CONTEXT  *Context
+  );
+
+/**
+  Verify a RSA PKCS1.5 signature against an expected hash.
+
+  @param[in] Context        The verification context.
+  @param[in] Signature      The RSA signature to be verified.
+  @param[in] SignatureSize  Size, in bytes, of Signature.
+  @param[in] Hash           The Hash digest of the signed data.
+  @param[in] HashSize       Size, in bytes, of Hash.
+  @param[in] Algorithm      The RSA algorithm used.
+
+  @returns  Whether the signature has been successfully verified as valid.
+
+**/
+BOOLEAN
+RsaVerifySigHashFromContext (
+  IN CONST OC_RSA_VERIFY_CONTEXT  *Context,
+  IN CONST UINT8                  *Signature,
+  IN UINTN                        SignatureSize,
+  IN CONST UINT8                  *Hash,
+  IN UINTN                        HashSize,
+  IN OC_SIG_HASH_TYPE             Algorithm
+  );
+
+/**
+  Verify RSA PKCS1.5 signed data against its signature.
+
+  @param[in] Context        The verification context.
+  @param[in] Signature      The RSA signature to be verified.
+  @param[in] SignatureSize  Size, in bytes, of Signature.
+  @param[in] Data           The signed data to verify.
+  @param[in] DataSize       Size, in bytes, of Data.
+  @param[in] Algorithm      The RSA algorithm used.
+
+  @returns  Whether the signature has been successfully verified as valid.
+
+**/
+BOOLEAN
+RsaVerifySigDataFromContext (
+  IN CONST OC_RSA_VERIFY_CONTEXT  *Context,
+  IN CONST UINT8                  *Signature,
+  IN UINTN                        SignatureSize,
+  IN CONST UINT8                  *Data,
+  IN UINTN                        DataSize,
+  IN OC_SIG_HASH_TYPE             Algorithm
+  );
+
+#endif // OC_CRYPTO_STATIC_MEMORY_ALLOCATION
+
 /**
   Performs a cryptographically secure comparison of the contents of two
   buffers.
@@ -665,4 +807,57 @@ OcVerifyPasswordSha512 (
   IN CONST UINT8  *RefHash
   );
 
+/**
+  Hash Password and Salt into a PasswordHash with multi-lane PBKDF2-HMAC-SHA512.
+  Every lane derives one independent PBKDF2 output block, and the lanes are
+  combined with XOR. A single lane is equivalent to plain PBKDF2-HMAC-SHA512
+  with a 64-byte output. Lanes are distributed across available processors.
+
+  @param[in]  Password      The entered password to hash.
+  @param[in]  PasswordSize  The size, in bytes, of Password.
+  @param[in]  Salt          The cryptographic salt.
+  @param[in]  SaltSize      The size, in bytes, of Salt.
+  @param[in]  Iterations    PBKDF2 iteration count of every lane, non-zero.
+  @param[in]  Lanes         Number of lanes, from 1 to OC_PASSWORD_MAX_LANES.
+  @param[out] Hash          The 64-byte hash of Password and Salt.
+
+**/
+VOID
+OcHashPasswordPbkdf2Sha512 (
+  IN  CONST UINT8  *Password,
+  IN  UINT32       PasswordSize,
+  IN  CONST UINT8  *Salt,
+  IN  UINT32       SaltSize,
+  IN  UINT32       Iterations,
+  IN  UINT32       Lanes,
+  OUT UINT8        *Hash
+  );
+
+/**
+  Verify Password and Salt against RefHash produced by OcHashPasswordPbkdf2Sha512.
+  The caller must ensure RefHash is at least 64 bytes in size.
+
+  @param[in] Password      The entered password to verify.
+  @param[in] PasswordSize  The size, in bytes, of Password.
+  @param[in] Salt          The cryptographic salt.
+  @param[in] SaltSize      The size, in bytes, of Salt.
+  @param[in] Iterations    PBKDF2 iteration count of every lane.
+  @param[in] Lanes         Number of lanes.
+  @param[in] RefHash       The reference hash.
+
+  @returns Whether Password and Salt cryptographically match RefHash.
+           FALSE is returned for unsupported Iterations or Lanes.
+
+**/
+BOOLEAN
+OcVerifyPasswordPbkdf2Sha512 (
+  IN CONST UINT8  *Password,
+  IN UINT32       PasswordSize,
+  IN CONST UINT8  *Salt,
+  IN UINT32       SaltSize,
+  IN UINT32       Iterations,
+  IN UINT32       Lanes,
+  IN CONST UINT8  *RefHash
+  );
+
 #endif // OC_CRYPTO_LIB_H
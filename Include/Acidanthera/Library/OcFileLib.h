@@ -648,6 +648,38 @@ OcGetDiskPartitions (
   IN BOOLEAN     UseBlockIo2
   );
 
+/**
+  Retrieve the disk GPT partitions, if applicable, reading the partition
+  table from prefetched leading disk blocks where they cover it.
+  The result is cached just like with OcGetDiskPartitions.
+
+  @param[in]  DiskHandle   Disk device handle to retrive partition table from.
+  @param[in]  UseBlockIo2  Use 2nd revision of Block I/O if available.
+  @param[in]  Buffer       Disk contents starting from LBA 0, optional.
+  @param[in]  BufferSize   Size of Buffer.
+
+  @retval partition entry list or NULL.
+**/
+CONST OC_PARTITION_ENTRIES *
+OcGetDiskPartitionsFromBuffer (
+  IN EFI_HANDLE  DiskHandle,
+  IN BOOLEAN     UseBlockIo2,
+  IN CONST VOID  *Buffer      OPTIONAL,
+  IN UINTN       BufferSize
+  );
+
+/**
+  Check whether the disk GPT partitions are already cached.
+
+  @param[in]  DiskHandle   Disk device handle.
+
+  @retval TRUE when OcGetDiskPartitions will not read the disk.
+**/
+BOOLEAN
+OcHasCachedDiskPartitions (
+  IN EFI_HANDLE  DiskHandle
+  );
+
 /**
   Retrieve the partition's GPT information, if applicable.
   Calls to this function undergo internal lazy caching.
@@ -27,6 +27,45 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 ///
 #define MACHO_ALIGN(x)  ALIGN_VALUE((x), MACHO_PAGE_SIZE)
 
+///
+/// Maximum amount of segment commands tracked by the load command index.
+/// Mach-O files with more segments are not indexed.
+///
+#define MACHO_INDEX_MAX_SEGMENTS  32U
+
+///
+/// Load command types (without MACH_LC_REQUIRE_DYLD) below this value have
+/// their first occurrence tracked by the load command index.
+///
+#define MACHO_INDEX_COMMAND_TYPES  64U
+
+///
+/// Marks a load command type without any occurrence in the index.
+///
+#define MACHO_INDEX_NONE  MAX_UINT32
+
+///
+/// State of the load command index.
+///
+typedef enum {
+  OcMachoIndexNone,
+  OcMachoIndexValid,
+  OcMachoIndexUnsupported
+} OC_MACHO_INDEX_STATE;
+
+///
+/// Lazily built load command index, storing offsets relative to the first
+/// load command.  It is rebuilt whenever the command count or size changes.
+///
+typedef struct {
+  OC_MACHO_INDEX_STATE    State;
+  UINT32                  NumCommands;
+  UINT32                  CommandsSize;
+  UINT32                  NumSegments;
+  UINT32                  Segments[MACHO_INDEX_MAX_SEGMENTS];
+  UINT32                  FirstCommands[MACHO_INDEX_COMMAND_TYPES];
+} OC_MACHO_INDEX;
+
 ///
 /// Context used to refer to a Mach-O.  This struct is exposed for reference
 /// only.  Members are not guaranteed to be sane.
@@ -44,6 +83,7 @@ typedef struct {
   MACH_NLIST_ANY           *IndirectSymbolTable;
   MACH_RELOCATION_INFO     *LocalRelocations;
   MACH_RELOCATION_INFO     *ExternRelocations;
+  OC_MACHO_INDEX           Index;
 
   BOOLEAN                  Is32Bit;
 } OC_MACHO_CONTEXT;
@@ -53,6 +53,8 @@
 
 #define OPEN_CORE_LOG_PREFIX_PATH  L"opencore"
 
+#define OPEN_CORE_TRACE_PREFIX_PATH  L"opencore-trace"
+
 #define OPEN_CORE_ACPI_PATH  L"ACPI\\"
 
 #define OPEN_CORE_UEFI_DRIVER_PATH  L"Drivers\\"
@@ -618,6 +618,38 @@ VmFlushCaches (
   VOID
   );
 
+/**
+  Built-in allocator statistics.
+**/
+typedef struct {
+  ///
+  /// Memory pool size.
+  ///
+  UINT32    HeapSize;
+  ///
+  /// Bytes currently handed out, rounded up to size classes and blocks.
+  ///
+  UINT32    AllocatedSize;
+  ///
+  /// High-water mark of AllocatedSize.
+  ///
+  UINT32    PeakAllocatedSize;
+  ///
+  /// Free bytes in the memory pool, and the largest of them in one piece.
+  ///
+  UINT32    FreeSize;
+  UINT32    LargestFreeSize;
+  ///
+  /// Percentage of free bytes outside the largest free block.
+  ///
+  UINT32    Fragmentation;
+  ///
+  /// Number of slabs for small allocations, and free bytes within them.
+  ///
+  UINT32    SlabCount;
+  UINT32    SlabFreeSize;
+} UMM_STATISTICS;
+
 /**
   Check whether built-in allocator is initialized.
 
@@ -642,6 +674,8 @@ UmmSetHeap (
 
 /**
   Perform allocation from built-in allocator.
+  Small allocations are served in O(1) from fixed size class slabs,
+  larger ones and slab shortages fall back to the general purpose heap.
 
   @param[in]  Size  Allocation size.
 
@@ -665,4 +699,14 @@ UmmFree (
   IN VOID  *Ptr
   );
 
+/**
+  Get built-in allocator statistics.
+
+  @param[out]  Statistics  Allocator statistics.
+**/
+VOID
+UmmGetStatistics (
+  OUT UMM_STATISTICS  *Statistics
+  );
+
 #endif // OC_MEMORY_LIB_H
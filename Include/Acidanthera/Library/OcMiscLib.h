@@ -59,6 +59,69 @@ ApplyPatch (
   IN UINT32        Skip
   );
 
+/**
+  Patch description for ApplyPatchSet.
+**/
+typedef struct {
+  ///
+  /// Pattern to find.
+  ///
+  CONST UINT8    *Pattern;
+  ///
+  /// Pattern mask, optional.
+  ///
+  CONST UINT8    *PatternMask;
+  ///
+  /// Pattern and replacement size.
+  ///
+  UINT32         PatternSize;
+  ///
+  /// Replacement data.
+  ///
+  CONST UINT8    *Replace;
+  ///
+  /// Replacement mask, optional.
+  ///
+  CONST UINT8    *ReplaceMask;
+  ///
+  /// Maximum number of replacements, 0 for unlimited.
+  ///
+  UINT32         Count;
+  ///
+  /// Number of occurrences to skip before replacing.
+  ///
+  UINT32         Skip;
+  ///
+  /// Maximum number of bytes to search in, 0 for unlimited.
+  ///
+  UINT32         Limit;
+  ///
+  /// Performed replacement count on return.
+  ///
+  UINT32         ReplaceCount;
+} OC_PATCH_SET_ENTRY;
+
+/**
+  Apply multiple patches to the data with a single sweep over it.
+  The result is identical to calling ApplyPatch for each patch in order,
+  including patches matching the data modified by preceding patches.
+
+  @param[in,out]  Patches     Patches to apply, ReplaceCount is updated.
+  @param[in]      PatchCount  Number of patches.
+  @param[in,out]  Data        Data to patch.
+  @param[in]      DataSize    Data size.
+
+  @retval EFI_SUCCESS           Patches were applied.
+  @retval EFI_OUT_OF_RESOURCES  Patch set could not be compiled, nothing was applied.
+**/
+EFI_STATUS
+ApplyPatchSet (
+  IN OUT OC_PATCH_SET_ENTRY  *Patches,
+  IN     UINT32              PatchCount,
+  IN OUT UINT8               *Data,
+  IN     UINT32              DataSize
+  );
+
 /**
   Obtain application arguments.
 
@@ -0,0 +1,111 @@
+/** @file
+  Copyright (C) 2026, Acidanthera. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#ifndef OC_PARALLEL_LIB_H
+#define OC_PARALLEL_LIB_H
+
+#include <Uefi.h>
+
+/**
+  Maximum number of workers, including BSP, to run a job on.
+**/
+#define OC_PARALLEL_MAX_WORKERS  64U
+
+/**
+  Parallel job function.
+
+  Functions may run on application processors, and therefore must not use
+  any UEFI services, including memory allocation and debug printing.
+  Only pure computation over preallocated memory is allowed.
+
+  @param[in,out]  Context   Job context.
+  @param[in]      Index     Job item index.
+  @param[in]      Worker    Worker index, 0 to worker count minus 1.
+                            Worker 0 is always the calling processor.
+**/
+typedef
+VOID
+(EFIAPI *OC_PARALLEL_FUNCTION)(
+  IN OUT VOID   *Context,
+  IN     UINTN  Index,
+  IN     UINTN  Worker
+  );
+
+/**
+  Background task state.
+**/
+typedef struct {
+  ///
+  /// Implementation specific handle, NULL when there is nothing to wait for.
+  ///
+  VOID    *Handle;
+} OC_PARALLEL_TASK;
+
+/**
+  Get the number of workers available for parallel jobs.
+
+  @retval Number of workers, at least 1.
+**/
+UINTN
+OcParallelGetWorkerCount (
+  VOID
+  );
+
+/**
+  Run job function for every item index, distributing the items across
+  available processors. The calling processor participates as worker 0.
+  Without multiprocessor support all items run on the calling processor.
+  Returns when all items are complete.
+
+  @param[in]      Function    Job function.
+  @param[in,out]  Context     Job context.
+  @param[in]      Count       Number of job items.
+  @param[in]      MaxWorkers  Maximum number of workers to use, 0 for no limit.
+**/
+VOID
+OcParallelFor (
+  IN     OC_PARALLEL_FUNCTION  Function,
+  IN OUT VOID                  *Context,
+  IN     UINTN                 Count,
+  IN     UINTN                 MaxWorkers
+  );
+
+/**
+  Start job function on another processor, with item and worker index 0, so that
+  the calling processor can do other work meanwhile. When no other processor
+  is available, the function completes on the calling processor before
+  returning. OcParallelWaitTask must always be called afterwards.
+
+  @param[in]      Function    Job function.
+  @param[in,out]  Context     Job context.
+  @param[out]     Task        Task state.
+**/
+VOID
+OcParallelStartTask (
+  IN     OC_PARALLEL_FUNCTION  Function,
+  IN OUT VOID                  *Context,
+  OUT    OC_PARALLEL_TASK      *Task
+  );
+
+/**
+  Wait for background task completion.
+
+  @param[in,out]  Task        Task state from OcParallelStartTask.
+**/
+VOID
+OcParallelWaitTask (
+  IN OUT OC_PARALLEL_TASK  *Task
+  );
+
+#endif // OC_PARALLEL_LIB_H
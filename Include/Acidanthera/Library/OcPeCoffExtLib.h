@@ -10,8 +10,22 @@
 #define OC_PE_COFF_EXT_LIB_H
 
 #include <IndustryStandard/Apfs.h>
+#include <Library/OcCryptoLib.h>
 #include <Library/PeCoffLib2.h>
 
+/**
+  Apple PE/COFF image hash computed while the file is being read.
+**/
+typedef struct {
+  SHA256_CONTEXT    HashContext;
+  CONST UINT8       *FileBuffer;
+  UINT32            FileSize;
+  UINT32            Hashed;
+  UINT32            ExeHdrOffset;
+  UINT32            SecDirOffset;
+  UINT32            SignedFileSize;
+} PE_COFF_APPLE_HASH_CONTEXT;
+
 /**
   Verify Apple COFF legacy signature.
   Image buffer is sanitized where necessary (zeroed),
@@ -28,6 +42,57 @@ PeCoffVerifyAppleSignature (
   IN OUT UINT32  *ImageSize
   );
 
+/**
+  Start hashing Apple COFF image, which is being read into FileBuffer.
+  Available data must cover the image headers, which are checked to have
+  Apple signature directory before anything is hashed.
+
+  @param[out] Context     Hash context.
+  @param[in]  FileBuffer  Image buffer, which may not be filled yet.
+  @param[in]  FileSize    Size of the image.
+  @param[in]  Available   Number of bytes filled from the image start.
+
+  @retval EFI_SUCCESS      Available data is hashed.
+  @retval EFI_UNSUPPORTED  Image is not Apple signed, nothing is to be hashed.
+**/
+EFI_STATUS
+PeCoffAppleHashInit (
+  OUT PE_COFF_APPLE_HASH_CONTEXT  *Context,
+  IN  CONST VOID                  *FileBuffer,
+  IN  UINT32                      FileSize,
+  IN  UINT32                      Available
+  );
+
+/**
+  Hash Apple COFF image data, which has arrived since the previous call,
+  with the checksum, the security directory and the signature left out.
+
+  @param[in,out] Context    Hash context.
+  @param[in]     Available  Number of bytes filled from the image start.
+**/
+VOID
+PeCoffAppleHashUpdate (
+  IN OUT PE_COFF_APPLE_HASH_CONTEXT  *Context,
+  IN     UINT32                      Available
+  );
+
+/**
+  Verify Apple COFF legacy signature like PeCoffVerifyAppleSignature,
+  reusing the image hash computed while reading when it matches.
+
+  @param[in,out]  PeImage      Image buffer.
+  @param[in,out]  ImageSize    Size of the image.
+  @param[in]      HashContext  Hash context for PeImage. Optional.
+
+  @retval EFI_SUCCESS on success.
+**/
+EFI_STATUS
+PeCoffVerifyAppleSignatureWithHash (
+  IN OUT VOID                        *PeImage,
+  IN OUT UINT32                      *ImageSize,
+  IN     PE_COFF_APPLE_HASH_CONTEXT  *HashContext  OPTIONAL
+  );
+
 #ifdef EFIUSER
 
 /**
@@ -46,6 +111,23 @@ InternalPeCoffVerifyAppleSignatureFromContext (
   IN OUT  UINT32                       *ImageSize
   );
 
+/**
+  Hash Apple COFF image in one pass, with the checksum, the security
+  directory and the signature left out.
+
+  @param[in]  Context         Image context.
+  @param[in]  SecDirOffset    Offset of the security directory entry.
+  @param[in]  SignedFileSize  Size of the signed part of the image.
+  @param[out] Hash            Image hash.
+**/
+VOID
+PeCoffHashAppleImage (
+  IN  PE_COFF_LOADER_IMAGE_CONTEXT  *Context,
+  IN  UINT32                        SecDirOffset,
+  IN  UINT32                        SignedFileSize,
+  OUT UINT8                         *Hash
+  );
+
 #endif
 
 /**
@@ -64,6 +64,48 @@ OcDecodePng (
   OUT  BOOLEAN  *HasAlphaType OPTIONAL
   );
 
+/**
+  Decodes PNG image into EFI_GRAPHICS_OUTPUT_BLT_PIXEL buffer.
+  Non-interlaced 8-bit RGB and RGBA images are reconstructed and converted
+  in a single pass, other images are decoded with OcDecodePng and converted.
+
+  @param  Buffer                 Buffer with desired png image
+  @param  Size                   Size of input image
+  @param  Premultiply            Premultiply colour channels by alpha
+  @param  RawData                Output buffer with pixels, free with FreePool
+  @param  Width                  Image width at output
+  @param  Height                 Image height at output
+
+  @return EFI_SUCCESS            The function completed successfully.
+  @return EFI_OUT_OF_RESOURCES   There are not enough resources to decode.
+  @return EFI_UNSUPPORTED        Image dimensions are too large.
+  @return EFI_INVALID_PARAMETER  Passed wrong parameter
+**/
+EFI_STATUS
+OcDecodePngBgra (
+  IN  VOID     *Buffer,
+  IN  UINTN    Size,
+  IN  BOOLEAN  Premultiply,
+  OUT VOID     **RawData,
+  OUT UINT32   *Width,
+  OUT UINT32   *Height
+  );
+
+#ifdef EFIUSER
+
+/**
+  Enable or disable SIMD kernels of OcDecodePngBgra to compare them with C code.
+  Does nothing when SIMD kernels are not built.
+
+  @param  Enable                 Use SIMD kernels supported by the CPU
+**/
+VOID
+InternalPngSetSimd (
+  IN BOOLEAN  Enable
+  );
+
+#endif
+
 /**
   Encodes raw pixel buffer into PNG image data
 
@@ -85,4 +127,64 @@ OcEncodePng (
   OUT UINTN   *BufferSize
   );
 
+/**
+  Incremental PNG encoder context.
+**/
+typedef struct OC_PNG_ENCODER_ OC_PNG_ENCODER;
+
+/**
+  Start incremental encoding of a raw pixel buffer into PNG image data.
+  The image is written as RGB with fast compression, alpha is ignored.
+
+  @param  Pixels                 Pixels in EFI_GRAPHICS_OUTPUT_BLT_PIXEL layout,
+                                 must stay valid until encoding is complete
+  @param  Width                  Image width
+  @param  Height                 Image height
+  @param  RowsPerStep            Number of rows to encode per step
+  @param  Encoder                Encoder context at output
+
+  @return EFI_SUCCESS            The function completed successfully.
+  @return EFI_OUT_OF_RESOURCES   There are not enough resources to encode.
+  @return EFI_UNSUPPORTED        Image dimensions are too large.
+  @return EFI_INVALID_PARAMETER  Passed wrong parameter
+**/
+EFI_STATUS
+OcPngEncoderCreate (
+  IN  CONST VOID      *Pixels,
+  IN  UINT32          Width,
+  IN  UINT32          Height,
+  IN  UINT32          RowsPerStep,
+  OUT OC_PNG_ENCODER  **Encoder
+  );
+
+/**
+  Encode next rows of the image.
+
+  @param  Encoder                Encoder context
+  @param  Buffer                 Output buffer with PNG image on completion,
+                                 free with FreePool
+  @param  BufferSize             Output size on completion
+
+  @return EFI_SUCCESS            The image is complete.
+  @return EFI_NOT_READY          More steps are needed.
+  @return EFI_ALREADY_STARTED    The image was already returned.
+  @return EFI_DEVICE_ERROR       Compression failed.
+**/
+EFI_STATUS
+OcPngEncoderStep (
+  IN OUT OC_PNG_ENCODER  *Encoder,
+  OUT    VOID            **Buffer,
+  OUT    UINTN           *BufferSize
+  );
+
+/**
+  Free incremental PNG encoder.
+
+  @param  Encoder                Encoder context
+**/
+VOID
+OcPngEncoderFree (
+  IN OC_PNG_ENCODER  *Encoder
+  );
+
 #endif
@@ -0,0 +1,133 @@
+/** @file
+  Boot phase tracing.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#ifndef OC_TRACE_LIB_H
+#define OC_TRACE_LIB_H
+
+#include <Uefi.h>
+#include <Protocol/SimpleFileSystem.h>
+
+//
+// Number of spans kept, older spans are overwritten. Must be a power of two.
+//
+#define OC_TRACE_MAX_EVENTS  256U
+
+//
+// Maximum size of the NVRAM summary including the terminator.
+//
+#define OC_TRACE_SUMMARY_SIZE  BASE_1KB
+
+//
+// Variable with the NVRAM summary under gOcVendorVariableGuid.
+//
+#define OC_TRACE_VARIABLE_NAME  L"boot-trace"
+
+//
+// Invalid span identifier, ignored by OcTraceEnd.
+//
+#define OC_TRACE_INVALID_ID  0U
+
+typedef UINT32 OC_TRACE_ID;
+
+///
+/// Boot milestones at which the trace file is written.
+///
+typedef enum {
+  OcTraceMilestoneBootScan,
+  OcTraceMilestoneKernel,
+  OcTraceMilestoneMax
+} OC_TRACE_MILESTONE;
+
+/**
+  Begin new trace span. Spans are always recorded, as recording only reads
+  TSC, and are exported once OcTraceConfigure is called.
+
+  @param[in]  Name  Span name, static string not requiring JSON escaping.
+
+  @retval span identifier to pass to OcTraceEnd.
+**/
+OC_TRACE_ID
+OcTraceBegin (
+  IN CONST CHAR8  *Name
+  );
+
+/**
+  End trace span.
+
+  @param[in]  Id  Span identifier returned by OcTraceBegin.
+**/
+VOID
+OcTraceEnd (
+  IN OC_TRACE_ID  Id
+  );
+
+/**
+  Format trace in Chrome trace event JSON format.
+
+  @param[out]  Buffer        Output buffer.
+  @param[in]   BufferSize    Output buffer size.
+  @param[in]   TscFrequency  TSC frequency in Hz.
+
+  @retval output size without the terminator, truncated spans are dropped.
+**/
+UINTN
+OcTraceFormatJson (
+  OUT CHAR8   *Buffer,
+  IN  UINTN   BufferSize,
+  IN  UINT64  TscFrequency
+  );
+
+/**
+  Format compact trace summary with durations of completed spans
+  in microseconds, as "Name=Duration;" pairs in order of their beginning.
+  Nested spans are prefixed with '+' for each nesting level.
+
+  @param[out]  Buffer        Output buffer.
+  @param[in]   BufferSize    Output buffer size.
+  @param[in]   TscFrequency  TSC frequency in Hz.
+
+  @retval output size without the terminator, truncated spans are dropped.
+**/
+UINTN
+OcTraceFormatSummary (
+  OUT CHAR8   *Buffer,
+  IN  UINTN   BufferSize,
+  IN  UINT64  TscFrequency
+  );
+
+/**
+  Enable trace export to a JSON file and to NVRAM summary.
+  The file is written by OcTraceExportFile, and the NVRAM summary is written
+  once at ExitBootServices.
+
+  @param[in] PrefixPath   Trace file path (without timestamp).
+  @param[in] FileSystem   Trace file system, optional.
+
+  Note: If FileSystem is specified, and it is not writable, then
+  the first writable file system is chosen.
+
+  @retval EFI_SUCCESS on success.
+**/
+EFI_STATUS
+OcTraceConfigure (
+  IN CONST CHAR16                     *PrefixPath,
+  IN EFI_SIMPLE_FILE_SYSTEM_PROTOCOL  *FileSystem  OPTIONAL
+  );
+
+/**
+  Write trace file when reaching boot milestone. The file is written at most
+  once per milestone, as every write rewrites it completely.
+  Does nothing unless OcTraceConfigure found a writable file system.
+
+  @param[in] Milestone  Reached boot milestone.
+**/
+VOID
+OcTraceExportFile (
+  IN OC_TRACE_MILESTONE  Milestone
+  );
+
+#endif // OC_TRACE_LIB_H
@@ -440,6 +440,26 @@ PlistDataValue (
   IN OUT  UINT32    *Size
   );
 
+/**
+  Decode data content in place within the document buffer, avoiding
+  a separate allocation for the decoded data.
+
+  @warning  The encoded content is overwritten, so the node must not be
+            decoded again, and the document must not be exported afterwards.
+
+  @param[in]   Node    A pointer to the XML node. Optional.
+  @param[out]  Buffer  Decoded data within the document buffer, NULL when empty.
+  @param[out]  Size    Size of decoded data.
+
+  @return TRUE if Node can be casted to PLIST_NODE_TYPE_DATA and is valid Base64.
+**/
+BOOLEAN
+PlistDataValueInPlace (
+  IN   XML_NODE  *Node    OPTIONAL,
+  OUT  UINT8     **Buffer,
+  OUT  UINT32    *Size
+  );
+
 /**
   Get the value of a plist boolean.
 
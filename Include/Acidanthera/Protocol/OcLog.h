@@ -34,11 +34,13 @@
 #define OC_LOG_NONVOLATILE  BIT5
 #define OC_LOG_FILE         BIT6
 #define OC_LOG_UNSAFE       BIT7
+#define OC_LOG_TRACE        BIT8
 #define OC_LOG_ALL_BITS     (\
   OC_LOG_ENABLE   | OC_LOG_CONSOLE     | \
   OC_LOG_DATA_HUB | OC_LOG_SERIAL      | \
   OC_LOG_VARIABLE | OC_LOG_NONVOLATILE | \
-  OC_LOG_FILE     | OC_LOG_UNSAFE )
+  OC_LOG_FILE     | OC_LOG_UNSAFE      | \
+  OC_LOG_TRACE )
 
 ///
 /// Maximum possible number of characters of log prefix including colon.
@@ -34,6 +34,7 @@
 #include <Library/OcMiscLib.h>
 #include <Library/OcOSInfoLib.h>
 #include <Library/OcStringLib.h>
+#include <Library/OcTraceLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiLib.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
@@ -379,8 +380,86 @@ ApplyBooterPatch (
   }
 }
 
+/**
+  Report booter patch set results with a single line of replacement counts.
+
+  @param[in]      Patches          Array of configured patches.
+  @param[in]      PatchIndices     Indices of applied patches in Patches.
+  @param[in]      PatchSet         Applied patch set.
+  @param[in]      PatchSetCount    Size of applied patch set.
+**/
+STATIC
+VOID
+ReportBooterPatchSet (
+  IN  OC_BOOTER_PATCH     *Patches,
+  IN  UINT32              *PatchIndices,
+  IN  OC_PATCH_SET_ENTRY  *PatchSet,
+  IN  UINT32              PatchSetCount
+  )
+{
+  OC_BOOTER_PATCH  *Patch;
+  CHAR8            *Summary;
+  UINTN            SummarySize;
+  UINTN            SummaryLength;
+  UINT32           ReplaceCount;
+  UINT32           Index;
+  UINT32           Failed;
+
+  Failed      = 0;
+  SummarySize = sizeof (CHAR8);
+
+  for (Index = 0; Index < PatchSetCount; ++Index) {
+    Patch        = &Patches[PatchIndices[Index]];
+    ReplaceCount = PatchSet[Index].ReplaceCount;
+
+    if ((ReplaceCount == 0) || ((Patch->Count > 0) && (ReplaceCount != Patch->Count))) {
+      ++Failed;
+    }
+
+    SummarySize += AsciiStrLen (Patch->Comment) + L_STR_LEN (", =4294967295/4294967295");
+  }
+
+  Summary = AllocatePool (SummarySize);
+  if (Summary == NULL) {
+    DEBUG ((
+      DEBUG_INFO,
+      "OCABC: Applied %u of %u Booter patches\n",
+      PatchSetCount - Failed,
+      PatchSetCount
+      ));
+    return;
+  }
+
+  Summary[0]    = '\0';
+  SummaryLength = 0;
+
+  for (Index = 0; Index < PatchSetCount; ++Index) {
+    OcAsciiSafeSPrint (
+      &Summary[SummaryLength],
+      SummarySize - SummaryLength,
+      "%a%a=%u/%u",
+      Index > 0 ? ", " : "",
+      Patches[PatchIndices[Index]].Comment,
+      PatchSet[Index].ReplaceCount,
+      Patches[PatchIndices[Index]].Count
+      );
+    SummaryLength += AsciiStrLen (&Summary[SummaryLength]);
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "OCABC: Applied %u of %u Booter patches - %a\n",
+    PatchSetCount - Failed,
+    PatchSetCount,
+    Summary
+    ));
+
+  FreePool (Summary);
+}
+
 /**
   Iterate through user booter patches and apply them.
+  All patches matching the image are applied with a single sweep over it.
 
   @param[in]      ImageHandle      Loaded image handle to patch.
   @param[in]      IsApple          Whether the booter is Apple-made.
@@ -402,6 +481,13 @@ ApplyBooterPatches (
   BOOLEAN                    UsePatch;
   CONST CHAR8                *UserIdentifier;
   CHAR16                     *UserIdentifierUnicode;
+  OC_PATCH_SET_ENTRY         *PatchSet;
+  UINT32                     *PatchIndices;
+  UINT32                     PatchSetCount;
+
+  if (PatchCount == 0) {
+    return;
+  }
 
   Status = gBS->HandleProtocol (
                   ImageHandle,
@@ -413,6 +499,18 @@ ApplyBooterPatches (
     return;
   }
 
+  PatchSet     = AllocatePool (PatchCount * sizeof (*PatchSet));
+  PatchIndices = AllocatePool (PatchCount * sizeof (*PatchIndices));
+  if ((PatchSet == NULL) || (PatchIndices == NULL)) {
+    DEBUG ((DEBUG_WARN, "OCABC: Booter patch set is out of memory, applying one by one\n"));
+    if (PatchSet != NULL) {
+      FreePool (PatchSet);
+      PatchSet = NULL;
+    }
+  }
+
+  PatchSetCount = 0;
+
   for (Index = 0; Index < PatchCount; ++Index) {
     UserIdentifier = Patches[Index].Identifier;
 
@@ -431,13 +529,63 @@ ApplyBooterPatches (
       FreePool (UserIdentifierUnicode);
     }
 
-    if (UsePatch) {
+    if (!UsePatch) {
+      continue;
+    }
+
+    if (PatchSet == NULL) {
       ApplyBooterPatch (
         (UINT8 *)LoadedImage->ImageBase,
         (UINTN)LoadedImage->ImageSize,
         &Patches[Index]
         );
+      continue;
+    }
+
+    if (LoadedImage->ImageSize < Patches[Index].Size) {
+      DEBUG ((DEBUG_INFO, "OCABC: Image size is even smaller than patch (%a) size\n", Patches[Index].Comment));
+      continue;
     }
+
+    PatchIndices[PatchSetCount]         = Index;
+    PatchSet[PatchSetCount].Pattern     = Patches[Index].Find;
+    PatchSet[PatchSetCount].PatternMask = Patches[Index].Mask;
+    PatchSet[PatchSetCount].PatternSize = Patches[Index].Size;
+    PatchSet[PatchSetCount].Replace     = Patches[Index].Replace;
+    PatchSet[PatchSetCount].ReplaceMask = Patches[Index].ReplaceMask;
+    PatchSet[PatchSetCount].Count       = Patches[Index].Count;
+    PatchSet[PatchSetCount].Skip        = Patches[Index].Skip;
+    PatchSet[PatchSetCount].Limit       = Patches[Index].Limit;
+    ++PatchSetCount;
+  }
+
+  if (PatchSetCount > 0) {
+    Status = ApplyPatchSet (
+               PatchSet,
+               PatchSetCount,
+               (UINT8 *)LoadedImage->ImageBase,
+               (UINT32)LoadedImage->ImageSize
+               );
+    if (!EFI_ERROR (Status)) {
+      ReportBooterPatchSet (Patches, PatchIndices, PatchSet, PatchSetCount);
+    } else {
+      DEBUG ((DEBUG_WARN, "OCABC: Booter patch set failed - %r, applying one by one\n", Status));
+      for (Index = 0; Index < PatchSetCount; ++Index) {
+        ApplyBooterPatch (
+          (UINT8 *)LoadedImage->ImageBase,
+          (UINTN)LoadedImage->ImageSize,
+          &Patches[PatchIndices[Index]]
+          );
+      }
+    }
+  }
+
+  if (PatchSet != NULL) {
+    FreePool (PatchSet);
+  }
+
+  if (PatchIndices != NULL) {
+    FreePool (PatchIndices);
   }
 }
 
@@ -1177,6 +1325,7 @@ OcStartImage (
   BOOT_COMPAT_CONTEXT        *BootCompat;
   OC_FWRT_CONFIG             Config;
   UINTN                      DataSize;
+  OC_TRACE_ID                TraceId;
 
   BootCompat       = GetBootCompatContext ();
   AppleLoadedImage = OcGetAppleBootLoadedImage (ImageHandle);
@@ -1326,12 +1475,14 @@ OcStartImage (
   //
   // Apply customised booter patches.
   //
+  TraceId = OcTraceBegin ("BooterPatch");
   ApplyBooterPatches (
     ImageHandle,
     AppleLoadedImage != NULL,
     BootCompat->Settings.BooterPatches,
     BootCompat->Settings.BooterPatchesSize
     );
+  OcTraceEnd (TraceId);
 
   Status = BootCompat->ServicePtrs.StartImage (
                                      ImageHandle,
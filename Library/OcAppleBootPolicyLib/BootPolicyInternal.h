@@ -0,0 +1,35 @@
+/** @file
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#ifndef BOOT_POLICY_INTERNAL_H
+#define BOOT_POLICY_INTERNAL_H
+
+#include <Uefi.h>
+#include <Protocol/SimpleFileSystem.h>
+
+/**
+  Look up file existence in the path cache, filling the cache with
+  a single listing of the parent directory on first use.
+
+  @param[in]  Device     Volume device handle, NULL bypasses the cache.
+  @param[in]  Root       Directory FileName is relative to.
+  @param[in]  Prefix     Path of Root within the volume, NULL for volume root.
+  @param[in]  FileName   File path relative to Root, leading slash is ignored.
+  @param[out] Attribute  File attributes when found.
+
+  @retval EFI_SUCCESS    File is present.
+  @retval EFI_NOT_FOUND  File is known to be missing.
+  @retval other          Cache cannot answer, the file must be opened directly.
+**/
+EFI_STATUS
+InternalPathCacheLookup (
+  IN  EFI_HANDLE         Device   OPTIONAL,
+  IN  EFI_FILE_PROTOCOL  *Root,
+  IN  CONST CHAR16       *Prefix  OPTIONAL,
+  IN  CONST CHAR16       *FileName,
+  OUT UINT64             *Attribute
+  );
+
+#endif // BOOT_POLICY_INTERNAL_H
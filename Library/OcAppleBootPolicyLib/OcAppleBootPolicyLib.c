@@ -34,6 +34,8 @@
 #include <Library/PrintLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 
+#include "BootPolicyInternal.h"
+
 typedef struct {
   EFI_HANDLE                Handle;
   GUID                      ContainerGuid;
@@ -140,7 +142,9 @@ STATIC APPLE_BOOT_POLICY_PROTOCOL  mAppleBootPolicyProtocol = {
 /**
   Checks whether the given file exists or not.
 
-  @param[in] Root      The volume's opened root.
+  @param[in] Device    The volume's device handle, NULL to bypass the path cache.
+  @param[in] Root      The volume's opened root or a directory within it.
+  @param[in] Prefix    The path of Root within the volume, NULL for volume root.
   @param[in] FileName  The path of the file to check.
 
   @return  Returned is whether the specified file exists or not.
@@ -149,12 +153,20 @@ STATIC APPLE_BOOT_POLICY_PROTOCOL  mAppleBootPolicyProtocol = {
 STATIC
 EFI_STATUS
 InternalFileExists (
+  IN EFI_HANDLE       Device  OPTIONAL,
   IN EFI_FILE_HANDLE  Root,
+  IN CONST CHAR16     *Prefix OPTIONAL,
   IN CONST CHAR16     *FileName
   )
 {
   EFI_STATUS       Status;
   EFI_FILE_HANDLE  FileHandle;
+  UINT64           Attribute;
+
+  Status = InternalPathCacheLookup (Device, Root, Prefix, FileName, &Attribute);
+  if ((Status == EFI_SUCCESS) || (Status == EFI_NOT_FOUND)) {
+    return Status;
+  }
 
   Status = OcSafeFileOpen (
              Root,
@@ -350,7 +362,7 @@ InternalGetBooterFromBlessedSystemFolderPath (
     return Status;
   }
 
-  Status = InternalFileExists (Root, BooterPath);
+  Status = InternalFileExists (Device, Root, NULL, BooterPath);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_BULK_INFO, "OCBP: Blessed folder %s is missing - %r\n", BooterPath, Status));
     return EFI_NOT_FOUND;
@@ -388,7 +400,9 @@ OcGetBooterFromPredefinedPathList (
     }
 
     Status = InternalFileExists (
+               Device,
                Root,
+               Prefix,
                Prefix != NULL ? &PathName[1] : &PathName[0]
                );
     if (!EFI_ERROR (Status)) {
@@ -506,6 +520,16 @@ InternalGetBooterFromApfsVolumePredefinedPathList (
   EFI_STATUS         Status;
   EFI_FILE_PROTOCOL  *VolumeDirectoryHandle;
   EFI_FILE_INFO      *VolumeDirectoryInfo;
+  UINT64             Attribute;
+
+  //
+  // Preboot root listing answers this for every volume in the container.
+  //
+  Status = InternalPathCacheLookup (Device, PrebootRoot, NULL, VolumeDirectoryName, &Attribute);
+  if ((Status == EFI_NOT_FOUND) || (!EFI_ERROR (Status) && ((Attribute & EFI_FILE_DIRECTORY) == 0))) {
+    DEBUG ((DEBUG_BULK_INFO, "OCBP: Missing partition %s on preboot (cached)\n", VolumeDirectoryName));
+    return EFI_NOT_FOUND;
+  }
 
   Status = OcSafeFileOpen (
              PrebootRoot,
@@ -1262,6 +1286,7 @@ OcBootPolicyGetApfsRecoveryFilePath (
   EFI_FILE_PROTOCOL  *NewHandle;
 
   EFI_FILE_INFO  *FileInfo;
+  UINT64         Attribute;
 
   ASSERT (DevicePath != NULL);
   ASSERT (PathName != NULL);
@@ -1387,6 +1412,13 @@ OcBootPolicyGetApfsRecoveryFilePath (
       PathName
       );
 
+    Status = InternalPathCacheLookup (HandleBuffer[Index], *Root, NULL, FullPathBuffer, &Attribute);
+    if ((Status == EFI_NOT_FOUND) || (!EFI_ERROR (Status) && ((Attribute & EFI_FILE_DIRECTORY) == 0))) {
+      (*Root)->Close (*Root);
+      FreePool (FullPathBuffer);
+      continue;
+    }
+
     Status = OcSafeFileOpen (
                *Root,
                &NewHandle,
@@ -1493,6 +1525,7 @@ OcBootPolicyGetAllApfsRecoveryFilePath (
   CHAR16                           VolumePathName[GUID_STRING_LENGTH + 1];
   EFI_FILE_INFO                    *FileInfo;
   APFS_VOLUME_ROOT                 *ApfsRoot;
+  UINT64                           Attribute;
 
   ASSERT (Volumes != NULL);
   ASSERT (NumberOfEntries != NULL);
@@ -1642,6 +1675,11 @@ OcBootPolicyGetAllApfsRecoveryFilePath (
           &VolumeInfo[Index3].VolumeGuid
           );
 
+        Status = InternalPathCacheLookup (VolumeInfo[Index2].Handle, Root, NULL, VolumePathName, &Attribute);
+        if ((Status == EFI_NOT_FOUND) || (!EFI_ERROR (Status) && ((Attribute & EFI_FILE_DIRECTORY) == 0))) {
+          continue;
+        }
+
         Status = OcSafeFileOpen (
                    Root,
                    &NewHandle,
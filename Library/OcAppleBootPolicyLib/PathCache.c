@@ -0,0 +1,472 @@
+/** @file
+  Boot policy path existence cache.
+
+  Probing predefined booter paths opens many files that do not exist on
+  every volume, often through slow third-party file system drivers. While
+  enabled, every probe is answered from a single listing of its parent
+  directory, including the listing failure when the directory is missing.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Uefi.h>
+
+#include <Guid/FileInfo.h>
+
+#include <Protocol/BlockIo.h>
+#include <Protocol/SimpleFileSystem.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcAppleBootPolicyLib.h>
+#include <Library/OcFileLib.h>
+#include <Library/OcStringLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+#include "BootPolicyInternal.h"
+
+//
+// Directories with more entries are cached incompletely, and missing
+// names in them are looked up directly.
+//
+#define PATH_CACHE_MAX_ENTRIES  512U
+
+typedef struct {
+  CHAR16    *Name;
+  UINT64    Attribute;
+} PATH_CACHE_ENTRY;
+
+typedef struct {
+  LIST_ENTRY          Link;
+  ///
+  /// Directory path within the volume without leading slash.
+  ///
+  CHAR16              *Path;
+  BOOLEAN             Exists;
+  BOOLEAN             Complete;
+  UINTN               NumEntries;
+  UINTN               MaxEntries;
+  PATH_CACHE_ENTRY    *Entries;
+} PATH_CACHE_DIRECTORY;
+
+typedef struct {
+  LIST_ENTRY    Link;
+  EFI_HANDLE    Device;
+  UINT32        MediaId;
+  LIST_ENTRY    Directories;
+} PATH_CACHE_VOLUME;
+
+STATIC BOOLEAN  mPathCacheEnabled;
+
+STATIC LIST_ENTRY  mPathCacheVolumes = INITIALIZE_LIST_HEAD_VARIABLE (mPathCacheVolumes);
+
+STATIC
+VOID
+InternalPathCacheFreeDirectory (
+  IN PATH_CACHE_DIRECTORY  *Directory
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < Directory->NumEntries; ++Index) {
+    FreePool (Directory->Entries[Index].Name);
+  }
+
+  if (Directory->Entries != NULL) {
+    FreePool (Directory->Entries);
+  }
+
+  FreePool (Directory->Path);
+  FreePool (Directory);
+}
+
+STATIC
+VOID
+InternalPathCacheFlush (
+  VOID
+  )
+{
+  PATH_CACHE_VOLUME     *Volume;
+  PATH_CACHE_DIRECTORY  *Directory;
+
+  while (!IsListEmpty (&mPathCacheVolumes)) {
+    Volume = BASE_CR (GetFirstNode (&mPathCacheVolumes), PATH_CACHE_VOLUME, Link);
+
+    while (!IsListEmpty (&Volume->Directories)) {
+      Directory = BASE_CR (GetFirstNode (&Volume->Directories), PATH_CACHE_DIRECTORY, Link);
+      RemoveEntryList (&Directory->Link);
+      InternalPathCacheFreeDirectory (Directory);
+    }
+
+    RemoveEntryList (&Volume->Link);
+    FreePool (Volume);
+  }
+}
+
+VOID
+OcBootPolicySetPathCache (
+  IN BOOLEAN  Enable
+  )
+{
+  InternalPathCacheFlush ();
+  mPathCacheEnabled = Enable;
+}
+
+/**
+  Find or create cached volume matching device handle and current media.
+
+  @param[in] Device  Volume device handle.
+
+  @retval Cached volume or NULL on allocation failure.
+**/
+STATIC
+PATH_CACHE_VOLUME *
+InternalPathCacheGetVolume (
+  IN EFI_HANDLE  Device
+  )
+{
+  EFI_STATUS             Status;
+  EFI_BLOCK_IO_PROTOCOL  *BlockIo;
+  UINT32                 MediaId;
+  LIST_ENTRY             *Link;
+  PATH_CACHE_VOLUME      *Volume;
+
+  //
+  // Volumes without BlockIo, e.g. virtual or APFS ones, rely on
+  // the handle and the cache session alone.
+  //
+  MediaId = 0;
+  Status  = gBS->HandleProtocol (Device, &gEfiBlockIoProtocolGuid, (VOID **)&BlockIo);
+  if (!EFI_ERROR (Status) && (BlockIo->Media != NULL)) {
+    MediaId = BlockIo->Media->MediaId;
+  }
+
+  for (
+       Link = GetFirstNode (&mPathCacheVolumes);
+       !IsNull (&mPathCacheVolumes, Link);
+       Link = GetNextNode (&mPathCacheVolumes, Link))
+  {
+    Volume = BASE_CR (Link, PATH_CACHE_VOLUME, Link);
+    if (Volume->Device != Device) {
+      continue;
+    }
+
+    if (Volume->MediaId == MediaId) {
+      return Volume;
+    }
+
+    //
+    // Media changed, drop stale listings and reuse the volume.
+    //
+    DEBUG ((DEBUG_BULK_INFO, "OCBP: Media changed on %p, flushing path cache\n", Device));
+    while (!IsListEmpty (&Volume->Directories)) {
+      Link = GetFirstNode (&Volume->Directories);
+      RemoveEntryList (Link);
+      InternalPathCacheFreeDirectory (BASE_CR (Link, PATH_CACHE_DIRECTORY, Link));
+    }
+
+    Volume->MediaId = MediaId;
+    return Volume;
+  }
+
+  Volume = AllocatePool (sizeof (*Volume));
+  if (Volume == NULL) {
+    return NULL;
+  }
+
+  Volume->Device  = Device;
+  Volume->MediaId = MediaId;
+  InitializeListHead (&Volume->Directories);
+  InsertTailList (&mPathCacheVolumes, &Volume->Link);
+
+  return Volume;
+}
+
+STATIC
+EFI_STATUS
+InternalPathCacheAddEntry (
+  EFI_FILE_HANDLE  Directory,
+  EFI_FILE_INFO    *FileInfo,
+  UINTN            FileInfoSize,
+  VOID             *Context  OPTIONAL
+  )
+{
+  PATH_CACHE_DIRECTORY  *CacheDirectory;
+  PATH_CACHE_ENTRY      *Entries;
+  UINTN                 NameSize;
+
+  CacheDirectory = Context;
+
+  if (  (StrCmp (FileInfo->FileName, L".") == 0)
+     || (StrCmp (FileInfo->FileName, L"..") == 0))
+  {
+    return EFI_NOT_FOUND;
+  }
+
+  if (CacheDirectory->NumEntries == PATH_CACHE_MAX_ENTRIES) {
+    CacheDirectory->Complete = FALSE;
+    return EFI_NOT_FOUND;
+  }
+
+  if (CacheDirectory->NumEntries == CacheDirectory->MaxEntries) {
+    Entries = ReallocatePool (
+                CacheDirectory->MaxEntries * sizeof (*Entries),
+                CacheDirectory->MaxEntries * 2 * sizeof (*Entries),
+                CacheDirectory->Entries
+                );
+    if (Entries == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    CacheDirectory->Entries     = Entries;
+    CacheDirectory->MaxEntries *= 2;
+  }
+
+  if (FileInfoSize <= SIZE_OF_EFI_FILE_INFO) {
+    CacheDirectory->Complete = FALSE;
+    return EFI_NOT_FOUND;
+  }
+
+  //
+  // FileName size is bounded by FileInfoSize, yet some drivers do not
+  // terminate it within that size.
+  //
+  NameSize = FileInfoSize - SIZE_OF_EFI_FILE_INFO;
+  CacheDirectory->Entries[CacheDirectory->NumEntries].Name = AllocateZeroPool (NameSize + sizeof (CHAR16));
+  if (CacheDirectory->Entries[CacheDirectory->NumEntries].Name == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  CopyMem (CacheDirectory->Entries[CacheDirectory->NumEntries].Name, FileInfo->FileName, NameSize);
+  CacheDirectory->Entries[CacheDirectory->NumEntries].Attribute = FileInfo->Attribute;
+  ++CacheDirectory->NumEntries;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  List directory into the cache.
+
+  @param[in] Volume      Cached volume.
+  @param[in] Root        Directory Path is relative to.
+  @param[in] CachePath   Directory path within the volume, consumed.
+  @param[in] Path        Directory path relative to Root, empty for Root.
+
+  @retval Cached directory or NULL when it cannot be listed.
+**/
+STATIC
+PATH_CACHE_DIRECTORY *
+InternalPathCacheListDirectory (
+  IN PATH_CACHE_VOLUME  *Volume,
+  IN EFI_FILE_PROTOCOL  *Root,
+  IN CHAR16             *CachePath,
+  IN CONST CHAR16       *Path
+  )
+{
+  EFI_STATUS            Status;
+  EFI_FILE_PROTOCOL     *Directory;
+  PATH_CACHE_DIRECTORY  *CacheDirectory;
+
+  CacheDirectory = AllocateZeroPool (sizeof (*CacheDirectory));
+  if (CacheDirectory == NULL) {
+    FreePool (CachePath);
+    return NULL;
+  }
+
+  CacheDirectory->Path     = CachePath;
+  CacheDirectory->Complete = TRUE;
+
+  if (Path[0] == L'\0') {
+    Directory = Root;
+    Status    = EFI_SUCCESS;
+  } else {
+    Status = OcSafeFileOpen (Root, &Directory, Path, EFI_FILE_MODE_READ, 0);
+  }
+
+  if (Status == EFI_NOT_FOUND) {
+    //
+    // Negative entry, everything within this directory is missing.
+    //
+    InsertTailList (&Volume->Directories, &CacheDirectory->Link);
+    return CacheDirectory;
+  }
+
+  if (EFI_ERROR (Status)) {
+    InternalPathCacheFreeDirectory (CacheDirectory);
+    return NULL;
+  }
+
+  CacheDirectory->MaxEntries = 16;
+  CacheDirectory->Entries    = AllocatePool (CacheDirectory->MaxEntries * sizeof (*CacheDirectory->Entries));
+  if (CacheDirectory->Entries != NULL) {
+    Status = OcScanDirectory (Directory, InternalPathCacheAddEntry, CacheDirectory);
+  } else {
+    Status = EFI_OUT_OF_RESOURCES;
+  }
+
+  if (Directory != Root) {
+    Directory->Close (Directory);
+  }
+
+  if (EFI_ERROR (Status) && (Status != EFI_NOT_FOUND)) {
+    DEBUG ((DEBUG_BULK_INFO, "OCBP: Cannot cache directory %s - %r\n", CachePath, Status));
+    InternalPathCacheFreeDirectory (CacheDirectory);
+    return NULL;
+  }
+
+  CacheDirectory->Exists = TRUE;
+  InsertTailList (&Volume->Directories, &CacheDirectory->Link);
+
+  DEBUG ((
+    DEBUG_BULK_INFO,
+    "OCBP: Cached directory %s with %u entries%a\n",
+    CachePath,
+    (UINT32)CacheDirectory->NumEntries,
+    CacheDirectory->Complete ? "" : " (incomplete)"
+    ));
+
+  return CacheDirectory;
+}
+
+EFI_STATUS
+InternalPathCacheLookup (
+  IN  EFI_HANDLE         Device   OPTIONAL,
+  IN  EFI_FILE_PROTOCOL  *Root,
+  IN  CONST CHAR16       *Prefix  OPTIONAL,
+  IN  CONST CHAR16       *FileName,
+  OUT UINT64             *Attribute
+  )
+{
+  PATH_CACHE_VOLUME     *Volume;
+  PATH_CACHE_DIRECTORY  *Directory;
+  LIST_ENTRY            *Link;
+  CHAR16                *Path;
+  CHAR16                *CachePath;
+  CONST CHAR16          *Name;
+  UINTN                 PathLength;
+  UINTN                 CachePathSize;
+  UINTN                 Index;
+  BOOLEAN               CaseMismatch;
+
+  ASSERT (Root != NULL);
+  ASSERT (FileName != NULL);
+  ASSERT (Attribute != NULL);
+
+  if (!mPathCacheEnabled || (Device == NULL)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (FileName[0] == L'\\') {
+    ++FileName;
+  }
+
+  if ((Prefix != NULL) && (Prefix[0] == L'\\')) {
+    ++Prefix;
+  }
+
+  //
+  // Split into parent directory path and file name.
+  //
+  Name = NULL;
+  for (Index = 0; FileName[Index] != L'\0'; ++Index) {
+    if (FileName[Index] == L'\\') {
+      Name = &FileName[Index + 1];
+    }
+  }
+
+  if (Name == NULL) {
+    Name       = FileName;
+    PathLength = 0;
+  } else {
+    PathLength = (UINTN)(Name - FileName) - 1;
+  }
+
+  if ((Name[0] == L'\0') || ((PathLength == 0) && (Name != FileName))) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Volume = InternalPathCacheGetVolume (Device);
+  if (Volume == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Path = AllocateCopyPool ((PathLength + 1) * sizeof (CHAR16), FileName);
+  if (Path == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Path[PathLength] = L'\0';
+
+  CachePathSize = (PathLength + 1) * sizeof (CHAR16);
+  if ((Prefix != NULL) && (Prefix[0] != L'\0')) {
+    CachePathSize += StrSize (Prefix);
+  }
+
+  CachePath = AllocatePool (CachePathSize);
+  if (CachePath == NULL) {
+    FreePool (Path);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  CachePath[0] = L'\0';
+  if ((Prefix != NULL) && (Prefix[0] != L'\0')) {
+    StrCpyS (CachePath, CachePathSize / sizeof (CHAR16), Prefix);
+    if (PathLength > 0) {
+      StrCatS (CachePath, CachePathSize / sizeof (CHAR16), L"\\");
+    }
+  }
+
+  StrCatS (CachePath, CachePathSize / sizeof (CHAR16), Path);
+
+  Directory = NULL;
+  for (
+       Link = GetFirstNode (&Volume->Directories);
+       !IsNull (&Volume->Directories, Link);
+       Link = GetNextNode (&Volume->Directories, Link))
+  {
+    if (StrCmp (BASE_CR (Link, PATH_CACHE_DIRECTORY, Link)->Path, CachePath) == 0) {
+      Directory = BASE_CR (Link, PATH_CACHE_DIRECTORY, Link);
+      break;
+    }
+  }
+
+  if (Directory != NULL) {
+    FreePool (CachePath);
+  } else {
+    Directory = InternalPathCacheListDirectory (Volume, Root, CachePath, Path);
+  }
+
+  FreePool (Path);
+
+  if (Directory == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (!Directory->Exists) {
+    return EFI_NOT_FOUND;
+  }
+
+  CaseMismatch = FALSE;
+  for (Index = 0; Index < Directory->NumEntries; ++Index) {
+    if (StrCmp (Directory->Entries[Index].Name, Name) == 0) {
+      *Attribute = Directory->Entries[Index].Attribute;
+      return EFI_SUCCESS;
+    }
+
+    if (OcStriCmp (Directory->Entries[Index].Name, Name) == 0) {
+      CaseMismatch = TRUE;
+    }
+  }
+
+  //
+  // Whether names differing in case match depends on the file system.
+  //
+  if (CaseMismatch || !Directory->Complete) {
+    return EFI_UNSUPPORTED;
+  }
+
+  return EFI_NOT_FOUND;
+}
@@ -19,6 +19,7 @@
 #include <Library/OcAppleChunklistLib.h>
 #include <Library/OcAppleRamDiskLib.h>
 #include <Library/OcCryptoLib.h>
+#include <Library/OcParallelLib.h>
 
 BOOLEAN
 OcAppleChunklistInitializeContext (
@@ -129,21 +130,77 @@ OcAppleChunklistVerifySignature (
   return Result;
 }
 
+/**
+  Upper bound for chunk buffer memory used by parallel verification.
+**/
+#define CHUNKLIST_VERIFY_BUFFER_BUDGET  SIZE_64MB
+
+///
+/// Parallel chunk verification state.
+///
+typedef struct {
+  CONST APPLE_RAM_DISK_EXTENT_TABLE    *ExtentTable;
+  CONST APPLE_CHUNKLIST_CHUNK          *Chunks;
+  UINTN                                *Offsets;
+  UINT8                                *Buffers;
+  UINT32                               BufferSize;
+  volatile BOOLEAN                     Failed;
+} CHUNKLIST_VERIFY_JOB;
+
+/**
+  Verify a single chunk. Runs on any processor.
+
+  @param[in,out]  Context   Chunk verification state.
+  @param[in]      Index     Chunk index.
+  @param[in]      Worker    Worker index selecting the chunk buffer.
+**/
+STATIC
+VOID
+EFIAPI
+ChunklistVerifyChunk (
+  IN OUT VOID   *Context,
+  IN     UINTN  Index,
+  IN     UINTN  Worker
+  )
+{
+  CHUNKLIST_VERIFY_JOB         *Job;
+  CONST APPLE_CHUNKLIST_CHUNK  *CurrentChunk;
+  UINT8                        *ChunkData;
+  UINT8                        ChunkHash[SHA256_DIGEST_SIZE];
+
+  Job = Context;
+  if (Job->Failed) {
+    return;
+  }
+
+  CurrentChunk = &Job->Chunks[Index];
+  ChunkData    = &Job->Buffers[Worker * Job->BufferSize];
+
+  if (!OcAppleRamDiskRead (Job->ExtentTable, Job->Offsets[Index], CurrentChunk->Length, ChunkData)) {
+    Job->Failed = TRUE;
+    return;
+  }
+
+  //
+  // Calculate checksum of data and ensure they match.
+  //
+  Sha256 (ChunkHash, ChunkData, CurrentChunk->Length);
+  if (CompareMem (ChunkHash, CurrentChunk->Checksum, SHA256_DIGEST_SIZE) != 0) {
+    Job->Failed = TRUE;
+  }
+}
+
 BOOLEAN
 OcAppleChunklistVerifyData (
   IN OUT OC_APPLE_CHUNKLIST_CONTEXT         *Context,
   IN     CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable
   )
 {
-  BOOLEAN  Result;
-
-  UINTN                        Index;
-  UINT8                        ChunkHash[SHA256_DIGEST_SIZE];
-  CONST APPLE_CHUNKLIST_CHUNK  *CurrentChunk;
-  UINTN                        CurrentOffset;
-
-  UINT32  ChunkDataSize;
-  VOID    *ChunkData;
+  CHUNKLIST_VERIFY_JOB  Job;
+  UINTN                 Index;
+  UINTN                 CurrentOffset;
+  UINT32                ChunkDataSize;
+  UINTN                 NumWorkers;
 
   ASSERT (Context != NULL);
   ASSERT (Context->Chunks != NULL);
@@ -153,52 +210,55 @@ OcAppleChunklistVerifyData (
     ASSERT (Context->Signature == NULL);
     );
 
-  ChunkDataSize = 0;
-  for (Index = 0; Index < Context->ChunkCount; ++Index) {
-    CurrentChunk = &Context->Chunks[Index];
-    if (ChunkDataSize < CurrentChunk->Length) {
-      ChunkDataSize = CurrentChunk->Length;
-    }
+  if (Context->ChunkCount == 0) {
+    return TRUE;
   }
 
-  ChunkData = AllocatePool (ChunkDataSize);
-  if (ChunkData == NULL) {
+  Job.Offsets = AllocatePool (Context->ChunkCount * sizeof (*Job.Offsets));
+  if (Job.Offsets == NULL) {
     return FALSE;
   }
 
+  ChunkDataSize = 0;
   CurrentOffset = 0;
-  for (Index = 0; Index < Context->ChunkCount; Index++) {
-    CurrentChunk = &Context->Chunks[Index];
-
-    Result = OcAppleRamDiskRead (
-               ExtentTable,
-               CurrentOffset,
-               CurrentChunk->Length,
-               ChunkData
-               );
-    if (!Result) {
-      FreePool (ChunkData);
-      return FALSE;
+  for (Index = 0; Index < Context->ChunkCount; ++Index) {
+    Job.Offsets[Index] = CurrentOffset;
+    CurrentOffset     += Context->Chunks[Index].Length;
+    if (ChunkDataSize < Context->Chunks[Index].Length) {
+      ChunkDataSize = Context->Chunks[Index].Length;
     }
+  }
 
-    //
-    // Calculate checksum of data and ensure they match.
-    //
-    DEBUG ((
-      DEBUG_VERBOSE,
-      "OCCL: Validating chunk %lu of %lu\n",
-      (UINT64)Index + 1,
-      (UINT64)Context->ChunkCount
-      ));
-    Sha256 (ChunkHash, ChunkData, CurrentChunk->Length);
-    if (CompareMem (ChunkHash, CurrentChunk->Checksum, SHA256_DIGEST_SIZE) != 0) {
-      FreePool (ChunkData);
-      return FALSE;
-    }
+  ChunkDataSize = MAX (ChunkDataSize, 1);
 
-    CurrentOffset += CurrentChunk->Length;
+  //
+  // Every worker needs its own chunk buffer, keep their total size bounded.
+  //
+  NumWorkers = MIN (OcParallelGetWorkerCount (), Context->ChunkCount);
+  NumWorkers = MIN (NumWorkers, CHUNKLIST_VERIFY_BUFFER_BUDGET / ChunkDataSize);
+  NumWorkers = MAX (NumWorkers, 1);
+
+  Job.Buffers = AllocatePool (NumWorkers * ChunkDataSize);
+  if (Job.Buffers == NULL) {
+    FreePool (Job.Offsets);
+    return FALSE;
   }
 
-  FreePool (ChunkData);
-  return TRUE;
+  Job.ExtentTable = ExtentTable;
+  Job.Chunks      = Context->Chunks;
+  Job.BufferSize  = ChunkDataSize;
+  Job.Failed      = FALSE;
+
+  DEBUG ((
+    DEBUG_VERBOSE,
+    "OCCL: Validating %lu chunks with %u workers\n",
+    (UINT64)Context->ChunkCount,
+    (UINT32)NumWorkers
+    ));
+
+  OcParallelFor (ChunklistVerifyChunk, &Job, Context->ChunkCount, NumWorkers);
+
+  FreePool (Job.Buffers);
+  FreePool (Job.Offsets);
+  return !Job.Failed;
 }
@@ -23,6 +23,7 @@
 #include <Library/OcAppleDiskImageLib.h>
 #include <Library/OcCompressionLib.h>
 #include <Library/OcFileLib.h>
+#include <Library/OcParallelLib.h>
 
 #include "OcAppleDiskImageLibInternal.h"
 
@@ -177,17 +178,16 @@ OcAppleDiskImageInitializeContext (
              &DmgBlockCount,
              &DmgBlocks
              );
-
-  FreePool (PlistData);
-
   if (!Result) {
     DEBUG ((DEBUG_INFO, "OCDI: DMG plist parse error: %Lu %Lu\n", XmlOffset, XmlLength));
+    FreePool (PlistData);
     return FALSE;
   }
 
   Context->ExtentTable = ExtentTable;
   Context->BlockCount  = DmgBlockCount;
   Context->Blocks      = DmgBlocks;
+  Context->PlistData   = PlistData;
   Context->SectorCount = (UINTN)SectorCount;
 
   return TRUE;
@@ -259,15 +259,10 @@ OcAppleDiskImageFreeContext (
   IN OC_APPLE_DISK_IMAGE_CONTEXT  *Context
   )
 {
-  UINT32  Index;
-
   ASSERT (Context != NULL);
 
-  for (Index = 0; Index < Context->BlockCount; ++Index) {
-    FreePool (Context->Blocks[Index]);
-  }
-
   FreePool (Context->Blocks);
+  FreePool (Context->PlistData);
 }
 
 VOID
@@ -279,6 +274,141 @@ OcAppleDiskImageFreeFile (
   OcAppleDiskImageFreeContext (Context);
 }
 
+/**
+  Maximum number of whole ZLIB chunks decompressed in one parallel batch.
+**/
+#define DISK_IMAGE_ZLIB_BATCH_SIZE  32U
+
+/**
+  Upper bound for per-worker scratch memory used by parallel decompression.
+**/
+#define DISK_IMAGE_ZLIB_SCRATCH_BUDGET  SIZE_32MB
+
+///
+/// Whole ZLIB chunk to be decompressed directly into the output buffer.
+///
+typedef struct {
+  CONST APPLE_DISK_IMAGE_CHUNK    *Chunk;
+  UINT8                           *Buffer;
+  UINTN                           BufferSize;
+} DISK_IMAGE_ZLIB_ITEM;
+
+///
+/// Parallel ZLIB chunk decompression state.
+///
+typedef struct {
+  CONST APPLE_RAM_DISK_EXTENT_TABLE    *ExtentTable;
+  DISK_IMAGE_ZLIB_ITEM                 Items[DISK_IMAGE_ZLIB_BATCH_SIZE];
+  UINT32                               ItemCount;
+  UINT8                                *Scratch;
+  UINTN                                ScratchSize;
+  volatile BOOLEAN                     Failed;
+} DISK_IMAGE_ZLIB_BATCH;
+
+/**
+  Decompress a single ZLIB chunk. Runs on any processor.
+
+  @param[in,out]  Context   ZLIB batch state.
+  @param[in]      Index     Batch item index.
+  @param[in]      Worker    Worker index selecting the scratch buffer.
+**/
+STATIC
+VOID
+EFIAPI
+InternalDecompressZlibItem (
+  IN OUT VOID   *Context,
+  IN     UINTN  Index,
+  IN     UINTN  Worker
+  )
+{
+  DISK_IMAGE_ZLIB_BATCH       *Batch;
+  CONST DISK_IMAGE_ZLIB_ITEM  *Item;
+  UINT8                       *Scratch;
+  UINT8                       *ChunkDataCompressed;
+  BOOLEAN                     Result;
+  UINTN                       OutSize;
+
+  Batch = Context;
+  if (Batch->Failed) {
+    return;
+  }
+
+  Item                = &Batch->Items[Index];
+  Scratch             = &Batch->Scratch[Worker * Batch->ScratchSize];
+  ChunkDataCompressed = Scratch + OC_ZLIB_SCRATCH_SIZE;
+
+  Result = OcAppleRamDiskRead (
+             Batch->ExtentTable,
+             (UINTN)Item->Chunk->CompressedOffset,
+             (UINTN)Item->Chunk->CompressedLength,
+             ChunkDataCompressed
+             );
+  if (!Result) {
+    Batch->Failed = TRUE;
+    return;
+  }
+
+  OutSize = DecompressZLIBScratch (
+              Item->Buffer,
+              Item->BufferSize,
+              ChunkDataCompressed,
+              (UINTN)Item->Chunk->CompressedLength,
+              Scratch
+              );
+  if (OutSize != Item->BufferSize) {
+    Batch->Failed = TRUE;
+  }
+}
+
+/**
+  Decompress all pending ZLIB chunks in parallel and reset the batch.
+
+  @param[in,out]  Batch     ZLIB batch state.
+
+  @retval TRUE when all chunks were decompressed.
+**/
+STATIC
+BOOLEAN
+InternalFlushZlibBatch (
+  IN OUT DISK_IMAGE_ZLIB_BATCH  *Batch
+  )
+{
+  UINT32  Index;
+  UINT64  MaxCompressedLength;
+  UINTN   NumWorkers;
+
+  if (Batch->ItemCount == 0) {
+    return TRUE;
+  }
+
+  MaxCompressedLength = 0;
+  for (Index = 0; Index < Batch->ItemCount; ++Index) {
+    MaxCompressedLength = MAX (MaxCompressedLength, Batch->Items[Index].Chunk->CompressedLength);
+  }
+
+  //
+  // Every worker needs its own scratch and compressed data buffer,
+  // keep their total size bounded.
+  //
+  Batch->ScratchSize = OC_ZLIB_SCRATCH_SIZE + ALIGN_VALUE ((UINTN)MaxCompressedLength, sizeof (UINT64));
+  NumWorkers         = MIN (OcParallelGetWorkerCount (), Batch->ItemCount);
+  NumWorkers         = MIN (NumWorkers, DISK_IMAGE_ZLIB_SCRATCH_BUDGET / Batch->ScratchSize);
+  NumWorkers         = MAX (NumWorkers, 1);
+
+  Batch->Scratch = AllocatePool (NumWorkers * Batch->ScratchSize);
+  if (Batch->Scratch == NULL) {
+    return FALSE;
+  }
+
+  OcParallelFor (InternalDecompressZlibItem, Batch, Batch->ItemCount, NumWorkers);
+
+  FreePool (Batch->Scratch);
+  Batch->Scratch   = NULL;
+  Batch->ItemCount = 0;
+
+  return !Batch->Failed;
+}
+
 BOOLEAN
 OcAppleDiskImageRead (
   IN  OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
@@ -306,6 +436,8 @@ OcAppleDiskImageRead (
 
   UINTN  OutSize;
 
+  DISK_IMAGE_ZLIB_BATCH  Batch;
+
   ASSERT (Context != NULL);
   ASSERT (Buffer != NULL);
   ASSERT (Lba < Context->SectorCount);
@@ -314,6 +446,11 @@ OcAppleDiskImageRead (
   RemainingBufferSize = BufferSize;
   BufferCurrent       = Buffer;
 
+  Batch.ExtentTable = Context->ExtentTable;
+  Batch.ItemCount   = 0;
+  Batch.Scratch     = NULL;
+  Batch.Failed      = FALSE;
+
   while (RemainingBufferSize > 0) {
     Result = InternalGetBlockChunk (Context, LbaCurrent, &BlockData, &Chunk);
     if (!Result) {
@@ -370,6 +507,25 @@ OcAppleDiskImageRead (
 
       case APPLE_DISK_IMAGE_CHUNK_TYPE_ZLIB:
       {
+        //
+        // Whole chunks decompress directly into the output buffer,
+        // and are deferred to be processed in parallel.
+        //
+        if ((ChunkOffset == 0) && (BufferChunkSize == ChunkTotalLength)) {
+          Batch.Items[Batch.ItemCount].Chunk      = Chunk;
+          Batch.Items[Batch.ItemCount].Buffer     = BufferCurrent;
+          Batch.Items[Batch.ItemCount].BufferSize = BufferChunkSize;
+          ++Batch.ItemCount;
+
+          if (  (Batch.ItemCount == DISK_IMAGE_ZLIB_BATCH_SIZE)
+             && !InternalFlushZlibBatch (&Batch))
+          {
+            return FALSE;
+          }
+
+          break;
+        }
+
         ChunkData = AllocatePool ((UINTN)(ChunkTotalLength + Chunk->CompressedLength));
         if (ChunkData == NULL) {
           return FALSE;
@@ -419,5 +575,5 @@ OcAppleDiskImageRead (
     LbaCurrent          += LbaLength;
   }
 
-  return TRUE;
+  return InternalFlushZlibBatch (&Batch);
 }
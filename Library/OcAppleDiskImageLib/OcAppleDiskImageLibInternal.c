@@ -265,30 +265,21 @@ InternalParsePlist (
       goto DONE_ERROR;
     }
 
-    Result = PlistDataSize (BlockDictChildValue, &BlockDictChildDataSize);
+    //
+    // Blocks are decoded in place and keep pointing into the plist buffer.
+    //
+    Result = PlistDataValueInPlace (
+               BlockDictChildValue,
+               (UINT8 **)&Block,
+               &BlockDictChildDataSize
+               );
     if (!Result || (BlockDictChildDataSize < sizeof (*Block))) {
       Result = FALSE;
       goto DONE_ERROR;
     }
 
-    Block = AllocatePool (BlockDictChildDataSize);
-    if (Block == NULL) {
-      Result = FALSE;
-      goto DONE_ERROR;
-    }
-
     DmgBlocks[Index] = Block;
 
-    Result = PlistDataValue (
-               BlockDictChildValue,
-               (UINT8 *)Block,
-               &BlockDictChildDataSize
-               );
-    if (!Result) {
-      FreePool (Block);
-      goto DONE_ERROR;
-    }
-
     Result = InternalSwapBlockData (
                Block,
                BlockDictChildDataSize,
@@ -297,7 +288,6 @@ InternalParsePlist (
                DataForkSize
                );
     if (!Result) {
-      FreePool (Block);
       goto DONE_ERROR;
     }
   }
@@ -308,10 +298,6 @@ InternalParsePlist (
 
 DONE_ERROR:
   if (!Result && (DmgBlocks != NULL)) {
-    while ((Index--) != 0) {
-      FreePool (DmgBlocks[Index]);
-    }
-
     FreePool (DmgBlocks);
   }
 
@@ -26,6 +26,10 @@
 #define DMG_PLIST_ID                 "ID"
 #define DMG_PLIST_NAME               "Name"
 
+/**
+  Parse DMG plist, decoding blkx data in place. The returned blocks point
+  into Plist, which must outlive them.
+**/
 BOOLEAN
 InternalParsePlist (
   IN  CHAR8                        *Plist,
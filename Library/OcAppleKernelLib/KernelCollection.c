@@ -25,6 +25,7 @@
 #include <Library/OcAppleKernelLib.h>
 #include <Library/OcCompressionLib.h>
 #include <Library/OcFileLib.h>
+#include <Library/OcParallelLib.h>
 
 #include "PrelinkedInternal.h"
 
@@ -416,13 +417,42 @@ KcInitKextFixupChains (
   return EFI_SUCCESS;
 }
 
+///
+/// Position of the last fixup inserted into the KEXTs segment chains.
+/// Relocations are usually sorted, so continuing from here avoids walking
+/// the page chain from its start for every relocation.
+///
+typedef struct {
+  UINT32    Page;
+  UINT16    PageOffset;
+} KC_FIXUP_CURSOR;
+
+///
+/// Relocations of one KEXT to be converted to fixups, grouped by page.
+///
+typedef struct {
+  PRELINKED_CONTEXT             *Context;
+  CONST MACH_RELOCATION_INFO    *Relocations;
+  UINT64                        RelocBase;
+  UINT32                        FirstPage;
+  UINT32                        NumPages;
+  UINT32                        PagesPerItem;
+  ///
+  /// Index of the first relocation of each KEXT page in PageRelocations,
+  /// followed by the total number of relocations.
+  ///
+  UINT32                        *PageStarts;
+  ///
+  /// Relocation indices sorted by page.
+  ///
+  UINT32                        *PageRelocations;
+} KC_FIXUP_JOB;
+
 /*
-  Indexes RelocInfo into the fixup chains SegChain of Segment.
+  Indexes RelocInfo into the KEXTs segment fixup chains.
 
   @param[in,out] Context      Prelinked context.
-  @param[in]     MachContext  The context of the Mach-O RelocInfo belongs to. It
-                              must have been prelinked by OcAppleKernelLib. The
-                              image must reside in Segment.
+  @param[in,out] Cursor       Last fixup inserted by the caller.
   @param[in]     RelocInfo    The relocation to add a fixup of.
   @param[in]     RelocBase    The relocation base address.
 */
@@ -430,7 +460,7 @@ STATIC
 VOID
 InternalKcConvertRelocToFixup (
   IN OUT PRELINKED_CONTEXT           *Context,
-  IN     OC_MACHO_CONTEXT            *MachContext,
+  IN OUT KC_FIXUP_CURSOR             *Cursor,
   IN     CONST MACH_RELOCATION_INFO  *RelocInfo,
   IN     UINT64                      RelocBase
   )
@@ -454,7 +484,7 @@ InternalKcConvertRelocToFixup (
   UINT16  FixupDelta;
 
   ASSERT (Context != NULL);
-  ASSERT (MachContext != NULL);
+  ASSERT (Cursor != NULL);
   ASSERT (RelocInfo != NULL);
 
   ASSERT (Context->KextsFixupChains != NULL);
@@ -511,10 +541,20 @@ InternalKcConvertRelocToFixup (
     Context->KextsFixupChains->PageStart[NewFixupPage] = NewFixupPageOffset;
   } else {
     SegmentPageData = SegmentData + NewFixupPage * MACHO_PAGE_SIZE;
+    //
+    // Fixups are only ever inserted, so the previous one is still chained.
+    // When it preceeds RelocInfo on the same page, resume the walk from there,
+    // which makes ascending relocations take constant time.
+    //
+    if (  (Cursor->Page == NewFixupPage)
+       && (Cursor->PageOffset > IterFixupPageOffset)
+       && (Cursor->PageOffset < NewFixupPageOffset))
+    {
+      IterFixupPageOffset = Cursor->PageOffset;
+    }
+
     //
     // Find the last fixup of this page that preceeds RelocInfo.
-    // FIXME: Consider sorting the relocations in descending order first to
-    //        then always prepend the new fixup.
     //
     NextIterFixupPageOffset = IterFixupPageOffset;
     do {
@@ -545,6 +585,71 @@ InternalKcConvertRelocToFixup (
   }
 
   CopyMem (RelocDest, &NewFixup, sizeof (NewFixup));
+
+  Cursor->Page       = NewFixupPage;
+  Cursor->PageOffset = NewFixupPageOffset;
+}
+
+/**
+  Get KEXT page of a relocation.
+
+  @param[in] Job         Fixup job.
+  @param[in] RelocIndex  Relocation index.
+
+  @retval Page index relative to the first KEXT page, NumPages or above
+          when the relocation is outside of the KEXT.
+**/
+STATIC
+UINT64
+InternalKcGetRelocPage (
+  IN CONST KC_FIXUP_JOB  *Job,
+  IN UINT32              RelocIndex
+  )
+{
+  return (Job->RelocBase - Job->Context->KextsVmAddress
+          + (UINT32)Job->Relocations[RelocIndex].Address) / MACHO_PAGE_SIZE - Job->FirstPage;
+}
+
+/**
+  Converts the relocations of one KEXT page range to fixups.
+  Fixup chains never cross pages, so disjoint ranges may be indexed
+  concurrently.
+
+  @param[in,out] Buffer   Fixup job.
+  @param[in]     Index    Page range index.
+  @param[in]     Worker   Worker index, unused.
+**/
+STATIC
+VOID
+EFIAPI
+InternalKcIndexFixupRange (
+  IN OUT VOID   *Buffer,
+  IN     UINTN  Index,
+  IN     UINTN  Worker
+  )
+{
+  KC_FIXUP_JOB     *Job;
+  KC_FIXUP_CURSOR  Cursor;
+  UINT32           StartPage;
+  UINT32           EndPage;
+  UINT32           Slot;
+
+  Job = Buffer;
+
+  StartPage = (UINT32)Index * Job->PagesPerItem;
+  EndPage   = MIN (StartPage + Job->PagesPerItem, Job->NumPages);
+
+  Cursor.Page       = MAX_UINT32;
+  Cursor.PageOffset = 0;
+
+  for (Slot = Job->PageStarts[StartPage]; Slot < Job->PageStarts[EndPage]; ++Slot) {
+    InternalKcConvertRelocToFixup (
+      Job->Context,
+      &Cursor,
+      &Job->Relocations[Job->PageRelocations[Slot]],
+      Job->RelocBase
+      );
+  }
 }
 
 /*
@@ -554,89 +659,120 @@ InternalKcConvertRelocToFixup (
   @param[in]     MachContext  The context of the Mach-O to index. It must have
                               been prelinked by OcAppleKernelLib. The image
                               must reside in Segment.
+  @param[in]     DySymtab     DYSYMTAB command of MachContext.
+  @param[in]     RelocBase    The relocation base address.
+
+  @retval EFI_SUCCESS           All relocations were indexed.
+  @retval EFI_UNSUPPORTED       A relocation is outside of MachContext.
+  @retval EFI_OUT_OF_RESOURCES  Memory allocation failure.
 */
-VOID
-KcKextIndexFixups (
-  IN OUT PRELINKED_CONTEXT  *Context,
-  IN     OC_MACHO_CONTEXT   *MachContext
+STATIC
+EFI_STATUS
+InternalKcKextIndexFixups (
+  IN OUT PRELINKED_CONTEXT            *Context,
+  IN     OC_MACHO_CONTEXT             *MachContext,
+  IN     CONST MACH_DYSYMTAB_COMMAND  *DySymtab,
+  IN     UINT64                       RelocBase
   )
 {
-  CONST MACH_DYSYMTAB_COMMAND    *DySymtab;
-  CONST MACH_SEGMENT_COMMAND_64  *FirstSegment;
-  MACH_HEADER_64                 *MachHeader;
-  CONST MACH_RELOCATION_INFO     *Relocations;
-  VOID                           *FileData;
-  UINT32                         RelocIndex;
-
-  ASSERT (Context != NULL);
-  ASSERT (MachContext != NULL);
-
-  MachHeader = MachoGetMachHeader64 (MachContext);
-
-  //
-  // Kexts with fixups are now dylibs in cache.
-  // This is required for OSKext_protect to work properly
-  // as the kernel map that operates on vm_map no longer has kext addresses.
-  //
-  MachHeader->Flags |= MACH_HEADER_FLAG_DYLIB_IN_CACHE;
-
-  //
-  // FIXME: The current OcMachoLib was not written with post-linking
-  // re-initialisation in mind. We really don't want to sanitise everything
-  // again, so avoid the dedicated API for now.
-  //
-  DySymtab = (MACH_DYSYMTAB_COMMAND *)MachoGetNextCommand (
-                                        MachContext,
-                                        MACH_LOAD_COMMAND_DYSYMTAB,
-                                        NULL
-                                        );
-  //
-  // If DYSYMTAB does not exist, the KEXT must have already not been flagged for
-  // DYLD linkage as otherwise prelinking would have failed.
-  //
-  if (DySymtab == NULL) {
-    return;
-  }
+  KC_FIXUP_JOB  Job;
+  UINT32        NumWorkers;
+  UINT32        RelocIndex;
+  UINT64        RelocPage;
+  UINT32        Page;
 
-  FirstSegment = MachoGetNextSegment64 (MachContext, NULL);
-  //
-  // DYSYMTAB and at least one segment must exist, otherwise prelinking would
-  // have failed.
-  //
-  ASSERT (DySymtab != NULL);
-  ASSERT (FirstSegment != NULL);
   //
   // The Mach-O file to index must be included in Segment.
   //
-  ASSERT (FirstSegment->VirtualAddress >= Context->KextsVmAddress);
+  ASSERT (RelocBase >= Context->KextsVmAddress);
   ASSERT (MachoGetLastAddress (MachContext) <= Context->PrelinkedLastAddress);
   //
   // Prelinking must have eliminated all external relocations.
   //
   ASSERT (DySymtab->NumExternalRelocations == 0);
-  //
-  // Convert all relocations to fixups.
-  //
-  FileData    = MachoGetFileData (MachContext);
-  Relocations = (MACH_RELOCATION_INFO *)(
-                                         (UINTN)FileData + DySymtab->LocalRelocationsOffset
-                                         );
 
   DEBUG ((
     DEBUG_INFO,
     "OCAK: Local relocs %u on %LX\n",
     DySymtab->NumOfLocalRelocations,
-    FirstSegment->VirtualAddress
+    RelocBase
     ));
 
+  if (DySymtab->NumOfLocalRelocations == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Job.Context     = Context;
+  Job.Relocations = (CONST MACH_RELOCATION_INFO *)(
+                                                   (UINTN)MachoGetFileData (MachContext) + DySymtab->LocalRelocationsOffset
+                                                   );
+  Job.RelocBase = RelocBase;
+  Job.FirstPage = (UINT32)((RelocBase - Context->KextsVmAddress) / MACHO_PAGE_SIZE);
+  Job.NumPages  = (UINT32)(
+                           (MachoGetLastAddress (MachContext) - Context->KextsVmAddress
+                            + MACHO_PAGE_SIZE - 1) / MACHO_PAGE_SIZE
+                           ) - Job.FirstPage;
+
+  //
+  // Group relocations by page with a counting sort, so that each page range
+  // only visits its own relocations. Counts are stored two entries ahead,
+  // so that after summing PageStarts[Page + 1] is the next slot of Page,
+  // and after filling it is the first slot of the next page.
+  //
+  Job.PageStarts      = AllocateZeroPool ((Job.NumPages + 2) * sizeof (Job.PageStarts[0]));
+  Job.PageRelocations = AllocatePool (DySymtab->NumOfLocalRelocations * sizeof (Job.PageRelocations[0]));
+  if ((Job.PageStarts == NULL) || (Job.PageRelocations == NULL)) {
+    if (Job.PageStarts != NULL) {
+      FreePool (Job.PageStarts);
+    }
+
+    if (Job.PageRelocations != NULL) {
+      FreePool (Job.PageRelocations);
+    }
+
+    return EFI_OUT_OF_RESOURCES;
+  }
+
   for (RelocIndex = 0; RelocIndex < DySymtab->NumOfLocalRelocations; ++RelocIndex) {
-    InternalKcConvertRelocToFixup (
-      Context,
-      MachContext,
-      &Relocations[RelocIndex],
-      FirstSegment->VirtualAddress
-      );
+    RelocPage = InternalKcGetRelocPage (&Job, RelocIndex);
+    if (RelocPage >= Job.NumPages) {
+      DEBUG ((
+        DEBUG_WARN,
+        "OCAK: Local reloc %u at %X is outside of %u pages\n",
+        RelocIndex,
+        Job.Relocations[RelocIndex].Address,
+        Job.NumPages
+        ));
+      FreePool (Job.PageStarts);
+      FreePool (Job.PageRelocations);
+      return EFI_UNSUPPORTED;
+    }
+
+    ++Job.PageStarts[RelocPage + 2];
+  }
+
+  for (Page = 2; Page < Job.NumPages + 2; ++Page) {
+    Job.PageStarts[Page] += Job.PageStarts[Page - 1];
+  }
+
+  for (RelocIndex = 0; RelocIndex < DySymtab->NumOfLocalRelocations; ++RelocIndex) {
+    Page                                          = (UINT32)InternalKcGetRelocPage (&Job, RelocIndex);
+    Job.PageRelocations[Job.PageStarts[Page + 1]] = RelocIndex;
+    ++Job.PageStarts[Page + 1];
   }
+
+  NumWorkers       = (UINT32)MIN (OcParallelGetWorkerCount (), Job.NumPages);
+  Job.PagesPerItem = (Job.NumPages + NumWorkers - 1) / NumWorkers;
+  OcParallelFor (
+    InternalKcIndexFixupRange,
+    &Job,
+    (Job.NumPages + Job.PagesPerItem - 1) / Job.PagesPerItem,
+    NumWorkers
+    );
+
+  FreePool (Job.PageStarts);
+  FreePool (Job.PageRelocations);
+  return EFI_SUCCESS;
 }
 
 UINT32
@@ -681,8 +817,8 @@ KcGetKextSize (
 }
 
 EFI_STATUS
-KcKextApplyFileDelta (
-  IN     PRELINKED_CONTEXT  *PrelinkedContext,
+KcKextIndexFixupsAndApplyFileDelta (
+  IN OUT PRELINKED_CONTEXT  *PrelinkedContext,
   IN OUT OC_MACHO_CONTEXT   *Context,
   IN     UINT32             Delta
   )
@@ -691,9 +827,11 @@ KcKextApplyFileDelta (
   MACH_LOAD_COMMAND        *Command;
   UINTN                    TopOfCommands;
   MACH_SEGMENT_COMMAND_64  *Segment;
+  MACH_SEGMENT_COMMAND_64  *FirstSegment;
   MACH_SYMTAB_COMMAND      *Symtab;
   MACH_DYSYMTAB_COMMAND    *DySymtab;
   UINT32                   SectIndex;
+  EFI_STATUS               Status;
 
   ASSERT (PrelinkedContext != NULL);
   ASSERT (Context != NULL);
@@ -702,9 +840,22 @@ KcKextApplyFileDelta (
   KextHeader = MachoGetMachHeader64 (Context);
   ASSERT (KextHeader != NULL);
 
+  //
+  // Kexts with fixups are now dylibs in cache.
+  // This is required for OSKext_protect to work properly
+  // as the kernel map that operates on vm_map no longer has kext addresses.
+  //
+  KextHeader->Flags |= MACH_HEADER_FLAG_DYLIB_IN_CACHE;
+
+  //
+  // FIXME: The current OcMachoLib was not written with post-linking
+  // re-initialisation in mind. We really don't want to sanitise everything
+  // again, so avoid the dedicated API for now.
+  //
+  FirstSegment  = NULL;
   TopOfCommands = ((UINTN)KextHeader->Commands + KextHeader->CommandsSize);
   //
-  // Iterate over all Load Commands to rebase them based on type.
+  // Iterate over all Load Commands to index and rebase them based on type.
   //
   for (
        Command = KextHeader->Commands;
@@ -719,6 +870,10 @@ KcKextApplyFileDelta (
         }
 
         Segment = (MACH_SEGMENT_COMMAND_64 *)(VOID *)Command;
+        if (FirstSegment == NULL) {
+          FirstSegment = Segment;
+        }
+
         //
         // Rebase the segment's sections.
         //
@@ -762,6 +917,29 @@ KcKextApplyFileDelta (
         }
 
         DySymtab = (MACH_DYSYMTAB_COMMAND *)(VOID *)Command;
+        //
+        // Segments normally preceed DYSYMTAB, look ahead otherwise.
+        // At least one segment must exist, otherwise prelinking would have
+        // failed.
+        //
+        if (FirstSegment == NULL) {
+          FirstSegment = MachoGetNextSegment64 (Context, NULL);
+          ASSERT (FirstSegment != NULL);
+        }
+
+        //
+        // Convert all relocations to fixups while they are still reachable.
+        //
+        Status = InternalKcKextIndexFixups (
+                   PrelinkedContext,
+                   Context,
+                   DySymtab,
+                   FirstSegment->VirtualAddress
+                   );
+        if (EFI_ERROR (Status)) {
+          return Status;
+        }
+
         //
         // Rebase DYSYMTAB fields that make sense in a prelinked context.
         //
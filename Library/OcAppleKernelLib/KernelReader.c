@@ -25,6 +25,7 @@
 #include <Library/OcCompressionLib.h>
 #include <Library/OcCryptoLib.h>
 #include <Library/OcFileLib.h>
+#include <Library/OcTraceLib.h>
 
 //
 // Pick a reasonable maximum to fit.
@@ -207,6 +208,7 @@ ParseCompressedHeader (
   UINT32            CompressedSize;
   UINT32            DecompressedSize;
   UINT32            DecompressedHash;
+  OC_TRACE_ID       TraceId;
 
   CompHeader       = (MACH_COMP_HEADER *)*Buffer;
   CompressionType  = CompHeader->Compression;
@@ -244,12 +246,15 @@ ParseCompressedHeader (
     return KernelSize;
   }
 
+  TraceId = OcTraceBegin ("KernelDecompress");
   if (CompressionType == MACH_COMPRESSED_BINARY_INVERT_LZVN) {
     KernelSize = (UINT32)DecompressLZVN (*Buffer, DecompressedSize, CompressedBuffer, CompressedSize);
   } else if (CompressionType == MACH_COMPRESSED_BINARY_INVERT_LZSS) {
     KernelSize = (UINT32)DecompressLZSS (*Buffer, DecompressedSize, CompressedBuffer, CompressedSize);
   }
 
+  OcTraceEnd (TraceId);
+
   if (KernelSize != DecompressedSize) {
     KernelSize = 0;
   }
@@ -1179,8 +1179,11 @@ PrelinkedInjectKext (
       // Note, we are no longer using ExecutableContext here, as the context
       // ownership was transferred by InternalLinkPrelinkedKext.
       //
-      KcKextIndexFixups (Context, &PrelinkedKext->Context.MachContext);
-      Status = KcKextApplyFileDelta (Context, &PrelinkedKext->Context.MachContext, KextOffset);
+      Status = KcKextIndexFixupsAndApplyFileDelta (
+                 Context,
+                 &PrelinkedKext->Context.MachContext,
+                 KextOffset
+                 );
       if (EFI_ERROR (Status)) {
         DEBUG ((
           DEBUG_WARN,
@@ -0,0 +1,403 @@
+/** @file
+  Per-filesystem scan result cache reused across picker rescans.
+
+  Copyright (C) 2026, Acidanthera. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include "BootManagementInternal.h"
+
+#include <Protocol/BlockIo.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/DevicePathLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcDevicePathLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+typedef struct {
+  LIST_ENTRY                  Link;
+  //
+  // Cache key.
+  //
+  EFI_HANDLE                  Handle;
+  EFI_DEVICE_PATH_PROTOCOL    *DevicePath;
+  UINT32                      MediaId;
+  //
+  // Scan policy result.
+  //
+  BOOLEAN                     HasPolicy;
+  UINT32                      ScanPolicy;
+  EFI_STATUS                  PolicyStatus;
+  BOOLEAN                     External;
+  //
+  // Bless result.
+  //
+  BOOLEAN                     HasBless;
+  CONST CHAR16                **BlessPaths;
+  UINTN                       NumBlessPaths;
+  CHAR16                      **CustomBlessPaths;
+  UINTN                       NumCustomBlessPaths;
+  EFI_STATUS                  BlessStatus;
+  EFI_DEVICE_PATH_PROTOCOL    *BlessDevicePath;
+} INTERNAL_SCAN_CACHE_ENTRY;
+
+STATIC LIST_ENTRY  mScanCache = INITIALIZE_LIST_HEAD_VARIABLE (mScanCache);
+STATIC EFI_EVENT   mScanCacheNotifyEvent;
+STATIC VOID        *mScanCacheNotifyRegistration;
+STATIC BOOLEAN     mScanCacheStale;
+
+STATIC
+VOID
+ScanCacheResetBless (
+  IN OUT INTERNAL_SCAN_CACHE_ENTRY  *Entry
+  )
+{
+  if (Entry->BlessDevicePath != NULL) {
+    FreePool (Entry->BlessDevicePath);
+    Entry->BlessDevicePath = NULL;
+  }
+
+  Entry->HasBless = FALSE;
+}
+
+STATIC
+VOID
+ScanCacheFreeEntry (
+  IN OUT INTERNAL_SCAN_CACHE_ENTRY  *Entry
+  )
+{
+  RemoveEntryList (&Entry->Link);
+  ScanCacheResetBless (Entry);
+  if (Entry->DevicePath != NULL) {
+    FreePool (Entry->DevicePath);
+  }
+
+  FreePool (Entry);
+}
+
+STATIC
+VOID
+EFIAPI
+ScanCacheNotify (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  //
+  // Filesystems appeared or were reinstalled, e.g. on hotplug or driver connection.
+  // Cached handles are revalidated on next lookup.
+  //
+  mScanCacheStale = TRUE;
+}
+
+STATIC
+VOID
+ScanCacheInit (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+
+  if (mScanCacheNotifyEvent != NULL) {
+    return;
+  }
+
+  Status = gBS->CreateEvent (
+                  EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  ScanCacheNotify,
+                  NULL,
+                  &mScanCacheNotifyEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    mScanCacheNotifyEvent = NULL;
+    return;
+  }
+
+  Status = gBS->RegisterProtocolNotify (
+                  &gEfiSimpleFileSystemProtocolGuid,
+                  mScanCacheNotifyEvent,
+                  &mScanCacheNotifyRegistration
+                  );
+  if (EFI_ERROR (Status)) {
+    gBS->CloseEvent (mScanCacheNotifyEvent);
+    mScanCacheNotifyEvent = NULL;
+  }
+}
+
+STATIC
+VOID
+ScanCacheDropStale (
+  VOID
+  )
+{
+  EFI_STATUS                 Status;
+  LIST_ENTRY                 *Link;
+  LIST_ENTRY                 *NextLink;
+  INTERNAL_SCAN_CACHE_ENTRY  *Entry;
+  VOID                       *Interface;
+
+  if (!mScanCacheStale) {
+    return;
+  }
+
+  mScanCacheStale = FALSE;
+
+  for (Link = GetFirstNode (&mScanCache); !IsNull (&mScanCache, Link); Link = NextLink) {
+    NextLink = GetNextNode (&mScanCache, Link);
+    Entry    = BASE_CR (Link, INTERNAL_SCAN_CACHE_ENTRY, Link);
+
+    Status = gBS->HandleProtocol (
+                    Entry->Handle,
+                    &gEfiSimpleFileSystemProtocolGuid,
+                    &Interface
+                    );
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_INFO, "OCB: Dropping cached fs %p - %r\n", Entry->Handle, Status));
+      ScanCacheFreeEntry (Entry);
+    }
+  }
+}
+
+STATIC
+UINT32
+ScanCacheGetMediaId (
+  IN EFI_HANDLE  Handle
+  )
+{
+  EFI_STATUS             Status;
+  EFI_BLOCK_IO_PROTOCOL  *BlockIo;
+
+  Status = gBS->HandleProtocol (
+                  Handle,
+                  &gEfiBlockIoProtocolGuid,
+                  (VOID **)&BlockIo
+                  );
+  if (EFI_ERROR (Status) || (BlockIo->Media == NULL)) {
+    return 0;
+  }
+
+  return BlockIo->Media->MediaId;
+}
+
+/**
+  Find up-to-date cache entry for filesystem handle, creating it if missing.
+  Entries with changed device path or media are reset.
+
+  @param[in]  Handle   Filesystem handle.
+
+  @retval cache entry or NULL.
+**/
+STATIC
+INTERNAL_SCAN_CACHE_ENTRY *
+ScanCacheLookup (
+  IN EFI_HANDLE  Handle
+  )
+{
+  EFI_STATUS                 Status;
+  LIST_ENTRY                 *Link;
+  INTERNAL_SCAN_CACHE_ENTRY  *Entry;
+  EFI_DEVICE_PATH_PROTOCOL   *DevicePath;
+  UINT32                     MediaId;
+
+  ScanCacheInit ();
+  ScanCacheDropStale ();
+
+  Status = gBS->HandleProtocol (
+                  Handle,
+                  &gEfiDevicePathProtocolGuid,
+                  (VOID **)&DevicePath
+                  );
+  if (EFI_ERROR (Status)) {
+    return NULL;
+  }
+
+  MediaId = ScanCacheGetMediaId (Handle);
+
+  for (
+       Link = GetFirstNode (&mScanCache);
+       !IsNull (&mScanCache, Link);
+       Link = GetNextNode (&mScanCache, Link))
+  {
+    Entry = BASE_CR (Link, INTERNAL_SCAN_CACHE_ENTRY, Link);
+    if (Entry->Handle != Handle) {
+      continue;
+    }
+
+    if ((Entry->MediaId == MediaId) && IsDevicePathEqual (Entry->DevicePath, DevicePath)) {
+      return Entry;
+    }
+
+    //
+    // Handle got reused for a different device or the media changed.
+    //
+    DEBUG ((DEBUG_INFO, "OCB: Invalidating cached fs %p (media %u->%u)\n", Handle, Entry->MediaId, MediaId));
+    ScanCacheFreeEntry (Entry);
+    break;
+  }
+
+  Entry = AllocateZeroPool (sizeof (*Entry));
+  if (Entry == NULL) {
+    return NULL;
+  }
+
+  Entry->DevicePath = DuplicateDevicePath (DevicePath);
+  if (Entry->DevicePath == NULL) {
+    FreePool (Entry);
+    return NULL;
+  }
+
+  Entry->Handle  = Handle;
+  Entry->MediaId = MediaId;
+  InsertTailList (&mScanCache, &Entry->Link);
+
+  return Entry;
+}
+
+EFI_STATUS
+InternalCheckScanPolicyCached (
+  IN  EFI_HANDLE  Handle,
+  IN  UINT32      Policy,
+  OUT BOOLEAN     *External OPTIONAL
+  )
+{
+  INTERNAL_SCAN_CACHE_ENTRY  *Entry;
+  BOOLEAN                    IsExternal;
+
+  Entry = ScanCacheLookup (Handle);
+  if (Entry == NULL) {
+    return InternalCheckScanPolicy (Handle, Policy, External);
+  }
+
+  if (!Entry->HasPolicy || (Entry->ScanPolicy != Policy)) {
+    IsExternal          = FALSE;
+    Entry->PolicyStatus = InternalCheckScanPolicy (Handle, Policy, &IsExternal);
+    Entry->External     = IsExternal;
+    Entry->ScanPolicy   = Policy;
+    Entry->HasPolicy    = TRUE;
+  }
+
+  if (External != NULL) {
+    *External = Entry->External;
+  }
+
+  return Entry->PolicyStatus;
+}
+
+BOOLEAN
+InternalHasCachedScanPolicy (
+  IN EFI_HANDLE  Handle,
+  IN UINT32      Policy
+  )
+{
+  INTERNAL_SCAN_CACHE_ENTRY  *Entry;
+
+  Entry = ScanCacheLookup (Handle);
+  return (Entry != NULL) && Entry->HasPolicy && (Entry->ScanPolicy == Policy);
+}
+
+EFI_STATUS
+InternalGetCachedBlessResult (
+  IN  EFI_HANDLE                Handle,
+  IN  CONST CHAR16              **PredefinedPaths,
+  IN  UINTN                     NumPredefinedPaths,
+  IN  CHAR16                    **CustomPaths,
+  IN  UINTN                     NumCustomPaths,
+  OUT EFI_DEVICE_PATH_PROTOCOL  **DevicePath
+  )
+{
+  INTERNAL_SCAN_CACHE_ENTRY  *Entry;
+
+  *DevicePath = NULL;
+
+  Entry = ScanCacheLookup (Handle);
+  if (  (Entry == NULL)
+     || !Entry->HasBless
+     || (Entry->BlessPaths != PredefinedPaths)
+     || (Entry->NumBlessPaths != NumPredefinedPaths)
+     || (Entry->CustomBlessPaths != CustomPaths)
+     || (Entry->NumCustomBlessPaths != NumCustomPaths))
+  {
+    return EFI_NOT_READY;
+  }
+
+  DEBUG ((DEBUG_INFO, "OCB: Using cached bless for fs %p - %r\n", Handle, Entry->BlessStatus));
+
+  if (EFI_ERROR (Entry->BlessStatus)) {
+    return Entry->BlessStatus;
+  }
+
+  *DevicePath = DuplicateDevicePath (Entry->BlessDevicePath);
+  if (*DevicePath == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  return EFI_SUCCESS;
+}
+
+VOID
+InternalSetCachedBlessResult (
+  IN EFI_HANDLE                Handle,
+  IN CONST CHAR16              **PredefinedPaths,
+  IN UINTN                     NumPredefinedPaths,
+  IN CHAR16                    **CustomPaths,
+  IN UINTN                     NumCustomPaths,
+  IN EFI_STATUS                Status,
+  IN EFI_DEVICE_PATH_PROTOCOL  *DevicePath OPTIONAL
+  )
+{
+  INTERNAL_SCAN_CACHE_ENTRY  *Entry;
+
+  //
+  // Transient errors are not cached, next scan retries them.
+  //
+  if (EFI_ERROR (Status) && (Status != EFI_NOT_FOUND)) {
+    return;
+  }
+
+  Entry = ScanCacheLookup (Handle);
+  if (Entry == NULL) {
+    return;
+  }
+
+  ScanCacheResetBless (Entry);
+
+  if (!EFI_ERROR (Status)) {
+    ASSERT (DevicePath != NULL);
+    Entry->BlessDevicePath = DuplicateDevicePath (DevicePath);
+    if (Entry->BlessDevicePath == NULL) {
+      return;
+    }
+  }
+
+  Entry->BlessPaths          = PredefinedPaths;
+  Entry->NumBlessPaths       = NumPredefinedPaths;
+  Entry->CustomBlessPaths    = CustomPaths;
+  Entry->NumCustomBlessPaths = NumCustomPaths;
+  Entry->BlessStatus         = Status;
+  Entry->HasBless            = TRUE;
+}
+
+VOID
+OcFlushBootEntryScanCache (
+  VOID
+  )
+{
+  while (!IsListEmpty (&mScanCache)) {
+    ScanCacheFreeEntry (BASE_CR (GetFirstNode (&mScanCache), INTERNAL_SCAN_CACHE_ENTRY, Link));
+  }
+
+  mScanCacheStale = FALSE;
+}
@@ -880,61 +880,29 @@ InternalAddBootEntryFromCustomEntry (
 }
 
 /**
-  Create bootable entries from bless policy.
-  This function may create more than one entry, and for APFS
-  it will likely produce a sequence of 'OS, RECOVERY' entry pairs.
+  Look up blessed device path on a filesystem, preferring custom bless paths.
 
-  @param[in,out] BootContext         Context of filesystems.
-  @param[in,out] FileSystem          Filesystem to scan for bless.
-  @param[in]     PredefinedPaths     The predefined boot file locations to scan.
-  @param[in]     NumPredefinedPaths  The number of elements in PredefinedPaths.
-  @param[in]     LazyScan            Lazy filesystem scanning.
-  @param[in]     Deduplicate         Ensure that duplicated entries are not added.
+  @param[in]  BootContext         Context of filesystems.
+  @param[in]  FileSystem          Filesystem to scan for bless.
+  @param[in]  PredefinedPaths     The predefined boot file locations to scan.
+  @param[in]  NumPredefinedPaths  The number of elements in PredefinedPaths.
+  @param[out] DevicePath          Blessed device path allocated from pool.
 
-  @retval EFI_STATUS for last created option.
+  @retval EFI_SUCCESS on success.
 **/
 STATIC
 EFI_STATUS
-AddBootEntryFromBless (
-  IN OUT OC_BOOT_CONTEXT     *BootContext,
-  IN OUT OC_BOOT_FILESYSTEM  *FileSystem,
-  IN     CONST CHAR16        **PredefinedPaths,
-  IN     UINTN               NumPredefinedPaths,
-  IN     BOOLEAN             LazyScan,
-  IN     BOOLEAN             Deduplicate
+LookupBlessedDevicePath (
+  IN  OC_BOOT_CONTEXT           *BootContext,
+  IN  OC_BOOT_FILESYSTEM        *FileSystem,
+  IN  CONST CHAR16              **PredefinedPaths,
+  IN  UINTN                     NumPredefinedPaths,
+  OUT EFI_DEVICE_PATH_PROTOCOL  **DevicePath
   )
 {
   EFI_STATUS                       Status;
-  EFI_STATUS                       PrimaryStatus;
   EFI_SIMPLE_FILE_SYSTEM_PROTOCOL  *SimpleFs;
-  EFI_DEVICE_PATH_PROTOCOL         *DevicePath;
-  EFI_DEVICE_PATH_PROTOCOL         *DevicePathWalker;
-  EFI_DEVICE_PATH_PROTOCOL         *NewDevicePath;
-  UINTN                            NewDevicePathSize;
-  EFI_DEVICE_PATH_PROTOCOL         *HdDevicePath;
-  UINTN                            HdPrefixSize;
-  INTN                             CmpResult;
   EFI_FILE_PROTOCOL                *Root;
-  CHAR16                           *RecoveryPath;
-  EFI_FILE_PROTOCOL                *RecoveryRoot;
-  EFI_HANDLE                       RecoveryDeviceHandle;
-
-  //
-  // We need to ensure that blessed device paths are on the same filesystem.
-  // Read the prefix path.
-  //
-  Status = gBS->HandleProtocol (
-                  FileSystem->Handle,
-                  &gEfiDevicePathProtocolGuid,
-                  (VOID **)&HdDevicePath
-                  );
-  if (EFI_ERROR (Status)) {
-    return EFI_UNSUPPORTED;
-  }
-
-  DebugPrintDevicePath (DEBUG_INFO, "OCB: Adding bless entry on disk", HdDevicePath);
-
-  HdPrefixSize = GetDevicePathSize (HdDevicePath) - END_DEVICE_PATH_LENGTH;
 
   //
   // Custom bless paths have the priority, try to look them up first.
@@ -954,7 +922,7 @@ AddBootEntryFromBless (
                    Root,
                    (CONST CHAR16 **)BootContext->PickerContext->CustomBootPaths,
                    BootContext->PickerContext->NumCustomBootPaths,
-                   &DevicePath,
+                   DevicePath,
                    NULL
                    );
 
@@ -973,8 +941,97 @@ AddBootEntryFromBless (
                FileSystem->Handle,
                PredefinedPaths,
                NumPredefinedPaths,
+               DevicePath
+               );
+  }
+
+  return Status;
+}
+
+/**
+  Create bootable entries from bless policy.
+  This function may create more than one entry, and for APFS
+  it will likely produce a sequence of 'OS, RECOVERY' entry pairs.
+
+  @param[in,out] BootContext         Context of filesystems.
+  @param[in,out] FileSystem          Filesystem to scan for bless.
+  @param[in]     PredefinedPaths     The predefined boot file locations to scan.
+  @param[in]     NumPredefinedPaths  The number of elements in PredefinedPaths.
+  @param[in]     LazyScan            Lazy filesystem scanning.
+  @param[in]     Deduplicate         Ensure that duplicated entries are not added.
+
+  @retval EFI_STATUS for last created option.
+**/
+STATIC
+EFI_STATUS
+AddBootEntryFromBless (
+  IN OUT OC_BOOT_CONTEXT     *BootContext,
+  IN OUT OC_BOOT_FILESYSTEM  *FileSystem,
+  IN     CONST CHAR16        **PredefinedPaths,
+  IN     UINTN               NumPredefinedPaths,
+  IN     BOOLEAN             LazyScan,
+  IN     BOOLEAN             Deduplicate
+  )
+{
+  EFI_STATUS                Status;
+  EFI_STATUS                PrimaryStatus;
+  EFI_DEVICE_PATH_PROTOCOL  *DevicePath;
+  EFI_DEVICE_PATH_PROTOCOL  *DevicePathWalker;
+  EFI_DEVICE_PATH_PROTOCOL  *NewDevicePath;
+  UINTN                     NewDevicePathSize;
+  EFI_DEVICE_PATH_PROTOCOL  *HdDevicePath;
+  UINTN                     HdPrefixSize;
+  INTN                      CmpResult;
+  CHAR16                    *RecoveryPath;
+  EFI_FILE_PROTOCOL         *RecoveryRoot;
+  EFI_HANDLE                RecoveryDeviceHandle;
+
+  //
+  // We need to ensure that blessed device paths are on the same filesystem.
+  // Read the prefix path.
+  //
+  Status = gBS->HandleProtocol (
+                  FileSystem->Handle,
+                  &gEfiDevicePathProtocolGuid,
+                  (VOID **)&HdDevicePath
+                  );
+  if (EFI_ERROR (Status)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  DebugPrintDevicePath (DEBUG_INFO, "OCB: Adding bless entry on disk", HdDevicePath);
+
+  HdPrefixSize = GetDevicePathSize (HdDevicePath) - END_DEVICE_PATH_LENGTH;
+
+  //
+  // Reuse the lookup result from previous scans when the filesystem did not change.
+  //
+  Status = InternalGetCachedBlessResult (
+             FileSystem->Handle,
+             PredefinedPaths,
+             NumPredefinedPaths,
+             BootContext->PickerContext->CustomBootPaths,
+             BootContext->PickerContext->NumCustomBootPaths,
+             &DevicePath
+             );
+  if (Status == EFI_NOT_READY) {
+    Status = LookupBlessedDevicePath (
+               BootContext,
+               FileSystem,
+               PredefinedPaths,
+               NumPredefinedPaths,
                &DevicePath
                );
+
+    InternalSetCachedBlessResult (
+      FileSystem->Handle,
+      PredefinedPaths,
+      NumPredefinedPaths,
+      BootContext->PickerContext->CustomBootPaths,
+      BootContext->PickerContext->NumCustomBootPaths,
+      Status,
+      EFI_ERROR (Status) ? NULL : DevicePath
+      );
   }
 
   //
@@ -1693,7 +1750,7 @@ AddFileSystemEntry (
   EFI_DEVICE_PATH_PROTOCOL  *DevicePath;
   CHAR16                    *TextDevicePath;
 
-  Status = InternalCheckScanPolicy (
+  Status = InternalCheckScanPolicyCached (
              FileSystemHandle,
              BootContext->PickerContext->ScanPolicy,
              &IsExternal
@@ -1940,6 +1997,8 @@ BuildFileSystemList (
     return BootContext;
   }
 
+  InternalPrefetchFileSystems (Handles, NoHandles, Context->ScanPolicy);
+
   for (Index = 0; Index < NoHandles; ++Index) {
     AddFileSystemEntry (
       BootContext,
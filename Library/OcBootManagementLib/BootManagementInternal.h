@@ -131,6 +131,99 @@ InternalCheckScanPolicy (
   OUT BOOLEAN     *External OPTIONAL
   );
 
+/**
+  Check scan policy for filesystem handle, reusing the result from previous
+  scans when the handle still refers to the same device path and media.
+
+  @param[in]  Handle    Filesystem handle.
+  @param[in]  Policy    Scan policy.
+  @param[out] External  Set to TRUE for external devices, optional.
+
+  @retval EFI_SUCCESS when the filesystem is allowed by scan policy.
+**/
+EFI_STATUS
+InternalCheckScanPolicyCached (
+  IN  EFI_HANDLE  Handle,
+  IN  UINT32      Policy,
+  OUT BOOLEAN     *External OPTIONAL
+  );
+
+/**
+  Check whether scan policy result for filesystem handle is already cached.
+
+  @param[in]  Handle    Filesystem handle.
+  @param[in]  Policy    Scan policy.
+
+  @retval TRUE when filesystem will not be probed for scan policy.
+**/
+BOOLEAN
+InternalHasCachedScanPolicy (
+  IN EFI_HANDLE  Handle,
+  IN UINT32      Policy
+  );
+
+/**
+  Obtain blessed device path for filesystem handle from previous scans.
+
+  @param[in]  Handle              Filesystem handle.
+  @param[in]  PredefinedPaths     The predefined boot file locations used for scanning.
+  @param[in]  NumPredefinedPaths  The number of elements in PredefinedPaths.
+  @param[in]  CustomPaths         The custom boot file locations used for scanning.
+  @param[in]  NumCustomPaths      The number of elements in CustomPaths.
+  @param[out] DevicePath          Blessed device path allocated from pool.
+
+  @retval EFI_NOT_READY  No cached result is available, filesystem needs to be probed.
+  @retval EFI_SUCCESS    Blessed device path was returned.
+  @retval other          Cached bless lookup failure.
+**/
+EFI_STATUS
+InternalGetCachedBlessResult (
+  IN  EFI_HANDLE                Handle,
+  IN  CONST CHAR16              **PredefinedPaths,
+  IN  UINTN                     NumPredefinedPaths,
+  IN  CHAR16                    **CustomPaths,
+  IN  UINTN                     NumCustomPaths,
+  OUT EFI_DEVICE_PATH_PROTOCOL  **DevicePath
+  );
+
+/**
+  Record blessed device path lookup result for filesystem handle.
+
+  @param[in]  Handle              Filesystem handle.
+  @param[in]  PredefinedPaths     The predefined boot file locations used for scanning.
+  @param[in]  NumPredefinedPaths  The number of elements in PredefinedPaths.
+  @param[in]  CustomPaths         The custom boot file locations used for scanning.
+  @param[in]  NumCustomPaths      The number of elements in CustomPaths.
+  @param[in]  Status              Lookup status.
+  @param[in]  DevicePath          Blessed device path on success.
+**/
+VOID
+InternalSetCachedBlessResult (
+  IN EFI_HANDLE                Handle,
+  IN CONST CHAR16              **PredefinedPaths,
+  IN UINTN                     NumPredefinedPaths,
+  IN CHAR16                    **CustomPaths,
+  IN UINTN                     NumCustomPaths,
+  IN EFI_STATUS                Status,
+  IN EFI_DEVICE_PATH_PROTOCOL  *DevicePath OPTIONAL
+  );
+
+/**
+  Read partition tables of the disks of all uncached filesystems concurrently
+  via Block I/O 2 and cache them for serial probing. This lets slow devices
+  process the requests in parallel before serial probing starts.
+
+  @param[in]  Handles     Filesystem handles.
+  @param[in]  NoHandles   Number of filesystem handles.
+  @param[in]  ScanPolicy  Scan policy used for probing.
+**/
+VOID
+InternalPrefetchFileSystems (
+  IN EFI_HANDLE  *Handles,
+  IN UINTN       NoHandles,
+  IN UINT32      ScanPolicy
+  );
+
 EFI_DEVICE_PATH_PROTOCOL *
 InternalLoadDmg (
   IN OUT INTERNAL_DMG_LOAD_CONTEXT  *Context,
@@ -0,0 +1,342 @@
+/** @file
+  Concurrent partition table prefetch via Block I/O 2.
+
+  Copyright (C) 2026, Acidanthera. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include "BootManagementInternal.h"
+
+#include <Protocol/BlockIo2.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/DevicePathLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcDevicePathLib.h>
+#include <Library/OcFileLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+//
+// Covers protective MBR, GPT header and the usual 128 partition entries
+// for both 512 and 4096 byte blocks.
+//
+#define INTERNAL_PREFETCH_SIZE  SIZE_32KB
+
+//
+// Time to wait for outstanding requests per submitted disk. Slower disks are
+// probed serially, reading whatever has completed by then.
+//
+#define INTERNAL_PREFETCH_DISK_BUDGET_US  20000U
+#define INTERNAL_PREFETCH_POLL_US         100U
+
+typedef struct {
+  LIST_ENTRY                Link;
+  EFI_HANDLE                DiskHandle;
+  EFI_BLOCK_IO2_PROTOCOL    *BlockIo2;
+  EFI_BLOCK_IO2_TOKEN       Token;
+  VOID                      *Buffer;
+  UINTN                     BufferSize;
+  BOOLEAN                   TimedOut;
+} INTERNAL_PREFETCH_REQUEST;
+
+//
+// Submitted requests, which did not complete yet. The driver owns their tokens
+// and buffers until completion, so requests which timed out are kept here and
+// consumed by later scans without waiting for them again.
+//
+STATIC LIST_ENTRY  mPrefetchRequests = INITIALIZE_LIST_HEAD_VARIABLE (mPrefetchRequests);
+
+/**
+  Get disk handle for partition, when its partition table is to be read.
+
+  @param[in]  Handle    Filesystem handle.
+
+  @retval disk handle or NULL.
+**/
+STATIC
+EFI_HANDLE
+PrefetchGetDiskHandle (
+  IN EFI_HANDLE  Handle
+  )
+{
+  EFI_DEVICE_PATH_PROTOCOL  *DevicePath;
+  EFI_HANDLE                DiskHandle;
+
+  DevicePath = DevicePathFromHandle (Handle);
+  if (  (DevicePath == NULL)
+     || (FindDevicePathNodeWithType (DevicePath, MEDIA_DEVICE_PATH, MEDIA_HARDDRIVE_DP) == NULL))
+  {
+    return NULL;
+  }
+
+  DiskHandle = OcPartitionGetDiskHandle (DevicePath);
+  if ((DiskHandle == NULL) || OcHasCachedDiskPartitions (DiskHandle)) {
+    return NULL;
+  }
+
+  return DiskHandle;
+}
+
+/**
+  Submit non-blocking read of leading disk blocks.
+
+  @param[in,out] Request   Request with DiskHandle set.
+
+  @retval EFI_SUCCESS when request was submitted.
+**/
+STATIC
+EFI_STATUS
+PrefetchSubmit (
+  IN OUT INTERNAL_PREFETCH_REQUEST  *Request
+  )
+{
+  EFI_STATUS          Status;
+  EFI_BLOCK_IO_MEDIA  *Media;
+
+  Status = gBS->HandleProtocol (
+                  Request->DiskHandle,
+                  &gEfiBlockIo2ProtocolGuid,
+                  (VOID **)&Request->BlockIo2
+                  );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Media = Request->BlockIo2->Media;
+  if (  (Media == NULL)
+     || !Media->MediaPresent
+     || (Media->BlockSize == 0)
+     || ((Media->BlockSize & (Media->BlockSize - 1)) != 0)
+     || (Media->IoAlign > EFI_PAGE_SIZE))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  Request->BufferSize = ALIGN_VALUE (INTERNAL_PREFETCH_SIZE, Media->BlockSize);
+  if (DivU64x32 (Request->BufferSize, Media->BlockSize) > Media->LastBlock + 1) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Request->Buffer = AllocatePages (EFI_SIZE_TO_PAGES (Request->BufferSize));
+  if (Request->Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Plain events are polled with CheckEvent after the driver signals them.
+  //
+  Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &Request->Token.Event);
+  if (EFI_ERROR (Status)) {
+    FreePages (Request->Buffer, EFI_SIZE_TO_PAGES (Request->BufferSize));
+    Request->Buffer = NULL;
+    return Status;
+  }
+
+  Status = Request->BlockIo2->ReadBlocksEx (
+                                Request->BlockIo2,
+                                Media->MediaId,
+                                0,
+                                &Request->Token,
+                                Request->BufferSize,
+                                Request->Buffer
+                                );
+  if (EFI_ERROR (Status)) {
+    gBS->CloseEvent (Request->Token.Event);
+    FreePages (Request->Buffer, EFI_SIZE_TO_PAGES (Request->BufferSize));
+    Request->Buffer = NULL;
+    return Status;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Consume completed read by caching the partition table it contains,
+  and free the request.
+
+  @param[in,out] Request   Completed request.
+**/
+STATIC
+VOID
+PrefetchComplete (
+  IN OUT INTERNAL_PREFETCH_REQUEST  *Request
+  )
+{
+  RemoveEntryList (&Request->Link);
+  gBS->CloseEvent (Request->Token.Event);
+
+  if (!EFI_ERROR (Request->Token.TransactionStatus)) {
+    OcGetDiskPartitionsFromBuffer (
+      Request->DiskHandle,
+      TRUE,
+      Request->Buffer,
+      Request->BufferSize
+      );
+  }
+
+  FreePages (Request->Buffer, EFI_SIZE_TO_PAGES (Request->BufferSize));
+  FreePool (Request);
+}
+
+/**
+  Consume all completed requests.
+
+  @param[in]  TimedOut  Check requests, which already timed out, or new ones.
+
+  @retval Number of requests of this kind still pending.
+**/
+STATIC
+UINTN
+PrefetchPoll (
+  IN BOOLEAN  TimedOut
+  )
+{
+  LIST_ENTRY                 *Link;
+  LIST_ENTRY                 *NextLink;
+  INTERNAL_PREFETCH_REQUEST  *Request;
+  UINTN                      Pending;
+
+  Pending = 0;
+  for (Link = GetFirstNode (&mPrefetchRequests); !IsNull (&mPrefetchRequests, Link); Link = NextLink) {
+    NextLink = GetNextNode (&mPrefetchRequests, Link);
+    Request  = BASE_CR (Link, INTERNAL_PREFETCH_REQUEST, Link);
+
+    if (Request->TimedOut != TimedOut) {
+      continue;
+    }
+
+    if (gBS->CheckEvent (Request->Token.Event) == EFI_NOT_READY) {
+      ++Pending;
+      continue;
+    }
+
+    PrefetchComplete (Request);
+  }
+
+  return Pending;
+}
+
+/**
+  Check whether disk has a request, which did not complete yet.
+
+  @param[in]  DiskHandle  Disk handle.
+
+  @retval TRUE when request is pending.
+**/
+STATIC
+BOOLEAN
+PrefetchIsPending (
+  IN EFI_HANDLE  DiskHandle
+  )
+{
+  LIST_ENTRY  *Link;
+
+  for (Link = GetFirstNode (&mPrefetchRequests); !IsNull (&mPrefetchRequests, Link); Link = GetNextNode (&mPrefetchRequests, Link)) {
+    if (BASE_CR (Link, INTERNAL_PREFETCH_REQUEST, Link)->DiskHandle == DiskHandle) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+VOID
+InternalPrefetchFileSystems (
+  IN EFI_HANDLE  *Handles,
+  IN UINTN       NoHandles,
+  IN UINT32      ScanPolicy
+  )
+{
+  EFI_STATUS                 Status;
+  INTERNAL_PREFETCH_REQUEST  *Request;
+  LIST_ENTRY                 *Link;
+  EFI_HANDLE                 DiskHandle;
+  UINTN                      Index;
+  UINTN                      Submitted;
+  UINTN                      Pending;
+  UINTN                      Waited;
+
+  //
+  // Consume reads, which timed out on previous scans and completed since.
+  //
+  Pending = PrefetchPoll (TRUE);
+  if (Pending > 0) {
+    DEBUG ((DEBUG_INFO, "OCB: Prefetch still has %u timed out requests\n", (UINT32)Pending));
+  }
+
+  if (NoHandles < 2) {
+    return;
+  }
+
+  //
+  // Issue partition table reads for all disks at once, so that slow devices
+  // (e.g. sleeping USB disks) spin up in parallel rather than one by one.
+  // Filesystems with cached scan results will not be probed and are skipped,
+  // as are disks with reads still pending from previous scans.
+  //
+  Submitted = 0;
+  for (Index = 0; Index < NoHandles; ++Index) {
+    if (InternalHasCachedScanPolicy (Handles[Index], ScanPolicy)) {
+      continue;
+    }
+
+    DiskHandle = PrefetchGetDiskHandle (Handles[Index]);
+    if ((DiskHandle == NULL) || PrefetchIsPending (DiskHandle)) {
+      continue;
+    }
+
+    Request = AllocateZeroPool (sizeof (*Request));
+    if (Request == NULL) {
+      break;
+    }
+
+    Request->DiskHandle = DiskHandle;
+    Status              = PrefetchSubmit (Request);
+    if (EFI_ERROR (Status)) {
+      FreePool (Request);
+      continue;
+    }
+
+    InsertTailList (&mPrefetchRequests, &Request->Link);
+    ++Submitted;
+  }
+
+  DEBUG ((DEBUG_INFO, "OCB: Prefetching %u disks\n", (UINT32)Submitted));
+
+  if (Submitted == 0) {
+    return;
+  }
+
+  Waited = 0;
+  while (TRUE) {
+    Pending = PrefetchPoll (FALSE);
+    if ((Pending == 0) || (Waited >= Submitted * INTERNAL_PREFETCH_DISK_BUDGET_US)) {
+      break;
+    }
+
+    gBS->Stall (INTERNAL_PREFETCH_POLL_US);
+    Waited += INTERNAL_PREFETCH_POLL_US;
+  }
+
+  if (Pending > 0) {
+    //
+    // Serial probing will read the partition tables of these disks synchronously.
+    //
+    DEBUG ((DEBUG_INFO, "OCB: Prefetch timed out with %u pending requests\n", (UINT32)Pending));
+
+    for (Link = GetFirstNode (&mPrefetchRequests); !IsNull (&mPrefetchRequests, Link); Link = GetNextNode (&mPrefetchRequests, Link)) {
+      BASE_CR (Link, INTERNAL_PREFETCH_REQUEST, Link)->TimedOut = TRUE;
+    }
+  }
+}
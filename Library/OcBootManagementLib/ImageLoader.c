@@ -149,18 +149,32 @@ RestoreGrubShimHooks (
   }
 }
 
+/**
+  Read image file, optionally hashing it as Apple image while reading.
+
+  @param[in]     DevicePath   Image device path.
+  @param[out]    FileSize     Size of the image.
+  @param[out]    FileBuffer   Image buffer to be freed by the caller.
+  @param[in,out] HashContext  Apple image hash context or NULL on input,
+                              reset to NULL when the image is not hashed.
+
+  @retval EFI_SUCCESS on success.
+**/
 STATIC
 EFI_STATUS
 InternalEfiLoadImageFile (
-  IN  EFI_DEVICE_PATH_PROTOCOL  *DevicePath,
-  OUT UINTN                     *FileSize,
-  OUT VOID                      **FileBuffer
+  IN     EFI_DEVICE_PATH_PROTOCOL    *DevicePath,
+  OUT    UINTN                       *FileSize,
+  OUT    VOID                        **FileBuffer,
+  IN OUT PE_COFF_APPLE_HASH_CONTEXT  **HashContext
   )
 {
   EFI_STATUS         Status;
   EFI_FILE_PROTOCOL  *File;
   VOID               *Buffer;
   UINT32             Size;
+  UINT32             Position;
+  UINT32             ChunkSize;
 
   Status = OcOpenFileByDevicePath (
              &DevicePath,
@@ -187,16 +201,38 @@ InternalEfiLoadImageFile (
     return EFI_OUT_OF_RESOURCES;
   }
 
-  Status = OcGetFileData (
-             File,
-             0,
-             Size,
-             Buffer
-             );
-  if (EFI_ERROR (Status)) {
-    FreePool (Buffer);
-    File->Close (File);
-    return EFI_DEVICE_ERROR;
+  //
+  // Hash every chunk right after reading it, while it is still in cache.
+  //
+  for (Position = 0; Position < Size; Position += ChunkSize) {
+    ChunkSize = MIN (Size - Position, BASE_1MB);
+    Status    = OcGetFileData (
+                  File,
+                  Position,
+                  ChunkSize,
+                  (UINT8 *)Buffer + Position
+                  );
+    if (EFI_ERROR (Status)) {
+      FreePool (Buffer);
+      File->Close (File);
+      return EFI_DEVICE_ERROR;
+    }
+
+    if (*HashContext == NULL) {
+      continue;
+    }
+
+    //
+    // Hashing starts only once the first chunk shows Apple signature directory.
+    //
+    if (Position == 0) {
+      Status = PeCoffAppleHashInit (*HashContext, Buffer, Size, ChunkSize);
+      if (EFI_ERROR (Status)) {
+        *HashContext = NULL;
+      }
+    } else {
+      PeCoffAppleHashUpdate (*HashContext, Position + ChunkSize);
+    }
   }
 
   *FileBuffer = Buffer;
@@ -791,6 +827,8 @@ InternalEfiLoadImage (
   CHAR16                         *FilePath;
   BOOLEAN                        FixupRequired;
   BOOLEAN                        AppleBootPath;
+  PE_COFF_APPLE_HASH_CONTEXT     AppleHashContext;
+  PE_COFF_APPLE_HASH_CONTEXT     *HashContext;
 
   if ((ParentImageHandle == NULL) || (ImageHandle == NULL)) {
     return EFI_INVALID_PARAMETER;
@@ -806,19 +844,29 @@ InternalEfiLoadImage (
 
   OcImageLoaderCaps = NULL;
   AllocatedBuffer   = NULL;
+  HashContext       = NULL;
   if (SourceBuffer == NULL) {
+    //
+    // Hash Apple images while reading, in case their signature is checked for fixups.
+    //
+    if (mFixupAppleEfiImages) {
+      HashContext = &AppleHashContext;
+    }
+
     Status = InternalEfiLoadImageFile (
                DevicePath,
                &SourceSize,
-               &SourceBuffer
+               &SourceBuffer,
+               &HashContext
                );
     if (EFI_ERROR (Status)) {
-      Status = InternalEfiLoadImageProtocol (
-                 DevicePath,
-                 BootPolicy == FALSE,
-                 &SourceSize,
-                 &SourceBuffer
-                 );
+      HashContext = NULL;
+      Status      = InternalEfiLoadImageProtocol (
+                      DevicePath,
+                      BootPolicy == FALSE,
+                      &SourceSize,
+                      &SourceBuffer
+                      );
     }
 
     if (!EFI_ERROR (Status)) {
@@ -904,7 +952,7 @@ InternalEfiLoadImage (
           // only in 32-bit slices), so verify signature allowing for W^X errors only.
           //
           SignedFileSize = RealSize;
-          Status         = PeCoffVerifyAppleSignature (SourceBuffer, &SignedFileSize);
+          Status         = PeCoffVerifyAppleSignatureWithHash (SourceBuffer, &SignedFileSize, HashContext);
           if (!EFI_ERROR (Status)) {
             DEBUG ((
               DEBUG_INFO,
@@ -37,6 +37,7 @@
 #include <Library/OcMiscLib.h>
 #include <Library/OcRtcLib.h>
 #include <Library/OcStringLib.h>
+#include <Library/OcTraceLib.h>
 #include <Library/OcVariableLib.h>
 #include <Library/PrintLib.h>
 #include <Library/UefiBootServicesTableLib.h>
@@ -204,6 +205,18 @@ OcVerifyPassword (
 {
   BOOLEAN  Result;
 
+  if (PrivilegeContext->Iterations != 0) {
+    return OcVerifyPasswordPbkdf2Sha512 (
+             Password,
+             PasswordSize,
+             PrivilegeContext->Salt,
+             PrivilegeContext->SaltSize,
+             PrivilegeContext->Iterations,
+             PrivilegeContext->Lanes,
+             PrivilegeContext->Hash
+             );
+  }
+
   Result = OcVerifyPasswordSha512 (
              Password,
              PasswordSize,
@@ -266,6 +279,7 @@ OcRunBootPicker (
   BOOLEAN                            SaidWelcome;
   OC_FIRMWARE_RUNTIME_PROTOCOL       *FwRuntime;
   BOOLEAN                            IsApplePickerSelection;
+  OC_TRACE_ID                        TraceId;
 
   SaidWelcome = FALSE;
 
@@ -334,6 +348,12 @@ OcRunBootPicker (
       Context->BootOrderCount = 0;
     }
 
+    //
+    // Cache path probes for the duration of the scan.
+    //
+    OcBootPolicySetPathCache (TRUE);
+    TraceId = OcTraceBegin ("BootScan");
+
     //
     // Turbo-boost scanning when bypassing picker.
     //
@@ -353,6 +373,10 @@ OcRunBootPicker (
       BootContext = OcScanForBootEntries (Context);
     }
 
+    OcTraceEnd (TraceId);
+    OcTraceExportFile (OcTraceMilestoneBootScan);
+    OcBootPolicySetPathCache (FALSE);
+
     //
     // We have no entries at all or have auxiliary entries.
     // Fallback to showing menu in the latter case.
@@ -510,6 +534,12 @@ OcRunBootPicker (
       OcRestoreNvramProtection (FwRuntime);
       RestoreMode ();
 
+      //
+      // Launched entry (e.g. a shell or an installer) may have changed filesystem
+      // contents, so do not trust cached scan results on next iteration.
+      //
+      OcFlushBootEntryScanCache ();
+
       //
       // Do not wait on successful return code.
       //
@@ -85,6 +85,18 @@ struct encode_state {
 };
 
 
+/*
+ * OpenCore: decode straight into the output buffer instead of going through
+ * the ring.  Ring position of output byte o is (N - F + o) & (N - 1), so a
+ * ring reference translates into a distance back from the current output.
+ * Bytes before the output start come from the space-filled ring prefix.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#  define LZSS_COPY8(Dst, Src) __builtin_memcpy((Dst), (Src), 8)
+#elif defined(MDE_CPU_X64) || defined(MDE_CPU_IA32)
+#  define LZSS_COPY8(Dst, Src) (*(UINT64 *)(Dst) = *(const UINT64 *)(Src))
+#endif
+
 /*******************************************************************************
 *******************************************************************************/
 u_int32_t decompress_lzss(
@@ -93,44 +105,53 @@ u_int32_t decompress_lzss(
     u_int8_t       * src,
     u_int32_t        srclen)
 {
-    /* ring buffer of size N, with extra F-1 bytes to aid string comparison */
-    u_int8_t text_buf[N + F - 1];
     u_int8_t * dststart = dst;
     const u_int8_t * dstend = dst + dstlen;
     const u_int8_t * srcend = src + srclen;
-    int  i, j, k, r;
-    u_int8_t c;
+    const u_int8_t * from;
+    u_int32_t pos, dist, len, k;
     unsigned int flags;
 
     if (dstlen > OC_COMPRESSION_MAX_LENGTH || srclen > OC_COMPRESSION_MAX_LENGTH) {
         return 0;
     }
 
-    dst = dststart;
-    memset(text_buf, ' ', N - F);
-    r = N - F;
     flags = 0;
     for ( ; ; ) {
         if (((flags >>= 1) & 0x100) == 0) {
-            if (src < srcend) c = *src++; else break;
-            flags = c | 0xFF00;  /* uses higher byte cleverly */
-        }   /* to count eight */
+            if (src < srcend) flags = *src++ | 0xFF00; else break;
+        }   /* uses higher byte cleverly to count eight */
         if (flags & 1) {
-            if (src < srcend) c = *src++; else break;
-            if (dst < dstend) *dst++ = c; else break;
-            text_buf[r++] = c;
-            r &= (N - 1);
+            if (src < srcend && dst < dstend) *dst++ = *src++; else break;
         } else {
-            if (src < srcend) i = *src++; else break;
-            if (src < srcend) j = *src++; else break;
-            i |= ((j & 0xF0) << 4);
-            j  =  (j & 0x0F) + THRESHOLD;
-            for (k = 0; k <= j; k++) {
-                c = text_buf[(i + k) & (N - 1)];
-                if (dst < dstend) *dst++ = c; else break;
-                text_buf[r++] = c;
-                r &= (N - 1);
+            if (srcend - src < 2 || dst == dstend) break;
+            pos  = src[0] | ((src[1] & 0xF0) << 4);
+            len  = (src[1] & 0x0F) + THRESHOLD + 1;
+            src += 2;
+            /* distance is 1..N, as ring position r itself holds the byte N back */
+            dist = ((N - F) + (u_int32_t)(dst - dststart) - pos) & (N - 1);
+            if (dist == 0) dist = N;
+            if (len > (u_int32_t)(dstend - dst)) len = (u_int32_t)(dstend - dst);
+            if (dist > (u_int32_t)(dst - dststart)) {
+                /* match starts in the initial ring contents */
+                for (k = 0; k < len; k++, dst++) {
+                    *dst = dist > (u_int32_t)(dst - dststart) ? ' ' : *(dst - dist);
+                }
+                continue;
+            }
+            from = dst - dist;
+#ifdef LZSS_COPY8
+            if (dist >= 8 && (u_int32_t)(dstend - dst) >= 3 * 8) {
+                /* at most F bytes, no overlap within a word */
+                LZSS_COPY8(dst, from);
+                LZSS_COPY8(dst + 8, from + 8);
+                if (len > 16) LZSS_COPY8(dst + 16, from + 16);
+                dst += len;
+                continue;
             }
+#endif
+            for (k = 0; k < len; k++) dst[k] = from[k];
+            dst += len;
         }
     }
 
@@ -76,32 +76,65 @@ typedef struct {
 
 } lzvn_decoder_state;
 
+//
+// OpenCore: memcpy is CopyMem in firmware, which is never inlined and turns
+// every fixed size load or store into a call. Use compiler builtins instead,
+// or plain unaligned accesses where the architecture permits them.
+//
+#if defined(__GNUC__) || defined(__clang__)
+#  define lzvn_memcpy_fixed __builtin_memcpy
+#elif defined(MDE_CPU_X64) || defined(MDE_CPU_IA32)
+#  define LZVN_UNALIGNED_ACCESS 1
+#else
+#  define lzvn_memcpy_fixed memcpy
+#endif
+
 /*! @abstract Load bytes from memory location SRC. */
 LZFSE_INLINE uint16_t load2(const void *ptr) {
+#ifdef LZVN_UNALIGNED_ACCESS
+  return *(const uint16_t *)ptr;
+#else
   uint16_t data;
-  memcpy(&data, ptr, sizeof data);
+  lzvn_memcpy_fixed(&data, ptr, sizeof data);
   return data;
+#endif
 }
 
 LZFSE_INLINE uint32_t load4(const void *ptr) {
+#ifdef LZVN_UNALIGNED_ACCESS
+  return *(const uint32_t *)ptr;
+#else
   uint32_t data;
-  memcpy(&data, ptr, sizeof data);
+  lzvn_memcpy_fixed(&data, ptr, sizeof data);
   return data;
+#endif
 }
 
 LZFSE_INLINE uint64_t load8(const void *ptr) {
+#ifdef LZVN_UNALIGNED_ACCESS
+  return *(const uint64_t *)ptr;
+#else
   uint64_t data;
-  memcpy(&data, ptr, sizeof data);
+  lzvn_memcpy_fixed(&data, ptr, sizeof data);
   return data;
+#endif
 }
 
 /*! @abstract Store bytes to memory location DST. */
 LZFSE_INLINE void store4(void *ptr, uint32_t data) {
-  memcpy(ptr, &data, sizeof data);
+#ifdef LZVN_UNALIGNED_ACCESS
+  *(uint32_t *)ptr = data;
+#else
+  lzvn_memcpy_fixed(ptr, &data, sizeof data);
+#endif
 }
 
 LZFSE_INLINE void store8(void *ptr, uint64_t data) {
-  memcpy(ptr, &data, sizeof data);
+#ifdef LZVN_UNALIGNED_ACCESS
+  *(uint64_t *)ptr = data;
+#else
+  lzvn_memcpy_fixed(ptr, &data, sizeof data);
+#endif
 }
 
 /*! @abstract Extracts \p width bits from \p container, starting with \p lsb; if
@@ -550,6 +583,19 @@ copy_match:
     //  away from the end of the destination buffer.
     for (size_t i = 0; i < M; i += 8)
       store8(&dst_ptr[i], load8(dst_ptr + i - D));
+  } else if (dst_len >= M + 7 && D < 8 && D != 0) {
+    //  OpenCore: short distances are common in kernel data (zero runs and
+    //  repeated patterns). The output repeats with period D, and thus with
+    //  any multiple of it. Copy the first bytes one by one until the period
+    //  reaches eight, then continue with eight byte copies as above.
+    size_t DW = D;
+    while (DW < 8)
+      DW += D;
+    size_t i = 0;
+    for (; i < DW - D && i < M; ++i)
+      dst_ptr[i] = *(dst_ptr + i - D);
+    for (; i < M; i += 8)
+      store8(&dst_ptr[i], load8(dst_ptr + i - DW));
   } else if (M <= dst_len) {
     //  Either the match distance is too small, or we are too close to
     //  the end of the buffer to safely use eight byte copies. Fall back
@@ -68,6 +68,17 @@ uLong ZEXPORT adler32_z(adler, buf, len)
     unsigned long sum2;
     unsigned n;
 
+#ifdef OC_ZLIB_SIMD
+    /* OpenCore: process whole 32-byte blocks with SSSE3 when available */
+    if (len >= 64 && (oc_zlib_simd_features() & OC_ZLIB_SIMD_SSSE3)) {
+        adler = InternalAdler32Ssse3((UINT32)adler, buf, len >> 5);
+        buf += len & ~(z_size_t)31;
+        len &= 31;
+        if (len == 0)
+            return adler;
+    }
+#endif
+
     /* split Adler-32 into component sums */
     sum2 = (adler >> 16) & 0xffff;
     adler &= 0xffff;
@@ -757,6 +757,15 @@ unsigned long ZEXPORT crc32_z(crc, buf, len)
     once(&made, make_crc_table);
 #endif /* DYNAMIC_CRC_TABLE */
 
+#ifdef OC_ZLIB_SIMD
+    /* OpenCore: fold whole 16-byte blocks with PCLMULQDQ when available */
+    if (len >= 64 && (oc_zlib_simd_features() & OC_ZLIB_SIMD_PCLMULQDQ)) {
+        crc = ~InternalCrc32Pclmul((UINT32)~crc, buf, len & ~(z_size_t)15);
+        buf += len & ~(z_size_t)15;
+        len &= 15;
+    }
+#endif
+
     /* Pre-condition the CRC */
     crc = (~crc) & 0xffffffff;
 
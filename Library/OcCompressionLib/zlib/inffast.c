@@ -12,6 +12,52 @@
 #  pragma message("Assembler code may have bugs -- use at your own risk")
 #else
 
+/*
+   OpenCore: on X64 keep up to 63 bits in the bit accumulator and refill it
+   with a single unaligned 8-byte load, and copy matches 8 bytes at a time
+   when there is enough room after the match end for the overrun.
+ */
+#if defined(MDE_CPU_X64)
+#  define OC_INFLATE_FAST_WIDE
+#endif
+
+#ifdef OC_INFLATE_FAST_WIDE
+typedef UINT64 zhold_t;
+#  if defined(__GNUC__) || defined(__clang__)
+#    define ZREAD64(Value, Ptr) __builtin_memcpy(&(Value), (Ptr), 8)
+#    define ZWRITE64(Ptr, Value) __builtin_memcpy((Ptr), &(Value), 8)
+#  else
+#    define ZREAD64(Value, Ptr) ((Value) = *(const UINT64 *)(Ptr))
+#    define ZWRITE64(Ptr, Value) (*(UINT64 *)(Ptr) = (Value))
+#  endif
+/* Refill to at least 56 bits with one load, when 8 input bytes are there */
+#  define PULLFAST() \
+    do { \
+        if (in < wlast) { \
+            UINT64 word; \
+            ZREAD64(word, in); \
+            hold |= word << bits; \
+            in += 7 - (bits >> 3); \
+            bits |= 56; \
+        } \
+        else { \
+            hold |= (zhold_t)(*in++) << bits; \
+            bits += 8; \
+            hold |= (zhold_t)(*in++) << bits; \
+            bits += 8; \
+        } \
+    } while (0)
+#else
+typedef unsigned long zhold_t;
+#  define PULLFAST() \
+    do { \
+        hold |= (zhold_t)(*in++) << bits; \
+        bits += 8; \
+        hold |= (zhold_t)(*in++) << bits; \
+        bits += 8; \
+    } while (0)
+#endif
+
 /*
    Decode literal, length, and distance codes and write out the resulting
    literal and match bytes until either not enough input or output is
@@ -46,6 +92,10 @@
       bytes, which is the maximum length that can be coded.  inflate_fast()
       requires strm->avail_out >= 258 for each loop to avoid checking for
       output space.
+
+    - With OC_INFLATE_FAST_WIDE the accumulator may hold bits past the count
+      in bits, which are always the next stream bits.  Bytes are therefore
+      merged with |= rather than +=, and the excess is cleared on return.
  */
 void ZLIB_INTERNAL inflate_fast(strm, start)
 z_streamp strm;
@@ -57,6 +107,10 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
     unsigned char FAR *out;     /* local strm->next_out */
     unsigned char FAR *beg;     /* inflate()'s initial strm->next_out */
     unsigned char FAR *end;     /* while out < end, enough space available */
+#ifdef OC_INFLATE_FAST_WIDE
+    z_const unsigned char FAR *wlast;   /* 8-byte loads allowed while in < wlast */
+    unsigned char FAR *oend;    /* end of output buffer */
+#endif
 #ifdef INFLATE_STRICT
     unsigned dmax;              /* maximum distance from zlib header */
 #endif
@@ -64,7 +118,7 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
     unsigned whave;             /* valid bytes in the window */
     unsigned wnext;             /* window write index */
     unsigned char FAR *window;  /* allocated sliding window, if wsize != 0 */
-    unsigned long hold;         /* local strm->hold */
+    zhold_t hold;               /* local strm->hold */
     unsigned bits;              /* local strm->bits */
     code const FAR *lcode;      /* local strm->lencode */
     code const FAR *dcode;      /* local strm->distcode */
@@ -84,6 +138,10 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
     out = strm->next_out;
     beg = out - (start - strm->avail_out);
     end = out + (strm->avail_out - 257);
+#ifdef OC_INFLATE_FAST_WIDE
+    wlast = strm->avail_in >= 8 ? in + (strm->avail_in - 7) : in;
+    oend = out + strm->avail_out;
+#endif
 #ifdef INFLATE_STRICT
     dmax = state->dmax;
 #endif
@@ -101,12 +159,8 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
     /* decode literals and length/distances until end-of-block or not enough
        input data or output space */
     do {
-        if (bits < 15) {
-            hold += (unsigned long)(*in++) << bits;
-            bits += 8;
-            hold += (unsigned long)(*in++) << bits;
-            bits += 8;
-        }
+        if (bits < 15)
+            PULLFAST();
         here = lcode + (hold & lmask);
       dolen:
         op = (unsigned)(here->bits);
@@ -124,7 +178,7 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
             op &= 15;                           /* number of extra bits */
             if (op) {
                 if (bits < op) {
-                    hold += (unsigned long)(*in++) << bits;
+                    hold |= (zhold_t)(*in++) << bits;
                     bits += 8;
                 }
                 len += (unsigned)hold & ((1U << op) - 1);
@@ -132,12 +186,8 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                 bits -= op;
             }
             Tracevv((stderr, "inflate:         length %u\n", len));
-            if (bits < 15) {
-                hold += (unsigned long)(*in++) << bits;
-                bits += 8;
-                hold += (unsigned long)(*in++) << bits;
-                bits += 8;
-            }
+            if (bits < 15)
+                PULLFAST();
             here = dcode + (hold & dmask);
           dodist:
             op = (unsigned)(here->bits);
@@ -148,10 +198,10 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                 dist = (unsigned)(here->val);
                 op &= 15;                       /* number of extra bits */
                 if (bits < op) {
-                    hold += (unsigned long)(*in++) << bits;
+                    hold |= (zhold_t)(*in++) << bits;
                     bits += 8;
                     if (bits < op) {
-                        hold += (unsigned long)(*in++) << bits;
+                        hold |= (zhold_t)(*in++) << bits;
                         bits += 8;
                     }
                 }
@@ -250,6 +300,32 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                 }
                 else {
                     from = out - dist;          /* copy direct from output */
+#ifdef OC_INFLATE_FAST_WIDE
+                    if (len + 7 <= (unsigned)(oend - out)) {
+                        if (dist >= 8) {        /* no overlap within a word */
+                            UINT64 word;
+                            unsigned char FAR *mend = out + len;
+                            do {
+                                ZREAD64(word, from);
+                                ZWRITE64(out, word);
+                                from += 8;
+                                out += 8;
+                            } while (out < mend);
+                            out = mend;
+                            continue;
+                        }
+                        if (dist == 1) {        /* run of a single byte */
+                            UINT64 word = *from * (UINT64)0x0101010101010101ULL;
+                            unsigned char FAR *mend = out + len;
+                            do {
+                                ZWRITE64(out, word);
+                                out += 8;
+                            } while (out < mend);
+                            out = mend;
+                            continue;
+                        }
+                    }
+#endif
                     do {                        /* minimum length is three */
                         *out++ = *from++;
                         *out++ = *from++;
@@ -301,7 +377,7 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
     strm->avail_in = (unsigned)(in < last ? 5 + (last - in) : 5 - (in - last));
     strm->avail_out = (unsigned)(out < end ?
                                  257 + (end - out) : 257 - (out - end));
-    state->hold = hold;
+    state->hold = (unsigned long)hold;
     state->bits = bits;
     return;
 }
@@ -14,6 +14,7 @@
 
 #include "zutil.h"
 
+#include <Library/BaseLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/OcCompressionLib.h>
 
@@ -34,6 +35,45 @@ void ZLIB_INTERNAL zcfree (opaque, ptr)
   FreePool (ptr);
 }
 
+#ifdef OC_ZLIB_SIMD
+
+///
+/// Detected SIMD features with OC_ZLIB_SIMD_DETECTED set, zero until detection.
+/// Concurrent detection from application processors is benign.
+///
+#define OC_ZLIB_SIMD_DETECTED  BIT31
+
+STATIC volatile UINT32  mZlibSimdFeatures;
+
+unsigned ZLIB_INTERNAL
+oc_zlib_simd_features (
+  void
+  )
+{
+  UINT32  Features;
+  UINT32  RegEcx;
+
+  Features = mZlibSimdFeatures;
+  if (Features == 0) {
+    AsmCpuid (1, NULL, NULL, &RegEcx, NULL);
+
+    Features = OC_ZLIB_SIMD_DETECTED;
+    if ((RegEcx & BIT9) != 0) {
+      Features |= OC_ZLIB_SIMD_SSSE3;
+    }
+
+    if ((RegEcx & BIT1) != 0) {
+      Features |= OC_ZLIB_SIMD_PCLMULQDQ;
+    }
+
+    mZlibSimdFeatures = Features;
+  }
+
+  return Features;
+}
+
+#endif
+
 UINT8 *
 CompressZLIB (
   OUT UINT8        *Dst,
@@ -76,6 +116,177 @@ DecompressZLIB (
   return 0;
 }
 
+struct OC_ZLIB_STREAM_ {
+  z_stream    Stream;
+};
+
+UINTN
+CompressZLIBBound (
+  IN UINTN  SrcLen
+  )
+{
+  return SrcLen + (SrcLen >> 12) + (SrcLen >> 14) + (SrcLen >> 25) + 13;
+}
+
+OC_ZLIB_STREAM *
+CompressZLIBStreamInit (
+  IN UINT32  Level
+  )
+{
+  OC_ZLIB_STREAM  *Stream;
+
+  if ((Level < Z_BEST_SPEED) || (Level > Z_BEST_COMPRESSION)) {
+    return NULL;
+  }
+
+  Stream = AllocateZeroPool (sizeof (*Stream));
+  if (Stream == NULL) {
+    return NULL;
+  }
+
+  if (deflateInit (&Stream->Stream, (int)Level) != Z_OK) {
+    FreePool (Stream);
+    return NULL;
+  }
+
+  return Stream;
+}
+
+UINTN
+CompressZLIBStream (
+  IN OUT OC_ZLIB_STREAM  *Stream,
+  OUT    UINT8           *Dst,
+  IN     UINTN           DstLen,
+  IN     CONST UINT8     *Src,
+  IN     UINTN           SrcLen,
+  IN     BOOLEAN         Finish
+  )
+{
+  int  Result;
+
+  if ((SrcLen > OC_COMPRESSION_MAX_LENGTH) || (DstLen > OC_COMPRESSION_MAX_LENGTH)) {
+    return MAX_UINTN;
+  }
+
+  Stream->Stream.next_in   = (z_const Bytef *)Src;
+  Stream->Stream.avail_in  = (uInt)SrcLen;
+  Stream->Stream.next_out  = Dst;
+  Stream->Stream.avail_out = (uInt)DstLen;
+
+  Result = deflate (&Stream->Stream, Finish ? Z_FINISH : Z_NO_FLUSH);
+
+  //
+  // Running out of output space before consuming all input is an error,
+  // as is not finishing the stream when requested.
+  //
+  if (  ((Result != Z_OK) && (Result != Z_STREAM_END) && (Result != Z_BUF_ERROR))
+     || (Stream->Stream.avail_in != 0)
+     || (Finish && (Result != Z_STREAM_END)))
+  {
+    return MAX_UINTN;
+  }
+
+  return DstLen - Stream->Stream.avail_out;
+}
+
+VOID
+CompressZLIBStreamFree (
+  IN OC_ZLIB_STREAM  *Stream
+  )
+{
+  deflateEnd (&Stream->Stream);
+  FreePool (Stream);
+}
+
+///
+/// Bump allocator over caller provided scratch memory.
+///
+typedef struct {
+  UINT8    *Buffer;
+  UINTN    Size;
+  UINTN    Used;
+} ZLIB_SCRATCH_ARENA;
+
+STATIC
+voidpf
+ZlibScratchAlloc (
+  voidpf    opaque,
+  unsigned  items,
+  unsigned  size
+  )
+{
+  ZLIB_SCRATCH_ARENA  *Arena;
+  UINTN               Length;
+  voidpf              Result;
+
+  Arena  = opaque;
+  Length = ALIGN_VALUE ((UINTN)items * size, sizeof (UINT64));
+  if (Length > Arena->Size - Arena->Used) {
+    return Z_NULL;
+  }
+
+  Result       = Arena->Buffer + Arena->Used;
+  Arena->Used += Length;
+  return Result;
+}
+
+STATIC
+void
+ZlibScratchFree (
+  voidpf  opaque,
+  voidpf  ptr
+  )
+{
+  //
+  // Arena memory is released all at once by the caller.
+  //
+  (void)opaque;
+  (void)ptr;
+}
+
+UINTN
+DecompressZLIBScratch (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        SrcLen,
+  IN  VOID         *Scratch
+  )
+{
+  ZLIB_SCRATCH_ARENA  Arena;
+  z_stream            Stream;
+  int                 Result;
+
+  if (SrcLen > OC_COMPRESSION_MAX_LENGTH || DstLen > OC_COMPRESSION_MAX_LENGTH) {
+    return 0;
+  }
+
+  Arena.Buffer = Scratch;
+  Arena.Size   = OC_ZLIB_SCRATCH_SIZE;
+  Arena.Used   = 0;
+
+  Stream.zalloc    = ZlibScratchAlloc;
+  Stream.zfree     = ZlibScratchFree;
+  Stream.opaque    = &Arena;
+  Stream.next_in   = (z_const Bytef *)Src;
+  Stream.avail_in  = (uInt)SrcLen;
+  Stream.next_out  = Dst;
+  Stream.avail_out = (uInt)DstLen;
+
+  if (inflateInit (&Stream) != Z_OK) {
+    return 0;
+  }
+
+  Result = inflate (&Stream, Z_FINISH);
+  inflateEnd (&Stream);
+
+  if (Result == Z_STREAM_END) {
+    return (UINTN)Stream.total_out;
+  }
+
+  return 0;
+}
+
 UINT32
 Adler32 (
   IN CONST UINT8  *Buffer,
@@ -241,6 +241,22 @@ extern z_const char * const z_errmsg[10]; /* indexed by 2-zlib_error */
 #define zmemcmp(Ptr1, Ptr2, Size) CompareMem ((Ptr1), (Ptr2), (Size))
 #define zmemzero(Dst, Size) ZeroMem ((Dst), (Size))
 
+/* OpenCore: SSSE3 Adler-32 and PCLMULQDQ CRC-32 kernels in X64/ZlibSimd.nasm,
+   userspace builds set EFIUSER_SIMD when they assemble it */
+#if defined(MDE_CPU_X64) && (!defined(EFIUSER) || defined(EFIUSER_SIMD))
+#  define OC_ZLIB_SIMD
+#endif
+
+#ifdef OC_ZLIB_SIMD
+#  define OC_ZLIB_SIMD_SSSE3     1U
+#  define OC_ZLIB_SIMD_PCLMULQDQ 2U
+   unsigned ZLIB_INTERNAL oc_zlib_simd_features OF((void));
+   UINT32 EFIAPI InternalAdler32Ssse3 OF((UINT32 Adler, CONST UINT8 *Buf,
+                                          UINTN Blocks));
+   UINT32 EFIAPI InternalCrc32Pclmul OF((UINT32 Crc, CONST UINT8 *Buf,
+                                         UINTN Len));
+#endif
+
 /* Diagnostic functions */
 #ifdef ZLIB_DEBUG
 #  include <stdio.h>
@@ -450,6 +450,8 @@ OC_SCHEMA
   OC_SCHEMA_INTEGER_IN ("ExposeSensitiveData",  OC_GLOBAL_CONFIG, Misc.Security.ExposeSensitiveData),
   OC_SCHEMA_INTEGER_IN ("HaltLevel",            OC_GLOBAL_CONFIG, Misc.Security.HaltLevel),
   OC_SCHEMA_DATAF_IN ("PasswordHash",           OC_GLOBAL_CONFIG, Misc.Security.PasswordHash),
+  OC_SCHEMA_INTEGER_IN ("PasswordIterations",   OC_GLOBAL_CONFIG, Misc.Security.PasswordIterations),
+  OC_SCHEMA_INTEGER_IN ("PasswordLanes",        OC_GLOBAL_CONFIG, Misc.Security.PasswordLanes),
   OC_SCHEMA_DATA_IN ("PasswordSalt",            OC_GLOBAL_CONFIG, Misc.Security.PasswordSalt),
   OC_SCHEMA_INTEGER_IN ("ScanPolicy",           OC_GLOBAL_CONFIG, Misc.Security.ScanPolicy),
   OC_SCHEMA_STRING_IN ("SecureBootModel",       OC_GLOBAL_CONFIG, Misc.Security.SecureBootModel),
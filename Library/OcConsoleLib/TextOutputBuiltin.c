@@ -66,9 +66,42 @@ STATIC UINT8                                mUIScale;
 STATIC UINT8                                mFontScale;
 STATIC EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION  mBackgroundColor;
 STATIC EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION  mForegroundColor;
+STATIC UINT8                                mConsoleAttribute;
 STATIC EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION  *mCharacterBuffer;
 STATIC EFI_CONSOLE_CONTROL_SCREEN_MODE      mConsoleMode = EfiConsoleControlScreenText;
 
+///
+/// Columns of a text row, which changed since last flush.
+///
+typedef struct {
+  UINT32    Start; ///< First changed column.
+  UINT32    End;   ///< Column past last changed one, 0 when unchanged.
+} CONSOLE_DIRTY_ROW;
+
+///
+/// Character cell of the console shadow.
+///
+typedef struct {
+  CHAR16    Char;      ///< Character code, 0 for an empty cell.
+  UINT8     Attribute; ///< Text attribute the character was written with.
+  UINT8     Cursor;    ///< Cursor colour index with CONSOLE_CURSOR_DRAWN, 0 without cursor.
+} CONSOLE_CELL;
+
+#define CONSOLE_CURSOR_DRAWN  BIT7
+
+//
+// System memory copy of console characters. Rows form a ring buffer starting at
+// mShadowTop, so that scrolling does not move any cells. Changed cells of a row
+// are rendered into mShadowRowBuffer, which holds one text row of pixels.
+//
+STATIC CONSOLE_CELL                         *mShadowCells;
+STATIC EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION  *mShadowRowBuffer;
+STATIC CONSOLE_DIRTY_ROW                    *mShadowDirtyRows;
+STATIC UINTN                                mShadowStride;
+STATIC UINTN                                mShadowTop;
+STATIC UINTN                                mShadowUsedWidth;
+STATIC BOOLEAN                              mShadowDirty;
+
 #define TGT_CHAR_WIDTH     ((UINTN)(ISO_CHAR_WIDTH) * mFontScale)
 #define TGT_CHAR_HEIGHT    ((UINTN)(ISO_CHAR_HEIGHT) * mFontScale)
 #define TGT_CHAR_AREA      ((TGT_CHAR_WIDTH) * (TGT_CHAR_HEIGHT))
@@ -184,21 +217,80 @@ OcConsoleFontContainsChar (
 }
 
 /**
-  Render character onscreen.
+  Get shadow cell for character position.
 
-  @param[in]  Char  Character code.
   @param[in]  PosX  Character X position.
   @param[in]  PosY  Character Y position.
+
+  @retval Shadow cell of the character.
+**/
+STATIC
+CONSOLE_CELL *
+GetShadowCell (
+  IN UINTN  PosX,
+  IN UINTN  PosY
+  )
+{
+  PosY += mShadowTop;
+  if (PosY >= mConsoleHeight) {
+    PosY -= mConsoleHeight;
+  }
+
+  return &mShadowCells[PosY * mConsoleWidth + PosX];
+}
+
+/**
+  Mark characters in shadow buffer as needing flush.
+
+  @param[in]  PosX   Character X position.
+  @param[in]  PosY   Character Y position.
+  @param[in]  Count  Number of characters.
 **/
 STATIC
 VOID
-RenderChar (
-  IN CHAR16  Char,
-  IN UINTN   PosX,
-  IN UINTN   PosY
+MarkShadowDirty (
+  IN UINTN  PosX,
+  IN UINTN  PosY,
+  IN UINTN  Count
+  )
+{
+  CONSOLE_DIRTY_ROW  *Row;
+
+  Row = &mShadowDirtyRows[PosY];
+  if (Row->End == 0) {
+    Row->Start = (UINT32)PosX;
+    Row->End   = (UINT32)(PosX + Count);
+  } else {
+    Row->Start = MIN (Row->Start, (UINT32)PosX);
+    Row->End   = MAX (Row->End, (UINT32)(PosX + Count));
+  }
+
+  mShadowUsedWidth = MAX (mShadowUsedWidth, PosX + Count);
+  mShadowDirty     = TRUE;
+}
+
+/**
+  Render character glyph into pixel buffer.
+
+  @param[in]  Char        Character code.
+  @param[in]  Foreground  Foreground colour.
+  @param[in]  Background  Background colour.
+  @param[out] DstBuffer   Top left pixel of the character.
+  @param[in]  DstStride   Pixels per buffer line.
+
+  @retval EFI_SUCCESS  The glyph was rendered.
+  @retval other        Nothing was rendered.
+**/
+STATIC
+EFI_STATUS
+DrawChar (
+  IN  CHAR16  Char,
+  IN  UINT32  Foreground,
+  IN  UINT32  Background,
+  OUT UINT32  *DstBuffer,
+  IN  UINTN   DstStride
   )
 {
-  UINT32                *DstBuffer;
   UINT8                 *SrcBuffer;
   OC_CONSOLE_FONT_PAGE  *Page;
   UINT8                 Line;
@@ -211,12 +303,10 @@ RenderChar (
   BOOLEAN               LeftToRight;
   EFI_STATUS            Status;
 
-  DstBuffer = &mCharacterBuffer[0].Raw;
-
   Status = GetConsoleFontCharInfo (mConsoleFont, Char, &Page, &GlyphIndex, TRUE);
 
   if (EFI_ERROR (Status)) {
-    return;
+    return Status;
   }
 
   FontHead    = Page->FontHead;
@@ -226,11 +316,10 @@ RenderChar (
   SrcBuffer = Page->Glyphs + ((GlyphIndex - 1) * (ISO_CHAR_HEIGHT - FontHead - FontTail));
 
   for (Line = 0; Line < FontHead; ++Line) {
-    //
-    // Apply scale twice, for width and height.
-    //
-    SetMem32 (DstBuffer, TGT_CHAR_WIDTH * mFontScale * sizeof (DstBuffer[0]), mBackgroundColor.Raw);
-    DstBuffer += TGT_CHAR_WIDTH * mFontScale;
+    for (Index = 0; Index < mFontScale; ++Index) {
+      SetMem32 (DstBuffer, TGT_CHAR_WIDTH * sizeof (DstBuffer[0]), Background);
+      DstBuffer += DstStride;
+    }
   }
 
   for ( ; Line < ISO_CHAR_HEIGHT - FontTail; ++Line) {
@@ -241,7 +330,7 @@ RenderChar (
       Mask = LeftToRight ? 0x80 : 1;
       do {
         for (Index2 = 0; Index2 < mFontScale; ++Index2) {
-          *DstBuffer = (*SrcBuffer & Mask) ? mForegroundColor.Raw : mBackgroundColor.Raw;
+          *DstBuffer = (*SrcBuffer & Mask) ? Foreground : Background;
           ++DstBuffer;
         }
 
@@ -251,17 +340,244 @@ RenderChar (
           Mask <<= 1U;
         }
       } while (Mask != 0);
+
+      DstBuffer += DstStride - TGT_CHAR_WIDTH;
     }
 
     ++SrcBuffer;
   }
 
   for ( ; Line < ISO_CHAR_HEIGHT; ++Line) {
-    SetMem32 (DstBuffer, TGT_CHAR_WIDTH * mFontScale * sizeof (DstBuffer[0]), mBackgroundColor.Raw);
-    DstBuffer += TGT_CHAR_WIDTH * mFontScale;
+    for (Index = 0; Index < mFontScale; ++Index) {
+      SetMem32 (DstBuffer, TGT_CHAR_WIDTH * sizeof (DstBuffer[0]), Background);
+      DstBuffer += DstStride;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Check whether character glyph covers the top left cursor pixel.
+
+  @param[in]  Char  Character code, 0 for an empty cell.
+
+  @retval TRUE when the pixel has foreground colour.
+**/
+STATIC
+BOOLEAN
+IsCursorPixelSet (
+  IN CHAR16  Char
+  )
+{
+  EFI_STATUS            Status;
+  OC_CONSOLE_FONT_PAGE  *Page;
+  UINT8                 GlyphIndex;
+  UINT8                 Line;
+  UINT8                 Glyph;
+
+  if (Char == 0) {
+    return FALSE;
+  }
+
+  Status = GetConsoleFontCharInfo (mConsoleFont, Char, &Page, &GlyphIndex, TRUE);
+  if (EFI_ERROR (Status)) {
+    return FALSE;
+  }
+
+  //
+  // Cursor starts at the second column of the last font line.
+  //
+  Line = ISO_CHAR_HEIGHT - 1;
+  if ((Line < Page->FontHead) || (Line >= ISO_CHAR_HEIGHT - Page->FontTail)) {
+    return FALSE;
+  }
+
+  Glyph = Page->Glyphs[(GlyphIndex - 1) * (ISO_CHAR_HEIGHT - Page->FontHead - Page->FontTail) + Line - Page->FontHead];
+  return (Glyph & (Page->LeftToRight ? 0x40 : 0x02)) != 0;
+}
+
+/**
+  Render shadow cell into pixel buffer.
+
+  @param[in]  Cell       Shadow cell.
+  @param[out] DstBuffer  Top left pixel of the character.
+  @param[in]  DstStride  Pixels per buffer line.
+**/
+STATIC
+VOID
+DrawCell (
+  IN  CONST CONSOLE_CELL  *Cell,
+  OUT UINT32              *DstBuffer,
+  IN  UINTN               DstStride
+  )
+{
+  UINT32      Background;
+  EFI_STATUS  Status;
+  UINTN       Line;
+
+  Background = mGraphicsEfiColors[BitFieldRead32 (Cell->Attribute, 4, 6)];
+
+  Status = EFI_NOT_FOUND;
+  if (Cell->Char != 0) {
+    Status = DrawChar (
+               Cell->Char,
+               mGraphicsEfiColors[BitFieldRead32 (Cell->Attribute, 0, 3)],
+               Background,
+               DstBuffer,
+               DstStride
+               );
+  }
+
+  if (EFI_ERROR (Status)) {
+    for (Line = 0; Line < TGT_CHAR_HEIGHT; ++Line) {
+      SetMem32 (&DstBuffer[Line * DstStride], TGT_CHAR_WIDTH * sizeof (DstBuffer[0]), Background);
+    }
+  }
+
+  if ((Cell->Cursor & CONSOLE_CURSOR_DRAWN) != 0) {
+    DstBuffer += TGT_CURSOR_Y * DstStride + TGT_CURSOR_X;
+    for (Line = 0; Line < TGT_CURSOR_HEIGHT; ++Line) {
+      SetMem32 (DstBuffer, TGT_CURSOR_WIDTH * sizeof (DstBuffer[0]), mGraphicsEfiColors[Cell->Cursor & 0xF]);
+      DstBuffer += DstStride;
+    }
+  }
+}
+
+/**
+  Write changed shadow cells onscreen, one text row at a time. Nothing is
+  written while the console does not own the screen in graphics mode, the
+  changes are kept until the next flush in text mode.
+**/
+STATIC
+VOID
+FlushShadow (
+  VOID
+  )
+{
+  UINTN              PosX;
+  UINTN              PosY;
+  CONSOLE_CELL       *Cells;
+  CONSOLE_DIRTY_ROW  *Row;
+
+  if (!mShadowDirty || (mConsoleMode != EfiConsoleControlScreenText)) {
+    return;
+  }
+
+  for (PosY = 0; PosY < mConsoleHeight; ++PosY) {
+    Row = &mShadowDirtyRows[PosY];
+    if (Row->End == 0) {
+      continue;
+    }
+
+    Cells = GetShadowCell (0, PosY);
+    for (PosX = Row->Start; PosX < Row->End; ++PosX) {
+      DrawCell (&Cells[PosX], &mShadowRowBuffer[PosX * TGT_CHAR_WIDTH].Raw, mShadowStride);
+    }
+
+    mGraphicsOutput->Blt (
+                       mGraphicsOutput,
+                       &mShadowRowBuffer[0].Pixel,
+                       EfiBltBufferToVideo,
+                       Row->Start * TGT_CHAR_WIDTH,
+                       0,
+                       TGT_PADD_WIDTH  + Row->Start * TGT_CHAR_WIDTH,
+                       TGT_PADD_HEIGHT + PosY * TGT_CHAR_HEIGHT,
+                       (Row->End - Row->Start) * TGT_CHAR_WIDTH,
+                       TGT_CHAR_HEIGHT,
+                       mShadowStride * sizeof (mShadowRowBuffer[0])
+                       );
+
+    Row->End = 0;
+  }
+
+  mShadowDirty = FALSE;
+}
+
+/**
+  Empty shadow cells of one text row.
+
+  @param[in]  PosY  Character Y position.
+**/
+STATIC
+VOID
+ClearShadowRow (
+  IN UINTN  PosY
+  )
+{
+  CONSOLE_CELL  *Cells;
+  UINTN         PosX;
+
+  Cells = GetShadowCell (0, PosY);
+  for (PosX = 0; PosX < mConsoleWidth; ++PosX) {
+    Cells[PosX].Char      = 0;
+    Cells[PosX].Attribute = mConsoleAttribute;
+    Cells[PosX].Cursor    = 0;
+  }
+}
+
+/**
+  Empty all shadow cells with background colour and forget pending changes.
+**/
+STATIC
+VOID
+ResetShadow (
+  VOID
+  )
+{
+  UINTN  PosY;
+
+  mShadowTop = 0;
+  for (PosY = 0; PosY < mConsoleHeight; ++PosY) {
+    ClearShadowRow (PosY);
+  }
+
+  ZeroMem (mShadowDirtyRows, mConsoleHeight * sizeof (mShadowDirtyRows[0]));
+  mShadowUsedWidth = 0;
+  mShadowDirty     = FALSE;
+}
+
+/**
+  Render character onscreen.
+
+  @param[in]  Char  Character code.
+  @param[in]  PosX  Character X position.
+  @param[in]  PosY  Character Y position.
+**/
+STATIC
+VOID
+RenderChar (
+  IN CHAR16  Char,
+  IN UINTN   PosX,
+  IN UINTN   PosY
+  )
+{
+  EFI_STATUS    Status;
+  CONSOLE_CELL  *Cell;
+
+  //
+  // Only remember the character when we have a shadow, it is rendered on flush.
+  // Otherwise render it into a single character buffer and write it onscreen.
+  //
+  if (mShadowCells != NULL) {
+    Cell            = GetShadowCell (PosX, PosY);
+    Cell->Char      = Char;
+    Cell->Attribute = mConsoleAttribute;
+    Cell->Cursor    = 0;
+    MarkShadowDirty (PosX, PosY, 1);
+    return;
   }
 
-  ASSERT (DstBuffer - &mCharacterBuffer[0].Raw == (INTN)TGT_CHAR_AREA);
+  Status = DrawChar (
+             Char,
+             mForegroundColor.Raw,
+             mBackgroundColor.Raw,
+             &mCharacterBuffer[0].Raw,
+             TGT_CHAR_WIDTH
+             );
+  if (EFI_ERROR (Status)) {
+    return;
+  }
 
   mGraphicsOutput->Blt (
                      mGraphicsOutput,
@@ -294,6 +610,7 @@ FlushCursor (
 {
   EFI_STATUS                           Status;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION  Colour;
+  CONSOLE_CELL                         *Cell;
 
   if (!Enabled || (mConsoleMode != EfiConsoleControlScreenText)) {
     return;
@@ -309,6 +626,30 @@ FlushCursor (
   // This is weird but EDK II implementation seems to match the logic, and as a result we
   // track cursor visibility or easily optimise this logic.
   //
+  if (mShadowCells != NULL) {
+    //
+    // Avoid reading back from VRAM, which is very slow with write-combining,
+    // and compute the current cursor pixel colour from the cell instead.
+    //
+    Cell = GetShadowCell (PosX, PosY);
+    if ((Cell->Cursor & CONSOLE_CURSOR_DRAWN) != 0) {
+      Colour.Raw = mGraphicsEfiColors[Cell->Cursor & 0xF];
+    } else if (IsCursorPixelSet (Cell->Char)) {
+      Colour.Raw = mGraphicsEfiColors[BitFieldRead32 (Cell->Attribute, 0, 3)];
+    } else {
+      Colour.Raw = mGraphicsEfiColors[BitFieldRead32 (Cell->Attribute, 4, 6)];
+    }
+
+    if (Colour.Raw == mForegroundColor.Raw) {
+      Cell->Cursor = (UINT8)(CONSOLE_CURSOR_DRAWN | BitFieldRead32 (mConsoleAttribute, 4, 6));
+    } else {
+      Cell->Cursor = (UINT8)(CONSOLE_CURSOR_DRAWN | BitFieldRead32 (mConsoleAttribute, 0, 3));
+    }
+
+    MarkShadowDirty (PosX, PosY, 1);
+    return;
+  }
+
   Status = mGraphicsOutput->Blt (
                               mGraphicsOutput,
                               &Colour.Pixel,
@@ -347,6 +688,29 @@ RenderScroll (
   )
 {
   UINTN  Width;
+  UINTN  PosY;
+
+  if (mShadowCells != NULL) {
+    //
+    // Old top row becomes the new bottom row, so just erase it. All rows are
+    // then written onscreen on next flush, which avoids slow VRAM reads.
+    //
+    ClearShadowRow (0);
+
+    ++mShadowTop;
+    if (mShadowTop == mConsoleHeight) {
+      mShadowTop = 0;
+    }
+
+    Width = MAX (mShadowUsedWidth, mConsoleMaxPosX + 1);
+    for (PosY = 0; PosY < mConsoleHeight; ++PosY) {
+      mShadowDirtyRows[PosY].Start = 0;
+      mShadowDirtyRows[PosY].End   = (UINT32)Width;
+    }
+
+    mShadowDirty = TRUE;
+    return;
+  }
 
   //
   // Move used screen region.
@@ -410,6 +774,15 @@ RenderResync (
     FreePool (mCharacterBuffer);
   }
 
+  if (mShadowCells != NULL) {
+    FreePool (mShadowCells);
+    FreePool (mShadowRowBuffer);
+    FreePool (mShadowDirtyRows);
+    mShadowCells     = NULL;
+    mShadowRowBuffer = NULL;
+    mShadowDirtyRows = NULL;
+  }
+
   //
   // Reset font scale and allocate for target size - may be over-allocated if we have to override below.
   //
@@ -457,6 +830,35 @@ RenderResync (
   mPrivateColumn           = mPrivateRow = 0;
   This->Mode->CursorColumn = This->Mode->CursorRow = 0;
 
+  //
+  // Shadow buffer is optional, and we can still render char by char without it.
+  //
+  mShadowStride    = mConsoleWidth * TGT_CHAR_WIDTH;
+  mShadowCells     = AllocatePool (mConsoleWidth * mConsoleHeight * sizeof (mShadowCells[0]));
+  mShadowRowBuffer = AllocatePool (mShadowStride * TGT_CHAR_HEIGHT * sizeof (mShadowRowBuffer[0]));
+  mShadowDirtyRows = AllocatePool (mConsoleHeight * sizeof (mShadowDirtyRows[0]));
+  if ((mShadowCells == NULL) || (mShadowRowBuffer == NULL) || (mShadowDirtyRows == NULL)) {
+    DEBUG ((DEBUG_INFO, "OCC: No shadow buffer for %ux%u console\n", (UINT32)mConsoleWidth, (UINT32)mConsoleHeight));
+    if (mShadowCells != NULL) {
+      FreePool (mShadowCells);
+      mShadowCells = NULL;
+    }
+
+    if (mShadowRowBuffer != NULL) {
+      FreePool (mShadowRowBuffer);
+      mShadowRowBuffer = NULL;
+    }
+
+    if (mShadowDirtyRows != NULL) {
+      FreePool (mShadowDirtyRows);
+      mShadowDirtyRows = NULL;
+    }
+
+    mShadowDirty = FALSE;
+  } else {
+    ResetShadow ();
+  }
+
   //
   // Avoid rendering any console content when in graphics mode.
   //
@@ -510,6 +912,7 @@ AsciiTextResetEx (
 
   This->Mode->MaxMode   = 1;
   This->Mode->Attribute = ARRAY_SIZE (mGraphicsEfiColors) / 2 - 1;
+  mConsoleAttribute     = (UINT8)This->Mode->Attribute;
   mBackgroundColor.Raw  = mGraphicsEfiColors[0];
   mForegroundColor.Raw  = mGraphicsEfiColors[ARRAY_SIZE (mGraphicsEfiColors) / 2 - 1];
 
@@ -646,6 +1049,7 @@ AsciiTextOutputString (
   }
 
   FlushCursor (This->Mode->CursorVisible, This->Mode->CursorColumn, This->Mode->CursorRow);
+  FlushShadow ();
 
   mPrivateColumn = (UINTN)This->Mode->CursorColumn;
   mPrivateRow    = (UINTN)This->Mode->CursorRow;
@@ -775,9 +1179,11 @@ AsciiTextSetAttribute (
 
     mForegroundColor.Raw  = mGraphicsEfiColors[FgColor];
     mBackgroundColor.Raw  = mGraphicsEfiColors[BgColor];
+    mConsoleAttribute     = (UINT8)Attribute;
     This->Mode->Attribute = (UINT32)Attribute;
 
     FlushCursor (This->Mode->CursorVisible, mPrivateColumn, mPrivateRow);
+    FlushShadow ();
   }
 
   gBS->RestoreTPL (OldTpl);
@@ -821,6 +1227,13 @@ AsciiTextClearScreen (
       return EFI_DEVICE_ERROR;
     }
   } else {
+    //
+    // Screen areas we do not clear below hold no text of ours.
+    //
+    if (mShadowCells != NULL) {
+      ResetShadow ();
+    }
+
     //
     // When controlled, we assume that only text which we rendered needs to be cleared.
     // When marked uncontrolled anyone may have put content (in particular, graphics) anywhere
@@ -873,6 +1286,7 @@ AsciiTextClearScreen (
   mPrivateColumn           = mPrivateRow = 0;
   This->Mode->CursorColumn = This->Mode->CursorRow = 0;
   FlushCursor (This->Mode->CursorVisible, mPrivateColumn, mPrivateRow);
+  FlushShadow ();
 
   //
   // After clear screen, shell may scroll through old text via page up/down buttons,
@@ -929,6 +1343,7 @@ AsciiTextSetCursorPosition (
     This->Mode->CursorColumn = (INT32)mPrivateColumn;
     This->Mode->CursorRow    = (INT32)mPrivateRow;
     FlushCursor (This->Mode->CursorVisible, mPrivateColumn, mPrivateRow);
+    FlushShadow ();
     mConsoleMaxPosX = MAX (mConsoleMaxPosX, Column);
     mConsoleMaxPosY = MAX (mConsoleMaxPosY, Row);
     Status          = EFI_SUCCESS;
@@ -964,6 +1379,7 @@ AsciiTextEnableCursor (
   FlushCursor (This->Mode->CursorVisible, mPrivateColumn, mPrivateRow);
   This->Mode->CursorVisible = Visible;
   FlushCursor (This->Mode->CursorVisible, mPrivateColumn, mPrivateRow);
+  FlushShadow ();
   gBS->RestoreTPL (OldTpl);
   return EFI_SUCCESS;
 }
@@ -33,6 +33,35 @@ BigNumWordMul64 (
   IN  OC_BN_WORD  B
   );
 
+#ifdef MDE_CPU_X64
+
+/**
+  Calculates a row of the Montgomery product of A and B mod N with 64-bit
+  Words. Both the multiplication and the reduction steps are fused into
+  a single pass over the Words of B and N.
+
+  @param[in,out] Result    The result buffer.
+  @param[in]     NumWords  The number of Words of Result, B and N.
+  @param[in]     AWord     The current row's Word of the multiplicant.
+  @param[in]     B         The multiplier.
+  @param[in]     N         The modulus.
+  @param[in]     N0Inv     The Montgomery Inverse of N.
+
+  @returns  Whether Result has wrapped around and must be reduced by N.
+
+**/
+BOOLEAN
+BigNumMontMulRow64 (
+  IN OUT OC_BN_WORD        *Result,
+  IN     OC_BN_NUM_WORDS   NumWords,
+  IN     OC_BN_WORD        AWord,
+  IN     CONST OC_BN_WORD  *B,
+  IN     CONST OC_BN_WORD  *N,
+  IN     OC_BN_WORD        N0Inv
+  );
+
+#endif
+
 /**
   Calculates the product of A and B.
 
@@ -298,6 +298,16 @@ BigNumMontMulRow (
   IN     OC_BN_WORD        N0Inv
   )
 {
+ #ifdef MDE_CPU_X64
+  //
+  // Use the fused 64-bit implementation, which keeps all carries in
+  // registers instead of calling out for every Word multiplication.
+  //
+  if (BigNumMontMulRow64 (Result, NumWords, AWord, B, N, N0Inv)) {
+    BigNumSub (Result, NumWords, Result, N);
+  }
+
+ #else
   UINTN  CompIndex;
 
   OC_BN_WORD  CCurMulHi;
@@ -311,6 +321,7 @@ BigNumMontMulRow (
   ASSERT (B != NULL);
   ASSERT (N != NULL);
   ASSERT (N0Inv != 0);
+
   //
   // Standard multiplication
   // C = C + A*B
@@ -382,6 +393,8 @@ BigNumMontMulRow (
     //
     BigNumSub (Result, NumWords, Result, N);
   }
+
+ #endif
 }
 
 /**
@@ -18,6 +18,48 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
   #pragma intrinsic(_umul128)
 #endif
 
+/**
+  Calculates the sum of C, D and the product of A and B.
+  The result always fits two Words.
+
+  @param[out] Hi  Buffer in which the high Word of the result is returned.
+  @param[in]  A   The multiplicant.
+  @param[in]  B   The multiplier.
+  @param[in]  C   The first addend.
+  @param[in]  D   The second addend.
+
+  @returns  The low Word of the result.
+
+**/
+STATIC
+OC_BN_WORD
+InternalWordMulAdd2 (
+  OUT OC_BN_WORD  *Hi,
+  IN  OC_BN_WORD  A,
+  IN  OC_BN_WORD  B,
+  IN  OC_BN_WORD  C,
+  IN  OC_BN_WORD  D
+  )
+{
+ #if !defined (_MSC_VER) || defined (__clang__)
+  unsigned __int128  Result = (unsigned __int128)A * B + C + D;
+  *Hi = (OC_BN_WORD)(Result >> OC_BN_WORD_NUM_BITS);
+  return (OC_BN_WORD)Result;
+ #else
+  OC_BN_WORD  ResHi;
+  OC_BN_WORD  ResLo;
+
+  ResLo  = _umul128 (A, B, &ResHi);
+  ResLo += C;
+  ResHi += ResLo < C;
+  ResLo += D;
+  ResHi += ResLo < D;
+
+  *Hi = ResHi;
+  return ResLo;
+ #endif
+}
+
 OC_BN_WORD
 BigNumWordMul64 (
   OUT OC_BN_WORD  *Hi,
@@ -43,3 +85,42 @@ BigNumWordMul64 (
   return _umul128 (A, B, Hi);
  #endif
 }
+
+BOOLEAN
+BigNumMontMulRow64 (
+  IN OUT OC_BN_WORD        *Result,
+  IN     OC_BN_NUM_WORDS   NumWords,
+  IN     OC_BN_WORD        AWord,
+  IN     CONST OC_BN_WORD  *B,
+  IN     CONST OC_BN_WORD  *N,
+  IN     OC_BN_WORD        N0Inv
+  )
+{
+  UINTN       CompIndex;
+  OC_BN_WORD  MulHi;
+  OC_BN_WORD  MulLo;
+  OC_BN_WORD  MontHi;
+  OC_BN_WORD  TFirst;
+  OC_BN_WORD  Top;
+
+  ASSERT (OC_BN_WORD_SIZE == sizeof (UINT64));
+  ASSERT (Result != NULL);
+  ASSERT (NumWords > 0);
+  ASSERT (B != NULL);
+  ASSERT (N != NULL);
+  ASSERT (N0Inv != 0);
+
+  MulLo  = InternalWordMulAdd2 (&MulHi, AWord, B[0], Result[0], 0);
+  TFirst = MulLo * N0Inv;
+  InternalWordMulAdd2 (&MontHi, TFirst, N[0], MulLo, 0);
+
+  for (CompIndex = 1; CompIndex < NumWords; ++CompIndex) {
+    MulLo                 = InternalWordMulAdd2 (&MulHi, AWord, B[CompIndex], Result[CompIndex], MulHi);
+    Result[CompIndex - 1] = InternalWordMulAdd2 (&MontHi, TFirst, N[CompIndex], MulLo, MontHi);
+  }
+
+  Top                   = MulHi + MontHi;
+  Result[CompIndex - 1] = Top;
+
+  return Top < MulHi;
+}
@@ -12,6 +12,25 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 **/
 
 #include "CryptoInternal.h"
+#include "Sha2Internal.h"
+
+#include <Library/OcParallelLib.h>
+
+///
+/// Multi-lane PBKDF2 job state shared by all lanes.
+///
+typedef struct {
+  //
+  // HMAC states after absorbing the inner and outer padded key.
+  //
+  UINT64    Inner[8];
+  UINT64    Outer[8];
+  //
+  // First PBKDF2 block of every lane on input, final block on output.
+  //
+  UINT64    Lanes[OC_PASSWORD_MAX_LANES][8];
+  UINT32    Iterations;
+} PASSWORD_PBKDF2_JOB;
 
 VOID
 OcHashPasswordSha512 (
@@ -86,3 +105,233 @@ OcVerifyPasswordSha512 (
 
   return Result;
 }
+
+/**
+  Compute one HMAC-SHA512 round of a 64-byte message with precomputed states.
+
+  @param[in]     Job       PBKDF2 job with HMAC states.
+  @param[in,out] Block     Padded message block, the first 64 bytes are used.
+  @param[in,out] Value     Message on input, HMAC value on output.
+  @param[in]     UseAccel  Whether accelerated transform may be used.
+**/
+STATIC
+VOID
+InternalPbkdf2HmacRound (
+  IN     CONST PASSWORD_PBKDF2_JOB  *Job,
+  IN OUT UINT8                      *Block,
+  IN OUT UINT64                     *Value,
+  IN     BOOLEAN                    UseAccel
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < 8; ++Index) {
+    WriteUnaligned64 ((UINT64 *)&Block[Index * sizeof (UINT64)], SwapBytes64 (Value[Index]));
+  }
+
+  CopyMem (Value, Job->Inner, sizeof (Job->Inner));
+  if (UseAccel) {
+    Sha512TransformAccel (Value, Block, 1);
+  } else {
+    Sha512Transform (Value, Block, 1);
+  }
+
+  for (Index = 0; Index < 8; ++Index) {
+    WriteUnaligned64 ((UINT64 *)&Block[Index * sizeof (UINT64)], SwapBytes64 (Value[Index]));
+  }
+
+  CopyMem (Value, Job->Outer, sizeof (Job->Outer));
+  if (UseAccel) {
+    Sha512TransformAccel (Value, Block, 1);
+  } else {
+    Sha512Transform (Value, Block, 1);
+  }
+}
+
+/**
+  Iterate a single PBKDF2 lane.
+
+  @param[in,out] Context   PBKDF2 job.
+  @param[in]     Index     Lane index.
+  @param[in]     Worker    Worker index.
+**/
+STATIC
+VOID
+EFIAPI
+InternalPbkdf2Lane (
+  IN OUT VOID   *Context,
+  IN     UINTN  Index,
+  IN     UINTN  Worker
+  )
+{
+  PASSWORD_PBKDF2_JOB  *Job;
+  UINT8                Block[SHA512_BLOCK_SIZE];
+  UINT64               Value[8];
+  UINT64               *Result;
+  UINT32               Iteration;
+  UINTN                Word;
+  BOOLEAN              UseAccel;
+
+  Job    = Context;
+  Result = Job->Lanes[Index];
+
+  //
+  // AVX state is only enabled on the bootstrap processor, which runs worker 0.
+  //
+  UseAccel = mIsAccelEnabled && Worker == 0;
+
+  //
+  // Both HMAC hashes process one block of a 64-byte digest after the
+  // 128-byte key block, so the padding and the length are constant.
+  //
+  ZeroMem (Block, sizeof (Block));
+  Block[SHA512_DIGEST_SIZE]    = 0x80;
+  Block[SHA512_BLOCK_SIZE - 2] = ((SHA512_BLOCK_SIZE + SHA512_DIGEST_SIZE) * 8) >> 8U;
+  Block[SHA512_BLOCK_SIZE - 1] = (UINT8)((SHA512_BLOCK_SIZE + SHA512_DIGEST_SIZE) * 8);
+
+  CopyMem (Value, Result, sizeof (Value));
+  for (Iteration = 1; Iteration < Job->Iterations; ++Iteration) {
+    InternalPbkdf2HmacRound (Job, Block, Value, UseAccel);
+    for (Word = 0; Word < ARRAY_SIZE (Value); ++Word) {
+      Result[Word] ^= Value[Word];
+    }
+  }
+
+  SecureZeroMem (Block, sizeof (Block));
+  SecureZeroMem (Value, sizeof (Value));
+}
+
+VOID
+OcHashPasswordPbkdf2Sha512 (
+  IN  CONST UINT8  *Password,
+  IN  UINT32       PasswordSize,
+  IN  CONST UINT8  *Salt,
+  IN  UINT32       SaltSize,
+  IN  UINT32       Iterations,
+  IN  UINT32       Lanes,
+  OUT UINT8        *Hash
+  )
+{
+  PASSWORD_PBKDF2_JOB  Job;
+  SHA512_CONTEXT       InnerContext;
+  SHA512_CONTEXT       OuterContext;
+  SHA512_CONTEXT       ShaContext;
+  UINT8                Key[SHA512_BLOCK_SIZE];
+  UINT8                Digest[SHA512_DIGEST_SIZE];
+  UINT8                LaneIndex[sizeof (UINT32)];
+  UINT32               Lane;
+  UINTN                Index;
+
+  ASSERT (Password != NULL);
+  ASSERT (Hash != NULL);
+  ASSERT (Iterations > 0);
+  ASSERT (Lanes > 0 && Lanes <= OC_PASSWORD_MAX_LANES);
+
+  //
+  // Derive HMAC key states once, so that every iteration only needs
+  // two block transforms.
+  //
+  ZeroMem (Key, sizeof (Key));
+  if (PasswordSize > SHA512_BLOCK_SIZE) {
+    Sha512 (Key, Password, PasswordSize);
+  } else {
+    CopyMem (Key, Password, PasswordSize);
+  }
+
+  for (Index = 0; Index < sizeof (Key); ++Index) {
+    Key[Index] ^= 0x36;
+  }
+
+  Sha512Init (&InnerContext);
+  Sha512Update (&InnerContext, Key, sizeof (Key));
+
+  for (Index = 0; Index < sizeof (Key); ++Index) {
+    Key[Index] ^= 0x36 ^ 0x5C;
+  }
+
+  Sha512Init (&OuterContext);
+  Sha512Update (&OuterContext, Key, sizeof (Key));
+
+  CopyMem (Job.Inner, InnerContext.State, sizeof (Job.Inner));
+  CopyMem (Job.Outer, OuterContext.State, sizeof (Job.Outer));
+  Job.Iterations = Iterations;
+
+  //
+  // The first block of every lane is U1 = HMAC (Password, Salt || INT (Lane + 1)).
+  // It is computed here as Salt may have any size.
+  //
+  for (Lane = 0; Lane < Lanes; ++Lane) {
+    LaneIndex[0] = (UINT8)((Lane + 1) >> 24U);
+    LaneIndex[1] = (UINT8)((Lane + 1) >> 16U);
+    LaneIndex[2] = (UINT8)((Lane + 1) >> 8U);
+    LaneIndex[3] = (UINT8)(Lane + 1);
+
+    CopyMem (&ShaContext, &InnerContext, sizeof (ShaContext));
+    Sha512Update (&ShaContext, Salt, SaltSize);
+    Sha512Update (&ShaContext, LaneIndex, sizeof (LaneIndex));
+    Sha512Final (&ShaContext, Digest);
+
+    CopyMem (&ShaContext, &OuterContext, sizeof (ShaContext));
+    Sha512Update (&ShaContext, Digest, sizeof (Digest));
+    Sha512Final (&ShaContext, Digest);
+
+    for (Index = 0; Index < ARRAY_SIZE (Job.Lanes[Lane]); ++Index) {
+      Job.Lanes[Lane][Index] = SwapBytes64 (ReadUnaligned64 ((UINT64 *)&Digest[Index * sizeof (UINT64)]));
+    }
+  }
+
+  OcParallelFor (InternalPbkdf2Lane, &Job, Lanes, 0);
+
+  for (Lane = 1; Lane < Lanes; ++Lane) {
+    for (Index = 0; Index < ARRAY_SIZE (Job.Lanes[0]); ++Index) {
+      Job.Lanes[0][Index] ^= Job.Lanes[Lane][Index];
+    }
+  }
+
+  for (Index = 0; Index < ARRAY_SIZE (Job.Lanes[0]); ++Index) {
+    WriteUnaligned64 ((UINT64 *)&Hash[Index * sizeof (UINT64)], SwapBytes64 (Job.Lanes[0][Index]));
+  }
+
+  SecureZeroMem (&Job, sizeof (Job));
+  SecureZeroMem (&InnerContext, sizeof (InnerContext));
+  SecureZeroMem (&OuterContext, sizeof (OuterContext));
+  SecureZeroMem (&ShaContext, sizeof (ShaContext));
+  SecureZeroMem (Key, sizeof (Key));
+  SecureZeroMem (Digest, sizeof (Digest));
+}
+
+BOOLEAN
+OcVerifyPasswordPbkdf2Sha512 (
+  IN CONST UINT8  *Password,
+  IN UINT32       PasswordSize,
+  IN CONST UINT8  *Salt,
+  IN UINT32       SaltSize,
+  IN UINT32       Iterations,
+  IN UINT32       Lanes,
+  IN CONST UINT8  *RefHash
+  )
+{
+  BOOLEAN  Result;
+  UINT8    VerifyHash[SHA512_DIGEST_SIZE];
+
+  ASSERT (Password != NULL);
+  ASSERT (RefHash != NULL);
+
+  if ((Iterations == 0) || (Lanes == 0) || (Lanes > OC_PASSWORD_MAX_LANES)) {
+    return FALSE;
+  }
+
+  OcHashPasswordPbkdf2Sha512 (
+    Password,
+    PasswordSize,
+    Salt,
+    SaltSize,
+    Iterations,
+    Lanes,
+    VerifyHash
+    );
+  Result = SecureCompareMem (RefHash, VerifyHash, SHA512_DIGEST_SIZE) == 0;
+  SecureZeroMem (VerifyHash, SHA512_DIGEST_SIZE);
+
+  return Result;
+}
@@ -484,16 +484,53 @@ RsaVerifySigDataFromProcessed (
 
 #ifndef OC_CRYPTO_STATIC_MEMORY_ALLOCATION
 
+///
+/// Number of moduli with cached Montgomery parameters for
+/// RsaVerifySigDataFromData. Signatures are usually verified against
+/// the same few certificates, so this need not be large.
+///
+#define RSA_VERIFY_CACHE_SIZE  4U
+
+STATIC OC_RSA_VERIFY_CONTEXT  mRsaVerifyCache[RSA_VERIFY_CACHE_SIZE];
+STATIC UINT32                 mRsaVerifyCacheNext;
+
 BOOLEAN
-RsaVerifySigDataFromData (
-  IN CONST UINT8       *Modulus,
-  IN UINTN             ModulusSize,
-  IN UINT32            Exponent,
-  IN CONST UINT8       *Signature,
-  IN UINTN             SignatureSize,
-  IN CONST UINT8       *Data,
-  IN UINTN             DataSize,
-  IN OC_SIG_HASH_TYPE  Algorithm
+RsaVerifyContextInitFromKey (
+  OUT OC_RSA_VERIFY_CONTEXT    *Context,
+  IN  CONST OC_RSA_PUBLIC_KEY  *Key
+  )
+{
+  OC_BN_SIZE  ModulusSize;
+
+  ASSERT (Context != NULL);
+  ASSERT (Key != NULL);
+
+  ZeroMem (Context, sizeof (*Context));
+
+  ModulusSize = (OC_BN_SIZE)Key->Hdr.NumQwords * sizeof (UINT64);
+  if ((ModulusSize == 0) || (ModulusSize > RSA_MOD_MAX_SIZE)) {
+    return FALSE;
+  }
+
+  Context->Scratch = AllocatePool (RSA_SCRATCH_BUFFER_SIZE (ModulusSize));
+  if (Context->Scratch == NULL) {
+    return FALSE;
+  }
+
+  Context->N           = Key->Data;
+  Context->RSqrMod     = &Key->Data[Key->Hdr.NumQwords];
+  Context->N0Inv       = Key->Hdr.N0Inv;
+  Context->ModulusSize = ModulusSize;
+  Context->Exponent    = 0x10001;
+  return TRUE;
+}
+
+BOOLEAN
+RsaVerifyContextInitFromData (
+  OUT OC_RSA_VERIFY_CONTEXT  *Context,
+  IN  CONST UINT8            *Modulus,
+  IN  UINTN                  ModulusSize,
+  IN  UINT32                 Exponent
   )
 {
   OC_BN_NUM_WORDS  ModulusNumWords;
@@ -502,18 +539,15 @@ RsaVerifySigDataFromData (
   VOID        *Mont;
   OC_BN_WORD  *N;
   OC_BN_WORD  *RSqrMod;
-  VOID        *Scratch;
 
   OC_BN_WORD  N0Inv;
-  BOOLEAN     Result;
 
+  ASSERT (Context != NULL);
   ASSERT (Modulus != NULL);
   ASSERT (ModulusSize > 0);
   ASSERT (Exponent > 0);
-  ASSERT (Signature != NULL);
-  ASSERT (SignatureSize > 0);
-  ASSERT (Data != NULL);
-  ASSERT (DataSize > 0);
+
+  ZeroMem (Context, sizeof (*Context));
 
   if (  (ModulusSize > OC_BN_MONT_MAX_SIZE)
      || ((ModulusSize % OC_BN_WORD_SIZE) != 0))
@@ -531,56 +565,212 @@ RsaVerifySigDataFromData (
   ModulusNumWords = (OC_BN_NUM_WORDS)(ModulusSize / OC_BN_WORD_SIZE);
 
   STATIC_ASSERT (
-    OC_BN_MAX_SIZE <= MAX_UINTN / 2,
+    OC_BN_MAX_SIZE <= MAX_UINTN / 5,
     "An overflow verification must be added"
     );
 
-  Memory = AllocatePool (
-             2 * ModulusSize + BIG_NUM_MONT_PARAMS_SCRATCH_SIZE (ModulusNumWords)
-             );
+  //
+  // Keep N, R^2 mod N and the verification scratch buffer together.
+  // This usage of RSA_SCRATCH_BUFFER_SIZE may overflow. However, the caller
+  // will error in this case before accessing the buffer.
+  //
+  Memory = AllocatePool (2 * ModulusSize + RSA_SCRATCH_BUFFER_SIZE (ModulusSize));
   if (Memory == NULL) {
     return FALSE;
   }
 
+  Mont = AllocatePool (BIG_NUM_MONT_PARAMS_SCRATCH_SIZE (ModulusNumWords));
+  if (Mont == NULL) {
+    FreePool (Memory);
+    return FALSE;
+  }
+
   N       = &Memory[0 * ModulusNumWords];
   RSqrMod = &Memory[1 * ModulusNumWords];
-  Mont    = &Memory[2 * ModulusNumWords];
 
   BigNumParseBuffer (N, ModulusNumWords, Modulus, ModulusSize);
 
   N0Inv = BigNumCalculateMontParams (RSqrMod, ModulusNumWords, N, Mont);
+  FreePool (Mont);
   if (N0Inv == 0) {
     FreePool (Memory);
     return FALSE;
   }
 
-  //
-  // This usage of RSA_SCRATCH_BUFFER_SIZE may overflow. However, the caller
-  // will error in this case before accessing the buffer.
-  //
-  Scratch = AllocatePool (RSA_SCRATCH_BUFFER_SIZE (ModulusSize));
-  if (Scratch == NULL) {
-    FreePool (Memory);
-    return FALSE;
+  Context->N           = N;
+  Context->RSqrMod     = RSqrMod;
+  Context->N0Inv       = N0Inv;
+  Context->ModulusSize = (UINT32)ModulusSize;
+  Context->Exponent    = Exponent;
+  Context->Scratch     = &Memory[2 * ModulusNumWords];
+  Context->Memory      = Memory;
+  return TRUE;
+}
+
+VOID
+RsaVerifyContextFree (
+  IN OUT OC_RSA_VERIFY_CONTEXT  *Context
+  )
+{
+  ASSERT (Context != NULL);
+
+  if (Context->Memory != NULL) {
+    FreePool (Context->Memory);
+  } else if (Context->Scratch != NULL) {
+    FreePool (Context->Scratch);
   }
 
-  Result = RsaVerifySigDataFromProcessed (
-             N,
-             ModulusNumWords,
-             N0Inv,
-             RSqrMod,
-             Exponent,
-             Signature,
-             SignatureSize,
-             Data,
-             DataSize,
-             Algorithm,
-             Scratch
-             );
+  ZeroMem (Context, sizeof (*Context));
+}
 
-  FreePool (Scratch);
-  FreePool (Memory);
-  return Result;
+BOOLEAN
+RsaVerifySigHashFromContext (
+  IN CONST OC_RSA_VERIFY_CONTEXT  *Context,
+  IN CONST UINT8                  *Signature,
+  IN UINTN                        SignatureSize,
+  IN CONST UINT8                  *Hash,
+  IN UINTN                        HashSize,
+  IN OC_SIG_HASH_TYPE             Algorithm
+  )
+{
+  ASSERT (Context != NULL);
+  ASSERT (Context->Scratch != NULL);
+
+  return RsaVerifySigHashFromProcessed (
+           Context->N,
+           (OC_BN_NUM_WORDS)(Context->ModulusSize / OC_BN_WORD_SIZE),
+           (OC_BN_WORD)Context->N0Inv,
+           Context->RSqrMod,
+           Context->Exponent,
+           Signature,
+           SignatureSize,
+           Hash,
+           HashSize,
+           Algorithm,
+           Context->Scratch
+           );
+}
+
+BOOLEAN
+RsaVerifySigDataFromContext (
+  IN CONST OC_RSA_VERIFY_CONTEXT  *Context,
+  IN CONST UINT8                  *Signature,
+  IN UINTN                        SignatureSize,
+  IN CONST UINT8                  *Data,
+  IN UINTN                        DataSize,
+  IN OC_SIG_HASH_TYPE             Algorithm
+  )
+{
+  ASSERT (Context != NULL);
+  ASSERT (Context->Scratch != NULL);
+
+  return RsaVerifySigDataFromProcessed (
+           Context->N,
+           (OC_BN_NUM_WORDS)(Context->ModulusSize / OC_BN_WORD_SIZE),
+           (OC_BN_WORD)Context->N0Inv,
+           Context->RSqrMod,
+           Context->Exponent,
+           Signature,
+           SignatureSize,
+           Data,
+           DataSize,
+           Algorithm,
+           Context->Scratch
+           );
+}
+
+/**
+  Find or create a cached verification context for a modulus.
+  Cached contexts share their scratch buffers, so verification through
+  this cache must not run concurrently.
+
+  @param[in] Modulus      The RSA modulus byte array.
+  @param[in] ModulusSize  The size, in bytes, of Modulus.
+  @param[in] Exponent     The RSA exponent.
+
+  @returns  Verification context or NULL on failure.
+
+**/
+STATIC
+CONST OC_RSA_VERIFY_CONTEXT *
+InternalRsaGetCachedContext (
+  IN CONST UINT8  *Modulus,
+  IN UINTN        ModulusSize,
+  IN UINT32       Exponent
+  )
+{
+  OC_RSA_VERIFY_CONTEXT  *Context;
+  UINT32                 Index;
+
+  for (Index = 0; Index < RSA_VERIFY_CACHE_SIZE; ++Index) {
+    Context = &mRsaVerifyCache[Index];
+    if (  (Context->Scratch == NULL)
+       || (Context->ModulusSize != ModulusSize)
+       || (Context->Exponent != Exponent))
+    {
+      continue;
+    }
+
+    //
+    // Scratch is unused between verifications, compare the modulus there.
+    //
+    BigNumParseBuffer (
+      Context->Scratch,
+      (OC_BN_NUM_WORDS)(ModulusSize / OC_BN_WORD_SIZE),
+      Modulus,
+      ModulusSize
+      );
+    if (CompareMem (Context->Scratch, Context->N, ModulusSize) == 0) {
+      return Context;
+    }
+  }
+
+  Context = &mRsaVerifyCache[mRsaVerifyCacheNext];
+  mRsaVerifyCacheNext = (mRsaVerifyCacheNext + 1) % RSA_VERIFY_CACHE_SIZE;
+
+  RsaVerifyContextFree (Context);
+  if (!RsaVerifyContextInitFromData (Context, Modulus, ModulusSize, Exponent)) {
+    return NULL;
+  }
+
+  return Context;
+}
+
+BOOLEAN
+RsaVerifySigDataFromData (
+  IN CONST UINT8       *Modulus,
+  IN UINTN             ModulusSize,
+  IN UINT32            Exponent,
+  IN CONST UINT8       *Signature,
+  IN UINTN             SignatureSize,
+  IN CONST UINT8       *Data,
+  IN UINTN             DataSize,
+  IN OC_SIG_HASH_TYPE  Algorithm
+  )
+{
+  CONST OC_RSA_VERIFY_CONTEXT  *Context;
+
+  ASSERT (Modulus != NULL);
+  ASSERT (ModulusSize > 0);
+  ASSERT (Exponent > 0);
+  ASSERT (Signature != NULL);
+  ASSERT (SignatureSize > 0);
+  ASSERT (Data != NULL);
+  ASSERT (DataSize > 0);
+
+  Context = InternalRsaGetCachedContext (Modulus, ModulusSize, Exponent);
+  if (Context == NULL) {
+    return FALSE;
+  }
+
+  return RsaVerifySigDataFromContext (
+           Context,
+           Signature,
+           SignatureSize,
+           Data,
+           DataSize,
+           Algorithm
+           );
 }
 
 #endif
@@ -627,6 +817,77 @@ RsaVerifySigHashFromKey (
 
 #ifndef OC_CRYPTO_NDYNALLOC
 
+///
+/// Scratch buffer reused by the dynamically allocating verification calls.
+///
+STATIC VOID     *mRsaScratch;
+STATIC UINTN    mRsaScratchSize;
+STATIC BOOLEAN  mRsaScratchBusy;
+
+/**
+  Acquire a scratch buffer for verifying with Key, reusing the previous one
+  when possible.
+
+  @param[in] Key  The RSA Public Key.
+
+  @returns  Scratch buffer or NULL on failure.
+
+**/
+STATIC
+VOID *
+InternalRsaAcquireScratch (
+  IN CONST OC_RSA_PUBLIC_KEY  *Key
+  )
+{
+  UINTN  Size;
+
+  //
+  // This usage of RSA_SCRATCH_BUFFER_SIZE may overflow. However, the caller
+  // will error in this case before accessing the buffer.
+  //
+  Size = RSA_SCRATCH_BUFFER_SIZE ((OC_BN_SIZE)Key->Hdr.NumQwords * sizeof (UINT64));
+
+  if (mRsaScratchBusy) {
+    return AllocatePool (Size);
+  }
+
+  if (mRsaScratchSize < Size) {
+    if (mRsaScratch != NULL) {
+      FreePool (mRsaScratch);
+    }
+
+    mRsaScratch = AllocatePool (Size);
+    if (mRsaScratch == NULL) {
+      mRsaScratchSize = 0;
+      return NULL;
+    }
+
+    mRsaScratchSize = Size;
+  }
+
+  mRsaScratchBusy = TRUE;
+  return mRsaScratch;
+}
+
+/**
+  Release a scratch buffer returned by InternalRsaAcquireScratch.
+
+  @param[in] Scratch  Scratch buffer.
+
+**/
+STATIC
+VOID
+InternalRsaReleaseScratch (
+  IN VOID  *Scratch
+  )
+{
+  if (Scratch == mRsaScratch) {
+    mRsaScratchBusy = FALSE;
+  } else {
+    FreePool (Scratch);
+  }
+}
+
 BOOLEAN
 RsaVerifySigHashFromKeyDynalloc (
   IN CONST OC_RSA_PUBLIC_KEY  *Key,
@@ -641,13 +902,8 @@ RsaVerifySigHashFromKeyDynalloc (
   VOID     *Scratch;
 
   ASSERT (Key != NULL);
-  //
-  // This usage of RSA_SCRATCH_BUFFER_SIZE may overflow. However, the caller
-  // will error in this case before accessing the buffer.
-  //
-  Scratch = AllocatePool (
-              RSA_SCRATCH_BUFFER_SIZE ((OC_BN_SIZE)Key->Hdr.NumQwords * sizeof (UINT64))
-              );
+
+  Scratch = InternalRsaAcquireScratch (Key);
   if (Scratch == NULL) {
     return FALSE;
   }
@@ -662,7 +918,7 @@ RsaVerifySigHashFromKeyDynalloc (
              Scratch
              );
 
-  FreePool (Scratch);
+  InternalRsaReleaseScratch (Scratch);
 
   return Result;
 }
@@ -725,13 +981,8 @@ RsaVerifySigDataFromKeyDynalloc (
   VOID     *Scratch;
 
   ASSERT (Key != NULL);
-  //
-  // This usage of RSA_SCRATCH_BUFFER_SIZE may overflow. However, the caller
-  // will error in this case before accessing the buffer.
-  //
-  Scratch = AllocatePool (
-              RSA_SCRATCH_BUFFER_SIZE ((OC_BN_SIZE)Key->Hdr.NumQwords * sizeof (UINT64))
-              );
+
+  Scratch = InternalRsaAcquireScratch (Key);
   if (Scratch == NULL) {
     return FALSE;
   }
@@ -746,7 +997,7 @@ RsaVerifySigDataFromKeyDynalloc (
              Scratch
              );
 
-  FreePool (Scratch);
+  InternalRsaReleaseScratch (Scratch);
 
   return Result;
 }
@@ -23,6 +23,13 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 extern BOOLEAN  mIsAccelEnabled;
 
+VOID
+Sha512Transform (
+  IN OUT UINT64       *State,
+  IN     CONST UINT8  *Data,
+  IN     UINTN        BlockNb
+  );
+
 VOID
 EFIAPI
 Sha512TransformAccel (
@@ -569,11 +569,67 @@ OcDiskFindSystemPartitionPath (
   return EspDevicePath;
 }
 
+/**
+  Read information from disk, using prefetched leading disk blocks if possible.
+**/
+STATIC
+EFI_STATUS
+InternalDiskReadPrefetched (
+  IN  OC_DISK_CONTEXT  *Context,
+  IN  UINT64           Lba,
+  IN  UINTN            BufferSize,
+  OUT VOID             *Buffer,
+  IN  CONST UINT8      *Prefetched  OPTIONAL,
+  IN  UINTN            PrefetchedSize
+  )
+{
+  UINTN  Offset;
+
+  if ((Prefetched != NULL) && (Lba <= PrefetchedSize / Context->BlockSize)) {
+    Offset = (UINTN)Lba * Context->BlockSize;
+    if (BufferSize <= PrefetchedSize - Offset) {
+      CopyMem (Buffer, Prefetched + Offset, BufferSize);
+      return EFI_SUCCESS;
+    }
+  }
+
+  return OcDiskRead (Context, Lba, BufferSize, Buffer);
+}
+
 CONST OC_PARTITION_ENTRIES *
 OcGetDiskPartitions (
   IN EFI_HANDLE  DiskHandle,
   IN BOOLEAN     UseBlockIo2
   )
+{
+  return OcGetDiskPartitionsFromBuffer (DiskHandle, UseBlockIo2, NULL, 0);
+}
+
+BOOLEAN
+OcHasCachedDiskPartitions (
+  IN EFI_HANDLE  DiskHandle
+  )
+{
+  EFI_STATUS  Status;
+  VOID        *PartEntries;
+
+  ASSERT (DiskHandle != NULL);
+
+  Status = gBS->HandleProtocol (
+                  DiskHandle,
+                  &mInternalDiskPartitionEntriesProtocolGuid,
+                  &PartEntries
+                  );
+  return !EFI_ERROR (Status);
+}
+
+CONST OC_PARTITION_ENTRIES *
+OcGetDiskPartitionsFromBuffer (
+  IN EFI_HANDLE  DiskHandle,
+  IN BOOLEAN     UseBlockIo2,
+  IN CONST VOID  *Buffer      OPTIONAL,
+  IN UINTN       BufferSize
+  )
 {
   OC_PARTITION_ENTRIES  *PartEntries;
 
@@ -587,7 +643,7 @@ OcGetDiskPartitions (
   UINT32                      PartEntrySize;
   UINTN                       PartEntriesSize;
   UINTN                       PartEntriesStructSize;
-  UINTN                       BufferSize;
+  UINTN                       HeaderSize;
   EFI_PARTITION_TABLE_HEADER  *GptHeader;
 
   ASSERT (DiskHandle != NULL);
@@ -610,18 +666,20 @@ OcGetDiskPartitions (
   //
   // Retrieve the GPT header.
   //
-  BufferSize = ALIGN_VALUE (sizeof (*GptHeader), DiskContext.BlockSize);
-  GptHeader  = AllocatePool (BufferSize);
+  HeaderSize = ALIGN_VALUE (sizeof (*GptHeader), DiskContext.BlockSize);
+  GptHeader  = AllocatePool (HeaderSize);
   if (GptHeader == NULL) {
     DEBUG ((DEBUG_INFO, "OCPI: GPT header allocation error\n"));
     return NULL;
   }
 
-  Status = OcDiskRead (
+  Status = InternalDiskReadPrefetched (
              &DiskContext,
              PRIMARY_PART_HEADER_LBA,
-             BufferSize,
-             GptHeader
+             HeaderSize,
+             GptHeader,
+             Buffer,
+             BufferSize
              );
   if (EFI_ERROR (Status)) {
     FreePool (GptHeader);
@@ -631,7 +689,7 @@ OcGetDiskPartitions (
       DiskContext.BlockSize,
       DiskContext.BlockIo != NULL,
       DiskContext.BlockIo2 != NULL,
-      (UINT32)BufferSize,
+      (UINT32)HeaderSize,
       Status
       ));
     return NULL;
@@ -682,11 +740,13 @@ OcGetDiskPartitions (
     return NULL;
   }
 
-  Status = OcDiskRead (
+  Status = InternalDiskReadPrefetched (
              &DiskContext,
              PartEntryLBA,
              PartEntriesSize,
-             PartEntries->FirstEntry
+             PartEntries->FirstEntry,
+             Buffer,
+             BufferSize
              );
   if (EFI_ERROR (Status)) {
     FreePool (PartEntries);
@@ -190,6 +190,121 @@ MACH_X (
   return MACH_X_TO_UINT32 (VmSize);
 }
 
+/**
+  Builds the load command index of the Mach-O when it is missing or outdated.
+
+  @param[in,out] Context  Context of the Mach-O.
+
+  @retval TRUE  The index is usable.
+
+**/
+STATIC
+BOOLEAN
+MACH_X (
+  InternalMachoUpdateIndex
+  )(
+    IN OUT OC_MACHO_CONTEXT  *Context
+    ) {
+  OC_MACHO_INDEX     *Index;
+  MACH_HEADER_X      *MachHeader;
+  MACH_LOAD_COMMAND  *Command;
+  UINT32             Offset;
+  UINT32             Type;
+
+  ASSERT (Context != NULL);
+  ASSERT (Context->MachHeader != NULL);
+  MACH_ASSERT_X (Context);
+
+  Index      = &Context->Index;
+  MachHeader = MACH_X (&Context->MachHeader->Header);
+
+  if (  (Index->State != OcMachoIndexNone)
+     && (Index->NumCommands == MachHeader->NumCommands)
+     && (Index->CommandsSize == MachHeader->CommandsSize))
+  {
+    return Index->State == OcMachoIndexValid;
+  }
+
+  Index->State        = OcMachoIndexUnsupported;
+  Index->NumCommands  = MachHeader->NumCommands;
+  Index->CommandsSize = MachHeader->CommandsSize;
+  Index->NumSegments  = 0;
+  SetMem32 (Index->FirstCommands, sizeof (Index->FirstCommands), MACHO_INDEX_NONE);
+
+  for (Offset = 0; Offset < MachHeader->CommandsSize; Offset += Command->CommandSize) {
+    if (MachHeader->CommandsSize - Offset < sizeof (*Command)) {
+      return FALSE;
+    }
+
+    Command = (MACH_LOAD_COMMAND *)((UINTN)MachHeader->Commands + Offset);
+    if (  (Command->CommandSize < sizeof (*Command))
+       || (Command->CommandSize > MachHeader->CommandsSize - Offset))
+    {
+      return FALSE;
+    }
+
+    Type = Command->CommandType & ~MACH_LC_REQUIRE_DYLD;
+    if ((Type < MACHO_INDEX_COMMAND_TYPES) && (Index->FirstCommands[Type] == MACHO_INDEX_NONE)) {
+      Index->FirstCommands[Type] = Offset;
+    }
+
+    if (Command->CommandType == MACH_LOAD_COMMAND_SEGMENT_X) {
+      if (Index->NumSegments == MACHO_INDEX_MAX_SEGMENTS) {
+        return FALSE;
+      }
+
+      Index->Segments[Index->NumSegments++] = Offset;
+    }
+  }
+
+  Index->State = OcMachoIndexValid;
+  return TRUE;
+}
+
+/**
+  Retrieves the segment command following Offset from the load command index.
+
+  @param[in] Index       Valid load command index.
+  @param[in] MachHeader  Mach-O header the index was built for.
+  @param[in] Offset      Offset of the previous load command.
+
+  @retval NULL  There are no more segment commands.
+
+**/
+STATIC
+MACH_LOAD_COMMAND *
+MACH_X (
+  InternalMachoGetNextIndexedSegment
+  )(
+    IN CONST OC_MACHO_INDEX  *Index,
+    IN CONST MACH_HEADER_X   *MachHeader,
+    IN UINT32                Offset
+    ) {
+  UINT32  Low;
+  UINT32  High;
+  UINT32  Middle;
+
+  //
+  // Segment offsets are sorted, find the first one past Offset.
+  //
+  Low  = 0;
+  High = Index->NumSegments;
+  while (Low < High) {
+    Middle = Low + (High - Low) / 2;
+    if (Index->Segments[Middle] <= Offset) {
+      Low = Middle + 1;
+    } else {
+      High = Middle;
+    }
+  }
+
+  if (Low == Index->NumSegments) {
+    return NULL;
+  }
+
+  return (MACH_LOAD_COMMAND *)((UINTN)MachHeader->Commands + Index->Segments[Low]);
+}
+
 MACH_LOAD_COMMAND *
 MACH_X (
   InternalMachoGetNextCommand
@@ -201,6 +316,8 @@ MACH_X (
   MACH_LOAD_COMMAND  *Command;
   MACH_HEADER_X      *MachHeader;
   UINTN              TopOfCommands;
+  UINT32             Type;
+  BOOLEAN            Indexed;
 
   ASSERT (Context != NULL);
   ASSERT (Context->MachHeader != NULL);
@@ -210,14 +327,37 @@ MACH_X (
 
   TopOfCommands = ((UINTN)MachHeader->Commands + MachHeader->CommandsSize);
 
+  Indexed = MACH_X (InternalMachoUpdateIndex)(Context);
+
   if (LoadCommand != NULL) {
     ASSERT (
       (LoadCommand >= &MachHeader->Commands[0])
            && ((UINTN)LoadCommand <= TopOfCommands)
       );
+
+    if (Indexed && (LoadCommandType == MACH_LOAD_COMMAND_SEGMENT_X)) {
+      return MACH_X (InternalMachoGetNextIndexedSegment)(
+               &Context->Index,
+               MachHeader,
+               (UINT32)((UINTN)LoadCommand - (UINTN)MachHeader->Commands)
+               );
+    }
+
     Command = NEXT_MACH_LOAD_COMMAND (LoadCommand);
   } else {
     Command = &MachHeader->Commands[0];
+
+    //
+    // Skip to the first command of matching type, if any.
+    //
+    Type = LoadCommandType & ~MACH_LC_REQUIRE_DYLD;
+    if (Indexed && (Type < MACHO_INDEX_COMMAND_TYPES)) {
+      if (Context->Index.FirstCommands[Type] == MACHO_INDEX_NONE) {
+        return NULL;
+      }
+
+      Command = (MACH_LOAD_COMMAND *)((UINTN)MachHeader->Commands + Context->Index.FirstCommands[Type]);
+    }
   }
 
   for (
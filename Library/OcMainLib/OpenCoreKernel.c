@@ -24,6 +24,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/OcMiscLib.h>
 #include <Library/OcAppleImg4Lib.h>
 #include <Library/OcStringLib.h>
+#include <Library/OcTraceLib.h>
 #include <Library/OcVirtualFsLib.h>
 #include <Library/PrintLib.h>
 #include <Library/UefiBootServicesTableLib.h>
@@ -777,15 +778,20 @@ OcKernelProcessPrelinked (
 {
   EFI_STATUS         Status;
   PRELINKED_CONTEXT  Context;
+  OC_TRACE_ID        TraceId;
 
   Status = PrelinkedContextInit (&Context, Kernel, *KernelSize, AllocatedSize, Is32Bit);
 
   if (!EFI_ERROR (Status)) {
     OcKernelBlockKexts (Config, DarwinVersion, Is32Bit, CacheTypePrelinked, &Context);
 
+    TraceId = OcTraceBegin ("KextLink");
     OcKernelInjectKexts (Config, CacheTypePrelinked, &Context, DarwinVersion, Is32Bit, LinkedExpansion, ReservedExeSize);
+    OcTraceEnd (TraceId);
 
+    TraceId = OcTraceBegin ("KextPatch");
     OcKernelApplyPatches (Config, mOcCpuInfo, DarwinVersion, Is32Bit, CacheTypePrelinked, &Context, NULL, 0);
+    OcTraceEnd (TraceId);
 
     *KernelSize = Context.PrelinkedSize;
 
@@ -808,6 +814,7 @@ OcKernelProcessMkext (
 {
   EFI_STATUS     Status;
   MKEXT_CONTEXT  Context;
+  OC_TRACE_ID    TraceId;
 
   Status = MkextContextInit (&Context, Mkext, *MkextSize, AllocatedSize);
   if (EFI_ERROR (Status)) {
@@ -816,9 +823,13 @@ OcKernelProcessMkext (
 
   OcKernelBlockKexts (Config, DarwinVersion, Is32Bit, CacheTypeMkext, &Context);
 
+  TraceId = OcTraceBegin ("KextLink");
   OcKernelInjectKexts (Config, CacheTypeMkext, &Context, DarwinVersion, Is32Bit, 0, 0);
+  OcTraceEnd (TraceId);
 
+  TraceId = OcTraceBegin ("KextPatch");
   OcKernelApplyPatches (Config, mOcCpuInfo, DarwinVersion, Is32Bit, CacheTypeMkext, &Context, NULL, 0);
+  OcTraceEnd (TraceId);
 
   MkextInjectPatchComplete (&Context);
 
@@ -883,10 +894,12 @@ OcKernelReadAppleKernel (
   UINT32      DarwinVersionNew;
   BOOLEAN     IsKernel32Bit;
 
-  UINT32  ReservedInfoSize;
-  UINT32  NumReservedKexts;
-  UINT32  ReservedFullSize;
+  UINT32       ReservedInfoSize;
+  UINT32       NumReservedKexts;
+  UINT32       ReservedFullSize;
+  OC_TRACE_ID  TraceId;
 
+  TraceId = OcTraceBegin ("KextLoad");
   OcKernelLoadKextsAndReserve (
     RootFile,
     mOcStorage,
@@ -897,6 +910,7 @@ OcKernelReadAppleKernel (
     &ReservedInfoSize,
     &NumReservedKexts
     );
+  OcTraceEnd (TraceId);
 
   *LinkedExpansion = KcGetSegmentFixupChainsSize (*ReservedExeSize);
   if (*LinkedExpansion == 0) {
@@ -917,16 +931,18 @@ OcKernelReadAppleKernel (
   // Read last requested architecture for kernel.
   //
   DEBUG ((DEBUG_INFO, "OC: Trying %a XNU hook on %s\n", Is32Bit ? "32-bit" : "64-bit", FileName));
-  Status = ReadAppleKernel (
-             KernelFile,
-             Is32Bit,
-             &IsKernel32Bit,
-             Kernel,
-             KernelSize,
-             AllocatedSize,
-             ReservedFullSize,
-             Digest
-             );
+  TraceId = OcTraceBegin ("KernelRead");
+  Status  = ReadAppleKernel (
+              KernelFile,
+              Is32Bit,
+              &IsKernel32Bit,
+              Kernel,
+              KernelSize,
+              AllocatedSize,
+              ReservedFullSize,
+              Digest
+              );
+  OcTraceEnd (TraceId);
   DEBUG ((
     DEBUG_INFO,
     "OC: Result of %a XNU hook on %s (%02X%02X%02X%02X) is %r\n",
@@ -1121,6 +1137,7 @@ OcKernelFileOpen (
   UINT32             ReservedFullSize;
   CHAR16             *NewFileName;
   EFI_FILE_PROTOCOL  *EspNewHandle;
+  OC_TRACE_ID        TraceId;
 
   if (mCustomKernelDirectoryInProgress) {
     DEBUG ((DEBUG_INFO, "OC: Skipping OpenFile hooking on ESP Kernels directory\n"));
@@ -1309,6 +1326,7 @@ OcKernelFileOpen (
       //
       // Apply patches to kernel itself, and then process prelinked.
       //
+      TraceId = OcTraceBegin ("KernelPatch");
       OcKernelApplyPatches (
         mOcConfiguration,
         mOcCpuInfo,
@@ -1319,6 +1337,7 @@ OcKernelFileOpen (
         Kernel,
         KernelSize
         );
+      OcTraceEnd (TraceId);
 
       PrelinkedStatus = OcKernelProcessPrelinked (
                           mOcConfiguration,
@@ -1354,6 +1373,8 @@ OcKernelFileOpen (
         OcAppleImg4RegisterOverride (mKernelDigest, Kernel, KernelSize);
       }
 
+      OcTraceExportFile (OcTraceMilestoneKernel);
+
       //
       // Return our handle.
       //
@@ -1376,6 +1397,7 @@ OcKernelFileOpen (
       return EFI_NOT_FOUND;
     }
 
+    TraceId = OcTraceBegin ("KextLoad");
     OcKernelLoadKextsAndReserve (
       This,
       mOcStorage,
@@ -1386,6 +1408,7 @@ OcKernelFileOpen (
       &ReservedInfoSize,
       &NumReservedKexts
       );
+    OcTraceEnd (TraceId);
 
     Result = BaseOverflowAddU32 (
                ReservedInfoSize,
@@ -1397,15 +1420,17 @@ OcKernelFileOpen (
     }
 
     DEBUG ((DEBUG_INFO, "OC: Trying %a mkext hook on %s\n", mUse32BitKernel ? "32-bit" : "64-bit", FileName));
-    Status = ReadAppleMkext (
-               *NewHandle,
-               mUse32BitKernel,
-               &Kernel,
-               &KernelSize,
-               &AllocatedSize,
-               ReservedFullSize,
-               NumReservedKexts
-               );
+    TraceId = OcTraceBegin ("MkextRead");
+    Status  = ReadAppleMkext (
+                *NewHandle,
+                mUse32BitKernel,
+                &Kernel,
+                &KernelSize,
+                &AllocatedSize,
+                ReservedFullSize,
+                NumReservedKexts
+                );
+    OcTraceEnd (TraceId);
     DEBUG ((DEBUG_INFO, "OC: Result of mkext hook on %s is %r\n", FileName, Status));
 
     if (!EFI_ERROR (Status)) {
@@ -34,6 +34,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/OcLogAggregatorLib.h>
 #include <Library/OcSmbiosLib.h>
 #include <Library/OcStringLib.h>
+#include <Library/OcTraceLib.h>
 #include <Library/OcVariableLib.h>
 #include <Library/PcdLib.h>
 #include <Library/PrintLib.h>
@@ -430,7 +431,9 @@ OcMiscEarlyInit (
   CONST CHAR8     *AsciiVault;
   OCS_VAULT_MODE  Vault;
   UINTN           PciDeviceInfoSize;
+  OC_TRACE_ID     TraceId;
 
+  TraceId    = OcTraceBegin ("ConfigLoad");
   ConfigData = OcStorageReadFileUnicode (
                  Storage,
                  OPEN_CORE_CONFIG_PATH,
@@ -454,12 +457,16 @@ OcMiscEarlyInit (
     return EFI_UNSUPPORTED; ///< Should be unreachable.
   }
 
+  OcTraceEnd (TraceId);
+
   Status = OcShimRetainProtocol (Config->Uefi.Quirks.ShimRetainProtocol);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_WARN, "OC: Failed to set %g:%s\n", &gShimLockGuid, SHIM_RETAIN_PROTOCOL));
   }
 
+  TraceId = OcTraceBegin ("DriversEarly");
   OcLoadDrivers (Storage, Config, NULL, TRUE);
+  OcTraceEnd (TraceId);
 
   OcVariableInit (Config->Uefi.Quirks.ForceOcWriteFlash);
 
@@ -537,6 +544,13 @@ OcMiscEarlyInit (
     Storage->FileSystem
     );
 
+  if ((Config->Misc.Debug.Target & (OC_LOG_ENABLE | OC_LOG_TRACE)) == (OC_LOG_ENABLE | OC_LOG_TRACE)) {
+    OcTraceConfigure (
+      OPEN_CORE_TRACE_PREFIX_PATH,
+      Storage->FileSystem
+      );
+  }
+
   DEBUG ((
     DEBUG_INFO,
     "OC: OpenCore %a is loading in %a mode (%d/%d)...\n",
@@ -50,6 +50,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/OcOSInfoLib.h>
 #include <Library/OcUnicodeCollationEngGenericLib.h>
 #include <Library/OcPciIoLib.h>
+#include <Library/OcTraceLib.h>
 #include <Library/OcVariableLib.h>
 #include <Library/PrintLib.h>
 #include <Library/UefiBootServicesTableLib.h>
@@ -890,12 +891,13 @@ OcLoadUefiSupport (
   IN UINT8               *Signature
   )
 {
-  EFI_STATUS  Status;
-  EFI_HANDLE  *DriversToConnect;
-  EFI_HANDLE  *HandleBuffer;
-  UINTN       HandleCount;
-  EFI_EVENT   Event;
-  BOOLEAN     AccelEnabled;
+  EFI_STATUS   Status;
+  EFI_HANDLE   *DriversToConnect;
+  EFI_HANDLE   *HandleBuffer;
+  UINTN        HandleCount;
+  EFI_EVENT    Event;
+  BOOLEAN      AccelEnabled;
+  OC_TRACE_ID  TraceId;
 
   OcUnloadDrivers (Config);
 
@@ -979,6 +981,7 @@ OcLoadUefiSupport (
   //
   OcReserveMemory (Config);
 
+  TraceId = OcTraceBegin ("Drivers");
   if (Config->Uefi.ConnectDrivers) {
     OcLoadDrivers (Storage, Config, &DriversToConnect, FALSE);
     DEBUG ((DEBUG_INFO, "OC: Connecting drivers...\n"));
@@ -1001,6 +1004,8 @@ OcLoadUefiSupport (
     OcLoadDrivers (Storage, Config, NULL, FALSE);
   }
 
+  OcTraceEnd (TraceId);
+
   DEBUG_CODE_BEGIN ();
   HandleCount  = 0;
   HandleBuffer = NULL;
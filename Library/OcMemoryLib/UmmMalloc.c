@@ -51,11 +51,16 @@
  *                     - Made pool initialization external to avoid memset deps
  *                       and to support initialization state
  *                     - Switched to UEFI types, pragmas, renamed external API
+ * Acidanthera 2026    - Moved external API to the slab front end in UmmSlab.c
+ *                     - Added aligned allocation, usable size and free space
+ *                       information for the front end
  * ----------------------------------------------------------------------------
  */
 
 #include <Library/OcMemoryLib.h>
 
+#include "UmmMallocInternal.h"
+
 STATIC UINT8   *default_umm_heap;
 STATIC UINT32  default_umm_heap_size;
 
@@ -273,13 +278,13 @@ VOID umm_init( VOID ) {
 
 /* ------------------------------------------------------------------------ */
 
-BOOLEAN UmmInitialized ( VOID ) {
+BOOLEAN InternalUmmInitialized ( VOID ) {
   return default_umm_heap != NULL;
 }
 
 /* ------------------------------------------------------------------------ */
 
-VOID UmmSetHeap( VOID *heap, UINT32 size ) {
+VOID InternalUmmSetHeap( VOID *heap, UINT32 size ) {
   default_umm_heap = (UINT8 *)heap;
   default_umm_heap_size = size;
   umm_init();
@@ -287,13 +292,13 @@ VOID UmmSetHeap( VOID *heap, UINT32 size ) {
 
 /* ------------------------------------------------------------------------ */
 
-BOOLEAN UmmFree( VOID *ptr ) {
+BOOLEAN InternalUmmFree( VOID *ptr ) {
 
   UINT32 c;
   UINT8 *cptr = (UINT8 *)ptr;
 
   /* If we are not initialised, reuturn false! */
-  if ( !UmmInitialized() )
+  if ( !InternalUmmInitialized() )
     return FALSE;
 
   /* If we're being asked to free a NULL pointer, well that's just silly! */
@@ -362,7 +367,7 @@ BOOLEAN UmmFree( VOID *ptr ) {
 
 /* ------------------------------------------------------------------------ */
 
-VOID *UmmMalloc( UINT32 size ) {
+VOID *InternalUmmMalloc( UINT32 size ) {
   UINT32 blocks;
   UINT32 blockSize = 0;
 
@@ -372,7 +377,7 @@ VOID *UmmMalloc( UINT32 size ) {
   UINT32 cf;
 
   /* If we are not initialised, reuturn false! */
-  if ( !UmmInitialized() )
+  if ( !InternalUmmInitialized() )
     return NULL;
 
   /*
@@ -491,3 +496,91 @@ VOID *UmmMalloc( UINT32 size ) {
 }
 
 /* ------------------------------------------------------------------------ */
+
+UINT32 InternalUmmUsableSize( VOID *ptr ) {
+  UINT32 c;
+
+  c = (UINT32)((((UINT8 *)ptr)-(UINT8 *)(&(umm_heap[0])))/sizeof(umm_block));
+
+  /* The data starts after the header of the first block. */
+  return( (UINT32)(((UMM_NBLOCK(c) & UMM_BLOCKNO_MASK) - c) * sizeof(umm_block)
+    - sizeof(((umm_block *)0)->header)) );
+}
+
+/* ------------------------------------------------------------------------ */
+
+VOID *InternalUmmMallocAligned( UINT32 size, UINT32 alignment, VOID **allocation ) {
+  UINT8 *raw;
+  UINT8 *aligned;
+  UINT32 c;
+  UINT32 k;
+  UINT32 blocks;
+
+  if( 0 == size || size > UMM_BLOCKNO_MASK - alignment )
+    return( (VOID *)NULL );
+
+  /*
+   * Over-allocate, so that an aligned region of `size` bytes always fits,
+   * then give back the leading and the trailing blocks.
+   */
+
+  raw = (UINT8 *)InternalUmmMalloc( size + alignment );
+  if( (VOID *)NULL == raw )
+    return( (VOID *)NULL );
+
+  UMM_CRITICAL_ENTRY();
+
+  aligned = (UINT8 *)ALIGN_POINTER( raw, alignment );
+  c = (UINT32)((raw - (UINT8 *)(&(umm_heap[0])))/sizeof(umm_block));
+
+  /* The last block with data starting at or below the aligned address. */
+  k = (UINT32)((aligned - (UINT8 *)(&(UMM_DATA(0))))/sizeof(umm_block));
+
+  if( k > c ) {
+    umm_split_block( c, k - c, 0 /*new block is used*/ );
+    UMM_CRITICAL_EXIT();
+    InternalUmmFree( &UMM_DATA(c) );
+    UMM_CRITICAL_ENTRY();
+  }
+
+  blocks = umm_blocks( (UINT32)(aligned + size - (UINT8 *)&UMM_DATA(k)) );
+
+  if( (UMM_NBLOCK(k) & UMM_BLOCKNO_MASK) - k > blocks ) {
+    umm_split_block( k, blocks, 0 /*new block is used*/ );
+    UMM_CRITICAL_EXIT();
+    InternalUmmFree( &UMM_DATA(k + blocks) );
+    UMM_CRITICAL_ENTRY();
+  }
+
+  UMM_CRITICAL_EXIT();
+
+  *allocation = &UMM_DATA(k);
+  return( (VOID *)aligned );
+}
+
+/* ------------------------------------------------------------------------ */
+
+VOID InternalUmmFreeInfo( UINT32 *free_size, UINT32 *largest_free_size ) {
+  UINT32 cf;
+  UINT32 blockSize;
+
+  *free_size = 0;
+  *largest_free_size = 0;
+
+  if ( !InternalUmmInitialized() )
+    return;
+
+  UMM_CRITICAL_ENTRY();
+
+  for( cf = UMM_NFREE(0); cf; cf = UMM_NFREE(cf) ) {
+    blockSize = ((UMM_NBLOCK(cf) & UMM_BLOCKNO_MASK) - cf) * sizeof(umm_block);
+
+    *free_size += blockSize;
+    if( blockSize > *largest_free_size )
+      *largest_free_size = blockSize;
+  }
+
+  UMM_CRITICAL_EXIT();
+}
+
+/* ------------------------------------------------------------------------ */
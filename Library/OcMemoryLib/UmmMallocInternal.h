@@ -0,0 +1,98 @@
+/** @file
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#ifndef UMM_MALLOC_INTERNAL_H
+#define UMM_MALLOC_INTERNAL_H
+
+#include <Uefi.h>
+
+/**
+  Check whether the general purpose heap is initialized.
+
+  @retval TRUE on success.
+**/
+BOOLEAN
+InternalUmmInitialized (
+  VOID
+  );
+
+/**
+  Initialize the general purpose heap.
+
+  @param[in]  Heap  Memory pool used for allocations.
+  @param[in]  Size  Memory pool size.
+**/
+VOID
+InternalUmmSetHeap (
+  IN VOID    *Heap,
+  IN UINT32  Size
+  );
+
+/**
+  Perform allocation from the general purpose heap.
+
+  @param[in]  Size  Allocation size.
+
+  @retval allocated memory on success.
+**/
+VOID *
+InternalUmmMalloc (
+  IN UINT32  Size
+  );
+
+/**
+  Perform aligned allocation from the general purpose heap.
+
+  @param[in]   Size        Allocation size.
+  @param[in]   Alignment   Power of two alignment.
+  @param[out]  Allocation  Pointer to pass to InternalUmmFree.
+
+  @retval aligned memory on success.
+**/
+VOID *
+InternalUmmMallocAligned (
+  IN  UINT32  Size,
+  IN  UINT32  Alignment,
+  OUT VOID    **Allocation
+  );
+
+/**
+  Perform free of memory allocated from the general purpose heap.
+  Checks whether memory belongs to the heap.
+
+  @param[in]  Ptr  Memory to free.
+
+  @retval TRUE on success
+**/
+BOOLEAN
+InternalUmmFree (
+  IN VOID  *Ptr
+  );
+
+/**
+  Get usable size of memory allocated from the general purpose heap.
+
+  @param[in]  Ptr  Allocated memory.
+
+  @retval usable size in bytes.
+**/
+UINT32
+InternalUmmUsableSize (
+  IN VOID  *Ptr
+  );
+
+/**
+  Get free space information of the general purpose heap.
+
+  @param[out]  FreeSize         Total free size in bytes.
+  @param[out]  LargestFreeSize  Largest free block size in bytes.
+**/
+VOID
+InternalUmmFreeInfo (
+  OUT UINT32  *FreeSize,
+  OUT UINT32  *LargestFreeSize
+  );
+
+#endif // UMM_MALLOC_INTERNAL_H
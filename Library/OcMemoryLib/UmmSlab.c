@@ -0,0 +1,423 @@
+/** @file
+  Slab front end of the built-in allocator.
+
+  Small allocations are rounded up to a power of two size class and served
+  from page sized slabs, each holding objects of one class. Free objects are
+  linked through their own storage, so both allocation and free are O(1).
+  A per-page map tells slab objects apart from general purpose heap memory.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/OcMemoryLib.h>
+
+#include "UmmMallocInternal.h"
+
+//
+// Slab size and alignment, one slab per page.
+//
+#define UMM_SLAB_SIZE  EFI_PAGE_SIZE
+
+//
+// Size classes are 16, 32, 64, 128 and 256 bytes.
+//
+#define UMM_SLAB_MIN_SHIFT    4U
+#define UMM_SLAB_CLASS_COUNT  5U
+#define UMM_SLAB_MAX_SIZE     (1U << (UMM_SLAB_MIN_SHIFT + UMM_SLAB_CLASS_COUNT - 1))
+
+#define UMM_SLAB_CLASS_SIZE(Class)  (1U << (UMM_SLAB_MIN_SHIFT + (Class)))
+
+//
+// Upper bound of objects in a slab of the smallest class.
+//
+#define UMM_SLAB_MAX_OBJECTS  (UMM_SLAB_SIZE / UMM_SLAB_CLASS_SIZE (0))
+
+typedef struct UMM_SLAB_ UMM_SLAB;
+
+//
+// Slab header at the start of its page, followed by the objects.
+//
+struct UMM_SLAB_ {
+  UMM_SLAB    *Next;
+  UMM_SLAB    *Prev;
+  VOID        *FreeList;
+  VOID        *Allocation;
+  UINT16      Class;
+  UINT16      Used;
+  UINT16      Carved;
+  //
+  // Bit per allocated object to reject double and invalid frees.
+  //
+  UINT8       UsedMap[UMM_SLAB_MAX_OBJECTS / 8];
+};
+
+#define UMM_SLAB_HEADER_SIZE  ALIGN_VALUE (sizeof (UMM_SLAB), 16)
+
+#define UMM_SLAB_CAPACITY(Class)  ((UMM_SLAB_SIZE - UMM_SLAB_HEADER_SIZE) / UMM_SLAB_CLASS_SIZE (Class))
+
+typedef struct {
+  //
+  // Slabs with at least one free object.
+  //
+  UMM_SLAB    *Partial;
+  UINT32      SlabCount;
+  UINT32      UsedCount;
+} UMM_SLAB_CLASS;
+
+STATIC UINT8           *mUmmHeap;
+STATIC UINT32          mUmmHeapSize;
+STATIC UINTN           mUmmPageBase;
+STATIC UINT32          mUmmPageCount;
+STATIC UINT8           *mUmmPageMap;
+STATIC UMM_SLAB_CLASS  mUmmClasses[UMM_SLAB_CLASS_COUNT];
+STATIC UINT32          mUmmAllocatedSize;
+STATIC UINT32          mUmmPeakAllocatedSize;
+
+STATIC
+VOID
+UmmAccount (
+  IN UINT32   Size,
+  IN BOOLEAN  Allocate
+  )
+{
+  if (Allocate) {
+    mUmmAllocatedSize += Size;
+    if (mUmmAllocatedSize > mUmmPeakAllocatedSize) {
+      mUmmPeakAllocatedSize = mUmmAllocatedSize;
+    }
+  } else {
+    mUmmAllocatedSize -= Size;
+  }
+}
+
+/**
+  Get slab page map index for memory within the heap.
+**/
+STATIC
+UINT32
+UmmSlabPage (
+  IN CONST VOID  *Ptr
+  )
+{
+  return (UINT32)(((UINTN)Ptr - mUmmPageBase) / UMM_SLAB_SIZE);
+}
+
+STATIC
+VOID
+UmmSlabLink (
+  IN OUT UMM_SLAB  *Slab
+  )
+{
+  UMM_SLAB_CLASS  *SlabClass;
+
+  SlabClass  = &mUmmClasses[Slab->Class];
+  Slab->Prev = NULL;
+  Slab->Next = SlabClass->Partial;
+  if (Slab->Next != NULL) {
+    Slab->Next->Prev = Slab;
+  }
+
+  SlabClass->Partial = Slab;
+}
+
+STATIC
+VOID
+UmmSlabUnlink (
+  IN OUT UMM_SLAB  *Slab
+  )
+{
+  if (Slab->Prev != NULL) {
+    Slab->Prev->Next = Slab->Next;
+  } else {
+    mUmmClasses[Slab->Class].Partial = Slab->Next;
+  }
+
+  if (Slab->Next != NULL) {
+    Slab->Next->Prev = Slab->Prev;
+  }
+}
+
+/**
+  Allocate new slab from the general purpose heap.
+
+  @param[in]  Class  Size class.
+
+  @retval new slab or NULL.
+**/
+STATIC
+UMM_SLAB *
+UmmSlabCreate (
+  IN UINT32  Class
+  )
+{
+  UMM_SLAB  *Slab;
+  VOID      *Allocation;
+
+  if (mUmmPageMap == NULL) {
+    return NULL;
+  }
+
+  Slab = InternalUmmMallocAligned (UMM_SLAB_SIZE, UMM_SLAB_SIZE, &Allocation);
+  if (Slab == NULL) {
+    return NULL;
+  }
+
+  Slab->FreeList   = NULL;
+  Slab->Allocation = Allocation;
+  Slab->Class      = (UINT16)Class;
+  Slab->Used       = 0;
+  Slab->Carved     = 0;
+  ZeroMem (Slab->UsedMap, sizeof (Slab->UsedMap));
+  UmmSlabLink (Slab);
+
+  mUmmPageMap[UmmSlabPage (Slab)] = (UINT8)(Class + 1);
+  ++mUmmClasses[Class].SlabCount;
+
+  return Slab;
+}
+
+/**
+  Return empty slab to the general purpose heap.
+
+  @param[in]  Slab  Slab to destroy.
+**/
+STATIC
+VOID
+UmmSlabDestroy (
+  IN UMM_SLAB  *Slab
+  )
+{
+  UmmSlabUnlink (Slab);
+  mUmmPageMap[UmmSlabPage (Slab)] = 0;
+  --mUmmClasses[Slab->Class].SlabCount;
+  InternalUmmFree (Slab->Allocation);
+}
+
+STATIC
+VOID *
+UmmSlabAllocate (
+  IN UINT32  Class
+  )
+{
+  UMM_SLAB  *Slab;
+  VOID      *Object;
+  UINTN     Index;
+
+  Slab = mUmmClasses[Class].Partial;
+  if (Slab == NULL) {
+    Slab = UmmSlabCreate (Class);
+    if (Slab == NULL) {
+      return NULL;
+    }
+  }
+
+  //
+  // Reuse freed objects first, then carve new ones to avoid
+  // touching the whole slab on creation.
+  //
+  if (Slab->FreeList != NULL) {
+    Object         = Slab->FreeList;
+    Slab->FreeList = *(VOID **)Object;
+  } else {
+    Object = (UINT8 *)Slab + UMM_SLAB_HEADER_SIZE + (UINTN)Slab->Carved * UMM_SLAB_CLASS_SIZE (Class);
+    ++Slab->Carved;
+  }
+
+  Index                    = ((UINTN)Object - (UINTN)Slab - UMM_SLAB_HEADER_SIZE) / UMM_SLAB_CLASS_SIZE (Class);
+  Slab->UsedMap[Index / 8] |= (UINT8)(1U << (Index % 8));
+
+  ++Slab->Used;
+  ++mUmmClasses[Class].UsedCount;
+
+  if (Slab->Used == UMM_SLAB_CAPACITY (Class)) {
+    UmmSlabUnlink (Slab);
+  }
+
+  return Object;
+}
+
+STATIC
+BOOLEAN
+UmmSlabFree (
+  IN VOID    *Ptr,
+  IN UINT32  Class
+  )
+{
+  UMM_SLAB  *Slab;
+  UINTN     Offset;
+  UINTN     Index;
+
+  Slab   = (UMM_SLAB *)(mUmmPageBase + (UINTN)UmmSlabPage (Ptr) * UMM_SLAB_SIZE);
+  Offset = (UINTN)Ptr - (UINTN)Slab;
+
+  if (  (Offset < UMM_SLAB_HEADER_SIZE)
+     || ((Offset - UMM_SLAB_HEADER_SIZE) % UMM_SLAB_CLASS_SIZE (Class) != 0)
+     || ((Offset - UMM_SLAB_HEADER_SIZE) / UMM_SLAB_CLASS_SIZE (Class) >= Slab->Carved))
+  {
+    return FALSE;
+  }
+
+  Index = (Offset - UMM_SLAB_HEADER_SIZE) / UMM_SLAB_CLASS_SIZE (Class);
+  if ((Slab->UsedMap[Index / 8] & (1U << (Index % 8))) == 0) {
+    return FALSE;
+  }
+
+  Slab->UsedMap[Index / 8] &= (UINT8) ~(1U << (Index % 8));
+
+  if (Slab->Used == UMM_SLAB_CAPACITY (Class)) {
+    UmmSlabLink (Slab);
+  }
+
+  *(VOID **)Ptr  = Slab->FreeList;
+  Slab->FreeList = Ptr;
+  --Slab->Used;
+  --mUmmClasses[Class].UsedCount;
+
+  //
+  // Keep a single empty slab per class to avoid thrashing on
+  // alternating allocations and frees.
+  //
+  if (  (Slab->Used == 0)
+     && ((Slab->Next != NULL) || (Slab->Prev != NULL)))
+  {
+    UmmSlabDestroy (Slab);
+  }
+
+  return TRUE;
+}
+
+BOOLEAN
+UmmInitialized (
+  VOID
+  )
+{
+  return InternalUmmInitialized ();
+}
+
+VOID
+UmmSetHeap (
+  IN VOID    *Heap,
+  IN UINT32  Size
+  )
+{
+  InternalUmmSetHeap (Heap, Size);
+
+  mUmmHeap              = Heap;
+  mUmmHeapSize          = Size;
+  mUmmAllocatedSize     = 0;
+  mUmmPeakAllocatedSize = 0;
+  ZeroMem (mUmmClasses, sizeof (mUmmClasses));
+
+  //
+  // Slabs are disabled when the page map cannot be allocated.
+  //
+  mUmmPageBase  = (UINTN)Heap & ~(UINTN)(UMM_SLAB_SIZE - 1);
+  mUmmPageCount = (UINT32)(((UINTN)Heap + Size - mUmmPageBase + UMM_SLAB_SIZE - 1) / UMM_SLAB_SIZE);
+  mUmmPageMap   = InternalUmmMalloc (mUmmPageCount);
+  if (mUmmPageMap != NULL) {
+    ZeroMem (mUmmPageMap, mUmmPageCount);
+  }
+}
+
+VOID *
+UmmMalloc (
+  IN UINT32  Size
+  )
+{
+  VOID    *Ptr;
+  UINT32  Class;
+
+  if (!InternalUmmInitialized () || (Size == 0)) {
+    return NULL;
+  }
+
+  if (Size <= UMM_SLAB_MAX_SIZE) {
+    Class = Size <= UMM_SLAB_CLASS_SIZE (0) ? 0 : (UINT32)HighBitSet32 (Size - 1) + 1 - UMM_SLAB_MIN_SHIFT;
+    Ptr   = UmmSlabAllocate (Class);
+    if (Ptr != NULL) {
+      UmmAccount (UMM_SLAB_CLASS_SIZE (Class), TRUE);
+      return Ptr;
+    }
+  }
+
+  Ptr = InternalUmmMalloc (Size);
+  if (Ptr != NULL) {
+    UmmAccount (InternalUmmUsableSize (Ptr), TRUE);
+  }
+
+  return Ptr;
+}
+
+BOOLEAN
+UmmFree (
+  IN VOID  *Ptr
+  )
+{
+  UINT8   *Memory;
+  UINT32  Class;
+  UINT32  Size;
+
+  Memory = Ptr;
+
+  if (  !InternalUmmInitialized ()
+     || (Memory < mUmmHeap)
+     || (Memory >= mUmmHeap + mUmmHeapSize))
+  {
+    return FALSE;
+  }
+
+  if ((mUmmPageMap != NULL) && (mUmmPageMap[UmmSlabPage (Memory)] != 0)) {
+    Class = mUmmPageMap[UmmSlabPage (Memory)] - 1U;
+    if (!UmmSlabFree (Memory, Class)) {
+      return FALSE;
+    }
+
+    UmmAccount (UMM_SLAB_CLASS_SIZE (Class), FALSE);
+    return TRUE;
+  }
+
+  Size = InternalUmmUsableSize (Memory);
+  if (!InternalUmmFree (Memory)) {
+    return FALSE;
+  }
+
+  UmmAccount (Size, FALSE);
+  return TRUE;
+}
+
+VOID
+UmmGetStatistics (
+  OUT UMM_STATISTICS  *Statistics
+  )
+{
+  UINT32  Class;
+  UINT32  SlabSize;
+
+  ZeroMem (Statistics, sizeof (*Statistics));
+
+  if (!InternalUmmInitialized ()) {
+    return;
+  }
+
+  Statistics->HeapSize          = mUmmHeapSize;
+  Statistics->AllocatedSize     = mUmmAllocatedSize;
+  Statistics->PeakAllocatedSize = mUmmPeakAllocatedSize;
+
+  InternalUmmFreeInfo (&Statistics->FreeSize, &Statistics->LargestFreeSize);
+  if (Statistics->FreeSize > 0) {
+    Statistics->Fragmentation = (UINT32)DivU64x32 (
+                                          MultU64x32 (Statistics->FreeSize - Statistics->LargestFreeSize, 100),
+                                          Statistics->FreeSize
+                                          );
+  }
+
+  for (Class = 0; Class < UMM_SLAB_CLASS_COUNT; ++Class) {
+    SlabSize                  = mUmmClasses[Class].SlabCount * UMM_SLAB_SIZE;
+    Statistics->SlabCount    += mUmmClasses[Class].SlabCount;
+    Statistics->SlabFreeSize += SlabSize - mUmmClasses[Class].UsedCount * UMM_SLAB_CLASS_SIZE (Class);
+  }
+}
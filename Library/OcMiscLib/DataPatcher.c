@@ -16,6 +16,7 @@
 #include <Library/BaseMemoryLib.h>
 #include <Library/BaseOverflowLib.h>
 #include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
 #include <Library/OcMiscLib.h>
 
 STATIC
@@ -182,3 +183,300 @@ ApplyPatch (
 
   return ReplaceCount;
 }
+
+//
+// Patches are compiled in groups sharing a single first byte lookup table.
+//
+#define PATCH_SET_GROUP_SIZE  32
+
+//
+// Maximum tracked matches per patch and modified ranges per group.
+// Exceeding either makes the rest of the group use ApplyPatch on current data.
+//
+#define PATCH_SET_MAX_MATCHES  64
+#define PATCH_SET_MAX_WRITTEN  256
+
+typedef struct {
+  UINT32     FirstByte[256];
+  UINT32     DataSize[PATCH_SET_GROUP_SIZE];
+  UINT32     MatchCount[PATCH_SET_GROUP_SIZE];
+  BOOLEAN    MatchOverflow[PATCH_SET_GROUP_SIZE];
+  UINT32     Matches[PATCH_SET_GROUP_SIZE][PATCH_SET_MAX_MATCHES];
+  UINT32     WrittenCount;
+  UINT32     Written[PATCH_SET_MAX_WRITTEN][2];
+} PATCH_SET_CONTEXT;
+
+STATIC
+BOOLEAN
+InternalPatternMatchesAt (
+  IN CONST OC_PATCH_SET_ENTRY  *Patch,
+  IN CONST UINT8               *Data,
+  IN UINT32                    DataOff
+  )
+{
+  UINT32  Index;
+
+  if (Patch->PatternMask == NULL) {
+    return CompareMem (&Data[DataOff], Patch->Pattern, Patch->PatternSize) == 0;
+  }
+
+  for (Index = 0; Index < Patch->PatternSize; ++Index) {
+    if ((Data[DataOff + Index] & Patch->PatternMask[Index]) != Patch->Pattern[Index]) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Find next offset at or after DataOff where the patch may match current data.
+  These are original matches and any window overlapping data modified since the scan.
+**/
+STATIC
+UINT32
+InternalPatchSetNextCandidate (
+  IN     PATCH_SET_CONTEXT  *Context,
+  IN     UINT32             Slot,
+  IN     UINT32             PatternSize,
+  IN     UINT32             DataOff,
+  IN OUT UINT32             *MatchIndex
+  )
+{
+  UINT32  Candidate;
+  UINT32  Last;
+  UINT32  Index;
+  UINT32  Low;
+  UINT32  High;
+
+  Last      = Context->DataSize[Slot] - PatternSize;
+  Candidate = MAX_UINT32;
+
+  while ((*MatchIndex < Context->MatchCount[Slot]) && (Context->Matches[Slot][*MatchIndex] < DataOff)) {
+    ++(*MatchIndex);
+  }
+
+  if (*MatchIndex < Context->MatchCount[Slot]) {
+    Candidate = Context->Matches[Slot][*MatchIndex];
+  }
+
+  for (Index = 0; Index < Context->WrittenCount; ++Index) {
+    Low  = Context->Written[Index][0] >= PatternSize ? Context->Written[Index][0] - PatternSize + 1 : 0;
+    High = MIN (Context->Written[Index][1] - 1, Last);
+    Low  = MAX (Low, DataOff);
+    if ((Low <= High) && (Low < Candidate)) {
+      Candidate = Low;
+    }
+  }
+
+  return Candidate;
+}
+
+STATIC
+VOID
+InternalPatchSetApplyOne (
+  IN OUT PATCH_SET_CONTEXT   *Context,
+  IN     UINT32              Slot,
+  IN OUT OC_PATCH_SET_ENTRY  *Patch,
+  IN OUT UINT8               *Data
+  )
+{
+  UINT32  DataOff;
+  UINT32  MatchIndex;
+  UINT32  Skip;
+  UINT32  Count;
+  UINT32  Index;
+
+  DataOff    = 0;
+  MatchIndex = 0;
+  Skip       = Patch->Skip;
+  Count      = Patch->Count;
+
+  while (TRUE) {
+    DataOff = InternalPatchSetNextCandidate (Context, Slot, Patch->PatternSize, DataOff, &MatchIndex);
+    if (DataOff == MAX_UINT32) {
+      break;
+    }
+
+    if (!InternalPatternMatchesAt (Patch, Data, DataOff)) {
+      ++DataOff;
+      continue;
+    }
+
+    if (Skip > 0) {
+      --Skip;
+      DataOff += Patch->PatternSize;
+      continue;
+    }
+
+    if (Patch->ReplaceMask == NULL) {
+      CopyMem (&Data[DataOff], Patch->Replace, Patch->PatternSize);
+    } else {
+      for (Index = 0; Index < Patch->PatternSize; ++Index) {
+        Data[DataOff + Index] = (Data[DataOff + Index] & ~Patch->ReplaceMask[Index]) | (Patch->Replace[Index] & Patch->ReplaceMask[Index]);
+      }
+    }
+
+    ASSERT (Context->WrittenCount < PATCH_SET_MAX_WRITTEN);
+    Context->Written[Context->WrittenCount][0] = DataOff;
+    Context->Written[Context->WrittenCount][1] = DataOff + Patch->PatternSize;
+    ++Context->WrittenCount;
+
+    ++Patch->ReplaceCount;
+    DataOff += Patch->PatternSize;
+
+    if (Count > 0) {
+      --Count;
+      if (Count == 0) {
+        break;
+      }
+    }
+
+    //
+    // Leave the fast path before running out of modified range slots.
+    //
+    if (Context->WrittenCount == PATCH_SET_MAX_WRITTEN) {
+      Patch->ReplaceCount += ApplyPatch (
+                               Patch->Pattern,
+                               Patch->PatternMask,
+                               Patch->PatternSize,
+                               Patch->Replace,
+                               Patch->ReplaceMask,
+                               &Data[DataOff],
+                               Context->DataSize[Slot] - DataOff,
+                               Count,
+                               Skip
+                               );
+      break;
+    }
+  }
+}
+
+STATIC
+VOID
+InternalApplyPatchSetGroup (
+  IN OUT PATCH_SET_CONTEXT   *Context,
+  IN OUT OC_PATCH_SET_ENTRY  *Patches,
+  IN     UINT32              PatchCount,
+  IN OUT UINT8               *Data,
+  IN     UINT32              DataSize
+  )
+{
+  UINT32              Slot;
+  UINT32              Value;
+  UINT32              DataOff;
+  UINT32              Pending;
+  BOOLEAN             Sequential;
+  OC_PATCH_SET_ENTRY  *Patch;
+
+  ASSERT (PatchCount <= PATCH_SET_GROUP_SIZE);
+
+  ZeroMem (Context, sizeof (*Context));
+
+  for (Slot = 0; Slot < PatchCount; ++Slot) {
+    Patch                   = &Patches[Slot];
+    Patch->ReplaceCount     = 0;
+    Context->DataSize[Slot] = DataSize;
+    if ((Patch->Limit > 0) && (Patch->Limit < DataSize)) {
+      Context->DataSize[Slot] = Patch->Limit;
+    }
+
+    if ((Patch->PatternSize == 0) || (Context->DataSize[Slot] < Patch->PatternSize)) {
+      continue;
+    }
+
+    for (Value = 0; Value < ARRAY_SIZE (Context->FirstByte); ++Value) {
+      if (((Patch->PatternMask == NULL) ? Value : (Value & Patch->PatternMask[0])) == Patch->Pattern[0]) {
+        Context->FirstByte[Value] |= 1U << Slot;
+      }
+    }
+  }
+
+  //
+  // Single sweep over the data collecting matches of all patches.
+  //
+  for (DataOff = 0; DataOff < DataSize; ++DataOff) {
+    Pending = Context->FirstByte[Data[DataOff]];
+    while (Pending != 0) {
+      Slot     = (UINT32)LowBitSet32 (Pending);
+      Pending &= Pending - 1;
+      Patch    = &Patches[Slot];
+
+      if (  (Context->DataSize[Slot] - Patch->PatternSize < DataOff)
+         || !InternalPatternMatchesAt (Patch, Data, DataOff))
+      {
+        continue;
+      }
+
+      if (Context->MatchCount[Slot] == PATCH_SET_MAX_MATCHES) {
+        Context->MatchOverflow[Slot] = TRUE;
+        continue;
+      }
+
+      Context->Matches[Slot][Context->MatchCount[Slot]] = DataOff;
+      ++Context->MatchCount[Slot];
+    }
+  }
+
+  //
+  // Apply patches in order. Each one observes the changes made by previous ones,
+  // which gives the same result as applying them one by one.
+  //
+  Sequential = FALSE;
+  for (Slot = 0; Slot < PatchCount; ++Slot) {
+    Patch = &Patches[Slot];
+
+    if ((Patch->PatternSize == 0) || (Context->DataSize[Slot] < Patch->PatternSize)) {
+      continue;
+    }
+
+    if (Context->MatchOverflow[Slot] || (Context->WrittenCount == PATCH_SET_MAX_WRITTEN)) {
+      //
+      // Modified ranges are no longer tracked, remaining patches cannot rely on the sweep.
+      //
+      Sequential = TRUE;
+    }
+
+    if (Sequential) {
+      Patch->ReplaceCount = ApplyPatch (
+                              Patch->Pattern,
+                              Patch->PatternMask,
+                              Patch->PatternSize,
+                              Patch->Replace,
+                              Patch->ReplaceMask,
+                              Data,
+                              Context->DataSize[Slot],
+                              Patch->Count,
+                              Patch->Skip
+                              );
+    } else {
+      InternalPatchSetApplyOne (Context, Slot, Patch, Data);
+    }
+  }
+}
+
+EFI_STATUS
+ApplyPatchSet (
+  IN OUT OC_PATCH_SET_ENTRY  *Patches,
+  IN     UINT32              PatchCount,
+  IN OUT UINT8               *Data,
+  IN     UINT32              DataSize
+  )
+{
+  PATCH_SET_CONTEXT  *Context;
+  UINT32             Index;
+  UINT32             GroupSize;
+
+  Context = AllocatePool (sizeof (*Context));
+  if (Context == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Index = 0; Index < PatchCount; Index += GroupSize) {
+    GroupSize = MIN (PatchCount - Index, PATCH_SET_GROUP_SIZE);
+    InternalApplyPatchSetGroup (Context, &Patches[Index], GroupSize, Data, DataSize);
+  }
+
+  FreePool (Context);
+  return EFI_SUCCESS;
+}
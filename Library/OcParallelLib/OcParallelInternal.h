@@ -0,0 +1,83 @@
+/** @file
+  Copyright (C) 2026, Acidanthera. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#ifndef OC_PARALLEL_INTERNAL_H
+#define OC_PARALLEL_INTERNAL_H
+
+#include <Library/OcParallelLib.h>
+
+///
+/// Items assigned to a single worker. Next is advanced atomically, so that
+/// idle workers may take items from the queues of busy ones.
+///
+typedef struct {
+  volatile UINT32    Next;
+  UINT32             End;
+} OC_PARALLEL_QUEUE;
+
+///
+/// Shared state of a running parallel job.
+///
+typedef struct {
+  OC_PARALLEL_FUNCTION    Function;
+  VOID                    *Context;
+  UINT32                  NumWorkers;
+  volatile UINT32         NextWorker;
+  OC_PARALLEL_QUEUE       Queues[OC_PARALLEL_MAX_WORKERS];
+} OC_PARALLEL_JOB;
+
+/**
+  Prepare job state by splitting items into contiguous per-worker queues.
+
+  @param[out]     Job         Job state.
+  @param[in]      Function    Job function.
+  @param[in,out]  Context     Job context.
+  @param[in]      Count       Number of job items.
+  @param[in]      NumWorkers  Number of workers, 1 to OC_PARALLEL_MAX_WORKERS.
+**/
+VOID
+InternalParallelInitJob (
+  OUT    OC_PARALLEL_JOB       *Job,
+  IN     OC_PARALLEL_FUNCTION  Function,
+  IN OUT VOID                  *Context,
+  IN     UINT32                Count,
+  IN     UINT32                NumWorkers
+  );
+
+/**
+  Claim next worker index for a processor joining the job.
+
+  @param[in,out]  Job         Job state.
+
+  @retval Worker index, NumWorkers or higher when no more workers are needed.
+**/
+UINT32
+InternalParallelClaimWorker (
+  IN OUT OC_PARALLEL_JOB  *Job
+  );
+
+/**
+  Run job items of the worker queue, then take remaining items
+  from other worker queues until all are exhausted.
+
+  @param[in,out]  Job         Job state.
+  @param[in]      Worker      Worker index.
+**/
+VOID
+InternalParallelRunWorker (
+  IN OUT OC_PARALLEL_JOB  *Job,
+  IN     UINT32           Worker
+  );
+
+#endif // OC_PARALLEL_INTERNAL_H
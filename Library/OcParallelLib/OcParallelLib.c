@@ -0,0 +1,351 @@
+/** @file
+  Parallel job dispatch via EFI MP Services.
+
+  Copyright (C) 2026, Acidanthera. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include "OcParallelInternal.h"
+
+#include <Protocol/MpService.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+
+///
+/// Background task running on an application processor.
+///
+typedef struct {
+  EFI_EVENT               Event;
+  OC_PARALLEL_FUNCTION    Function;
+  VOID                    *Context;
+} INTERNAL_PARALLEL_TASK;
+
+STATIC EFI_MP_SERVICES_PROTOCOL  *mMpServices;
+STATIC UINTN                     mWorkerCount;
+STATIC UINTN                     mTaskProcessor;
+
+/**
+  Discover usable application processors once.
+**/
+STATIC
+VOID
+ParallelInit (
+  VOID
+  )
+{
+  EFI_STATUS                 Status;
+  UINTN                      NumberOfProcessors;
+  UINTN                      NumberOfEnabledProcessors;
+  UINTN                      Index;
+  EFI_PROCESSOR_INFORMATION  Info;
+
+  if (mWorkerCount != 0) {
+    return;
+  }
+
+  mWorkerCount = 1;
+
+  Status = gBS->LocateProtocol (
+                  &gEfiMpServiceProtocolGuid,
+                  NULL,
+                  (VOID **)&mMpServices
+                  );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCPL: No MP services - %r\n", Status));
+    mMpServices = NULL;
+    return;
+  }
+
+  Status = mMpServices->GetNumberOfProcessors (
+                          mMpServices,
+                          &NumberOfProcessors,
+                          &NumberOfEnabledProcessors
+                          );
+  if (EFI_ERROR (Status) || (NumberOfEnabledProcessors < 2)) {
+    DEBUG ((DEBUG_INFO, "OCPL: No application processors - %r\n", Status));
+    mMpServices = NULL;
+    return;
+  }
+
+  //
+  // Background tasks go to the first enabled application processor.
+  //
+  for (Index = 0; Index < NumberOfProcessors; ++Index) {
+    Status = mMpServices->GetProcessorInfo (mMpServices, Index, &Info);
+    if (  !EFI_ERROR (Status)
+       && ((Info.StatusFlag & PROCESSOR_AS_BSP_BIT) == 0)
+       && ((Info.StatusFlag & PROCESSOR_ENABLED_BIT) != 0))
+    {
+      mTaskProcessor = Index;
+      break;
+    }
+  }
+
+  if (Index == NumberOfProcessors) {
+    DEBUG ((DEBUG_INFO, "OCPL: No enabled application processors\n"));
+    mMpServices = NULL;
+    return;
+  }
+
+  mWorkerCount = MIN (NumberOfEnabledProcessors, OC_PARALLEL_MAX_WORKERS);
+
+  DEBUG ((DEBUG_INFO, "OCPL: Using %u workers\n", (UINT32)mWorkerCount));
+}
+
+/**
+  Check whether application processors may be used right now.
+  Non-blocking MP Services signal completion from a timer at TPL_NOTIFY,
+  so waiting at or above that level would never finish.
+
+  @retval TRUE when application processors can be used.
+**/
+STATIC
+BOOLEAN
+ParallelCanUseAps (
+  VOID
+  )
+{
+  ParallelInit ();
+
+  return (mMpServices != NULL) && (EfiGetCurrentTpl () < TPL_NOTIFY);
+}
+
+/**
+  Wait for application processors to signal completion.
+
+  @param[in]  Event    Completion event.
+**/
+STATIC
+VOID
+ParallelWaitEvent (
+  IN EFI_EVENT  Event
+  )
+{
+  while (gBS->CheckEvent (Event) == EFI_NOT_READY) {
+    CpuPause ();
+  }
+
+  gBS->CloseEvent (Event);
+}
+
+/**
+  Application processor entry point for parallel jobs.
+
+  @param[in,out]  Buffer   Job state.
+**/
+STATIC
+VOID
+EFIAPI
+ParallelJobProcedure (
+  IN OUT VOID  *Buffer
+  )
+{
+  OC_PARALLEL_JOB  *Job;
+  UINT32           Worker;
+
+  Job    = Buffer;
+  Worker = InternalParallelClaimWorker (Job);
+  if (Worker < Job->NumWorkers) {
+    InternalParallelRunWorker (Job, Worker);
+  }
+}
+
+/**
+  Application processor entry point for background tasks.
+
+  @param[in,out]  Buffer   Task state.
+**/
+STATIC
+VOID
+EFIAPI
+ParallelTaskProcedure (
+  IN OUT VOID  *Buffer
+  )
+{
+  INTERNAL_PARALLEL_TASK  *Task;
+
+  Task = Buffer;
+  Task->Function (Task->Context, 0, 0);
+}
+
+UINTN
+OcParallelGetWorkerCount (
+  VOID
+  )
+{
+  ParallelInit ();
+  return mWorkerCount;
+}
+
+VOID
+OcParallelFor (
+  IN     OC_PARALLEL_FUNCTION  Function,
+  IN OUT VOID                  *Context,
+  IN     UINTN                 Count,
+  IN     UINTN                 MaxWorkers
+  )
+{
+  EFI_STATUS       Status;
+  OC_PARALLEL_JOB  Job;
+  UINTN            NumWorkers;
+  EFI_EVENT        Event;
+  UINT32           Worker;
+
+  ASSERT (Function != NULL);
+  ASSERT (Count <= MAX_UINT32);
+
+  if (Count == 0) {
+    return;
+  }
+
+  NumWorkers = OcParallelGetWorkerCount ();
+  if ((MaxWorkers != 0) && (MaxWorkers < NumWorkers)) {
+    NumWorkers = MaxWorkers;
+  }
+
+  if (Count < NumWorkers) {
+    NumWorkers = Count;
+  }
+
+  if ((NumWorkers < 2) || !ParallelCanUseAps ()) {
+    NumWorkers = 1;
+  }
+
+  InternalParallelInitJob (&Job, Function, Context, (UINT32)Count, (UINT32)NumWorkers);
+
+  //
+  // BSP always runs worker 0.
+  //
+  Worker = InternalParallelClaimWorker (&Job);
+  ASSERT (Worker == 0);
+
+  if (NumWorkers == 1) {
+    InternalParallelRunWorker (&Job, Worker);
+    return;
+  }
+
+  //
+  // Prefer non-blocking mode to let the BSP do its share of work.
+  // Fall back to blocking mode, where the BSP only picks up leftovers.
+  // Whatever fails, the BSP still runs all remaining items below.
+  //
+  Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &Event);
+  if (!EFI_ERROR (Status)) {
+    Status = mMpServices->StartupAllAPs (
+                            mMpServices,
+                            ParallelJobProcedure,
+                            FALSE,
+                            Event,
+                            0,
+                            &Job,
+                            NULL
+                            );
+    if (EFI_ERROR (Status)) {
+      gBS->CloseEvent (Event);
+    }
+  }
+
+  if (!EFI_ERROR (Status)) {
+    InternalParallelRunWorker (&Job, Worker);
+    ParallelWaitEvent (Event);
+    return;
+  }
+
+  if (Status == EFI_UNSUPPORTED) {
+    Status = mMpServices->StartupAllAPs (
+                            mMpServices,
+                            ParallelJobProcedure,
+                            FALSE,
+                            NULL,
+                            0,
+                            &Job,
+                            NULL
+                            );
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_VERBOSE, "OCPL: Running %u items on BSP - %r\n", (UINT32)Count, Status));
+  }
+
+  InternalParallelRunWorker (&Job, Worker);
+}
+
+VOID
+OcParallelStartTask (
+  IN     OC_PARALLEL_FUNCTION  Function,
+  IN OUT VOID                  *Context,
+  OUT    OC_PARALLEL_TASK      *Task
+  )
+{
+  EFI_STATUS              Status;
+  INTERNAL_PARALLEL_TASK  *Internal;
+
+  ASSERT (Function != NULL);
+  ASSERT (Task != NULL);
+
+  Task->Handle = NULL;
+
+  if (ParallelCanUseAps ()) {
+    Internal = AllocatePool (sizeof (*Internal));
+    if (Internal != NULL) {
+      Internal->Function = Function;
+      Internal->Context  = Context;
+
+      Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &Internal->Event);
+      if (!EFI_ERROR (Status)) {
+        Status = mMpServices->StartupThisAP (
+                                mMpServices,
+                                ParallelTaskProcedure,
+                                mTaskProcessor,
+                                Internal->Event,
+                                0,
+                                Internal,
+                                NULL
+                                );
+        if (!EFI_ERROR (Status)) {
+          Task->Handle = Internal;
+          return;
+        }
+
+        gBS->CloseEvent (Internal->Event);
+      }
+
+      FreePool (Internal);
+    }
+  }
+
+  Function (Context, 0, 0);
+}
+
+VOID
+OcParallelWaitTask (
+  IN OUT OC_PARALLEL_TASK  *Task
+  )
+{
+  INTERNAL_PARALLEL_TASK  *Internal;
+
+  ASSERT (Task != NULL);
+
+  Internal = Task->Handle;
+  if (Internal == NULL) {
+    return;
+  }
+
+  ParallelWaitEvent (Internal->Event);
+  FreePool (Internal);
+  Task->Handle = NULL;
+}
@@ -0,0 +1,113 @@
+/** @file
+  Copyright (C) 2026, Acidanthera. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include "OcParallelInternal.h"
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/SynchronizationLib.h>
+
+VOID
+InternalParallelInitJob (
+  OUT    OC_PARALLEL_JOB       *Job,
+  IN     OC_PARALLEL_FUNCTION  Function,
+  IN OUT VOID                  *Context,
+  IN     UINT32                Count,
+  IN     UINT32                NumWorkers
+  )
+{
+  UINT32  Index;
+  UINT32  Start;
+
+  ASSERT (NumWorkers > 0);
+  ASSERT (NumWorkers <= OC_PARALLEL_MAX_WORKERS);
+
+  Job->Function   = Function;
+  Job->Context    = Context;
+  Job->NumWorkers = NumWorkers;
+  Job->NextWorker = 0;
+
+  //
+  // Neighbouring items usually touch neighbouring memory, keep them together.
+  //
+  Start = 0;
+  for (Index = 0; Index < NumWorkers; ++Index) {
+    Job->Queues[Index].Next = Start;
+    Start                  += Count / NumWorkers + (Index < Count % NumWorkers ? 1 : 0);
+    Job->Queues[Index].End  = Start;
+  }
+
+  ASSERT (Start == Count);
+}
+
+UINT32
+InternalParallelClaimWorker (
+  IN OUT OC_PARALLEL_JOB  *Job
+  )
+{
+  return InterlockedIncrement (&Job->NextWorker) - 1;
+}
+
+/**
+  Take next item from worker queue.
+
+  @param[in,out]  Queue       Worker queue.
+  @param[out]     Item        Item index.
+
+  @retval TRUE when item was taken.
+**/
+STATIC
+BOOLEAN
+ParallelQueuePop (
+  IN OUT OC_PARALLEL_QUEUE  *Queue,
+  OUT    UINT32             *Item
+  )
+{
+  //
+  // Check first to avoid atomics on drained queues. Next may still go past End
+  // by at most one per worker, which is harmless.
+  //
+  if (Queue->Next >= Queue->End) {
+    return FALSE;
+  }
+
+  *Item = InterlockedIncrement (&Queue->Next) - 1;
+  return *Item < Queue->End;
+}
+
+VOID
+InternalParallelRunWorker (
+  IN OUT OC_PARALLEL_JOB  *Job,
+  IN     UINT32           Worker
+  )
+{
+  UINT32  Victim;
+  UINT32  Item;
+
+  //
+  // This runs on application processors, no debug printing is allowed.
+  //
+  Victim = Worker;
+  do {
+    while (ParallelQueuePop (&Job->Queues[Victim], &Item)) {
+      Job->Function (Job->Context, Item, Worker);
+    }
+
+    ++Victim;
+    if (Victim == Job->NumWorkers) {
+      Victim = 0;
+    }
+  } while (Victim != Worker);
+}
@@ -327,7 +327,9 @@ PeCoffSanitiseAppleImage (
   return EFI_SUCCESS;
 }
 
+#ifndef EFIUSER
 STATIC
+#endif
 VOID
 PeCoffHashAppleImage (
   IN  PE_COFF_LOADER_IMAGE_CONTEXT  *Context,
@@ -376,13 +378,172 @@ PeCoffHashAppleImage (
   Sha256Final (&HashContext, Hash);
 }
 
-#ifndef EFIUSER
+/**
+  Locate hashed regions in the image headers read so far.
+  The layout is validated again against the complete image before use.
+
+  @param[in,out] Context    Hash context.
+  @param[in]     Available  Number of bytes filled from the image start.
+
+  @retval EFI_SUCCESS      Headers describe an Apple signed image.
+  @retval EFI_UNSUPPORTED  Headers are incomplete or have no Apple signature directory.
+**/
 STATIC
-#endif
 EFI_STATUS
-InternalPeCoffVerifyAppleSignatureFromContext (
+PeCoffAppleHashParseLayout (
+  IN OUT PE_COFF_APPLE_HASH_CONTEXT  *Context,
+  IN     UINT32                      Available
+  )
+{
+  CONST UINT8  *Buffer;
+  UINT32       ExeHdrOffset;
+  UINT32       DirectoryOffset;
+  UINT32       CountOffset;
+  UINT32       SecDirOffset;
+  UINT32       SignedFileSize;
+
+  Buffer = Context->FileBuffer;
+
+  //
+  // Apple images are required to start with DOS header.
+  //
+  if (  (Available < sizeof (EFI_IMAGE_DOS_HEADER))
+     || (ReadUnaligned16 ((CONST UINT16 *)Buffer) != EFI_IMAGE_DOS_SIGNATURE))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  ExeHdrOffset = ReadUnaligned32 (
+                   (CONST UINT32 *)(Buffer + OFFSET_OF (EFI_IMAGE_DOS_HEADER, e_lfanew))
+                   );
+  if (  (ExeHdrOffset < sizeof (EFI_IMAGE_DOS_HEADER))
+     || (ExeHdrOffset > Available)
+     || (Available - ExeHdrOffset < sizeof (EFI_IMAGE_NT_HEADERS_COMMON_HDR) + sizeof (UINT16))
+     || (ReadUnaligned32 ((CONST UINT32 *)(Buffer + ExeHdrOffset)) != EFI_IMAGE_NT_SIGNATURE))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  switch (ReadUnaligned16 ((CONST UINT16 *)(Buffer + ExeHdrOffset + sizeof (EFI_IMAGE_NT_HEADERS_COMMON_HDR)))) {
+    case EFI_IMAGE_NT_OPTIONAL_HDR32_MAGIC:
+      DirectoryOffset = OFFSET_OF (EFI_IMAGE_NT_HEADERS32, DataDirectory);
+      CountOffset     = OFFSET_OF (EFI_IMAGE_NT_HEADERS32, NumberOfRvaAndSizes);
+      break;
+
+    case EFI_IMAGE_NT_OPTIONAL_HDR64_MAGIC:
+      DirectoryOffset = OFFSET_OF (EFI_IMAGE_NT_HEADERS64, DataDirectory);
+      CountOffset     = OFFSET_OF (EFI_IMAGE_NT_HEADERS64, NumberOfRvaAndSizes);
+      break;
+
+    default:
+      return EFI_UNSUPPORTED;
+  }
+
+  DirectoryOffset += EFI_IMAGE_DIRECTORY_ENTRY_SECURITY * sizeof (EFI_IMAGE_DATA_DIRECTORY);
+  if (  (Available - ExeHdrOffset < DirectoryOffset + sizeof (EFI_IMAGE_DATA_DIRECTORY))
+     || (ReadUnaligned32 ((CONST UINT32 *)(Buffer + ExeHdrOffset + CountOffset)) <= EFI_IMAGE_DIRECTORY_ENTRY_SECURITY))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  SecDirOffset = ExeHdrOffset + DirectoryOffset;
+
+  //
+  // Apple signature directory is a single certificate info, see PeCoffGetAppleCertificateInfo.
+  //
+  if (  ReadUnaligned32 ((CONST UINT32 *)(Buffer + SecDirOffset + OFFSET_OF (EFI_IMAGE_DATA_DIRECTORY, Size)))
+     != sizeof (APPLE_EFI_CERTIFICATE_INFO))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  SignedFileSize = ReadUnaligned32 (
+                     (CONST UINT32 *)(Buffer + SecDirOffset + OFFSET_OF (EFI_IMAGE_DATA_DIRECTORY, VirtualAddress))
+                     );
+  if (  !BASE_TYPE_ALIGNED (APPLE_EFI_CERTIFICATE_INFO, SignedFileSize)
+     || (SignedFileSize < SecDirOffset + sizeof (EFI_IMAGE_DATA_DIRECTORY))
+     || (SignedFileSize > Context->FileSize))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  Context->ExeHdrOffset   = ExeHdrOffset;
+  Context->SecDirOffset   = SecDirOffset;
+  Context->SignedFileSize = SignedFileSize;
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+PeCoffAppleHashInit (
+  OUT PE_COFF_APPLE_HASH_CONTEXT  *Context,
+  IN  CONST VOID                  *FileBuffer,
+  IN  UINT32                      FileSize,
+  IN  UINT32                      Available
+  )
+{
+  EFI_STATUS  Status;
+
+  ASSERT (Context != NULL);
+  ASSERT (FileBuffer != NULL);
+  ASSERT (Available <= FileSize);
+
+  ZeroMem (Context, sizeof (*Context));
+  Context->FileBuffer = FileBuffer;
+  Context->FileSize   = FileSize;
+
+  Status = PeCoffAppleHashParseLayout (Context, Available);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Sha256Init (&Context->HashContext);
+  PeCoffAppleHashUpdate (Context, Available);
+  return EFI_SUCCESS;
+}
+
+VOID
+PeCoffAppleHashUpdate (
+  IN OUT PE_COFF_APPLE_HASH_CONTEXT  *Context,
+  IN     UINT32                      Available
+  )
+{
+  UINT32  Regions[4][2];
+  UINT32  Index;
+  UINT32  Start;
+  UINT32  End;
+
+  ASSERT (Context != NULL);
+  ASSERT (Available <= Context->FileSize);
+
+  //
+  // Hashed regions in file order, matching PeCoffHashAppleImage.
+  //
+  Regions[0][0] = 0;
+  Regions[0][1] = sizeof (EFI_IMAGE_DOS_HEADER);
+  Regions[1][0] = Context->ExeHdrOffset;
+  Regions[1][1] = Context->ExeHdrOffset + APPLE_CHECKSUM_OFFSET;
+  Regions[2][0] = Regions[1][1] + APPLE_CHECKSUM_SIZE;
+  Regions[2][1] = Context->SecDirOffset;
+  Regions[3][0] = Context->SecDirOffset + sizeof (EFI_IMAGE_DATA_DIRECTORY);
+  Regions[3][1] = Context->SignedFileSize;
+
+  for (Index = 0; Index < ARRAY_SIZE (Regions); ++Index) {
+    Start = MAX (Regions[Index][0], Context->Hashed);
+    End   = MIN (Regions[Index][1], Available);
+    if (Start < End) {
+      Sha256Update (&Context->HashContext, Context->FileBuffer + Start, End - Start);
+    }
+  }
+
+  Context->Hashed = MAX (Context->Hashed, Available);
+}
+
+STATIC
+EFI_STATUS
+InternalPeCoffVerifyAppleSignature (
   IN OUT PE_COFF_LOADER_IMAGE_CONTEXT  *ImageContext,
-  IN OUT  UINT32                       *ImageSize
+  IN OUT UINT32                        *ImageSize,
+  IN     PE_COFF_APPLE_HASH_CONTEXT    *HashContext  OPTIONAL
   )
 {
   EFI_STATUS                  ImageStatus;
@@ -392,6 +553,7 @@ InternalPeCoffVerifyAppleSignatureFromContext (
   APPLE_EFI_CERTIFICATE_INFO  *CertInfo;
   UINT32                      SecDirOffset;
   UINT32                      SignedFileSize;
+  SHA256_CONTEXT              StreamedHash;
 
   ImageStatus = PeCoffGetAppleCertificateInfo (
                   ImageContext,
@@ -415,6 +577,22 @@ InternalPeCoffVerifyAppleSignatureFromContext (
     return EFI_UNSUPPORTED;
   }
 
+  //
+  // Streamed hash can only be used when it covers the very same regions.
+  //
+  if (  (HashContext != NULL)
+     && (HashContext->FileBuffer == ImageContext->FileBuffer)
+     && (HashContext->FileSize == *ImageSize)
+     && (HashContext->Hashed >= SignedFileSize)
+     && (HashContext->ExeHdrOffset == ImageContext->ExeHdrOffset)
+     && (HashContext->SecDirOffset == SecDirOffset)
+     && (HashContext->SignedFileSize == SignedFileSize))
+  {
+    CopyMem (&StreamedHash, &HashContext->HashContext, sizeof (StreamedHash));
+  } else {
+    HashContext = NULL;
+  }
+
   ImageStatus = PeCoffSanitiseAppleImage (
                   ImageContext,
                   SecDirOffset,
@@ -428,12 +606,16 @@ InternalPeCoffVerifyAppleSignatureFromContext (
 
   *ImageSize = SignedFileSize;
 
-  PeCoffHashAppleImage (
-    ImageContext,
-    SecDirOffset,
-    SignedFileSize,
-    &Hash[0]
-    );
+  if (HashContext != NULL) {
+    Sha256Final (&StreamedHash, &Hash[0]);
+  } else {
+    PeCoffHashAppleImage (
+      ImageContext,
+      SecDirOffset,
+      SignedFileSize,
+      &Hash[0]
+      );
+  }
 
   //
   // Verify signature
@@ -454,11 +636,33 @@ InternalPeCoffVerifyAppleSignatureFromContext (
   return EFI_SUCCESS;
 }
 
+#ifndef EFIUSER
+STATIC
+#endif
+EFI_STATUS
+InternalPeCoffVerifyAppleSignatureFromContext (
+  IN OUT PE_COFF_LOADER_IMAGE_CONTEXT  *ImageContext,
+  IN OUT  UINT32                       *ImageSize
+  )
+{
+  return InternalPeCoffVerifyAppleSignature (ImageContext, ImageSize, NULL);
+}
+
 EFI_STATUS
 PeCoffVerifyAppleSignature (
   IN OUT VOID    *PeImage,
   IN OUT UINT32  *ImageSize
   )
+{
+  return PeCoffVerifyAppleSignatureWithHash (PeImage, ImageSize, NULL);
+}
+
+EFI_STATUS
+PeCoffVerifyAppleSignatureWithHash (
+  IN OUT VOID                        *PeImage,
+  IN OUT UINT32                      *ImageSize,
+  IN     PE_COFF_APPLE_HASH_CONTEXT  *HashContext  OPTIONAL
+  )
 {
   EFI_STATUS                    ImageStatus;
   PE_COFF_LOADER_IMAGE_CONTEXT  ImageContext;
@@ -474,7 +678,7 @@ PeCoffVerifyAppleSignature (
     return EFI_UNSUPPORTED;
   }
 
-  return InternalPeCoffVerifyAppleSignatureFromContext (&ImageContext, ImageSize);
+  return InternalPeCoffVerifyAppleSignature (&ImageContext, ImageSize, HashContext);
 }
 
 #ifndef EFIUSER
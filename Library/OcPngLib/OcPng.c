@@ -16,11 +16,244 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 **/
 #include <Base.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseOverflowLib.h>
 #include <Library/DebugLib.h>
 #include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
 #include <Library/OcPngLib.h>
 #include "lodepng.h"
 
+//
+// Largest scanline buffer accepted by the single pass decoder,
+// matches the lodepng allocation limit.
+//
+#define OC_PNG_MAX_SCANLINES_SIZE  ((UINTN)256 * 1024 * 1024)
+
+//
+// PNG filter types.
+//
+#define OC_PNG_FILTER_NONE   0U
+#define OC_PNG_FILTER_SUB    1U
+#define OC_PNG_FILTER_UP     2U
+#define OC_PNG_FILTER_AVG    3U
+#define OC_PNG_FILTER_PAETH  4U
+
+//
+// Userspace builds set EFIUSER_SIMD when they assemble X64/PngSimd.nasm.
+//
+#if defined (MDE_CPU_X64) && (!defined (EFIUSER) || defined (EFIUSER_SIMD))
+#define OC_PNG_SIMD
+#endif
+
+//
+// SIMD kernels used for decoding an image.
+//
+#define OC_PNG_SIMD_SSE2   BIT0
+#define OC_PNG_SIMD_SSSE3  BIT1
+
+#ifdef OC_PNG_SIMD
+
+///
+/// Detected SIMD features with OC_PNG_SIMD_DETECTED set, zero until detection.
+/// Concurrent detection from application processors is benign.
+///
+#define OC_PNG_SIMD_DETECTED  BIT31
+
+STATIC volatile UINT32  mPngSimdFeatures;
+
+///
+/// Vector state and RFLAGS saved for the duration of decoding an image.
+///
+typedef struct {
+  UINT8     Xmm[6][16];
+  UINT64    Rflags;
+} OC_PNG_SIMD_STATE;
+
+/**
+  Save XMM0-XMM5 and disable interrupts before calling the kernels,
+  as UEFI does not (officially) support vector registers as a part of the context.
+  Kernels using XMM6-XMM7 preserve them.
+
+  @param[out] State  Saved state.
+**/
+VOID
+EFIAPI
+InternalPngSimdEnter (
+  OUT OC_PNG_SIMD_STATE  *State
+  );
+
+/**
+  Restore XMM0-XMM5 and the interrupt flag saved by InternalPngSimdEnter.
+
+  @param[in] State  Saved state.
+**/
+VOID
+EFIAPI
+InternalPngSimdLeave (
+  IN CONST OC_PNG_SIMD_STATE  *State
+  );
+
+/**
+  Reconstruct Up filtered bytes in 16-byte blocks. Requires SSE2.
+
+  @param[in,out] Row     Filtered row.
+  @param[in]     Prev    Reconstructed previous row.
+  @param[in]     Length  Row length in bytes.
+
+  @retval Number of reconstructed bytes from the start of the row.
+**/
+UINTN
+EFIAPI
+InternalPngUnfilterUpSse2 (
+  IN OUT UINT8        *Row,
+  IN     CONST UINT8  *Prev,
+  IN     UINTN        Length
+  );
+
+/**
+  Reconstruct Sub filtered pixels. Requires SSE2.
+
+  @param[in,out] Row     Filtered row.
+  @param[in]     Length  Row length in bytes.
+  @param[in]     Bpp     Bytes per pixel, 3 or 4.
+
+  @retval Number of reconstructed bytes from the start of the row.
+**/
+UINTN
+EFIAPI
+InternalPngUnfilterSubSse2 (
+  IN OUT UINT8  *Row,
+  IN     UINTN  Length,
+  IN     UINTN  Bpp
+  );
+
+/**
+  Reconstruct Average filtered pixels. Requires SSE2.
+
+  @param[in,out] Row     Filtered row.
+  @param[in]     Prev    Reconstructed previous row.
+  @param[in]     Length  Row length in bytes.
+  @param[in]     Bpp     Bytes per pixel, 3 or 4.
+
+  @retval Number of reconstructed bytes from the start of the row.
+**/
+UINTN
+EFIAPI
+InternalPngUnfilterAvgSse2 (
+  IN OUT UINT8        *Row,
+  IN     CONST UINT8  *Prev,
+  IN     UINTN        Length,
+  IN     UINTN        Bpp
+  );
+
+/**
+  Reconstruct Paeth filtered pixels. Requires SSE2.
+
+  @param[in,out] Row     Filtered row.
+  @param[in]     Prev    Reconstructed previous row.
+  @param[in]     Length  Row length in bytes.
+  @param[in]     Bpp     Bytes per pixel, 3 or 4.
+
+  @retval Number of reconstructed bytes from the start of the row.
+**/
+UINTN
+EFIAPI
+InternalPngUnfilterPaethSse2 (
+  IN OUT UINT8        *Row,
+  IN     CONST UINT8  *Prev,
+  IN     UINTN        Length,
+  IN     UINTN        Bpp
+  );
+
+/**
+  Convert 4-pixel blocks of RGBA to BGRA. Requires SSSE3.
+
+  @param[out] Dst          Destination pixels.
+  @param[in]  Src          Source RGBA pixels.
+  @param[in]  Blocks       Number of 4-pixel blocks.
+  @param[in]  Premultiply  Premultiply colour channels by alpha.
+**/
+VOID
+EFIAPI
+InternalPngRgbaToBgraSsse3 (
+  OUT UINT32       *Dst,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        Blocks,
+  IN  BOOLEAN      Premultiply
+  );
+
+/**
+  Convert 4-pixel blocks of RGB to opaque BGRA. Requires SSSE3.
+  Every block reads 16 source bytes, of which 12 are used.
+
+  @param[out] Dst     Destination pixels.
+  @param[in]  Src     Source RGB pixels.
+  @param[in]  Blocks  Number of 4-pixel blocks.
+**/
+VOID
+EFIAPI
+InternalPngRgbToBgraSsse3 (
+  OUT UINT32       *Dst,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        Blocks
+  );
+
+#endif
+
+/**
+  Get SIMD kernels to decode an image with.
+
+  @retval OC_PNG_SIMD_* bits, zero for C code only.
+**/
+STATIC
+UINT32
+InternalPngGetSimd (
+  VOID
+  )
+{
+ #ifdef OC_PNG_SIMD
+  UINT32  Features;
+  UINT32  RegEcx;
+
+  Features = mPngSimdFeatures;
+  if (Features == 0) {
+    AsmCpuid (1, NULL, NULL, &RegEcx, NULL);
+
+    //
+    // SSE2 is architectural on X64.
+    //
+    Features = OC_PNG_SIMD_DETECTED | OC_PNG_SIMD_SSE2;
+    if ((RegEcx & BIT9) != 0) {
+      Features |= OC_PNG_SIMD_SSSE3;
+    }
+
+    mPngSimdFeatures = Features;
+  }
+
+  return Features & ~OC_PNG_SIMD_DETECTED;
+ #else
+  return 0;
+ #endif
+}
+
+#ifdef EFIUSER
+
+VOID
+InternalPngSetSimd (
+  IN BOOLEAN  Enable
+  )
+{
+ #ifdef OC_PNG_SIMD
+  //
+  // Disabled SIMD looks like a CPU without features, enabling redetects them.
+  //
+  mPngSimdFeatures = Enable ? 0 : OC_PNG_SIMD_DETECTED;
+ #endif
+}
+
+#endif
+
 EFI_STATUS
 OcGetPngDims (
   IN  VOID    *Buffer,
@@ -137,3 +370,511 @@ OcEncodePng (
 
   return EFI_SUCCESS;
 }
+
+STATIC
+UINT8
+InternalPngPaeth (
+  IN UINT8  A,
+  IN UINT8  B,
+  IN UINT8  C
+  )
+{
+  INT32  Pa;
+  INT32  Pb;
+  INT32  Pc;
+
+  Pa = ABS ((INT32)B - C);
+  Pb = ABS ((INT32)A - C);
+  Pc = ABS ((INT32)A + B - 2 * C);
+
+  if ((Pa <= Pb) && (Pa <= Pc)) {
+    return A;
+  }
+
+  if (Pb <= Pc) {
+    return B;
+  }
+
+  return C;
+}
+
+/**
+  Reconstruct one filtered scanline in place.
+
+  @param[in,out] Row     Filtered row without the filter type byte.
+  @param[in]     Prev    Reconstructed previous row, zeroes for the first row.
+  @param[in]     Length  Row length in bytes.
+  @param[in]     Bpp     Bytes per pixel, 3 or 4.
+  @param[in]     Filter  Filter type.
+  @param[in]     Simd    SIMD kernels to use.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+InternalPngUnfilterRow (
+  IN OUT UINT8        *Row,
+  IN     CONST UINT8  *Prev,
+  IN     UINTN        Length,
+  IN     UINTN        Bpp,
+  IN     UINT8        Filter,
+  IN     UINT32       Simd
+  )
+{
+  UINTN  Index;
+
+  Index = 0;
+
+ #ifdef OC_PNG_SIMD
+  if ((Simd & OC_PNG_SIMD_SSE2) != 0) {
+    switch (Filter) {
+      case OC_PNG_FILTER_SUB:
+        Index = InternalPngUnfilterSubSse2 (Row, Length, Bpp);
+        break;
+      case OC_PNG_FILTER_UP:
+        Index = InternalPngUnfilterUpSse2 (Row, Prev, Length);
+        break;
+      case OC_PNG_FILTER_AVG:
+        Index = InternalPngUnfilterAvgSse2 (Row, Prev, Length, Bpp);
+        break;
+      case OC_PNG_FILTER_PAETH:
+        Index = InternalPngUnfilterPaethSse2 (Row, Prev, Length, Bpp);
+        break;
+      default:
+        break;
+    }
+  }
+
+ #endif
+
+  switch (Filter) {
+    case OC_PNG_FILTER_NONE:
+      break;
+    case OC_PNG_FILTER_SUB:
+      for (Index = MAX (Index, Bpp); Index < Length; ++Index) {
+        Row[Index] = (UINT8)(Row[Index] + Row[Index - Bpp]);
+      }
+
+      break;
+    case OC_PNG_FILTER_UP:
+      for ( ; Index < Length; ++Index) {
+        Row[Index] = (UINT8)(Row[Index] + Prev[Index]);
+      }
+
+      break;
+    case OC_PNG_FILTER_AVG:
+      for ( ; Index < Bpp; ++Index) {
+        Row[Index] = (UINT8)(Row[Index] + Prev[Index] / 2);
+      }
+
+      for ( ; Index < Length; ++Index) {
+        Row[Index] = (UINT8)(Row[Index] + (Row[Index - Bpp] + Prev[Index]) / 2);
+      }
+
+      break;
+    case OC_PNG_FILTER_PAETH:
+      for ( ; Index < Bpp; ++Index) {
+        Row[Index] = (UINT8)(Row[Index] + Prev[Index]);
+      }
+
+      for ( ; Index < Length; ++Index) {
+        Row[Index] = (UINT8)(Row[Index] + InternalPngPaeth (Row[Index - Bpp], Prev[Index], Prev[Index - Bpp]));
+      }
+
+      break;
+    default:
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+  Convert reconstructed pixels to EFI_GRAPHICS_OUTPUT_BLT_PIXEL layout.
+  In-place conversion is allowed for RGBA source.
+
+  @param[out] Dst          Destination pixels.
+  @param[in]  Src          Source RGB or RGBA pixels.
+  @param[in]  NumPixels    Number of pixels.
+  @param[in]  Bpp          Source bytes per pixel, 3 or 4.
+  @param[in]  Premultiply  Premultiply colour channels by alpha.
+  @param[in]  Simd         SIMD kernels to use.
+**/
+STATIC
+VOID
+InternalPngConvertRow (
+  OUT UINT8        *Dst,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        NumPixels,
+  IN  UINTN        Bpp,
+  IN  BOOLEAN      Premultiply,
+  IN  UINT32       Simd
+  )
+{
+  UINTN  Index;
+  UINTN  Blocks;
+  UINT8  Red;
+  UINT8  Alpha;
+
+  Index = 0;
+
+ #ifdef OC_PNG_SIMD
+  if ((Simd & OC_PNG_SIMD_SSSE3) != 0) {
+    if (Bpp == 4) {
+      Blocks = NumPixels / 4;
+      InternalPngRgbaToBgraSsse3 ((UINT32 *)Dst, Src, Blocks, Premultiply);
+    } else {
+      //
+      // Every block reads 4 bytes past the last pixel it converts.
+      //
+      Blocks = NumPixels >= 2 ? (NumPixels * 3 - 4) / 12 : 0;
+      InternalPngRgbToBgraSsse3 ((UINT32 *)Dst, Src, Blocks);
+    }
+
+    Index = Blocks * 4;
+  }
+
+ #endif
+
+  Src += Index * Bpp;
+  Dst += Index * 4;
+
+  if (Bpp == 3) {
+    for ( ; Index < NumPixels; ++Index) {
+      Red    = Src[0];
+      Dst[0] = Src[2];
+      Dst[1] = Src[1];
+      Dst[2] = Red;
+      Dst[3] = 0xFF;
+      Src   += 3;
+      Dst   += 4;
+    }
+  } else if (Premultiply) {
+    for ( ; Index < NumPixels; ++Index) {
+      Red    = Src[0];
+      Alpha  = Src[3];
+      Dst[0] = (UINT8)((Src[2] * Alpha) / 0xFF);
+      Dst[1] = (UINT8)((Src[1] * Alpha) / 0xFF);
+      Dst[2] = (UINT8)((Red * Alpha) / 0xFF);
+      Dst[3] = Alpha;
+      Src   += 4;
+      Dst   += 4;
+    }
+  } else {
+    for ( ; Index < NumPixels; ++Index) {
+      Red    = Src[0];
+      Dst[0] = Src[2];
+      Dst[1] = Src[1];
+      Dst[2] = Red;
+      Dst[3] = Src[3];
+      Src   += 4;
+      Dst   += 4;
+    }
+  }
+}
+
+/**
+  Decode PNG image with lodepng and convert it in place.
+  Used for images the single pass decoder does not handle.
+**/
+STATIC
+EFI_STATUS
+InternalDecodePngBgraGeneric (
+  IN  VOID     *Buffer,
+  IN  UINTN    Size,
+  IN  BOOLEAN  Premultiply,
+  OUT VOID     **RawData,
+  OUT UINT32   *Width,
+  OUT UINT32   *Height
+  )
+{
+  EFI_STATUS  Status;
+  UINT32      Simd;
+
+ #ifdef OC_PNG_SIMD
+  OC_PNG_SIMD_STATE  SimdState;
+ #endif
+
+  Status = OcDecodePng (Buffer, Size, RawData, Width, Height, NULL);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Simd = InternalPngGetSimd ();
+
+ #ifdef OC_PNG_SIMD
+  if (Simd != 0) {
+    InternalPngSimdEnter (&SimdState);
+  }
+
+ #endif
+
+  InternalPngConvertRow (*RawData, *RawData, (UINTN)*Width * *Height, 4, Premultiply, Simd);
+
+ #ifdef OC_PNG_SIMD
+  if (Simd != 0) {
+    InternalPngSimdLeave (&SimdState);
+  }
+
+ #endif
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Find IDAT data of a non-interlaced PNG image.
+
+  @param[in]  Buffer     PNG image.
+  @param[in]  Size       PNG image size.
+  @param[out] Idat       IDAT data, points to Buffer for a single IDAT chunk.
+  @param[out] IdatSize   IDAT data size.
+  @param[out] Allocated  Idat is an allocated copy of multiple IDAT chunks.
+
+  @retval EFI_SUCCESS      IDAT data was found.
+  @retval EFI_UNSUPPORTED  Image must be decoded by lodepng.
+  @retval other            Image is malformed or out of resources.
+**/
+STATIC
+EFI_STATUS
+InternalPngFindIdat (
+  IN  CONST UINT8  *Buffer,
+  IN  UINTN        Size,
+  OUT CONST UINT8  **Idat,
+  OUT UINTN        *IdatSize,
+  OUT BOOLEAN      *Allocated
+  )
+{
+  CONST UINT8  *Chunk;
+  UINTN        Offset;
+  UINT32       ChunkLength;
+  UINT8        *IdatCopy;
+
+  *Idat      = NULL;
+  *IdatSize  = 0;
+  *Allocated = FALSE;
+  IdatCopy   = NULL;
+
+  //
+  // Walk the chunks after the header with the same checks as lodepng.
+  //
+  Chunk = &Buffer[33];
+  while (TRUE) {
+    Offset = (UINTN)(Chunk - Buffer);
+    if (Offset + 12 > Size) {
+      break;
+    }
+
+    ChunkLength = lodepng_chunk_length (Chunk);
+    if ((ChunkLength > MAX_INT32) || (Offset + ChunkLength + 12 > Size)) {
+      break;
+    }
+
+    if (lodepng_chunk_type_equals (Chunk, "IDAT")) {
+      if (*Idat == NULL) {
+        *Idat = lodepng_chunk_data_const (Chunk);
+      } else {
+        if (IdatCopy == NULL) {
+          IdatCopy = AllocatePool (Size);
+          if (IdatCopy == NULL) {
+            return EFI_OUT_OF_RESOURCES;
+          }
+
+          CopyMem (IdatCopy, *Idat, *IdatSize);
+          *Idat      = IdatCopy;
+          *Allocated = TRUE;
+        }
+
+        CopyMem (IdatCopy + *IdatSize, lodepng_chunk_data_const (Chunk), ChunkLength);
+      }
+
+      *IdatSize += ChunkLength;
+    } else if (lodepng_chunk_type_equals (Chunk, "IEND")) {
+      if (*Idat != NULL) {
+        return EFI_SUCCESS;
+      }
+
+      break;
+    } else if (lodepng_chunk_type_equals (Chunk, "tRNS")) {
+      //
+      // Colour key transparency is handled by lodepng.
+      //
+      break;
+    } else if (!lodepng_chunk_type_equals (Chunk, "PLTE") && !lodepng_chunk_ancillary (Chunk)) {
+      break;
+    }
+
+    Chunk = lodepng_chunk_next_const (Chunk, Buffer + Size);
+  }
+
+  //
+  // Let lodepng decide on everything unusual, including errors.
+  //
+  if (IdatCopy != NULL) {
+    FreePool (IdatCopy);
+  }
+
+  return EFI_UNSUPPORTED;
+}
+
+EFI_STATUS
+OcDecodePngBgra (
+  IN  VOID     *Buffer,
+  IN  UINTN    Size,
+  IN  BOOLEAN  Premultiply,
+  OUT VOID     **RawData,
+  OUT UINT32   *Width,
+  OUT UINT32   *Height
+  )
+{
+  EFI_STATUS    Status;
+  LodePNGState  State;
+  unsigned      Error;
+  unsigned      W;
+  unsigned      H;
+  UINTN         Bpp;
+  UINTN         Stride;
+  UINTN         ScanlinesSize;
+  UINTN         PixelsSize;
+  CONST UINT8   *Idat;
+  UINTN         IdatSize;
+  BOOLEAN       IdatAllocated;
+  UINT8         *Scanlines;
+  size_t        DecodedSize;
+  UINT8         *ZeroRow;
+  UINT8         *Row;
+  CONST UINT8   *Prev;
+  UINT8         *Pixels;
+  UINTN         Y;
+  UINT32        Simd;
+
+ #ifdef OC_PNG_SIMD
+  OC_PNG_SIMD_STATE  SimdState;
+ #endif
+
+  lodepng_state_init (&State);
+  State.decoder.ignore_crc                  = TRUE;
+  State.decoder.zlibsettings.ignore_adler32 = TRUE;
+  State.decoder.zlibsettings.ignore_nlen    = TRUE;
+
+  Error = lodepng_inspect (&W, &H, &State, Buffer, Size);
+  if (  (Error != 0)
+     || (State.info_png.color.bitdepth != 8)
+     || (  (State.info_png.color.colortype != LCT_RGB)
+        && (State.info_png.color.colortype != LCT_RGBA))
+     || (State.info_png.interlace_method != 0))
+  {
+    lodepng_state_cleanup (&State);
+    return InternalDecodePngBgraGeneric (Buffer, Size, Premultiply, RawData, Width, Height);
+  }
+
+  Bpp = State.info_png.color.colortype == LCT_RGBA ? 4 : 3;
+
+  if (  BaseOverflowMulUN (W, Bpp, &Stride)
+     || BaseOverflowAddUN (Stride, 1, &ScanlinesSize)
+     || BaseOverflowMulUN (ScanlinesSize, H, &ScanlinesSize)
+     || BaseOverflowTriMulUN (W, H, sizeof (UINT32), &PixelsSize)
+     || (ScanlinesSize > OC_PNG_MAX_SCANLINES_SIZE)
+     || (PixelsSize > OC_PNG_MAX_SCANLINES_SIZE))
+  {
+    lodepng_state_cleanup (&State);
+    return EFI_UNSUPPORTED;
+  }
+
+  Status = InternalPngFindIdat (Buffer, Size, &Idat, &IdatSize, &IdatAllocated);
+  if (EFI_ERROR (Status)) {
+    lodepng_state_cleanup (&State);
+    if (Status == EFI_UNSUPPORTED) {
+      return InternalDecodePngBgraGeneric (Buffer, Size, Premultiply, RawData, Width, Height);
+    }
+
+    return Status;
+  }
+
+  Scanlines   = NULL;
+  DecodedSize = 0;
+  Error       = lodepng_zlib_decompress_expected (
+                  &Scanlines,
+                  &DecodedSize,
+                  ScanlinesSize,
+                  Idat,
+                  IdatSize,
+                  &State.decoder.zlibsettings
+                  );
+
+  lodepng_state_cleanup (&State);
+  if (IdatAllocated) {
+    FreePool ((VOID *)Idat);
+  }
+
+  if ((Error != 0) || (DecodedSize != ScanlinesSize)) {
+    DEBUG ((DEBUG_INFO, "OCPNG: Error while decompressing PNG image - %u\n", Error));
+    if (Scanlines != NULL) {
+      FreePool (Scanlines);
+    }
+
+    return EFI_INVALID_PARAMETER;
+  }
+
+  ZeroRow = AllocateZeroPool (Stride);
+  Pixels  = AllocatePool (PixelsSize);
+  if ((ZeroRow == NULL) || (Pixels == NULL)) {
+    if (ZeroRow != NULL) {
+      FreePool (ZeroRow);
+    }
+
+    if (Pixels != NULL) {
+      FreePool (Pixels);
+    }
+
+    FreePool (Scanlines);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Simd = InternalPngGetSimd ();
+
+ #ifdef OC_PNG_SIMD
+  if (Simd != 0) {
+    InternalPngSimdEnter (&SimdState);
+  }
+
+ #endif
+
+  //
+  // Reconstruct every scanline in place and convert it while it is hot in cache.
+  //
+  Row  = NULL;
+  Prev = ZeroRow;
+  for (Y = 0; Y < H; ++Y) {
+    Row = &Scanlines[Y * (Stride + 1)];
+    if (!InternalPngUnfilterRow (Row + 1, Prev, Stride, Bpp, Row[0], Simd)) {
+      break;
+    }
+
+    InternalPngConvertRow (&Pixels[Y * W * sizeof (UINT32)], Row + 1, W, Bpp, Premultiply, Simd);
+    Prev = Row + 1;
+  }
+
+ #ifdef OC_PNG_SIMD
+  if (Simd != 0) {
+    InternalPngSimdLeave (&SimdState);
+  }
+
+ #endif
+
+  if (Y < H) {
+    DEBUG ((DEBUG_INFO, "OCPNG: Invalid PNG filter %u\n", Row[0]));
+    FreePool (ZeroRow);
+    FreePool (Pixels);
+    FreePool (Scanlines);
+    return EFI_INVALID_PARAMETER;
+  }
+
+  FreePool (ZeroRow);
+  FreePool (Scanlines);
+
+  *RawData = Pixels;
+  *Width   = (UINT32)W;
+  *Height  = (UINT32)H;
+
+  return EFI_SUCCESS;
+}
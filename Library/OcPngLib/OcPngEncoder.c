@@ -0,0 +1,308 @@
+/** @file
+  Incremental PNG encoder for screen captures.
+
+  Pixels are written as 8-bit RGB with the Up filter and compressed with
+  the fastest ZLIB level, a fixed number of rows per step, so that large
+  images can be encoded in the background without stalling the caller.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Base.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/BaseOverflowLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcCompressionLib.h>
+#include <Library/OcPngLib.h>
+#include "lodepng.h"
+
+//
+// Chunk length, type and CRC.
+//
+#define OC_PNG_CHUNK_OVERHEAD  12U
+#define OC_PNG_SIGNATURE_SIZE  8U
+#define OC_PNG_IHDR_SIZE       13U
+
+//
+// Fastest ZLIB compression level.
+//
+#define OC_PNG_ENCODER_LEVEL  1U
+
+//
+// PNG filter types used by the encoder.
+//
+#define OC_PNG_FILTER_NONE  0U
+#define OC_PNG_FILTER_UP    2U
+
+struct OC_PNG_ENCODER_ {
+  CONST UINT8       *Pixels;
+  UINT32            Width;
+  UINT32            Height;
+  UINT32            RowsPerStep;
+  UINT32            Row;
+  UINTN             Stride;
+  UINT8             *Scanlines;
+  OC_ZLIB_STREAM    *Stream;
+  UINT8             *Buffer;
+  UINTN             BufferSize;
+  UINTN             Offset;
+};
+
+STATIC
+VOID
+InternalPngWriteBe32 (
+  OUT UINT8   *Buffer,
+  IN  UINT32  Value
+  )
+{
+  Buffer[0] = (UINT8)(Value >> 24U);
+  Buffer[1] = (UINT8)(Value >> 16U);
+  Buffer[2] = (UINT8)(Value >> 8U);
+  Buffer[3] = (UINT8)Value;
+}
+
+/**
+  Finalise chunk with data already in place and append it to the output.
+
+  @param[in,out] Encoder  Encoder context.
+  @param[in]     Type     Chunk type.
+  @param[in]     Length   Chunk data length.
+**/
+STATIC
+VOID
+InternalPngAppendChunk (
+  IN OUT OC_PNG_ENCODER  *Encoder,
+  IN     CONST CHAR8     *Type,
+  IN     UINT32          Length
+  )
+{
+  UINT8  *Chunk;
+
+  Chunk = &Encoder->Buffer[Encoder->Offset];
+  InternalPngWriteBe32 (Chunk, Length);
+  CopyMem (&Chunk[4], Type, 4);
+  lodepng_chunk_generate_crc (Chunk);
+
+  Encoder->Offset += Length + OC_PNG_CHUNK_OVERHEAD;
+}
+
+/**
+  Filter encoder rows into scanlines.
+
+  @param[in,out] Encoder  Encoder context.
+  @param[in]     Rows     Number of rows starting from the current row.
+**/
+STATIC
+VOID
+InternalPngFilterRows (
+  IN OUT OC_PNG_ENCODER  *Encoder,
+  IN     UINT32          Rows
+  )
+{
+  UINT32       Index;
+  UINT32       X;
+  UINTN        SrcStride;
+  CONST UINT8  *Src;
+  CONST UINT8  *Prev;
+  UINT8        *Dst;
+
+  SrcStride = (UINTN)Encoder->Width * sizeof (UINT32);
+
+  for (Index = 0; Index < Rows; ++Index) {
+    Src = &Encoder->Pixels[(Encoder->Row + Index) * SrcStride];
+    Dst = &Encoder->Scanlines[Index * Encoder->Stride];
+
+    if (Encoder->Row + Index == 0) {
+      *Dst++ = OC_PNG_FILTER_NONE;
+      for (X = 0; X < Encoder->Width; ++X) {
+        Dst[0] = Src[2];
+        Dst[1] = Src[1];
+        Dst[2] = Src[0];
+        Src   += 4;
+        Dst   += 3;
+      }
+    } else {
+      Prev   = Src - SrcStride;
+      *Dst++ = OC_PNG_FILTER_UP;
+      for (X = 0; X < Encoder->Width; ++X) {
+        Dst[0] = (UINT8)(Src[2] - Prev[2]);
+        Dst[1] = (UINT8)(Src[1] - Prev[1]);
+        Dst[2] = (UINT8)(Src[0] - Prev[0]);
+        Src   += 4;
+        Prev  += 4;
+        Dst   += 3;
+      }
+    }
+  }
+}
+
+EFI_STATUS
+OcPngEncoderCreate (
+  IN  CONST VOID      *Pixels,
+  IN  UINT32          Width,
+  IN  UINT32          Height,
+  IN  UINT32          RowsPerStep,
+  OUT OC_PNG_ENCODER  **Encoder
+  )
+{
+  OC_PNG_ENCODER  *Context;
+  UINTN           Stride;
+  UINTN           ScanlinesSize;
+  UINTN           StepSize;
+  UINTN           BufferSize;
+  UINTN           NumChunks;
+  UINT8           *Header;
+
+  ASSERT (Pixels != NULL);
+  ASSERT (Encoder != NULL);
+
+  if ((Width == 0) || (Height == 0) || (RowsPerStep == 0)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  //
+  // Every step may emit an IDAT chunk, and the final step one more.
+  //
+  NumChunks = (Height + RowsPerStep - 1) / RowsPerStep + 1;
+
+  if (  BaseOverflowMulAddUN (Width, 3, 1, &Stride)
+     || BaseOverflowMulUN (Stride, Height, &ScanlinesSize)
+     || BaseOverflowMulUN (Stride, MIN (RowsPerStep, Height), &StepSize)
+     || (ScanlinesSize > OC_COMPRESSION_MAX_LENGTH)
+     || BaseOverflowMulAddUN (
+          NumChunks,
+          OC_PNG_CHUNK_OVERHEAD,
+          CompressZLIBBound (ScanlinesSize),
+          &BufferSize
+          )
+     || BaseOverflowAddUN (
+          BufferSize,
+          OC_PNG_SIGNATURE_SIZE + 2 * OC_PNG_CHUNK_OVERHEAD + OC_PNG_IHDR_SIZE,
+          &BufferSize
+          ))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  Context = AllocateZeroPool (sizeof (*Context));
+  if (Context == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Context->Pixels      = Pixels;
+  Context->Width       = Width;
+  Context->Height      = Height;
+  Context->RowsPerStep = RowsPerStep;
+  Context->Stride      = Stride;
+  Context->BufferSize  = BufferSize;
+  Context->Scanlines   = AllocatePool (StepSize);
+  Context->Buffer      = AllocatePool (BufferSize);
+  Context->Stream      = CompressZLIBStreamInit (OC_PNG_ENCODER_LEVEL);
+
+  if ((Context->Scanlines == NULL) || (Context->Buffer == NULL) || (Context->Stream == NULL)) {
+    OcPngEncoderFree (Context);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Signature and IHDR: 8-bit RGB, deflate, adaptive filtering, no interlace.
+  //
+  CopyMem (Context->Buffer, "\x89PNG\r\n\x1A\n", OC_PNG_SIGNATURE_SIZE);
+  Context->Offset = OC_PNG_SIGNATURE_SIZE;
+
+  Header = &Context->Buffer[Context->Offset + 8];
+  InternalPngWriteBe32 (&Header[0], Width);
+  InternalPngWriteBe32 (&Header[4], Height);
+  Header[8]  = 8;
+  Header[9]  = LCT_RGB;
+  Header[10] = 0;
+  Header[11] = 0;
+  Header[12] = 0;
+  InternalPngAppendChunk (Context, "IHDR", OC_PNG_IHDR_SIZE);
+
+  *Encoder = Context;
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+OcPngEncoderStep (
+  IN OUT OC_PNG_ENCODER  *Encoder,
+  OUT    VOID            **Buffer,
+  OUT    UINTN           *BufferSize
+  )
+{
+  UINT32   Rows;
+  BOOLEAN  Finish;
+  UINTN    Written;
+
+  ASSERT (Encoder != NULL);
+  ASSERT (Buffer != NULL);
+  ASSERT (BufferSize != NULL);
+
+  if (Encoder->Buffer == NULL) {
+    return EFI_ALREADY_STARTED;
+  }
+
+  Rows = MIN (Encoder->RowsPerStep, Encoder->Height - Encoder->Row);
+  InternalPngFilterRows (Encoder, Rows);
+  Encoder->Row += Rows;
+  Finish        = Encoder->Row == Encoder->Height;
+
+  //
+  // Compressed data goes straight after the IDAT header, leaving room
+  // for its CRC and the IEND chunk.
+  //
+  Written = CompressZLIBStream (
+              Encoder->Stream,
+              &Encoder->Buffer[Encoder->Offset + 8],
+              Encoder->BufferSize - Encoder->Offset - 2 * OC_PNG_CHUNK_OVERHEAD,
+              Encoder->Scanlines,
+              Rows * Encoder->Stride,
+              Finish
+              );
+  if (Written == MAX_UINTN) {
+    DEBUG ((DEBUG_INFO, "OCPNG: Error while compressing PNG rows %u/%u\n", Encoder->Row, Encoder->Height));
+    return EFI_DEVICE_ERROR;
+  }
+
+  if (Written > 0) {
+    InternalPngAppendChunk (Encoder, "IDAT", (UINT32)Written);
+  }
+
+  if (!Finish) {
+    return EFI_NOT_READY;
+  }
+
+  InternalPngAppendChunk (Encoder, "IEND", 0);
+
+  *Buffer         = Encoder->Buffer;
+  *BufferSize     = Encoder->Offset;
+  Encoder->Buffer = NULL;
+
+  return EFI_SUCCESS;
+}
+
+VOID
+OcPngEncoderFree (
+  IN OC_PNG_ENCODER  *Encoder
+  )
+{
+  ASSERT (Encoder != NULL);
+
+  if (Encoder->Stream != NULL) {
+    CompressZLIBStreamFree (Encoder->Stream);
+  }
+
+  if (Encoder->Scanlines != NULL) {
+    FreePool (Encoder->Scanlines);
+  }
+
+  if (Encoder->Buffer != NULL) {
+    FreePool (Encoder->Buffer);
+  }
+
+  FreePool (Encoder);
+}
@@ -2291,6 +2291,13 @@ static unsigned zlib_decompress(unsigned char** out, size_t* outsize, size_t exp
   return error;
 }
 
+/* OC: Exported for the single pass decoder in OcPng.c. */
+unsigned lodepng_zlib_decompress_expected(unsigned char** out, size_t* outsize, size_t expected_size,
+                                          const unsigned char* in, size_t insize,
+                                          const LodePNGDecompressSettings* settings) {
+  return zlib_decompress(out, outsize, expected_size, in, insize, settings);
+}
+
 #endif /*LODEPNG_COMPILE_DECODER*/
 
 #ifdef LODEPNG_COMPILE_ENCODER
@@ -1060,6 +1060,11 @@ buffer and *outsize its size in bytes. out must be freed by user after usage.
 unsigned lodepng_zlib_decompress(unsigned char** out, size_t* outsize,
                                  const unsigned char* in, size_t insize,
                                  const LodePNGDecompressSettings* settings);
+
+/* OC: Same as lodepng_zlib_decompress, but with a known output size to preallocate. */
+unsigned lodepng_zlib_decompress_expected(unsigned char** out, size_t* outsize, size_t expected_size,
+                                          const unsigned char* in, size_t insize,
+                                          const LodePNGDecompressSettings* settings);
 #endif /*LODEPNG_COMPILE_DECODER*/
 
 #ifdef LODEPNG_COMPILE_ENCODER
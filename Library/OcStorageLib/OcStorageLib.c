@@ -22,6 +22,7 @@
 #include <Library/DevicePathLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/OcDevicePathLib.h>
+#include <Library/OcParallelLib.h>
 #include <Library/OcStringLib.h>
 #include <Library/OcStorageLib.h>
 #include <Library/UefiBootServicesTableLib.h>
@@ -379,6 +380,91 @@ OcStorageExistsFileUnicode (
   return FALSE;
 }
 
+/**
+  Size of file pieces read while the previous piece is hashed.
+**/
+#define OC_STORAGE_HASH_PIECE_SIZE  SIZE_1MB
+
+///
+/// Vault digest calculation overlapped with file reading.
+///
+typedef struct {
+  SHA256_CONTEXT    Sha256;
+  CONST UINT8       *Data;
+  UINTN             Length;
+} OC_STORAGE_HASH_TASK;
+
+/**
+  Hash the pending file piece. Runs on any processor.
+
+  @param[in,out]  Context   Hash task state.
+  @param[in]      Index     Unused.
+  @param[in]      Worker    Unused.
+**/
+STATIC
+VOID
+EFIAPI
+OcStorageHashPiece (
+  IN OUT VOID   *Context,
+  IN     UINTN  Index,
+  IN     UINTN  Worker
+  )
+{
+  OC_STORAGE_HASH_TASK  *Task;
+
+  Task = Context;
+  Sha256Update (&Task->Sha256, Task->Data, Task->Length);
+}
+
+/**
+  Read file contents and calculate their SHA-256 digest. SHA-256 is sequential,
+  so each piece is hashed on another processor while the next one is read.
+
+  @param[in]   File        File to read from.
+  @param[in]   Size        File size.
+  @param[out]  Buffer      Buffer of at least Size bytes.
+  @param[out]  Digest      Resulting file digest.
+
+  @retval EFI_SUCCESS on success.
+**/
+STATIC
+EFI_STATUS
+OcStorageReadAndHash (
+  IN  EFI_FILE_PROTOCOL  *File,
+  IN  UINT32             Size,
+  OUT UINT8              *Buffer,
+  OUT UINT8              *Digest
+  )
+{
+  EFI_STATUS            Status;
+  OC_STORAGE_HASH_TASK  HashTask;
+  OC_PARALLEL_TASK      Task;
+  UINT32                Offset;
+  UINT32                Length;
+
+  Sha256Init (&HashTask.Sha256);
+  Task.Handle = NULL;
+  Status      = EFI_SUCCESS;
+
+  for (Offset = 0; Offset < Size; Offset += Length) {
+    Length = MIN (Size - Offset, OC_STORAGE_HASH_PIECE_SIZE);
+    Status = OcGetFileData (File, Offset, Length, Buffer + Offset);
+
+    OcParallelWaitTask (&Task);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    HashTask.Data   = Buffer + Offset;
+    HashTask.Length = Length;
+    OcParallelStartTask (OcStorageHashPiece, &HashTask, &Task);
+  }
+
+  OcParallelWaitTask (&Task);
+  Sha256Final (&HashTask.Sha256, Digest);
+  return Status;
+}
+
 VOID *
 OcStorageReadFileUnicode (
   IN  OC_STORAGE_CONTEXT  *Context,
@@ -438,7 +524,12 @@ OcStorageReadFileUnicode (
     return NULL;
   }
 
-  Status = OcGetFileData (File, 0, Size, FileBuffer);
+  if (VaultDigest != 0) {
+    Status = OcStorageReadAndHash (File, Size, FileBuffer, FileDigest);
+  } else {
+    Status = OcGetFileData (File, 0, Size, FileBuffer);
+  }
+
   File->Close (File);
   if (EFI_ERROR (Status)) {
     FreePool (FileBuffer);
@@ -446,7 +537,6 @@ OcStorageReadFileUnicode (
   }
 
   if (VaultDigest != 0) {
-    Sha256 (FileDigest, FileBuffer, Size);
     if (CompareMem (FileDigest, VaultDigest, SHA256_DIGEST_SIZE) != 0) {
       DEBUG ((DEBUG_ERROR, "OCST: Aborting corrupted %s file access\n", FilePath));
       FreePool (FileBuffer);
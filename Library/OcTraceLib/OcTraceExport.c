@@ -0,0 +1,202 @@
+/** @file
+  Boot phase trace export to a file and to NVRAM.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Uefi.h>
+#include <Guid/OcVariable.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcCpuLib.h>
+#include <Library/OcFileLib.h>
+#include <Library/OcTraceLib.h>
+#include <Library/OcVariableLib.h>
+#include <Library/PrintLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+#include <Library/UefiRuntimeServicesTableLib.h>
+
+//
+// Large enough for the whole ring, as a span takes below 128 bytes
+// of JSON with a reasonable name.
+//
+#define OC_TRACE_BUFFER_SIZE  BASE_64KB
+
+STATIC EFI_FILE_PROTOCOL  *mTraceRoot;
+STATIC CHAR16             *mTracePath;
+STATIC CHAR8              *mTraceBuffer;
+STATIC UINT64             mTraceTscFrequency;
+STATIC BOOLEAN            mTraceExported[OcTraceMilestoneMax];
+
+/**
+  Write NVRAM summary once boot services are about to exit, so that
+  it covers the whole boot without repeated variable writes.
+  The summary is stored like other OC system variables, i.e. it only
+  reaches flash with ForceOcWriteFlash.
+**/
+STATIC
+VOID
+EFIAPI
+InternalTraceExitBootServices (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Size;
+
+  Size   = OcTraceFormatSummary (mTraceBuffer, OC_TRACE_SUMMARY_SIZE, mTraceTscFrequency);
+  Status = OcSetSystemVariable (
+             OC_TRACE_VARIABLE_NAME,
+             EFI_VARIABLE_BOOTSERVICE_ACCESS | EFI_VARIABLE_RUNTIME_ACCESS,
+             Size,
+             mTraceBuffer,
+             NULL
+             );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCT: Failed to write trace summary - %r\n", Status));
+  }
+}
+
+/**
+  Get trace file path with timestamp.
+**/
+STATIC
+CHAR16 *
+InternalTraceGetPath (
+  IN CONST CHAR16  *PrefixPath
+  )
+{
+  EFI_STATUS  Status;
+  EFI_TIME    Date;
+  CHAR16      *Path;
+  UINTN       Size;
+
+  Status = gRT->GetTime (&Date, NULL);
+  if (EFI_ERROR (Status)) {
+    ZeroMem (&Date, sizeof (Date));
+  }
+
+  Size = StrSize (PrefixPath) + L_STR_SIZE (L"-0000-00-00-000000.json");
+
+  Path = AllocatePool (Size);
+  if (Path == NULL) {
+    return NULL;
+  }
+
+  UnicodeSPrint (
+    Path,
+    Size,
+    L"%s-%04u-%02u-%02u-%02u%02u%02u.json",
+    PrefixPath,
+    (UINT32)Date.Year,
+    (UINT32)Date.Month,
+    (UINT32)Date.Day,
+    (UINT32)Date.Hour,
+    (UINT32)Date.Minute,
+    (UINT32)Date.Second
+    );
+
+  return Path;
+}
+
+EFI_STATUS
+OcTraceConfigure (
+  IN CONST CHAR16                     *PrefixPath,
+  IN EFI_SIMPLE_FILE_SYSTEM_PROTOCOL  *FileSystem  OPTIONAL
+  )
+{
+  EFI_STATUS  Status;
+  EFI_EVENT   Event;
+
+  ASSERT (PrefixPath != NULL);
+
+  if (mTraceBuffer != NULL) {
+    return EFI_ALREADY_STARTED;
+  }
+
+  mTraceTscFrequency = OcGetTSCFrequency ();
+  if (mTraceTscFrequency == 0) {
+    DEBUG ((DEBUG_INFO, "OCT: No TSC frequency for tracing\n"));
+    return EFI_UNSUPPORTED;
+  }
+
+  mTraceBuffer = AllocatePool (OC_TRACE_BUFFER_SIZE);
+  if (mTraceBuffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  mTracePath = InternalTraceGetPath (PrefixPath);
+  if (mTracePath != NULL) {
+    if (FileSystem != NULL) {
+      Status = FileSystem->OpenVolume (FileSystem, &mTraceRoot);
+      if (EFI_ERROR (Status)) {
+        mTraceRoot = NULL;
+      } else if (!OcIsWritableFileSystem (mTraceRoot)) {
+        mTraceRoot->Close (mTraceRoot);
+        mTraceRoot = NULL;
+      }
+    }
+
+    if (mTraceRoot == NULL) {
+      Status = OcFindWritableFileSystem (&mTraceRoot);
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_INFO, "OCT: There is no place to write trace file to - %r\n", Status));
+        mTraceRoot = NULL;
+      }
+    }
+  }
+
+  Status = gBS->CreateEvent (
+                  EVT_SIGNAL_EXIT_BOOT_SERVICES,
+                  TPL_CALLBACK,
+                  InternalTraceExitBootServices,
+                  NULL,
+                  &Event
+                  );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCT: Failed to create exit bs event for trace summary - %r\n", Status));
+  }
+
+  return EFI_SUCCESS;
+}
+
+VOID
+OcTraceExportFile (
+  IN OC_TRACE_MILESTONE  Milestone
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Size;
+
+  ASSERT (Milestone < OcTraceMilestoneMax);
+
+  if ((mTraceRoot == NULL) || mTraceExported[Milestone]) {
+    return;
+  }
+
+  //
+  // File writes are only safe at low TPL.
+  //
+  if (EfiGetCurrentTpl () > TPL_CALLBACK) {
+    return;
+  }
+
+  mTraceExported[Milestone] = TRUE;
+
+  //
+  // Rewrite the whole file, as overwriting it completely is most reliable
+  // with broken FAT32 drivers.
+  //
+  Size   = OcTraceFormatJson (mTraceBuffer, OC_TRACE_BUFFER_SIZE, mTraceTscFrequency);
+  Status = OcSetFileData (mTraceRoot, mTracePath, mTraceBuffer, (UINT32)Size);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCT: Failed to write trace file - %r\n", Status));
+    mTraceRoot->Close (mTraceRoot);
+    mTraceRoot = NULL;
+  }
+}
@@ -0,0 +1,259 @@
+/** @file
+  Boot phase span recording and formatting.
+
+  Spans are kept in a fixed ring indexed by their identifier, so that
+  beginning and ending a span is a TSC read and a few stores.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/DebugLib.h>
+#include <Library/OcTraceLib.h>
+#include <Library/PrintLib.h>
+
+typedef struct {
+  CONST CHAR8    *Name;
+  UINT64         Start;
+  //
+  // Zero until the span ends.
+  //
+  UINT64         End;
+  OC_TRACE_ID    Id;
+  UINT32         Depth;
+} OC_TRACE_EVENT;
+
+STATIC OC_TRACE_EVENT  mTraceEvents[OC_TRACE_MAX_EVENTS];
+STATIC OC_TRACE_ID     mTraceLastId;
+STATIC UINT32          mTraceDepth;
+STATIC UINT64          mTraceBase;
+
+STATIC
+OC_TRACE_EVENT *
+InternalTraceGetEvent (
+  IN OC_TRACE_ID  Id
+  )
+{
+  return &mTraceEvents[(Id - 1) & (OC_TRACE_MAX_EVENTS - 1)];
+}
+
+/**
+  Convert TSC ticks to microseconds without overflowing on long spans.
+**/
+STATIC
+UINT64
+InternalTraceTicksToUs (
+  IN UINT64  Ticks,
+  IN UINT64  TscFrequency
+  )
+{
+  UINT64  Seconds;
+  UINT64  Remainder;
+
+  Seconds = DivU64x64Remainder (Ticks, TscFrequency, &Remainder);
+  return MultU64x32 (Seconds, 1000000) + DivU64x64Remainder (MultU64x32 (Remainder, 1000000), TscFrequency, NULL);
+}
+
+/**
+  Get the oldest span still in the ring.
+**/
+STATIC
+OC_TRACE_ID
+InternalTraceFirstId (
+  VOID
+  )
+{
+  if (mTraceLastId > OC_TRACE_MAX_EVENTS) {
+    return mTraceLastId - OC_TRACE_MAX_EVENTS + 1;
+  }
+
+  return 1;
+}
+
+OC_TRACE_ID
+OcTraceBegin (
+  IN CONST CHAR8  *Name
+  )
+{
+  OC_TRACE_EVENT  *Event;
+
+  ASSERT (Name != NULL);
+
+  //
+  // Identifiers wrap after 2^32 spans, skip the invalid one.
+  //
+  ++mTraceLastId;
+  if (mTraceLastId == OC_TRACE_INVALID_ID) {
+    ++mTraceLastId;
+  }
+
+  Event        = InternalTraceGetEvent (mTraceLastId);
+  Event->Name  = Name;
+  Event->End   = 0;
+  Event->Id    = mTraceLastId;
+  Event->Depth = mTraceDepth++;
+  Event->Start = AsmReadTsc ();
+
+  if (mTraceBase == 0) {
+    mTraceBase = Event->Start;
+  }
+
+  return mTraceLastId;
+}
+
+VOID
+OcTraceEnd (
+  IN OC_TRACE_ID  Id
+  )
+{
+  UINT64          Tsc;
+  OC_TRACE_EVENT  *Event;
+
+  Tsc = AsmReadTsc ();
+
+  if (Id == OC_TRACE_INVALID_ID) {
+    return;
+  }
+
+  //
+  // The span may already be overwritten by newer ones.
+  //
+  Event = InternalTraceGetEvent (Id);
+  if (Event->Id == Id) {
+    Event->End = Tsc;
+  }
+
+  if (mTraceDepth > 0) {
+    --mTraceDepth;
+  }
+}
+
+UINTN
+OcTraceFormatJson (
+  OUT CHAR8   *Buffer,
+  IN  UINTN   BufferSize,
+  IN  UINT64  TscFrequency
+  )
+{
+  OC_TRACE_ID     First;
+  OC_TRACE_ID     Id;
+  OC_TRACE_EVENT  *Event;
+  UINTN           Size;
+  UINTN           Available;
+  UINTN           Length;
+
+  STATIC CONST CHAR8  Header[] = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  STATIC CONST CHAR8  Footer[] = "\n]}\n";
+
+  if ((TscFrequency == 0) || (BufferSize < L_STR_LEN (Header) + sizeof (Footer))) {
+    if (BufferSize > 0) {
+      Buffer[0] = '\0';
+    }
+
+    return 0;
+  }
+
+  //
+  // Always leave room for the footer.
+  //
+  Size  = AsciiSPrint (Buffer, BufferSize - L_STR_LEN (Footer), "%a", Header);
+  First = InternalTraceFirstId ();
+
+  for (Id = First; Id <= mTraceLastId; ++Id) {
+    Event     = InternalTraceGetEvent (Id);
+    Available = BufferSize - L_STR_LEN (Footer) - Size;
+
+    if (Event->End != 0) {
+      Length = AsciiSPrint (
+                 &Buffer[Size],
+                 Available,
+                 "%a\n{\"name\":\"%a\",\"cat\":\"OC\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%Lu,\"dur\":%Lu}",
+                 Id == First ? "" : ",",
+                 Event->Name,
+                 InternalTraceTicksToUs (Event->Start - mTraceBase, TscFrequency),
+                 InternalTraceTicksToUs (Event->End - Event->Start, TscFrequency)
+                 );
+    } else {
+      Length = AsciiSPrint (
+                 &Buffer[Size],
+                 Available,
+                 "%a\n{\"name\":\"%a\",\"cat\":\"OC\",\"ph\":\"B\",\"pid\":1,\"tid\":1,\"ts\":%Lu}",
+                 Id == First ? "" : ",",
+                 Event->Name,
+                 InternalTraceTicksToUs (Event->Start - mTraceBase, TscFrequency)
+                 );
+    }
+
+    //
+    // Drop the truncated span and everything after it.
+    //
+    if (Length + 1 >= Available) {
+      Buffer[Size] = '\0';
+      break;
+    }
+
+    Size += Length;
+  }
+
+  Size += AsciiSPrint (&Buffer[Size], BufferSize - Size, "%a", Footer);
+  return Size;
+}
+
+UINTN
+OcTraceFormatSummary (
+  OUT CHAR8   *Buffer,
+  IN  UINTN   BufferSize,
+  IN  UINT64  TscFrequency
+  )
+{
+  OC_TRACE_ID     First;
+  OC_TRACE_ID     Id;
+  OC_TRACE_EVENT  *Event;
+  UINTN           Size;
+  UINTN           Available;
+  UINTN           Length;
+  UINT32          Index;
+
+  if ((TscFrequency == 0) || (BufferSize == 0)) {
+    return 0;
+  }
+
+  Size      = 0;
+  Buffer[0] = '\0';
+  First     = InternalTraceFirstId ();
+
+  for (Id = First; Id <= mTraceLastId; ++Id) {
+    Event = InternalTraceGetEvent (Id);
+    if (Event->End == 0) {
+      continue;
+    }
+
+    Available = BufferSize - Size;
+    if (Event->Depth >= Available) {
+      break;
+    }
+
+    for (Index = 0; Index < Event->Depth; ++Index) {
+      Buffer[Size + Index] = '+';
+    }
+
+    Length = AsciiSPrint (
+               &Buffer[Size + Event->Depth],
+               Available - Event->Depth,
+               "%a=%Lu;",
+               Event->Name,
+               InternalTraceTicksToUs (Event->End - Event->Start, TscFrequency)
+               );
+
+    if (Event->Depth + Length + 1 >= Available) {
+      Buffer[Size] = '\0';
+      break;
+    }
+
+    Size += Event->Depth + Length;
+  }
+
+  return Size;
+}
@@ -54,6 +54,72 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #define XML_PLIST_HEADER  "<?xml version=\"1.0\" encoding=\"UTF-8\"?><!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">"
 
+/**
+  Minimal remaining buffer size to scan with SIMD.
+**/
+#define XML_SCAN_SIMD_MIN_LENGTH  64U
+
+/**
+  Number of machine words scanned before switching to SIMD, which
+  only pays off for long runs like base64 data.
+**/
+#define XML_SCAN_SIMD_WORDS  8U
+
+/**
+  Number of bytes checked one by one before switching to wider scanning,
+  as most whitespace runs and plist values are short.
+**/
+#define XML_SCAN_PROBE_LENGTH  16U
+
+/**
+  XML whitespace matching IsAsciiSpace: space and \t, \n, \v, \f, \r.
+**/
+#define XML_IS_SPACE(Char)  (((Char) == ' ') || ((UINT8)((Char) - '\t') <= (UINT8)('\r' - '\t')))
+
+/**
+  Non-zero when any byte of Word is equal to the byte replicated in Mask.
+**/
+#define XML_WORD_HAS_BYTE(Word, Mask) \
+  ((((Word) ^ (Mask)) - 0x0101010101010101ULL) & ~((Word) ^ (Mask)) & 0x8080808080808080ULL)
+
+#if defined (MDE_CPU_X64) && (!defined (EFIUSER) || defined (EFIUSER_SIMD))
+#define OC_XML_SIMD
+#endif
+
+#ifdef OC_XML_SIMD
+
+/**
+  Find the first `<' byte in 32-byte and 16-byte blocks. Requires SSE2.
+
+  @param[in] Buffer  Buffer to scan.
+  @param[in] Length  Buffer length.
+
+  @return Offset of the first match, or Length rounded down to 16 bytes.
+**/
+UINTN
+EFIAPI
+InternalXmlFindMarkupSse2 (
+  IN CONST CHAR8  *Buffer,
+  IN UINTN        Length
+  );
+
+/**
+  Find the first non-whitespace byte in 16-byte blocks. Requires SSE2.
+
+  @param[in] Buffer  Buffer to scan.
+  @param[in] Length  Buffer length.
+
+  @return Offset of the first match, or Length rounded down to 16 bytes.
+**/
+UINTN
+EFIAPI
+InternalXmlSkipSpaceSse2 (
+  IN CONST CHAR8  *Buffer,
+  IN UINTN        Length
+  );
+
+#endif
+
 struct XML_NODE_LIST_;
 struct XML_PARSER_;
 
@@ -530,6 +596,108 @@ XmlParserError (
 #define XML_USAGE_ERROR(X)                         do {} while (0)
 #endif
 
+/**
+  Find the first `<' byte, which terminates text content.
+  Entities are left for unescaping.
+
+  @param[in]  Buffer    Buffer to scan.
+  @param[in]  Position  Starting position.
+  @param[in]  Length    Buffer length.
+
+  @return Position of the first match or Length.
+**/
+STATIC
+UINT32
+XmlScanMarkup (
+  IN  CONST CHAR8  *Buffer,
+  IN  UINT32       Position,
+  IN  UINT32       Length
+  )
+{
+  UINT32  End;
+  UINT32  Words;
+  UINT64  Word;
+
+  End = Length - Position > XML_SCAN_PROBE_LENGTH ? Position + XML_SCAN_PROBE_LENGTH : Length;
+  while (Position < End) {
+    if (Buffer[Position] == '<') {
+      return Position;
+    }
+
+    ++Position;
+  }
+
+  //
+  // Skip words without matches, the match itself is located bytewise.
+  //
+  for (Words = 0; Length - Position >= sizeof (UINT64); ++Words) {
+ #ifdef OC_XML_SIMD
+    if ((Words == XML_SCAN_SIMD_WORDS) && (Length - Position >= XML_SCAN_SIMD_MIN_LENGTH)) {
+      Position += (UINT32)InternalXmlFindMarkupSse2 (&Buffer[Position], Length - Position);
+      if (Length - Position < sizeof (UINT64)) {
+        break;
+      }
+    }
+
+ #endif
+
+    Word = ReadUnaligned64 ((CONST UINT64 *)&Buffer[Position]);
+    if (XML_WORD_HAS_BYTE (Word, 0x3C3C3C3C3C3C3C3CULL) != 0) {
+      break;
+    }
+
+    Position += sizeof (UINT64);
+  }
+
+  while ((Position < Length) && (Buffer[Position] != '<')) {
+    ++Position;
+  }
+
+  return Position;
+}
+
+/**
+  Find the first non-whitespace byte.
+
+  @param[in]  Buffer    Buffer to scan.
+  @param[in]  Position  Starting position.
+  @param[in]  Length    Buffer length.
+
+  @return Position of the first match or Length.
+**/
+STATIC
+UINT32
+XmlScanNonSpace (
+  IN  CONST CHAR8  *Buffer,
+  IN  UINT32       Position,
+  IN  UINT32       Length
+  )
+{
+  UINT32  End;
+
+  End = Length - Position > XML_SCAN_PROBE_LENGTH ? Position + XML_SCAN_PROBE_LENGTH : Length;
+  while (Position < End) {
+    if (!XML_IS_SPACE (Buffer[Position])) {
+      return Position;
+    }
+
+    ++Position;
+  }
+
+ #ifdef OC_XML_SIMD
+  if (Length - Position >= XML_SCAN_SIMD_MIN_LENGTH) {
+    Position += (UINT32)InternalXmlSkipSpaceSse2 (&Buffer[Position], Length - Position);
+  }
+
+ #endif
+
+  while ((Position < Length) && XML_IS_SPACE (Buffer[Position])) {
+    ++Position;
+  }
+
+  return Position;
+}
+
 /**
   Return the N-th not-whitespace byte in parser or 0 if such a byte does not exist.
 
@@ -633,11 +801,7 @@ XmlSkipWhitespace (
 
   XML_PARSER_INFO (Parser, "whitespace");
 
-  while (  Parser->Position < Parser->Length
-        && IsAsciiSpace (Parser->Buffer[Parser->Position]))
-  {
-    ++Parser->Position;
-  }
+  Parser->Position = XmlScanNonSpace (Parser->Buffer, Parser->Position, Parser->Length);
 }
 
 /**
@@ -663,6 +827,7 @@ XmlParseTagEnd (
 {
   CHAR8   Current;
   UINT32  Start;
+  UINT32  Position;
   UINT32  AttributeStart;
   UINT32  Length     = 0;
   UINT32  NameLength = 0;
@@ -671,19 +836,20 @@ XmlParseTagEnd (
 
   XML_PARSER_INFO (Parser, "tag_end");
 
-  Current = XmlParserPeek (Parser, CURRENT_CHARACTER);
-  Start   = Parser->Position;
+  Start    = Parser->Position;
+  Position = Start;
 
   //
   // Parse until `>' or a whitespace is reached.
   //
-  while (Start + Length < Parser->Length) {
+  while (Position < Parser->Length) {
+    Current = Parser->Buffer[Position];
     if (('/' == Current) || ('>' == Current)) {
       break;
     }
 
-    if ((NameLength == 0) && IsAsciiSpace (Current)) {
-      NameLength = Length;
+    if ((NameLength == 0) && XML_IS_SPACE (Current)) {
+      NameLength = Position - Start;
 
       if (NameLength == 0) {
         XML_PARSER_ERROR (Parser, CURRENT_CHARACTER, "XmlParseTagEnd::expected tag name");
@@ -691,12 +857,13 @@ XmlParseTagEnd (
       }
     }
 
-    XmlParserConsume (Parser, 1);
-    ++Length;
-
-    Current = XmlParserPeek (Parser, CURRENT_CHARACTER);
+    ++Position;
   }
 
+  Length           = Position - Start;
+  Parser->Position = Position;
+  Current          = XmlParserPeek (Parser, CURRENT_CHARACTER);
+
   //
   // Handle attributes.
   //
@@ -951,9 +1118,9 @@ XmlParseContent (
   IN OUT  XML_PARSER  *Parser
   )
 {
-  UINTN  Start;
-  UINTN  Length;
-  CHAR8  Current;
+  UINT32  Start;
+  UINT32  Position;
+  UINTN   Length;
 
   ASSERT (Parser != NULL);
 
@@ -964,22 +1131,11 @@ XmlParseContent (
   //
   XmlSkipWhitespace (Parser);
 
-  Start  = Parser->Position;
-  Length = 0;
+  Start    = Parser->Position;
+  Position = XmlScanMarkup (Parser->Buffer, Start, Parser->Length);
 
-  //
-  // Consume until `<' is reached.
-  //
-  while (Start + Length < Parser->Length) {
-    Current = XmlParserPeek (Parser, CURRENT_CHARACTER);
-
-    if ('<' == Current) {
-      break;
-    } else {
-      XmlParserConsume (Parser, 1);
-      ++Length;
-    }
-  }
+  Length           = Position - Start;
+  Parser->Position = Position;
 
   //
   // Next character must be an `<' or we have reached end of file.
@@ -992,7 +1148,7 @@ XmlParseContent (
   //
   // Ignore tailing whitespace.
   //
-  while ((Length > 0) && IsAsciiSpace (Parser->Buffer[Start + Length - 1])) {
+  while ((Length > 0) && XML_IS_SPACE (Parser->Buffer[Start + Length - 1])) {
     --Length;
   }
 
@@ -1688,48 +1844,56 @@ XmlUnescapeString (
   IN      CONST CHAR8  *String
   )
 {
-  UINTN  StringSize;
-  CHAR8  *Buffer;
-  CHAR8  *Pointer;
+  CHAR8        *Buffer;
+  CONST CHAR8  *Source;
+  CHAR8        *Pointer;
 
   ASSERT (String != NULL);
 
-  StringSize = AsciiStrSize (String);
-  Pointer    = (CHAR8 *)AllocatePool (StringSize);
-  if (Pointer == NULL) {
+  Buffer = AllocateCopyPool (AsciiStrSize (String), String);
+  if (Buffer == NULL) {
     return NULL;
   }
 
-  Buffer = Pointer;
+  //
+  // Unescaped strings are never longer, so the copy is unescaped in place
+  // and nothing moves before the first entity.
+  //
+  Source = Buffer;
+  while ((*Source != '\0') && (*Source != '&')) {
+    ++Source;
+  }
 
-  while (*String != '\0') {
-    if (*String == '&') {
-      if (AsciiStrnCmp (String + 1, "apos;", L_STR_LEN ("apos;")) == 0) {
+  Pointer = (CHAR8 *)Source;
+
+  while (*Source != '\0') {
+    if (*Source == '&') {
+      if (AsciiStrnCmp (Source + 1, "apos;", L_STR_LEN ("apos;")) == 0) {
         *Pointer++ = '\'';
-        String    += L_STR_LEN ("&apos;");
-      } else if (AsciiStrnCmp (String + 1, "quot;", L_STR_LEN ("quot;")) == 0) {
+        Source    += L_STR_LEN ("&apos;");
+      } else if (AsciiStrnCmp (Source + 1, "quot;", L_STR_LEN ("quot;")) == 0) {
         *Pointer++ = '\"';
-        String    += L_STR_LEN ("&quot;");
-      } else if (AsciiStrnCmp (String + 1, "amp;", L_STR_LEN ("amp;")) == 0) {
+        Source    += L_STR_LEN ("&quot;");
+      } else if (AsciiStrnCmp (Source + 1, "amp;", L_STR_LEN ("amp;")) == 0) {
         *Pointer++ = '&';
-        String    += L_STR_LEN ("&amp;");
-      } else if (AsciiStrnCmp (String + 1, "lt;", L_STR_LEN ("lt;")) == 0) {
+        Source    += L_STR_LEN ("&amp;");
+      } else if (AsciiStrnCmp (Source + 1, "lt;", L_STR_LEN ("lt;")) == 0) {
         *Pointer++ = '<';
-        String    += L_STR_LEN ("&lt;");
-      } else if (AsciiStrnCmp (String + 1, "gt;", L_STR_LEN ("gt;")) == 0) {
+        Source    += L_STR_LEN ("&lt;");
+      } else if (AsciiStrnCmp (Source + 1, "gt;", L_STR_LEN ("gt;")) == 0) {
         *Pointer++ = '>';
-        String    += L_STR_LEN ("&gt;");
+        Source    += L_STR_LEN ("&gt;");
       } else {
-        *Pointer++ = *String++;
+        *Pointer++ = *Source++;
       }
     } else {
-      *Pointer++ = *String++;
+      *Pointer++ = *Source++;
     }
   }
 
   *Pointer = '\0';
 
-  return (CONST CHAR8 *)Buffer;
+  return Buffer;
 }
 
 XML_NODE *
@@ -1918,6 +2082,135 @@ PlistDataValue (
   return FALSE;
 }
 
+/**
+  Decode Base64 string in place, whitespace is ignored and padding is optional.
+  Every 4 characters read produce at most 3 bytes, so the output never
+  overtakes the input.
+
+  @param[in,out]  String  Base64 string to be decoded.
+  @param[out]     Size    Size of decoded data.
+
+  @return TRUE on success.
+**/
+STATIC
+BOOLEAN
+XmlBase64DecodeInPlace (
+  IN OUT  CHAR8   *String,
+  OUT     UINT32  *Size
+  )
+{
+  CONST CHAR8  *Source;
+  UINT8        *Destination;
+  UINT32       Accumulator;
+  UINT32       Quantum;
+  UINT32       Padding;
+  CHAR8        Char;
+  UINT8        Value;
+
+  Source      = String;
+  Destination = (UINT8 *)String;
+  Accumulator = 0;
+  Quantum     = 0;
+  Padding     = 0;
+
+  for ( ; *Source != '\0'; ++Source) {
+    Char = *Source;
+
+    if (XML_IS_SPACE (Char)) {
+      continue;
+    }
+
+    if (Char == '=') {
+      if (++Padding > 2) {
+        return FALSE;
+      }
+
+      continue;
+    }
+
+    if (Padding > 0) {
+      return FALSE;
+    }
+
+    if ((Char >= 'A') && (Char <= 'Z')) {
+      Value = (UINT8)(Char - 'A');
+    } else if ((Char >= 'a') && (Char <= 'z')) {
+      Value = (UINT8)(Char - 'a' + 26);
+    } else if ((Char >= '0') && (Char <= '9')) {
+      Value = (UINT8)(Char - '0' + 52);
+    } else if (Char == '+') {
+      Value = 62;
+    } else if (Char == '/') {
+      Value = 63;
+    } else {
+      return FALSE;
+    }
+
+    Accumulator = (Accumulator << 6U) | Value;
+    if (++Quantum == 4) {
+      *Destination++ = (UINT8)(Accumulator >> 16U);
+      *Destination++ = (UINT8)(Accumulator >> 8U);
+      *Destination++ = (UINT8)Accumulator;
+      Accumulator    = 0;
+      Quantum        = 0;
+    }
+  }
+
+  if ((Quantum == 1) || ((Padding > 0) && (Quantum + Padding != 4))) {
+    return FALSE;
+  }
+
+  if (Quantum == 2) {
+    *Destination++ = (UINT8)(Accumulator >> 4U);
+  } else if (Quantum == 3) {
+    *Destination++ = (UINT8)(Accumulator >> 10U);
+    *Destination++ = (UINT8)(Accumulator >> 2U);
+  }
+
+  *Size = (UINT32)(Destination - (UINT8 *)String);
+  return TRUE;
+}
+
+BOOLEAN
+PlistDataValueInPlace (
+  IN   XML_NODE  *Node    OPTIONAL,
+  OUT  UINT8     **Buffer,
+  OUT  UINT32    *Size
+  )
+{
+  CONST CHAR8  *Content;
+
+  ASSERT (Buffer != NULL);
+  ASSERT (Size   != NULL);
+
+  *Buffer = NULL;
+  *Size   = 0;
+
+  if (PlistNodeCast (Node, PLIST_NODE_TYPE_DATA) == NULL) {
+    return FALSE;
+  }
+
+  Content = XmlNodeContent (Node);
+  if (Content == NULL) {
+    return TRUE;
+  }
+
+  //
+  // Parsed content points into the writable document buffer, nodes
+  // changed with XmlNodeChangeContent must not be decoded in place.
+  //
+  if (!XmlBase64DecodeInPlace ((CHAR8 *)Content, Size)) {
+    *Size = 0;
+    return FALSE;
+  }
+
+  if (*Size > 0) {
+    *Buffer = (UINT8 *)Content;
+  }
+
+  return TRUE;
+}
+
 BOOLEAN
 PlistBooleanValue (
   IN   XML_NODE  *Node   OPTIONAL,
@@ -33,6 +33,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <Library/TimerLib.h>
 #include <Library/UefiDriverEntryPoint.h>
 #include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
 
 #include <Protocol/AppleEvent.h>
@@ -49,6 +50,22 @@ STATIC EFI_EVENT  mProtocolNotification;
 STATIC UINT64   mPreviousTime     = 0;
 STATIC BOOLEAN  mEnableMouseClick = FALSE;
 
+//
+// Screenshots are encoded in timer driven steps of this many rows,
+// which keeps every step within a few milliseconds even for 4K screens.
+//
+#define SCREENSHOT_ROWS_PER_STEP  16U
+#define SCREENSHOT_STEP_PERIOD    EFI_TIMER_PERIOD_MILLISECONDS (10)
+
+//
+// Screenshot being encoded, its pixels, file system and file name.
+//
+STATIC EFI_EVENT                      mEncodeEvent;
+STATIC OC_PNG_ENCODER                 *mEncoder;
+STATIC EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *mImage;
+STATIC EFI_FILE_PROTOCOL              *mFs;
+STATIC CHAR16                         mFileName[16];
+
 STATIC
 EFI_STATUS
 EFIAPI
@@ -145,41 +162,93 @@ ShowStatus (
   return EFI_SUCCESS;
 }
 
+/**
+  Encode the pending screenshot a few rows at a time and write it once done.
+  Runs at TPL_CALLBACK, so file system access is allowed.
+
+  TakeScreenshot may preempt this from a key handler, but starts nothing
+  while mEncoder is set. Hence the finished screenshot is moved to locals
+  and mEncoder is cleared last, after which a new one may begin.
+
+  Status is shown by TakeScreenshot, as stalling here would block
+  other callbacks. Encoding and writing errors are only logged.
+**/
 STATIC
-EFI_STATUS
+VOID
 EFIAPI
-TakeScreenshot (
-  IN EFI_KEY_DATA  *KeyData
+ScreenshotEncodeStep (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
   )
 {
+  EFI_STATUS                     Status;
   EFI_FILE_PROTOCOL              *Fs;
-  EFI_GRAPHICS_OUTPUT_PROTOCOL   *GraphicsOutput;
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Image;
-  UINTN                          ImageSize;        ///< Size in pixels
   VOID                           *PngFile;
-  UINTN                          PngFileSize;      ///< Size in bytes
-  EFI_STATUS                     Status;
-  UINT32                         ScreenWidth;
-  UINT32                         ScreenHeight;
-  CHAR16                         FileName[16];
-  EFI_TIME                       Time;
-  UINTN                          Index;
-  UINT8                          Temp;
+  UINTN                          PngFileSize;
+  OC_PNG_ENCODER                 *Encoder;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Image;
+  CHAR16                         FileName[ARRAY_SIZE (mFileName)];
+
+  Encoder = mEncoder;
+  if (Encoder == NULL) {
+    return;
+  }
+
+  Status = OcPngEncoderStep (Encoder, &PngFile, &PngFileSize);
+  if (Status == EFI_NOT_READY) {
+    return;
+  }
+
+  gBS->SetTimer (mEncodeEvent, TimerCancel, 0);
+
+  Image = mImage;
+  Fs    = mFs;
+  StrCpyS (FileName, ARRAY_SIZE (FileName), mFileName);
+  mImage = NULL;
+  mFs    = NULL;
+  MemoryFence ();
+  mEncoder = NULL;
+
+  OcPngEncoderFree (Encoder);
+  gBS->FreePool (Image);
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "CRSCR: OcPngEncoderStep returned %r\n", Status));
+    Fs->Close (Fs);
+    return;
+  }
 
   //
-  // This is required to avoid assert (only noticeable on firmware compiled to
-  // assert) from gBS->RaiseTPL(TPL_CALLBACK) within the file system accesses
-  // below. Makes explicit what was happening anyway, which is that we're
-  // effectively lowering the TPL for a long running task, during a keyboard
-  // interrupt.
-  // REF: https://github.com/acidanthera/audk/blob/bcdcc4160d7460c46c08c9395aae81be44ef23a9/FatPkg/EnhancedFatDxe/Misc.c#L399
+  // Write PNG image into the file.
   //
-  gBS->RestoreTPL (TPL_CALLBACK);
-
-  Status = OcFindWritableOcFileSystem (&Fs);
+  Status = OcSetFileData (Fs, FileName, PngFile, (UINT32)PngFileSize);
+  gBS->FreePool (PngFile);
+  Fs->Close (Fs);
   if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_INFO, "OCSCR: Can't find writable FS - %r\n", Status));
-    ShowStatus (0xFF, 0xFF, 0x00); ///< Yellow
+    DEBUG ((DEBUG_INFO, "CRSCR: OcSetFileData returned %r\n", Status));
+  }
+}
+
+/**
+  Capture the screen and start encoding it in the background.
+  Returns as soon as the framebuffer is copied.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+TakeScreenshot (
+  IN EFI_KEY_DATA  *KeyData
+  )
+{
+  EFI_GRAPHICS_OUTPUT_PROTOCOL  *GraphicsOutput;
+  UINTN                         ImageSize;         ///< Size in pixels
+  EFI_STATUS                    Status;
+  UINT32                        ScreenWidth;
+  UINT32                        ScreenHeight;
+  EFI_TIME                      Time;
+
+  if (mEncoder != NULL) {
+    DEBUG ((DEBUG_INFO, "CRSCR: Previous screenshot is still being saved\n"));
     return EFI_SUCCESS;
   }
 
@@ -190,7 +259,6 @@ TakeScreenshot (
              );
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_INFO, "OCSCR: Graphics output protocol not found for screen - %r\n", Status));
-    Fs->Close (Fs);
     return EFI_SUCCESS;
   }
 
@@ -203,7 +271,14 @@ TakeScreenshot (
 
   if (ImageSize == 0) {
     DEBUG ((DEBUG_INFO, "OCSCR: Empty screen size\n"));
-    Fs->Close (Fs);
+    return EFI_SUCCESS;
+  }
+
+  Status = OcFindWritableOcFileSystem (&mFs);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCSCR: Can't find writable FS - %r\n", Status));
+    mFs = NULL;
+    ShowStatus (0xFF, 0xFF, 0x00); ///< Yellow
     return EFI_SUCCESS;
   }
 
@@ -219,8 +294,8 @@ TakeScreenshot (
     // Set file name to current day and time
     //
     UnicodeSPrint (
-      FileName,
-      sizeof (FileName),
+      mFileName,
+      sizeof (mFileName),
       L"%02d%02d%02d%02d.png",
       Time.Day,
       Time.Hour,
@@ -231,7 +306,7 @@ TakeScreenshot (
     //
     // Set file name to scrnshot.png
     //
-    StrCpyS (FileName, sizeof (FileName), L"scrnshot.png");
+    StrCpyS (mFileName, ARRAY_SIZE (mFileName), L"scrnshot.png");
   }
 
   //
@@ -240,12 +315,13 @@ TakeScreenshot (
   Status = gBS->AllocatePool (
                   EfiBootServicesData,
                   ImageSize * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL),
-                  (VOID **)&Image
+                  (VOID **)&mImage
                   );
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_INFO, "CRSCR: gBS->AllocatePool returned %r\n", Status));
+    mFs->Close (mFs);
+    mFs = NULL;
     ShowStatus (0xFF, 0x00, 0x00); ///< Red
-    Fs->Close (Fs);
     return EFI_SUCCESS;
   }
 
@@ -254,7 +330,7 @@ TakeScreenshot (
   //
   Status = GraphicsOutput->Blt (
                              GraphicsOutput,
-                             Image,
+                             mImage,
                              EfiBltVideoToBltBuffer,
                              0,
                              0,
@@ -264,53 +340,50 @@ TakeScreenshot (
                              ScreenHeight,
                              0
                              );
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_INFO, "CRSCR: GraphicsOutput->Blt returned %r\n", Status));
-    gBS->FreePool (Image);
-    ShowStatus (0xFF, 0x00, 0x00); ///< Red
-    Fs->Close (Fs);
-    return EFI_SUCCESS;
+  if (!EFI_ERROR (Status)) {
+    Status = OcPngEncoderCreate (
+               mImage,
+               ScreenWidth,
+               ScreenHeight,
+               SCREENSHOT_ROWS_PER_STEP,
+               &mEncoder
+               );
   }
 
-  //
-  // Convert BGR to RGBA with Alpha set to 0xFF.
-  //
-  for (Index = 0; Index < ImageSize; ++Index) {
-    Temp                  = Image[Index].Blue;
-    Image[Index].Blue     = Image[Index].Red;
-    Image[Index].Red      = Temp;
-    Image[Index].Reserved = 0xFF;
+  if (!EFI_ERROR (Status) && (mEncodeEvent == NULL)) {
+    Status = gBS->CreateEvent (
+                    EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                    TPL_CALLBACK,
+                    ScreenshotEncodeStep,
+                    NULL,
+                    &mEncodeEvent
+                    );
+    if (EFI_ERROR (Status)) {
+      mEncodeEvent = NULL;
+    }
   }
 
-  Status = OcEncodePng (
-             Image,
-             ScreenWidth,
-             ScreenHeight,
-             &PngFile,
-             &PngFileSize
-             );
-  gBS->FreePool (Image);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_INFO, "CRSCR: OcEncodePng returned %r\n", Status));
-    ShowStatus (0xFF, 0x00, 0x00); ///< Red
-    Fs->Close (Fs);
-    return EFI_SUCCESS;
+  if (!EFI_ERROR (Status)) {
+    Status = gBS->SetTimer (mEncodeEvent, TimerPeriodic, SCREENSHOT_STEP_PERIOD);
   }
 
-  //
-  // Write PNG image into the file.
-  //
-  Status = OcSetFileData (Fs, FileName, PngFile, (UINT32)PngFileSize);
-  gBS->FreePool (PngFile);
-  Fs->Close (Fs);
   if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_INFO, "CRSCR: OcEncodePng returned %r\n", Status));
+    DEBUG ((DEBUG_INFO, "CRSCR: Screenshot capture failed - %r\n", Status));
+    if (mEncoder != NULL) {
+      OcPngEncoderFree (mEncoder);
+      mEncoder = NULL;
+    }
+
+    gBS->FreePool (mImage);
+    mImage = NULL;
+    mFs->Close (mFs);
+    mFs = NULL;
     ShowStatus (0xFF, 0x00, 0x00); ///< Red
     return EFI_SUCCESS;
   }
 
   //
-  // Show success.
+  // Show success once the frame is captured, so the square is not in it.
   //
   ShowStatus (0x00, 0xFF, 0x00); ///< Green
 
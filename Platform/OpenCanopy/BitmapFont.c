@@ -714,6 +714,39 @@ GuiGetLabel (
   return TRUE;
 }
 
+BOOLEAN
+GuiFontConstructFromImage (
+  OUT GUI_FONT_CONTEXT  *Context,
+  IN  CONST GUI_IMAGE   *FontImage,
+  IN  VOID              *FileBuffer,
+  IN  UINT32            FileSize,
+  IN  UINT8             Scale
+  )
+{
+  BOOLEAN  Result;
+
+  ASSERT (Context    != NULL);
+  ASSERT (FontImage  != NULL);
+  ASSERT (FileBuffer != NULL);
+  ASSERT (FileSize   > 0);
+
+  ZeroMem (Context, sizeof (*Context));
+
+  Context->KerningData = FileBuffer;
+  CopyMem (&Context->FontImage, FontImage, sizeof (Context->FontImage));
+
+  Result = BmfContextInitialize (&Context->BmfContext, FileBuffer, FileSize);
+  if (!Result) {
+    GuiFontDestruct (Context);
+    return FALSE;
+  }
+
+  Context->Scale = Scale;
+
+  // TODO: check file size
+  return TRUE;
+}
+
 BOOLEAN
 GuiFontConstruct (
   OUT GUI_FONT_CONTEXT  *Context,
@@ -725,7 +758,7 @@ GuiFontConstruct (
   )
 {
   EFI_STATUS  Status;
-  BOOLEAN     Result;
+  GUI_IMAGE   Image;
 
   ASSERT (Context       != NULL);
   ASSERT (FontImage     != NULL);
@@ -733,32 +766,22 @@ GuiFontConstruct (
   ASSERT (FileBuffer    != NULL);
   ASSERT (FileSize      > 0);
 
-  ZeroMem (Context, sizeof (*Context));
-
-  Context->KerningData = FileBuffer;
-  Status               = GuiPngToImage (
-                           &Context->FontImage,
-                           FontImage,
-                           FontImageSize,
-                           FALSE
-                           );
+  Status = GuiPngToImage (
+             &Image,
+             FontImage,
+             FontImageSize,
+             FALSE
+             );
   FreePool (FontImage);
 
   if (EFI_ERROR (Status)) {
+    ZeroMem (Context, sizeof (*Context));
+    Context->KerningData = FileBuffer;
     GuiFontDestruct (Context);
     return FALSE;
   }
 
-  Result = BmfContextInitialize (&Context->BmfContext, FileBuffer, FileSize);
-  if (!Result) {
-    GuiFontDestruct (Context);
-    return FALSE;
-  }
-
-  Context->Scale = Scale;
-
-  // TODO: check file size
-  return TRUE;
+  return GuiFontConstructFromImage (Context, &Image, FileBuffer, FileSize, Scale);
 }
 
 VOID
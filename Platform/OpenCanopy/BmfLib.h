@@ -39,6 +39,26 @@ GuiFontConstruct (
   IN  UINT8             Scale
   );
 
+/**
+  Construct font context from an already decoded font image.
+
+  @param[out] Context     Font context.
+  @param[in]  FontImage   Font image, its buffer is owned by the context on return.
+  @param[in]  FileBuffer  BMF data, owned by the context on return.
+  @param[in]  FileSize    BMF data size.
+  @param[in]  Scale       User interface scale.
+
+  @retval TRUE on success.
+**/
+BOOLEAN
+GuiFontConstructFromImage (
+  OUT GUI_FONT_CONTEXT  *Context,
+  IN  CONST GUI_IMAGE   *FontImage,
+  IN  VOID              *FileBuffer,
+  IN  UINT32            FileSize,
+  IN  UINT8             Scale
+  );
+
 VOID
 GuiFontDestruct (
   IN GUI_FONT_CONTEXT  *Context
@@ -25,6 +25,7 @@
 #include "OpenCanopy.h"
 #include "BmfLib.h"
 #include "GuiApp.h"
+#include "ThemePack.h"
 
 GLOBAL_REMOVE_IF_UNREFERENCED BOOT_PICKER_GUI_CONTEXT  mGuiContext;
 
@@ -88,6 +89,29 @@ InternalSafeFreePool (
   }
 }
 
+/**
+  Free image buffer unless it is mapped from the theme pack.
+
+  @param[in] Context  GUI context.
+  @param[in] Buffer   Image buffer.
+**/
+STATIC
+VOID
+InternalFreeImageBuffer (
+  IN CONST BOOT_PICKER_GUI_CONTEXT  *Context,
+  IN CONST VOID                     *Buffer
+  )
+{
+  if (  (Context->ThemePack != NULL)
+     && ((UINTN)Buffer >= (UINTN)Context->ThemePack)
+     && ((UINTN)Buffer < (UINTN)Context->ThemePack + Context->ThemePackSize))
+  {
+    return;
+  }
+
+  InternalSafeFreePool (Buffer);
+}
+
 STATIC
 VOID
 InternalContextDestruct (
@@ -99,7 +123,8 @@ InternalContextDestruct (
 
   for (Index = 0; Index < ICON_NUM_TOTAL; ++Index) {
     for (Index2 = 0; Index2 < ICON_TYPE_COUNT; ++Index2) {
-      InternalSafeFreePool (Context->Icons[Index][Index2].Buffer);
+      GuiFreeLazyImage (&Context->Icons[Index][Index2]);
+      InternalFreeImageBuffer (Context, Context->Icons[Index][Index2].Buffer);
     }
   }
 
@@ -107,8 +132,10 @@ InternalContextDestruct (
     InternalSafeFreePool (Context->Labels[Index].Buffer);
   }
 
-  InternalSafeFreePool (Context->Background.Buffer);
+  InternalFreeImageBuffer (Context, Context->Background.Buffer);
   InternalSafeFreePool (Context->FontContext.FontImage.Buffer);
+  InternalSafeFreePool (Context->ThemePack);
+  Context->ThemePack = NULL;
 
   /*
   InternalSafeFreePool (Context->Poof[0].Buffer);
@@ -119,30 +146,86 @@ InternalContextDestruct (
   */
 }
 
+/**
+  Load the theme pack for the current scale when present.
+
+  @param[in,out] Context  GUI context with prefix and scale set.
+  @param[in]     Storage  OpenCore storage.
+**/
 STATIC
-EFI_STATUS
-LoadImageFileFromStorage (
-  OUT GUI_IMAGE           *Images,
-  IN  OC_STORAGE_CONTEXT  *Storage,
-  IN  CONST CHAR8         *ImageFilePath,
-  IN  UINT8               Scale,
-  IN  UINT32              MatchWidth,
-  IN  UINT32              MatchHeight,
-  IN  BOOLEAN             Icon,
-  IN  CONST CHAR8         *Prefix,
-  IN  BOOLEAN             AllowLessSize
+VOID
+LoadThemePackFromStorage (
+  IN OUT BOOT_PICKER_GUI_CONTEXT  *Context,
+  IN     OC_STORAGE_CONTEXT       *Storage
   )
 {
   EFI_STATUS  Status;
   CHAR16      Path[OC_STORAGE_SAFE_PATH_MAX];
-  UINT8       *FileData;
-  UINT32      FileSize;
-  UINT32      ImageCount;
-  UINT32      Index;
+
+  Context->ThemePack     = NULL;
+  Context->ThemePackSize = 0;
+
+  Status = OcUnicodeSafeSPrint (
+             Path,
+             sizeof (Path),
+             OPEN_CORE_IMAGE_PATH L"%a\\" GUI_THEME_PACK_FILE_NAME,
+             Context->Prefix,
+             Context->Scale
+             );
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  UnicodeUefiSlashes (Path);
+  if (!OcStorageExistsFileUnicode (Storage, Path)) {
+    return;
+  }
+
+  Context->ThemePack = OcStorageReadFileUnicode (Storage, Path, &Context->ThemePackSize);
+  if (Context->ThemePack == NULL) {
+    return;
+  }
+
+  Status = GuiThemePackValidate (Context->ThemePack, Context->ThemePackSize, Context->Scale);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "OCUI: Ignoring invalid theme pack %s - %r\n", Path, Status));
+    FreePool (Context->ThemePack);
+    Context->ThemePack     = NULL;
+    Context->ThemePackSize = 0;
+    return;
+  }
+
+  DEBUG ((DEBUG_INFO, "OCUI: Using theme pack %s\n", Path));
+}
+
+STATIC
+EFI_STATUS
+LoadImageFileFromStorage (
+  OUT GUI_IMAGE                *Images,
+  IN  BOOT_PICKER_GUI_CONTEXT  *Context,
+  IN  OC_STORAGE_CONTEXT       *Storage,
+  IN  CONST CHAR8              *ImageFilePath,
+  IN  UINT8                    Scale,
+  IN  UINT32                   MatchWidth,
+  IN  UINT32                   MatchHeight,
+  IN  BOOLEAN                  Icon,
+  IN  BOOLEAN                  AllowLessSize,
+  IN  CONST GUI_IMAGE          *LazyFallback  OPTIONAL
+  )
+{
+  EFI_STATUS   Status;
+  CHAR16       Path[OC_STORAGE_SAFE_PATH_MAX];
+  CHAR8        ImageName[GUI_THEME_PACK_NAME_SIZE];
+  CONST CHAR8  *Prefix;
+  UINT8        *FileData;
+  UINT32       FileSize;
+  UINT32       ImageCount;
+  UINT32       Index;
 
   ASSERT (ImageFilePath != NULL);
   ASSERT (Scale == 1 || Scale == 2);
 
+  Prefix     = Context->Prefix;
   ImageCount = Icon ? ICON_TYPE_COUNT : 1; ///< Icons can be external.
 
   for (Index = 0; Index < ImageCount; ++Index) {
@@ -160,19 +243,66 @@ LoadImageFileFromStorage (
     }
 
     UnicodeUefiSlashes (Path);
-    Status = EFI_NOT_FOUND;
+    FileData = NULL;
+    FileSize = 0;
     if (OcStorageExistsFileUnicode (Storage, Path)) {
       FileData = OcStorageReadFileUnicode (Storage, Path, &FileSize);
-      if ((FileData != NULL) && (FileSize > 0)) {
-        Status = GuiIcnsToImageIcon (
-                   &Images[Index],
-                   FileData,
-                   FileSize,
-                   Scale,
-                   MatchWidth,
-                   MatchHeight,
-                   AllowLessSize
-                   );
+    }
+
+    Status = OcAsciiSafeSPrint (
+               ImageName,
+               sizeof (ImageName),
+               "%a%a",
+               Index > 0 ? "Ext" : "",
+               ImageFilePath
+               );
+    if (!EFI_ERROR (Status) && (FileData != NULL)) {
+      Status = GuiThemePackGetImage (
+                 &Images[Index],
+                 Context->ThemePack,
+                 ImageName,
+                 FileData,
+                 FileSize,
+                 Scale,
+                 MatchWidth,
+                 MatchHeight,
+                 AllowLessSize,
+                 TRUE
+                 );
+      if (!EFI_ERROR (Status)) {
+        FreePool (FileData);
+        continue;
+      }
+    }
+
+    Status = EFI_NOT_FOUND;
+    if (FileData != NULL) {
+      if (FileSize > 0) {
+        if (LazyFallback != NULL) {
+          ASSERT (!AllowLessSize);
+          Status = GuiIcnsToLazyImageIcon (
+                     &Images[Index],
+                     FileData,
+                     FileSize,
+                     Scale,
+                     MatchWidth,
+                     MatchHeight,
+                     &LazyFallback[Index]
+                     );
+          if (!EFI_ERROR (Status)) {
+            FileData = NULL;
+          }
+        } else {
+          Status = GuiIcnsToImageIcon (
+                     &Images[Index],
+                     FileData,
+                     FileSize,
+                     Scale,
+                     MatchWidth,
+                     MatchHeight,
+                     AllowLessSize
+                     );
+        }
       }
 
       if (FileData != NULL) {
@@ -202,6 +332,7 @@ LoadImageFileFromStorage (
       Images[Index].Width  = 0;
       Images[Index].Height = 0;
       Images[Index].Buffer = NULL;
+      Images[Index].Lazy   = NULL;
     }
   }
 
@@ -290,6 +421,7 @@ InternalGetFlavourIcon (
   IN  UINTN                    FlavourNameLen,
   IN  UINT32                   IconTypeIndex,
   IN  BOOLEAN                  UseFlavourIcon,
+  IN  CONST GUI_IMAGE          *Fallback,
   OUT GUI_IMAGE                *EntryIcon,
   OUT BOOLEAN                  *CustomIcon
   )
@@ -297,6 +429,7 @@ InternalGetFlavourIcon (
   EFI_STATUS  Status;
   CHAR16      Path[OC_STORAGE_SAFE_PATH_MAX];
   CHAR8       ImageName[OC_MAX_CONTENT_FLAVOUR_SIZE];
+  CHAR8       PackName[GUI_THEME_PACK_NAME_SIZE];
   UINT8       *FileData;
   UINT32      FileSize;
   UINTN       Index;
@@ -316,7 +449,7 @@ InternalGetFlavourIcon (
   //
   for (Index = ICON_NUM_SYS; Index < ICON_NUM_TOTAL; ++Index) {
     if (OcAsciiStrniCmp (FlavourName, mIconNames[Index], FlavourNameLen) == 0) {
-      if (GuiContext->Icons[Index][IconTypeIndex].Buffer != NULL) {
+      if (GUI_IMAGE_PRESENT (&GuiContext->Icons[Index][IconTypeIndex])) {
         CopyMem (EntryIcon, &GuiContext->Icons[Index][IconTypeIndex], sizeof (*EntryIcon));
         *CustomIcon = FALSE;
         return EFI_SUCCESS;
@@ -334,6 +467,7 @@ InternalGetFlavourIcon (
   }
 
   AsciiStrnCpyS (ImageName, OC_MAX_CONTENT_FLAVOUR_SIZE, FlavourName, FlavourNameLen);
+
   Status = OcUnicodeSafeSPrint (
              Path,
              sizeof (Path),
@@ -351,32 +485,71 @@ InternalGetFlavourIcon (
   UnicodeUefiSlashes (Path);
   DEBUG ((DEBUG_INFO, "OCUI: Trying flavour icon %s\n", Path));
 
-  Status = EFI_NOT_FOUND;
-  if (OcStorageExistsFileUnicode (Storage, Path)) {
-    FileData = OcStorageReadFileUnicode (Storage, Path, &FileSize);
-    if ((FileData != NULL) && (FileSize > 0)) {
-      Status = GuiIcnsToImageIcon (
-                 EntryIcon,
-                 FileData,
-                 FileSize,
-                 GuiContext->Scale,
-                 BOOT_ENTRY_ICON_DIMENSION,
-                 BOOT_ENTRY_ICON_DIMENSION,
-                 FALSE
-                 );
-    }
+  if (!OcStorageExistsFileUnicode (Storage, Path)) {
+    return EFI_NOT_FOUND;
+  }
 
-    if (FileData != NULL) {
+  FileData = OcStorageReadFileUnicode (Storage, Path, &FileSize);
+  if (FileData == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  Status = OcAsciiSafeSPrint (
+             PackName,
+             sizeof (PackName),
+             "%a%a",
+             IconTypeIndex > 0 ? "Ext" : "",
+             ImageName
+             );
+  if (!EFI_ERROR (Status)) {
+    Status = GuiThemePackGetImage (
+               EntryIcon,
+               GuiContext->ThemePack,
+               PackName,
+               FileData,
+               FileSize,
+               GuiContext->Scale,
+               BOOT_ENTRY_ICON_DIMENSION,
+               BOOT_ENTRY_ICON_DIMENSION,
+               FALSE,
+               TRUE
+               );
+    if (!EFI_ERROR (Status)) {
       FreePool (FileData);
+      //
+      // Packed images are owned by the theme pack.
+      //
+      *CustomIcon = FALSE;
+      return EFI_SUCCESS;
     }
+  }
 
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_WARN, "OCUI: Invalid icon file\n"));
+  Status = EFI_NOT_FOUND;
+  if (FileSize > 0) {
+    Status = GuiIcnsToLazyImageIcon (
+               EntryIcon,
+               FileData,
+               FileSize,
+               GuiContext->Scale,
+               BOOT_ENTRY_ICON_DIMENSION,
+               BOOT_ENTRY_ICON_DIMENSION,
+               Fallback
+               );
+    if (!EFI_ERROR (Status)) {
+      FileData = NULL;
     }
   }
 
+  if (FileData != NULL) {
+    FreePool (FileData);
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "OCUI: Invalid icon file\n"));
+  }
+
   if (!EFI_ERROR (Status)) {
-    ASSERT (EntryIcon->Buffer != NULL);
+    ASSERT (EntryIcon->Lazy != NULL);
     *CustomIcon = TRUE;
     return EFI_SUCCESS;
   }
@@ -393,6 +566,7 @@ InternalContextConstruct (
 {
   EFI_STATUS                         Status;
   EFI_USER_INTERFACE_THEME_PROTOCOL  *UiTheme;
+  GUI_IMAGE                          PackedFontImage;
   VOID                               *FontImage;
   VOID                               *FontData;
   UINT32                             FontImageSize;
@@ -449,16 +623,19 @@ InternalContextConstruct (
     Context->Prefix = Picker->PickerVariant;
   }
 
+  LoadThemePackFromStorage (Context, Storage);
+
   LoadImageFileFromStorage (
     &Context->Background,
+    Context,
     Storage,
     "Background",
     Context->Scale,
     0,
     0,
     FALSE,
-    Context->Prefix,
-    FALSE
+    FALSE,
+    NULL
     );
 
   if (Context->BackgroundColor.Raw == APPLE_COLOR_SYRAH_BLACK) {
@@ -526,14 +703,15 @@ InternalContextConstruct (
 
     Status = LoadImageFileFromStorage (
                Context->Icons[Index],
+               Context,
                Storage,
                mIconNames[Index],
                Context->Scale,
                ImageWidth,
                ImageHeight,
                Index >= ICON_NUM_SYS,
-               Context->Prefix,
-               AllowLessSize
+               AllowLessSize,
+               Index >= ICON_NUM_MANDATORY ? Context->Icons[ICON_GENERIC_HDD] : NULL
                );
     if (!EFI_ERROR (Status)) {
       if ((Index == ICON_SELECTOR) || (Index == ICON_SET_DEFAULT) || (Index == ICON_LEFT) || (Index == ICON_RIGHT) || (Index == ICON_SHUT_DOWN) || (Index == ICON_RESTART) || (Index == ICON_ENTER)) {
@@ -619,15 +797,68 @@ InternalContextConstruct (
     }
   }
 
+  if (Context->Scale == 2) {
+    FontData = OcStorageReadFileUnicode (Storage, OPEN_CORE_FONT_PATH L"Font_2x.bin", &FontDataSize);
+  } else {
+    FontData = OcStorageReadFileUnicode (Storage, OPEN_CORE_FONT_PATH L"Font_1x.bin", &FontDataSize);
+  }
+
+  FontImageSize = 0;
   if (Context->Scale == 2) {
     FontImage = OcStorageReadFileUnicode (Storage, OPEN_CORE_FONT_PATH L"Font_2x.png", &FontImageSize);
-    FontData  = OcStorageReadFileUnicode (Storage, OPEN_CORE_FONT_PATH L"Font_2x.bin", &FontDataSize);
   } else {
     FontImage = OcStorageReadFileUnicode (Storage, OPEN_CORE_FONT_PATH L"Font_1x.png", &FontImageSize);
-    FontData  = OcStorageReadFileUnicode (Storage, OPEN_CORE_FONT_PATH L"Font_1x.bin", &FontDataSize);
   }
 
-  if ((FontImage != NULL) && (FontData != NULL)) {
+  //
+  // Font image is owned by the font context, so packed pixels are copied.
+  //
+  Status = GuiThemePackGetImage (
+             &PackedFontImage,
+             Context->ThemePack,
+             "Font",
+             FontImage,
+             FontImageSize,
+             Context->Scale,
+             0,
+             0,
+             FALSE,
+             FALSE
+             );
+  if (!EFI_ERROR (Status)) {
+    PackedFontImage.Buffer = AllocateCopyPool (
+                               PackedFontImage.Width * PackedFontImage.Height * sizeof (*PackedFontImage.Buffer),
+                               PackedFontImage.Buffer
+                               );
+    if (PackedFontImage.Buffer == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+    }
+  }
+
+  if (!EFI_ERROR (Status)) {
+    FreePool (FontImage);
+    FontImage = NULL;
+  }
+
+  if (FontData == NULL) {
+    if (!EFI_ERROR (Status)) {
+      FreePool (PackedFontImage.Buffer);
+    }
+
+    if (FontImage != NULL) {
+      FreePool (FontImage);
+    }
+
+    Result = FALSE;
+  } else if (!EFI_ERROR (Status)) {
+    Result = GuiFontConstructFromImage (
+               &Context->FontContext,
+               &PackedFontImage,
+               FontData,
+               FontDataSize,
+               Context->Scale
+               );
+  } else if (FontImage != NULL) {
     Result = GuiFontConstruct (
                &Context->FontContext,
                FontImage,
@@ -636,19 +867,20 @@ InternalContextConstruct (
                FontDataSize,
                Context->Scale
                );
-    if (Context->FontContext.BmfContext.Height != (BOOT_ENTRY_LABEL_HEIGHT - BOOT_ENTRY_LABEL_TEXT_OFFSET) * Context->Scale) {
-      DEBUG ((
-        DEBUG_WARN,
-        "OCUI: Font has height %d instead of %d\n",
-        Context->FontContext.BmfContext.Height,
-        (BOOT_ENTRY_LABEL_HEIGHT - BOOT_ENTRY_LABEL_TEXT_OFFSET) * Context->Scale
-        ));
-      Result = FALSE;
-    }
   } else {
     Result = FALSE;
   }
 
+  if (Result && (Context->FontContext.BmfContext.Height != (BOOT_ENTRY_LABEL_HEIGHT - BOOT_ENTRY_LABEL_TEXT_OFFSET) * Context->Scale)) {
+    DEBUG ((
+      DEBUG_WARN,
+      "OCUI: Font has height %d instead of %d\n",
+      Context->FontContext.BmfContext.Height,
+      (BOOT_ENTRY_LABEL_HEIGHT - BOOT_ENTRY_LABEL_TEXT_OFFSET) * Context->Scale
+      ));
+    Result = FALSE;
+  }
+
   if (!Result) {
     DEBUG ((DEBUG_WARN, "OCUI: Font init failed\n"));
     InternalContextDestruct (Context);
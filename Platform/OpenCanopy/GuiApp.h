@@ -119,6 +119,8 @@ typedef struct _BOOT_PICKER_GUI_CONTEXT {
   // GUI_IMAGE                         Poof[5];
   GUI_FONT_CONTEXT                       FontContext;
   CONST CHAR8                            *Prefix;
+  VOID                                   *ThemePack;
+  UINT32                                 ThemePackSize;
   VOID                                   *BootEntry;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL_UNION    BackgroundColor;
   BOOLEAN                                HideAuxiliary;
@@ -189,6 +191,7 @@ InternalGetFlavourIcon (
   IN  UINTN                    FlavourNameLen,
   IN  UINT32                   IconTypeIndex,
   IN  BOOLEAN                  UseFlavourIcon,
+  IN  CONST GUI_IMAGE          *Fallback,
   OUT GUI_IMAGE                *EntryIcon,
   OUT BOOLEAN                  *CustomIcon
   );
@@ -11,12 +11,14 @@
 #include <IndustryStandard/AppleDiskLabel.h>
 
 #include <Library/BaseLib.h>
+#include <Library/BaseOverflowLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/DebugLib.h>
 #include <Library/OcCompressionLib.h>
 #include <Library/OcPngLib.h>
 
 #include "OpenCanopy.h"
+#include "ThemePack.h"
 
 //
 // Disk label palette.
@@ -42,25 +44,77 @@ CONST UINT8
   [0xd6] = 0
 };
 
+/**
+  Check whether image dimensions are acceptable for the target dimensions.
+
+  @param[in] Image        Image to check.
+  @param[in] Scale        User interface scale.
+  @param[in] MatchWidth   Target width, 0 to accept any dimensions.
+  @param[in] MatchHeight  Target height, 0 to accept any dimensions.
+  @param[in] AllowLess    Whether smaller images are acceptable.
+
+  @retval TRUE when dimensions are acceptable.
+**/
+STATIC
+BOOLEAN
+InternalImageMatchesSize (
+  IN CONST GUI_IMAGE  *Image,
+  IN UINT8            Scale,
+  IN UINT32           MatchWidth,
+  IN UINT32           MatchHeight,
+  IN BOOLEAN          AllowLess
+  )
+{
+  if ((MatchWidth == 0) || (MatchHeight == 0)) {
+    return TRUE;
+  }
+
+  if (AllowLess
+    ? (  (Image->Width >  MatchWidth * Scale) || (Image->Height >  MatchWidth * Scale)
+      || (Image->Width == 0) || (Image->Height == 0))
+    : ((Image->Width != MatchWidth * Scale) || (Image->Height != MatchHeight * Scale)))
+  {
+    DEBUG ((
+      DEBUG_INFO,
+      "OCUI: Expected %dx%d, actual %dx%d, allow less: %d\n",
+      MatchWidth * Scale,
+      MatchHeight * Scale,
+      Image->Width,
+      Image->Height,
+      AllowLess
+      ));
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+  Find the records to decode an icon from at the given scale.
+
+  @param[in]  IcnsImage      Icon file data.
+  @param[in]  IcnsImageSize  Icon file size.
+  @param[in]  Scale          User interface scale.
+  @param[out] RecordPng      PNG record, if present.
+  @param[out] RecordIT32     IT32 record when PNG record is not present.
+  @param[out] RecordT8MK     T8MK record when PNG record is not present.
+
+  @retval EFI_SUCCESS when either PNG or both IT32 and T8MK records are found.
+**/
+STATIC
 EFI_STATUS
-GuiIcnsToImageIcon (
-  OUT GUI_IMAGE  *Image,
-  IN  VOID       *IcnsImage,
-  IN  UINT32     IcnsImageSize,
-  IN  UINT8      Scale,
-  IN  UINT32     MatchWidth,
-  IN  UINT32     MatchHeight,
-  IN  BOOLEAN    AllowLess
+InternalIcnsFindRecords (
+  IN  VOID               *IcnsImage,
+  IN  UINT32             IcnsImageSize,
+  IN  UINT8              Scale,
+  OUT APPLE_ICNS_RECORD  **RecordPng,
+  OUT APPLE_ICNS_RECORD  **RecordIT32,
+  OUT APPLE_ICNS_RECORD  **RecordT8MK
   )
 {
-  EFI_STATUS         Status;
   UINT32             Offset;
   UINT32             RecordLength;
-  UINT32             ImageSize;
-  UINT32             DecodedBytes;
   APPLE_ICNS_RECORD  *Record;
-  APPLE_ICNS_RECORD  *RecordIT32;
-  APPLE_ICNS_RECORD  *RecordT8MK;
 
   ASSERT (Scale == 1 || Scale == 2);
 
@@ -79,8 +133,9 @@ GuiIcnsToImageIcon (
     return EFI_SECURITY_VIOLATION;
   }
 
-  RecordIT32 = NULL;
-  RecordT8MK = NULL;
+  *RecordPng  = NULL;
+  *RecordIT32 = NULL;
+  *RecordT8MK = NULL;
 
   Offset = sizeof (APPLE_ICNS_RECORD);
   while (Offset < IcnsImageSize - sizeof (APPLE_ICNS_RECORD)) {
@@ -103,77 +158,340 @@ GuiIcnsToImageIcon (
     if (  ((Scale == 1) && (Record->Type == APPLE_ICNS_IC07))
        || ((Scale == 2) && (Record->Type == APPLE_ICNS_IC13)))
     {
-      Status = GuiPngToImage (
-                 Image,
-                 Record->Data,
-                 RecordLength - sizeof (APPLE_ICNS_RECORD),
-                 TRUE
-                 );
-
-      if (!EFI_ERROR (Status) && (MatchWidth > 0) && (MatchHeight > 0)) {
-        if (AllowLess
-          ? (  (Image->Width >  MatchWidth * Scale) || (Image->Height >  MatchWidth * Scale)
-            || (Image->Width == 0) || (Image->Height == 0))
-          : ((Image->Width != MatchWidth * Scale) || (Image->Height != MatchHeight * Scale)))
-        {
-          FreePool (Image->Buffer);
-          DEBUG ((
-            DEBUG_INFO,
-            "OCUI: Expected %dx%d, actual %dx%d, allow less: %d\n",
-            MatchWidth * Scale,
-            MatchHeight * Scale,
-            Image->Width,
-            Image->Height,
-            AllowLess
-            ));
-          Status = EFI_UNSUPPORTED;
-        }
-      }
-
-      return Status;
+      *RecordPng = Record;
+      return EFI_SUCCESS;
     }
 
     if (Scale == 1) {
       if (Record->Type == APPLE_ICNS_IT32) {
-        RecordIT32 = Record;
+        *RecordIT32 = Record;
       } else if (Record->Type == APPLE_ICNS_T8MK) {
-        RecordT8MK = Record;
+        *RecordT8MK = Record;
       }
 
-      if ((RecordT8MK != NULL) && (RecordIT32 != NULL)) {
-        Image->Width  = MatchWidth;
-        Image->Height = MatchHeight;
-        ImageSize     = (MatchWidth * MatchHeight) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
-        Image->Buffer = AllocateZeroPool (ImageSize);
+      if ((*RecordT8MK != NULL) && (*RecordIT32 != NULL)) {
+        return EFI_SUCCESS;
+      }
+    }
+  }
 
-        if (Image->Buffer == NULL) {
-          return EFI_OUT_OF_RESOURCES;
-        }
+  return EFI_NOT_FOUND;
+}
 
-        //
-        // We have to add an additional UINT32 for IT32, since it has a reserved field.
-        //
-        DecodedBytes = DecompressMaskedRLE24 (
-                         (UINT8 *)Image->Buffer,
-                         ImageSize,
-                         RecordIT32->Data + sizeof (UINT32),
-                         SwapBytes32 (RecordIT32->Size) - sizeof (APPLE_ICNS_RECORD) - sizeof (UINT32),
-                         RecordT8MK->Data,
-                         SwapBytes32 (RecordT8MK->Size) - sizeof (APPLE_ICNS_RECORD),
-                         TRUE
-                         );
-
-        if (DecodedBytes != ImageSize) {
-          FreePool (Image->Buffer);
-          return EFI_UNSUPPORTED;
-        }
+EFI_STATUS
+GuiIcnsToImageIcon (
+  OUT GUI_IMAGE  *Image,
+  IN  VOID       *IcnsImage,
+  IN  UINT32     IcnsImageSize,
+  IN  UINT8      Scale,
+  IN  UINT32     MatchWidth,
+  IN  UINT32     MatchHeight,
+  IN  BOOLEAN    AllowLess
+  )
+{
+  EFI_STATUS         Status;
+  UINT32             ImageSize;
+  UINT32             DecodedBytes;
+  APPLE_ICNS_RECORD  *RecordPng;
+  APPLE_ICNS_RECORD  *RecordIT32;
+  APPLE_ICNS_RECORD  *RecordT8MK;
 
-        return EFI_SUCCESS;
+  Status = InternalIcnsFindRecords (
+             IcnsImage,
+             IcnsImageSize,
+             Scale,
+             &RecordPng,
+             &RecordIT32,
+             &RecordT8MK
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (RecordPng != NULL) {
+    Status = GuiPngToImage (
+               Image,
+               RecordPng->Data,
+               SwapBytes32 (RecordPng->Size) - sizeof (APPLE_ICNS_RECORD),
+               TRUE
+               );
+
+    if (  !EFI_ERROR (Status)
+       && !InternalImageMatchesSize (Image, Scale, MatchWidth, MatchHeight, AllowLess))
+    {
+      FreePool (Image->Buffer);
+      Status = EFI_UNSUPPORTED;
+    }
+
+    return Status;
+  }
+
+  Image->Width  = MatchWidth;
+  Image->Height = MatchHeight;
+  ImageSize     = (MatchWidth * MatchHeight) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+  Image->Buffer = AllocateZeroPool (ImageSize);
+
+  if (Image->Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // We have to add an additional UINT32 for IT32, since it has a reserved field.
+  //
+  DecodedBytes = DecompressMaskedRLE24 (
+                   (UINT8 *)Image->Buffer,
+                   ImageSize,
+                   RecordIT32->Data + sizeof (UINT32),
+                   SwapBytes32 (RecordIT32->Size) - sizeof (APPLE_ICNS_RECORD) - sizeof (UINT32),
+                   RecordT8MK->Data,
+                   SwapBytes32 (RecordT8MK->Size) - sizeof (APPLE_ICNS_RECORD),
+                   TRUE
+                   );
+
+  if (DecodedBytes != ImageSize) {
+    FreePool (Image->Buffer);
+    return EFI_UNSUPPORTED;
+  }
+
+  return EFI_SUCCESS;
+}
+
+//
+// Lazily decoded icon. The icon file data is retained until the image is
+// first requested for drawing, and decoded pixels live in a bounded cache.
+//
+struct GUI_LAZY_IMAGE_ {
+  VOID               *IcnsImage;
+  UINT32             IcnsImageSize;
+  UINT32             MatchWidth;
+  UINT32             MatchHeight;
+  UINT8              Scale;
+  BOOLEAN            Failed;
+  UINT32             LastUse;
+  CONST GUI_IMAGE    *Fallback;
+  GUI_IMAGE          Decoded;
+};
+
+//
+// Decoded lazy images. The capacity exceeds the number of boot entries
+// that fit on a 4K screen at 1x scale, so that redrawing the visible entries
+// never evicts each other.
+//
+#define GUI_LAZY_IMAGE_CACHE_SIZE  32U
+
+STATIC GUI_LAZY_IMAGE  *mLazyImageCache[GUI_LAZY_IMAGE_CACHE_SIZE];
+STATIC UINT32          mLazyImageUseCounter;
+
+STATIC
+VOID
+InternalLazyImageEvict (
+  IN UINT32  Slot
+  )
+{
+  GUI_LAZY_IMAGE  *Lazy;
+
+  Lazy = mLazyImageCache[Slot];
+  ASSERT (Lazy != NULL);
+  ASSERT (Lazy->Decoded.Buffer != NULL);
+
+  FreePool (Lazy->Decoded.Buffer);
+  Lazy->Decoded.Buffer  = NULL;
+  mLazyImageCache[Slot] = NULL;
+}
+
+/**
+  Get a free cache slot, evicting the least recently used image if needed.
+
+  @retval Free cache slot index.
+**/
+STATIC
+UINT32
+InternalLazyImageGetSlot (
+  VOID
+  )
+{
+  UINT32  Index;
+  UINT32  Oldest;
+
+  Oldest = 0;
+  for (Index = 0; Index < GUI_LAZY_IMAGE_CACHE_SIZE; ++Index) {
+    if (mLazyImageCache[Index] == NULL) {
+      return Index;
+    }
+
+    if (  (mLazyImageUseCounter - mLazyImageCache[Index]->LastUse)
+       > (mLazyImageUseCounter - mLazyImageCache[Oldest]->LastUse))
+    {
+      Oldest = Index;
+    }
+  }
+
+  InternalLazyImageEvict (Oldest);
+  return Oldest;
+}
+
+EFI_STATUS
+GuiIcnsToLazyImageIcon (
+  OUT GUI_IMAGE        *Image,
+  IN  VOID             *IcnsImage,
+  IN  UINT32           IcnsImageSize,
+  IN  UINT8            Scale,
+  IN  UINT32           MatchWidth,
+  IN  UINT32           MatchHeight,
+  IN  CONST GUI_IMAGE  *Fallback
+  )
+{
+  EFI_STATUS         Status;
+  GUI_LAZY_IMAGE     *Lazy;
+  APPLE_ICNS_RECORD  *RecordPng;
+  APPLE_ICNS_RECORD  *RecordIT32;
+  APPLE_ICNS_RECORD  *RecordT8MK;
+
+  ASSERT (Image != NULL);
+  ASSERT (IcnsImage != NULL);
+  ASSERT (MatchWidth > 0);
+  ASSERT (MatchHeight > 0);
+  ASSERT (Fallback != NULL);
+  ASSERT (Fallback->Width == MatchWidth * Scale);
+  ASSERT (Fallback->Height == MatchHeight * Scale);
+
+  //
+  // Only check that the icon has data for this scale, so that callers may
+  // still choose another icon. Decoding failures fall back to Fallback.
+  //
+  Status = InternalIcnsFindRecords (
+             IcnsImage,
+             IcnsImageSize,
+             Scale,
+             &RecordPng,
+             &RecordIT32,
+             &RecordT8MK
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Lazy = AllocateZeroPool (sizeof (*Lazy));
+  if (Lazy == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Lazy->IcnsImage     = IcnsImage;
+  Lazy->IcnsImageSize = IcnsImageSize;
+  Lazy->MatchWidth    = MatchWidth;
+  Lazy->MatchHeight   = MatchHeight;
+  Lazy->Scale         = Scale;
+  Lazy->Fallback      = Fallback;
+
+  Image->Width  = MatchWidth * Scale;
+  Image->Height = MatchHeight * Scale;
+  Image->Buffer = NULL;
+  Image->Lazy   = Lazy;
+
+  return EFI_SUCCESS;
+}
+
+CONST GUI_IMAGE *
+GuiGetImage (
+  IN CONST GUI_IMAGE  *Image
+  )
+{
+  EFI_STATUS      Status;
+  GUI_LAZY_IMAGE  *Lazy;
+  UINT32          Index;
+
+  ASSERT (Image != NULL);
+
+  Lazy = Image->Lazy;
+  if (Lazy == NULL) {
+    return Image;
+  }
+
+  if (Lazy->Failed) {
+    return GuiGetImage (Lazy->Fallback);
+  }
+
+  Lazy->LastUse = ++mLazyImageUseCounter;
+
+  if (Lazy->Decoded.Buffer != NULL) {
+    return &Lazy->Decoded;
+  }
+
+  Index  = InternalLazyImageGetSlot ();
+  Status = GuiIcnsToImageIcon (
+             &Lazy->Decoded,
+             Lazy->IcnsImage,
+             Lazy->IcnsImageSize,
+             Lazy->Scale,
+             Lazy->MatchWidth,
+             Lazy->MatchHeight,
+             FALSE
+             );
+  if (Status == EFI_OUT_OF_RESOURCES) {
+    //
+    // Give up all other decoded images under memory pressure.
+    //
+    for (Index = 0; Index < GUI_LAZY_IMAGE_CACHE_SIZE; ++Index) {
+      if (mLazyImageCache[Index] != NULL) {
+        InternalLazyImageEvict (Index);
       }
     }
+
+    Index  = 0;
+    Status = GuiIcnsToImageIcon (
+               &Lazy->Decoded,
+               Lazy->IcnsImage,
+               Lazy->IcnsImageSize,
+               Lazy->Scale,
+               Lazy->MatchWidth,
+               Lazy->MatchHeight,
+               FALSE
+               );
   }
 
-  return EFI_NOT_FOUND;
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCUI: Failed to decode lazy icon - %r\n", Status));
+    Lazy->Decoded.Buffer = NULL;
+    Lazy->Failed         = TRUE;
+    FreePool (Lazy->IcnsImage);
+    Lazy->IcnsImage = NULL;
+    return GuiGetImage (Lazy->Fallback);
+  }
+
+  mLazyImageCache[Index] = Lazy;
+  return &Lazy->Decoded;
+}
+
+VOID
+GuiFreeLazyImage (
+  IN OUT GUI_IMAGE  *Image
+  )
+{
+  GUI_LAZY_IMAGE  *Lazy;
+  UINT32          Index;
+
+  ASSERT (Image != NULL);
+
+  Lazy = Image->Lazy;
+  if (Lazy == NULL) {
+    return;
+  }
+
+  if (Lazy->Decoded.Buffer != NULL) {
+    for (Index = 0; Index < GUI_LAZY_IMAGE_CACHE_SIZE; ++Index) {
+      if (mLazyImageCache[Index] == Lazy) {
+        InternalLazyImageEvict (Index);
+        break;
+      }
+    }
+  }
+
+  if (Lazy->IcnsImage != NULL) {
+    FreePool (Lazy->IcnsImage);
+  }
+
+  FreePool (Lazy);
+  Image->Lazy = NULL;
 }
 
 EFI_STATUS
@@ -242,39 +560,164 @@ GuiPngToImage (
   IN  BOOLEAN    PremultiplyAlpha
   )
 {
-  EFI_STATUS                     Status;
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *BufferWalker;
-  UINTN                          Index;
-  UINT8                          TmpChannel;
-
-  Status = OcDecodePng (
-             ImageData,
-             ImageDataSize,
-             (VOID **)&Image->Buffer,
-             &Image->Width,
-             &Image->Height,
-             NULL
-             );
+  EFI_STATUS  Status;
+
+  //
+  // Icons are decoded straight to premultiplied BGRA, while the font
+  // is used as decoded by lodepng.
+  //
+  if (PremultiplyAlpha) {
+    Status = OcDecodePngBgra (
+               ImageData,
+               ImageDataSize,
+               TRUE,
+               (VOID **)&Image->Buffer,
+               &Image->Width,
+               &Image->Height
+               );
+  } else {
+    Status = OcDecodePng (
+               ImageData,
+               ImageDataSize,
+               (VOID **)&Image->Buffer,
+               &Image->Width,
+               &Image->Height,
+               NULL
+               );
+  }
 
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_INFO, "OCUI: DecodePNG - %r\n", Status));
     return Status;
   }
 
-  if (PremultiplyAlpha) {
-    BufferWalker = Image->Buffer;
-    for (Index = 0; Index < (UINTN)Image->Width * Image->Height; ++Index) {
-      TmpChannel          = (UINT8)((BufferWalker->Blue * BufferWalker->Reserved) / 0xFF);
-      BufferWalker->Blue  = (UINT8)((BufferWalker->Red * BufferWalker->Reserved) / 0xFF);
-      BufferWalker->Green = (UINT8)((BufferWalker->Green * BufferWalker->Reserved) / 0xFF);
-      BufferWalker->Red   = TmpChannel;
-      ++BufferWalker;
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+GuiThemePackValidate (
+  IN CONST VOID  *Pack,
+  IN UINT32      PackSize,
+  IN UINT8       Scale
+  )
+{
+  CONST GUI_THEME_PACK_HEADER  *Header;
+  CONST GUI_THEME_PACK_ENTRY   *Entries;
+  UINT32                       Index;
+  UINT32                       TocSize;
+  UINT32                       ImageSize;
+  UINT32                       ImageEnd;
+  UINT32                       PreviousEnd;
+
+  ASSERT (Pack != NULL);
+  ASSERT (Scale == 1 || Scale == 2);
+
+  if (PackSize < sizeof (GUI_THEME_PACK_HEADER)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Header = Pack;
+  if (  (Header->Signature != GUI_THEME_PACK_SIGNATURE)
+     || (Header->Version != GUI_THEME_PACK_VERSION)
+     || (Header->Scale != Scale))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (  BaseOverflowMulAddU32 (Header->NumEntries, sizeof (GUI_THEME_PACK_ENTRY), sizeof (GUI_THEME_PACK_HEADER), &TocSize)
+     || (TocSize > PackSize))
+  {
+    return EFI_SECURITY_VIOLATION;
+  }
+
+  //
+  // Validate every entry once, so that lookups can use the data directly.
+  //
+  Entries     = (CONST GUI_THEME_PACK_ENTRY *)(Header + 1);
+  PreviousEnd = TocSize;
+  for (Index = 0; Index < Header->NumEntries; ++Index) {
+    if (  (Entries[Index].Name[GUI_THEME_PACK_NAME_SIZE - 1] != '\0')
+       || (Entries[Index].Width == 0)
+       || (Entries[Index].Height == 0)
+       || (Entries[Index].Offset < PreviousEnd)
+       || ((Entries[Index].Offset % GUI_THEME_PACK_ALIGNMENT) != 0)
+       || BaseOverflowMulU32 (Entries[Index].Width, Entries[Index].Height, &ImageSize)
+       || BaseOverflowMulU32 (ImageSize, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL), &ImageSize)
+       || BaseOverflowAddU32 (Entries[Index].Offset, ImageSize, &ImageEnd)
+       || (ImageEnd > PackSize))
+    {
+      return EFI_SECURITY_VIOLATION;
     }
+
+    PreviousEnd = ImageEnd;
   }
 
   return EFI_SUCCESS;
 }
 
+EFI_STATUS
+GuiThemePackGetImage (
+  OUT GUI_IMAGE    *Image,
+  IN  VOID         *Pack,
+  IN  CONST CHAR8  *Name,
+  IN  CONST VOID   *Source      OPTIONAL,
+  IN  UINT32       SourceSize,
+  IN  UINT8        Scale,
+  IN  UINT32       MatchWidth,
+  IN  UINT32       MatchHeight,
+  IN  BOOLEAN      AllowLess,
+  IN  BOOLEAN      Premultiplied
+  )
+{
+  CONST GUI_THEME_PACK_HEADER  *Header;
+  CONST GUI_THEME_PACK_ENTRY   *Entries;
+  UINT32                       Index;
+
+  ASSERT (Image != NULL);
+  ASSERT (Name != NULL);
+
+  if (Pack == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  Header  = Pack;
+  Entries = (CONST GUI_THEME_PACK_ENTRY *)(Header + 1);
+  ASSERT (Header->Scale == Scale);
+
+  for (Index = 0; Index < Header->NumEntries; ++Index) {
+    if (AsciiStrCmp (Entries[Index].Name, Name) != 0) {
+      continue;
+    }
+
+    if (((Entries[Index].Flags & GUI_THEME_PACK_PREMULTIPLIED) != 0) != Premultiplied) {
+      DEBUG ((DEBUG_INFO, "OCUI: Packed image %a has wrong flags %x\n", Name, Entries[Index].Flags));
+      return EFI_UNSUPPORTED;
+    }
+
+    if (  (Source == NULL)
+       || (Entries[Index].SourceSize != SourceSize)
+       || (Entries[Index].SourceChecksum != Adler32 (Source, SourceSize)))
+    {
+      DEBUG ((DEBUG_WARN, "OCUI: Packed image %a is outdated, theme pack needs a rebuild\n", Name));
+      return EFI_UNSUPPORTED;
+    }
+
+    Image->Width  = Entries[Index].Width;
+    Image->Height = Entries[Index].Height;
+    Image->Buffer = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)((UINT8 *)Pack + Entries[Index].Offset);
+    Image->Lazy   = NULL;
+
+    if (!InternalImageMatchesSize (Image, Scale, MatchWidth, MatchHeight, AllowLess)) {
+      Image->Buffer = NULL;
+      return EFI_UNSUPPORTED;
+    }
+
+    return EFI_SUCCESS;
+  }
+
+  return EFI_NOT_FOUND;
+}
+
 EFI_STATUS
 GuiCreateHighlightedImage (
   OUT GUI_IMAGE                            *SelectedImage,
@@ -123,12 +123,24 @@ struct GUI_OBJ_CHILD_ {
   GUI_OBJ    *Parent;
 };
 
+typedef struct GUI_LAZY_IMAGE_ GUI_LAZY_IMAGE;
+
 typedef struct {
   UINT32                           Width;
   UINT32                           Height;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL    *Buffer;
+  ///
+  /// When not NULL, the image is decoded on first use and Buffer is NULL.
+  /// Such images must be accessed with GuiGetImage.
+  ///
+  GUI_LAZY_IMAGE                   *Lazy;
 } GUI_IMAGE;
 
+///
+/// Whether the image is decoded or can be decoded on first use.
+///
+#define GUI_IMAGE_PRESENT(Image)  (((Image)->Buffer != NULL) || ((Image)->Lazy != NULL))
+
 typedef struct GUI_SCREEN_CURSOR_ GUI_SCREEN_CURSOR;
 
 typedef
@@ -195,6 +207,55 @@ GuiIcnsToImageIcon (
   IN  BOOLEAN    AllowLess
   );
 
+/**
+  Prepare an icon to be decoded on first use. Only the presence of icon data
+  for the requested scale is checked here.
+
+  @param[out] Image          Resulting lazy image.
+  @param[in]  IcnsImage      Icon file data, owned by Image on success.
+  @param[in]  IcnsImageSize  Icon file size.
+  @param[in]  Scale          User interface scale.
+  @param[in]  MatchWidth     Exact icon width.
+  @param[in]  MatchHeight    Exact icon height.
+  @param[in]  Fallback       Image of the same dimensions to use when decoding
+                             fails, must outlive Image.
+
+  @retval EFI_SUCCESS on success.
+**/
+EFI_STATUS
+GuiIcnsToLazyImageIcon (
+  OUT GUI_IMAGE        *Image,
+  IN  VOID             *IcnsImage,
+  IN  UINT32           IcnsImageSize,
+  IN  UINT8            Scale,
+  IN  UINT32           MatchWidth,
+  IN  UINT32           MatchHeight,
+  IN  CONST GUI_IMAGE  *Fallback
+  );
+
+/**
+  Get a drawable image, decoding lazy images on demand. The result is only
+  valid until the next call, as decoded images may be evicted from the cache.
+
+  @param[in] Image  Image to get.
+
+  @retval Image with pixel data.
+**/
+CONST GUI_IMAGE *
+GuiGetImage (
+  IN CONST GUI_IMAGE  *Image
+  );
+
+/**
+  Free lazy image data. Does nothing for images decoded up front.
+
+  @param[in,out] Image  Image to free.
+**/
+VOID
+GuiFreeLazyImage (
+  IN OUT GUI_IMAGE  *Image
+  );
+
 EFI_STATUS
 GuiLabelToImage (
   OUT GUI_IMAGE  *Image,
@@ -204,6 +265,56 @@ GuiLabelToImage (
   IN  BOOLEAN    Inverted
   );
 
+/**
+  Validate a pre-decoded theme pack.
+
+  @param[in] Pack      Theme pack file contents.
+  @param[in] PackSize  Theme pack file size.
+  @param[in] Scale     User interface scale the pack must be built for.
+
+  @retval EFI_SUCCESS when the pack and all its entries are valid.
+**/
+EFI_STATUS
+GuiThemePackValidate (
+  IN CONST VOID  *Pack,
+  IN UINT32      PackSize,
+  IN UINT8       Scale
+  );
+
+/**
+  Get an image from a validated theme pack. The image buffer points into
+  the pack and must not be freed.
+
+  @param[out] Image          Resulting image.
+  @param[in]  Pack           Validated theme pack, may be NULL.
+  @param[in]  Name           Image name.
+  @param[in]  Source         Current contents of the file the image was
+                             decoded from, NULL when it is missing.
+  @param[in]  SourceSize     Size of Source.
+  @param[in]  Scale          User interface scale.
+  @param[in]  MatchWidth     Target width, 0 to accept any dimensions.
+  @param[in]  MatchHeight    Target height, 0 to accept any dimensions.
+  @param[in]  AllowLess      Whether smaller images are acceptable.
+  @param[in]  Premultiplied  Whether the image must have premultiplied alpha.
+
+  @retval EFI_SUCCESS      The image was found.
+  @retval EFI_NOT_FOUND    The pack has no such image.
+  @retval EFI_UNSUPPORTED  The packed image does not match Source or the requested size.
+**/
+EFI_STATUS
+GuiThemePackGetImage (
+  OUT GUI_IMAGE    *Image,
+  IN  VOID         *Pack,
+  IN  CONST CHAR8  *Name,
+  IN  CONST VOID   *Source      OPTIONAL,
+  IN  UINT32       SourceSize,
+  IN  UINT8        Scale,
+  IN  UINT32       MatchWidth,
+  IN  UINT32       MatchHeight,
+  IN  BOOLEAN      AllowLess,
+  IN  BOOLEAN      Premultiplied
+  );
+
 VOID
 GuiObjDrawDelegate (
   IN OUT GUI_OBJ                  *This,
@@ -0,0 +1,67 @@
+/** @file
+  This file is part of OpenCanopy, OpenCore GUI.
+
+  Pre-decoded theme pack format. A pack holds every image of a theme at a
+  single scale as raw EFI_GRAPHICS_OUTPUT_BLT_PIXEL arrays, exactly as the
+  GUI would produce them after decoding, so that no decoding is required
+  at picker start. Packs are built by the themepack utility.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#ifndef GUI_THEME_PACK_H
+#define GUI_THEME_PACK_H
+
+//
+// Pack file name within the theme directory, formatted with the scale.
+//
+#define GUI_THEME_PACK_FILE_NAME  "Theme_%ux.pack"
+
+#define GUI_THEME_PACK_SIGNATURE  SIGNATURE_32 ('O', 'C', 'T', 'P')
+#define GUI_THEME_PACK_VERSION    2U
+
+//
+// Maximum image name size, including the null terminator.
+// Names match .icns file names without the extension, e.g. ExtHardDrive.
+//
+#define GUI_THEME_PACK_NAME_SIZE  32U
+
+//
+// Alignment of pixel data within the pack.
+//
+#define GUI_THEME_PACK_ALIGNMENT  16U
+
+//
+// Pixels have alpha premultiplied (icons), otherwise they are stored
+// as decoded (font).
+//
+#define GUI_THEME_PACK_PREMULTIPLIED  BIT0
+
+#pragma pack(push, 1)
+
+typedef struct {
+  UINT32    Signature;
+  UINT32    Version;
+  UINT32    Scale;
+  UINT32    NumEntries;
+} GUI_THEME_PACK_HEADER;
+
+//
+// Entries are sorted by Offset and do not overlap. SourceSize and
+// SourceChecksum (Adler-32) describe the .icns or .png file the image was
+// decoded from, packed pixels are only used while the file is unchanged.
+//
+typedef struct {
+  CHAR8     Name[GUI_THEME_PACK_NAME_SIZE];
+  UINT32    Width;
+  UINT32    Height;
+  UINT32    Flags;
+  UINT32    Offset;
+  UINT32    SourceSize;
+  UINT32    SourceChecksum;
+} GUI_THEME_PACK_ENTRY;
+
+#pragma pack(pop)
+
+#endif // GUI_THEME_PACK_H
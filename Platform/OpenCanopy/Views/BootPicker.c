@@ -542,7 +542,7 @@ InternalBootPickerEntryDraw (
   /*if (mBootPickerImageIndex < 5) {
     EntryIcon = &((BOOT_PICKER_GUI_CONTEXT *) DrawContext->GuiContext)->Poof[mBootPickerImageIndex];
   } else */{
-    EntryIcon = &Entry->EntryIcon;
+    EntryIcon = GuiGetImage (&Entry->EntryIcon);
   }
   Label = &Entry->Label;
   //
@@ -773,7 +773,7 @@ InternalBootPickerEntryPtrEvent (
   Entry = BASE_CR (This, GUI_VOLUME_ENTRY, Hdr.Obj);
 
   IsHit = GuiClickableIsHit (
-            &Entry->EntryIcon,
+            GuiGetImage (&Entry->EntryIcon),
             OffsetX,
             OffsetY
             );
@@ -1548,6 +1548,23 @@ BootPickerEntriesSet (
 
   VolumeEntry->Context = Entry;
 
+  IconTypeIndex = Entry->IsExternal ? ICON_TYPE_EXTERNAL : ICON_TYPE_BASE;
+
+  //
+  // Icons are decoded on first draw, the suggested icon is used when this fails.
+  //
+  SuggestedIcon = NULL;
+
+  if (Entry->Type == OC_BOOT_EXTERNAL_OS) {
+    SuggestedIcon = &GuiContext->Icons[ICON_OTHER][IconTypeIndex];
+  } else if ((Entry->Type & (OC_BOOT_EXTERNAL_TOOL | OC_BOOT_SYSTEM)) != 0) {
+    SuggestedIcon = &GuiContext->Icons[ICON_TOOL][IconTypeIndex];
+  }
+
+  if ((SuggestedIcon == NULL) || !GUI_IMAGE_PRESENT (SuggestedIcon)) {
+    SuggestedIcon = &GuiContext->Icons[ICON_GENERIC_HDD][IconTypeIndex];
+  }
+
   //
   // Load volume icons when allowed.
   // Do not load volume icons for Time Machine entries unless explicitly enabled.
@@ -1560,19 +1577,19 @@ BootPickerEntriesSet (
     Status = Context->GetEntryIcon (Context, Entry, &IconFileData, &IconFileSize);
 
     if (!EFI_ERROR (Status)) {
-      Status = GuiIcnsToImageIcon (
+      Status = GuiIcnsToLazyImageIcon (
                  &VolumeEntry->EntryIcon,
                  IconFileData,
                  IconFileSize,
                  GuiContext->Scale,
                  BOOT_ENTRY_ICON_DIMENSION,
                  BOOT_ENTRY_ICON_DIMENSION,
-                 FALSE
+                 SuggestedIcon
                  );
-      FreePool (IconFileData);
       if (!EFI_ERROR (Status)) {
         VolumeEntry->CustomIcon = TRUE;
       } else {
+        FreePool (IconFileData);
         DEBUG ((DEBUG_INFO, "OCUI: Failed to convert icon - %r\n", Status));
       }
     }
@@ -1587,8 +1604,6 @@ BootPickerEntriesSet (
   if (EFI_ERROR (Status)) {
     ASSERT (Entry->Flavour != NULL);
 
-    IconTypeIndex = Entry->IsExternal ? ICON_TYPE_EXTERNAL : ICON_TYPE_BASE;
-
     FlavourNameEnd = Entry->Flavour - 1;
     do {
       for (FlavourNameStart = ++FlavourNameEnd; *FlavourNameEnd != '\0' && *FlavourNameEnd != ':'; ++FlavourNameEnd) {
@@ -1601,24 +1616,13 @@ BootPickerEntriesSet (
                  FlavourNameEnd - FlavourNameStart,
                  IconTypeIndex,
                  UseFlavourIcon,
+                 SuggestedIcon,
                  &VolumeEntry->EntryIcon,
                  &VolumeEntry->CustomIcon
                  );
     } while (EFI_ERROR (Status) && *FlavourNameEnd != '\0');
 
     if (EFI_ERROR (Status)) {
-      SuggestedIcon = NULL;
-
-      if (Entry->Type == OC_BOOT_EXTERNAL_OS) {
-        SuggestedIcon = &GuiContext->Icons[ICON_OTHER][IconTypeIndex];
-      } else if ((Entry->Type & (OC_BOOT_EXTERNAL_TOOL | OC_BOOT_SYSTEM)) != 0) {
-        SuggestedIcon = &GuiContext->Icons[ICON_TOOL][IconTypeIndex];
-      }
-
-      if ((SuggestedIcon == NULL) || (SuggestedIcon->Buffer == NULL)) {
-        SuggestedIcon = &GuiContext->Icons[ICON_GENERIC_HDD][IconTypeIndex];
-      }
-
       CopyMem (&VolumeEntry->EntryIcon, SuggestedIcon, sizeof (VolumeEntry->EntryIcon));
     } else {
       DEBUG ((DEBUG_INFO, "OCUI: Using flavour icon, custom: %u\n", VolumeEntry->CustomIcon));
@@ -1666,7 +1670,7 @@ InternalBootPickerEntryDestruct (
   ASSERT (Entry->Label.Buffer != NULL);
 
   if (Entry->CustomIcon) {
-    FreePool (Entry->EntryIcon.Buffer);
+    GuiFreeLazyImage (&Entry->EntryIcon);
   }
 
   FreePool (Entry->Label.Buffer);
@@ -904,6 +904,7 @@ AutodetectLinuxAtDirectory (
   Status = EFI_SUCCESS;
 
   if (!IsStandaloneBoot) {
+    InternalRecordEntryProbe (RootDirectory, ROOT_FS_FILE);
     Status = OcSafeFileOpen (RootDirectory, &RootFsFile, ROOT_FS_FILE, EFI_FILE_MODE_READ, 0);
     if (!EFI_ERROR (Status)) {
       Status = OcEnsureDirectoryFile (RootFsFile, FALSE);
@@ -0,0 +1,992 @@
+/** @file
+  Cache of generated entries per partition, keyed by a fingerprint of the
+  files read when generating them and by the files probed for existence.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include "LinuxBootInternal.h"
+
+#include <Uefi.h>
+#include <Guid/FileInfo.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcCryptoLib.h>
+#include <Library/OcDebugLogLib.h>
+#include <Library/OcFileLib.h>
+#include <Library/OcFlexArrayLib.h>
+#include <Library/OcStringLib.h>
+#include <Library/PrintLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+#define LINUX_BOOT_CACHE_FILE      L"OpenLinuxBoot.cache"
+#define LINUX_BOOT_CACHE_MAGIC     SIGNATURE_32 ('O', 'L', 'B', 'C')
+#define LINUX_BOOT_CACHE_VERSION   2
+#define LINUX_BOOT_CACHE_MAX_SIZE  SIZE_1MB
+
+/*
+  Files read when generating entries, fingerprinted by size and modification time.
+  Directories themselves are not fingerprinted, as their modification time
+  changes on almost every boot.
+*/
+STATIC CONST CHAR16  *mFingerprintFiles[] = {
+  L"\\grub2\\grub.cfg",
+  L"\\boot\\grub2\\grub.cfg",
+  L"\\etc\\default\\grub",
+  L"\\etc\\os-release"
+};
+
+/*
+  GRUB environment blocks, fingerprinted by contents, as they are rewritten
+  with boot counting state on every boot.
+*/
+STATIC CONST CHAR16  *mFingerprintGrubEnvFiles[] = {
+  L"\\grub2\\grubenv",
+  L"\\boot\\grub2\\grubenv"
+};
+
+/*
+  Directories with loader entries, fingerprinted by their .conf files.
+*/
+STATIC CONST CHAR16  *mFingerprintEntryDirectories[] = {
+  L"\\loader\\entries",
+  L"\\boot\\loader\\entries"
+};
+
+/*
+  Autodetect directories, fingerprinted by their kernel, initrd and label files.
+*/
+STATIC CONST CHAR16  *mFingerprintKernelDirectories[] = {
+  L"\\boot",
+  L"\\"
+};
+
+#pragma pack(1)
+
+typedef PACKED struct {
+  UINT32    Magic;
+  UINT32    Version;
+  UINT32    Size;
+  UINT32    RecordCount;
+} LINUX_BOOT_CACHE_HEADER;
+
+typedef PACKED struct {
+  EFI_GUID    Partuuid;
+  UINT8       Fingerprint[SHA256_DIGEST_SIZE];
+  UINT32      Size;
+  UINT32      NumProbes;
+  UINT32      NumEntries;
+} LINUX_BOOT_CACHE_RECORD;
+
+#pragma pack()
+
+/*
+  Result of probing a path for existence.
+*/
+#define CACHE_PROBE_MISSING    0
+#define CACHE_PROBE_FILE       1
+#define CACHE_PROBE_DIRECTORY  2
+
+/*
+  In-memory record, serialized probes and then entries follow LINUX_BOOT_CACHE_RECORD.
+*/
+typedef struct {
+  LINUX_BOOT_CACHE_RECORD    *Record;
+} CACHE_RECORD_ITEM;
+
+/*
+  Path probed during entry generation, which is not covered by the fingerprint.
+*/
+typedef struct {
+  CHAR16    *Path;
+  UINT8     Kind;
+} CACHE_PROBE_ITEM;
+
+STATIC OC_FLEX_ARRAY  *mCacheRecords;
+STATIC BOOLEAN        mCacheLoaded;
+STATIC UINT8          mLoadOptionsHash[SHA256_DIGEST_SIZE];
+STATIC OC_FLEX_ARRAY  *mCacheProbes;
+STATIC BOOLEAN        mCacheProbesValid;
+STATIC UINT8          mCacheFileHash[SHA256_DIGEST_SIZE];
+STATIC BOOLEAN        mCacheFileHashValid;
+
+STATIC
+VOID
+FreeCacheRecordItem (
+  IN CACHE_RECORD_ITEM  *Item
+  )
+{
+  if (Item->Record != NULL) {
+    FreePool (Item->Record);
+  }
+}
+
+STATIC
+VOID
+FreeCacheProbeItem (
+  IN CACHE_PROBE_ITEM  *Item
+  )
+{
+  if (Item->Path != NULL) {
+    FreePool (Item->Path);
+  }
+}
+
+STATIC
+UINT8
+GetProbeKind (
+  IN EFI_FILE_PROTOCOL  *Directory,
+  IN CONST CHAR16       *Path
+  )
+{
+  EFI_STATUS         Status;
+  EFI_FILE_PROTOCOL  *File;
+
+  Status = OcSafeFileOpen (Directory, &File, (CHAR16 *)Path, EFI_FILE_MODE_READ, 0);
+  if (EFI_ERROR (Status)) {
+    return CACHE_PROBE_MISSING;
+  }
+
+  Status = OcEnsureDirectoryFile (File, TRUE);
+  File->Close (File);
+
+  return EFI_ERROR (Status) ? CACHE_PROBE_FILE : CACHE_PROBE_DIRECTORY;
+}
+
+STATIC
+VOID
+HashFileInfo (
+  IN     EFI_FILE_INFO   *FileInfo,
+  IN OUT SHA256_CONTEXT  *Sha256Context
+  )
+{
+  Sha256Update (Sha256Context, (UINT8 *)FileInfo->FileName, StrSize (FileInfo->FileName));
+  Sha256Update (Sha256Context, (UINT8 *)&FileInfo->FileSize, sizeof (FileInfo->FileSize));
+  Sha256Update (Sha256Context, (UINT8 *)&FileInfo->ModificationTime, sizeof (FileInfo->ModificationTime));
+}
+
+STATIC
+EFI_STATUS
+HashLoaderEntryFile (
+  EFI_FILE_HANDLE  Directory,
+  EFI_FILE_INFO    *FileInfo,
+  UINTN            FileInfoSize,
+  VOID             *Context        OPTIONAL
+  )
+{
+  if (  ((FileInfo->Attribute & EFI_FILE_DIRECTORY) == 0)
+     && OcUnicodeEndsWith (FileInfo->FileName, L".conf", TRUE))
+  {
+    HashFileInfo (FileInfo, Context);
+  }
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+HashKernelFile (
+  EFI_FILE_HANDLE  Directory,
+  EFI_FILE_INFO    *FileInfo,
+  UINTN            FileInfoSize,
+  VOID             *Context        OPTIONAL
+  )
+{
+  if (  ((FileInfo->Attribute & EFI_FILE_DIRECTORY) == 0)
+     && (  OcUnicodeStartsWith (FileInfo->FileName, L"vmlinuz", FALSE)
+        || OcUnicodeStartsWith (FileInfo->FileName, L"init", FALSE)
+        || (StrCmp (FileInfo->FileName, L".contentDetails") == 0)
+        || (StrCmp (FileInfo->FileName, L".disk_label.contentDetails") == 0)))
+  {
+    HashFileInfo (FileInfo, Context);
+  }
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+VOID
+HashDirectory (
+  IN     EFI_FILE_PROTOCOL           *RootDirectory,
+  IN     CONST CHAR16                *Path,
+  IN     OC_PROCESS_DIRECTORY_ENTRY  ProcessEntry,
+  IN OUT SHA256_CONTEXT              *Sha256Context
+  )
+{
+  EFI_STATUS         Status;
+  EFI_FILE_PROTOCOL  *Directory;
+
+  Sha256Update (Sha256Context, (UINT8 *)Path, StrSize (Path));
+
+  Status = OcSafeFileOpen (RootDirectory, &Directory, (CHAR16 *)Path, EFI_FILE_MODE_READ, 0);
+  if (!EFI_ERROR (Status)) {
+    Status = OcScanDirectory (Directory, ProcessEntry, Sha256Context);
+    Directory->Close (Directory);
+  }
+
+  Sha256Update (Sha256Context, (UINT8 *)&Status, sizeof (Status));
+}
+
+STATIC
+VOID
+HashFile (
+  IN     EFI_FILE_PROTOCOL  *RootDirectory,
+  IN     CONST CHAR16       *Path,
+  IN OUT SHA256_CONTEXT     *Sha256Context
+  )
+{
+  EFI_STATUS         Status;
+  EFI_FILE_PROTOCOL  *File;
+  EFI_FILE_INFO      *FileInfo;
+
+  Sha256Update (Sha256Context, (UINT8 *)Path, StrSize (Path));
+
+  Status = OcSafeFileOpen (RootDirectory, &File, (CHAR16 *)Path, EFI_FILE_MODE_READ, 0);
+  if (EFI_ERROR (Status)) {
+    Sha256Update (Sha256Context, (UINT8 *)&Status, sizeof (Status));
+    return;
+  }
+
+  FileInfo = OcGetFileInfo (File, &gEfiFileInfoGuid, sizeof (EFI_FILE_INFO), NULL);
+  if (FileInfo != NULL) {
+    HashFileInfo (FileInfo, Sha256Context);
+    FreePool (FileInfo);
+  }
+
+  File->Close (File);
+}
+
+/**
+  Hash GRUB environment block without boot counting variables
+  (boot_success, boot_indeterminate), which are not used for entries.
+**/
+STATIC
+VOID
+HashGrubEnv (
+  IN     EFI_FILE_PROTOCOL  *RootDirectory,
+  IN     CONST CHAR16       *Path,
+  IN OUT SHA256_CONTEXT     *Sha256Context
+  )
+{
+  CHAR8  *GrubEnv;
+  UINTN  Start;
+  UINTN  End;
+
+  Sha256Update (Sha256Context, (UINT8 *)Path, StrSize (Path));
+
+  GrubEnv = OcReadFileFromDirectory (RootDirectory, Path, NULL, SIZE_1KB);
+  if (GrubEnv == NULL) {
+    return;
+  }
+
+  for (Start = 0; GrubEnv[Start] != '\0'; Start = End) {
+    End = Start;
+    while (GrubEnv[End] != '\0' && GrubEnv[End] != '\n') {
+      ++End;
+    }
+
+    if (GrubEnv[End] == '\n') {
+      ++End;
+    }
+
+    if (!OcAsciiStartsWith (&GrubEnv[Start], "boot_", FALSE)) {
+      Sha256Update (Sha256Context, (UINT8 *)&GrubEnv[Start], End - Start);
+    }
+  }
+
+  FreePool (GrubEnv);
+}
+
+VOID
+InternalInitEntryCache (
+  IN EFI_LOADED_IMAGE_PROTOCOL  *LoadedImage
+  )
+{
+  SHA256_CONTEXT  Sha256Context;
+
+  //
+  // Load options (e.g. autoopts) affect generated entries.
+  //
+  Sha256Init (&Sha256Context);
+  if ((LoadedImage->LoadOptions != NULL) && (LoadedImage->LoadOptionsSize > 0)) {
+    Sha256Update (&Sha256Context, LoadedImage->LoadOptions, LoadedImage->LoadOptionsSize);
+  }
+
+  Sha256Final (&Sha256Context, mLoadOptionsHash);
+}
+
+EFI_STATUS
+InternalComputeEntryFingerprint (
+  IN   EFI_FILE_PROTOCOL  *RootDirectory,
+  OUT  UINT8              *Fingerprint
+  )
+{
+  SHA256_CONTEXT  Sha256Context;
+  UINTN           Index;
+  UINT32          Attributes;
+
+  if (mCacheProbes != NULL) {
+    OcFlexArrayFree (&mCacheProbes);
+  }
+
+  mCacheProbesValid = FALSE;
+
+  //
+  // Entries without PARTUUID cannot be told apart.
+  //
+  if (CompareGuid (&gPartuuid, &gEfiPartTypeUnusedGuid)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Start collecting probes made while generating entries.
+  //
+  mCacheProbes      = OcFlexArrayInit (sizeof (CACHE_PROBE_ITEM), (OC_FLEX_ARRAY_FREE_ITEM)FreeCacheProbeItem);
+  mCacheProbesValid = mCacheProbes != NULL;
+
+  Sha256Init (&Sha256Context);
+
+  Sha256Update (&Sha256Context, mLoadOptionsHash, sizeof (mLoadOptionsHash));
+  Sha256Update (&Sha256Context, (UINT8 *)&gLinuxBootFlags, sizeof (gLinuxBootFlags));
+  Sha256Update (&Sha256Context, (UINT8 *)gFileSystemType, AsciiStrSize (gFileSystemType));
+
+  Attributes = gPickerContext->PickerAttributes;
+  Sha256Update (&Sha256Context, (UINT8 *)&Attributes, sizeof (Attributes));
+  Sha256Update (&Sha256Context, (UINT8 *)&gPickerContext->HideAuxiliary, sizeof (gPickerContext->HideAuxiliary));
+
+  for (Index = 0; Index < ARRAY_SIZE (mFingerprintFiles); ++Index) {
+    HashFile (RootDirectory, mFingerprintFiles[Index], &Sha256Context);
+  }
+
+  for (Index = 0; Index < ARRAY_SIZE (mFingerprintGrubEnvFiles); ++Index) {
+    HashGrubEnv (RootDirectory, mFingerprintGrubEnvFiles[Index], &Sha256Context);
+  }
+
+  for (Index = 0; Index < ARRAY_SIZE (mFingerprintEntryDirectories); ++Index) {
+    HashDirectory (RootDirectory, mFingerprintEntryDirectories[Index], HashLoaderEntryFile, &Sha256Context);
+  }
+
+  //
+  // Kernel directories are only listed during autodetect.
+  //
+  if ((gLinuxBootFlags & LINUX_BOOT_ALLOW_AUTODETECT) != 0) {
+    for (Index = 0; Index < ARRAY_SIZE (mFingerprintKernelDirectories); ++Index) {
+      HashDirectory (RootDirectory, mFingerprintKernelDirectories[Index], HashKernelFile, &Sha256Context);
+    }
+  }
+
+  Sha256Final (&Sha256Context, Fingerprint);
+
+  return EFI_SUCCESS;
+}
+
+VOID
+InternalRecordEntryProbe (
+  IN   EFI_FILE_PROTOCOL  *Directory,
+  IN   CONST CHAR16       *Path
+  )
+{
+  UINTN             Index;
+  CACHE_PROBE_ITEM  *Item;
+
+  if (!mCacheProbesValid) {
+    return;
+  }
+
+  //
+  // Relative paths cannot be probed again from the root directory.
+  //
+  if (Path[0] != L'\\') {
+    mCacheProbesValid = FALSE;
+    return;
+  }
+
+  for (Index = 0; Index < mCacheProbes->Count; ++Index) {
+    Item = OcFlexArrayItemAt (mCacheProbes, Index);
+    if (StrCmp (Item->Path, Path) == 0) {
+      return;
+    }
+  }
+
+  Item = OcFlexArrayAddItem (mCacheProbes);
+  if (Item == NULL) {
+    mCacheProbesValid = FALSE;
+    return;
+  }
+
+  Item->Path = AllocateCopyPool (StrSize (Path), Path);
+  if (Item->Path == NULL) {
+    OcFlexArrayDiscardItem (mCacheProbes, TRUE);
+    mCacheProbesValid = FALSE;
+    return;
+  }
+
+  Item->Kind = GetProbeKind (Directory, Path);
+}
+
+STATIC
+BOOLEAN
+CanPersistCache (
+  VOID
+  )
+{
+  //
+  // Cache file is not covered by the vault, never trust it in secured setups.
+  //
+  return ((gLinuxBootFlags & LINUX_BOOT_PERSIST_CACHE) != 0)
+         && (gPickerContext->StorageContext != NULL)
+         && (gPickerContext->StorageContext->FileSystem != NULL)
+         && !gPickerContext->StorageContext->HasVault;
+}
+
+STATIC
+CHAR16 *
+GetCacheFilePath (
+  VOID
+  )
+{
+  CHAR16  *Path;
+  UINTN   Size;
+
+  Size = StrSize (gPickerContext->StorageContext->StorageRoot) + L_STR_SIZE (L"\\" LINUX_BOOT_CACHE_FILE);
+  Path = AllocatePool (Size);
+  if (Path == NULL) {
+    return NULL;
+  }
+
+  UnicodeSPrint (Path, Size, L"%s\\%s", gPickerContext->StorageContext->StorageRoot, LINUX_BOOT_CACHE_FILE);
+
+  return Path;
+}
+
+STATIC
+BOOLEAN
+AddCacheRecord (
+  IN LINUX_BOOT_CACHE_RECORD  *Record
+  )
+{
+  UINTN              Index;
+  CACHE_RECORD_ITEM  *Item;
+
+  for (Index = 0; Index < mCacheRecords->Count; ++Index) {
+    Item = OcFlexArrayItemAt (mCacheRecords, Index);
+    if (CompareGuid (&Item->Record->Partuuid, &Record->Partuuid)) {
+      FreePool (Item->Record);
+      Item->Record = Record;
+      return TRUE;
+    }
+  }
+
+  Item = OcFlexArrayAddItem (mCacheRecords);
+  if (Item == NULL) {
+    return FALSE;
+  }
+
+  Item->Record = Record;
+  return TRUE;
+}
+
+STATIC
+VOID
+LoadCacheFile (
+  VOID
+  )
+{
+  EFI_STATUS               Status;
+  EFI_FILE_PROTOCOL        *Root;
+  CHAR16                   *Path;
+  UINT8                    *Buffer;
+  UINT32                   BufferSize;
+  LINUX_BOOT_CACHE_HEADER  *Header;
+  LINUX_BOOT_CACHE_RECORD  *Record;
+  UINT32                   Offset;
+  UINT32                   Index;
+
+  Path = GetCacheFilePath ();
+  if (Path == NULL) {
+    return;
+  }
+
+  Status = gPickerContext->StorageContext->FileSystem->OpenVolume (gPickerContext->StorageContext->FileSystem, &Root);
+  if (EFI_ERROR (Status)) {
+    FreePool (Path);
+    return;
+  }
+
+  Buffer = OcReadFileFromDirectory (Root, Path, &BufferSize, LINUX_BOOT_CACHE_MAX_SIZE);
+  Root->Close (Root);
+  FreePool (Path);
+
+  if (Buffer == NULL) {
+    return;
+  }
+
+  Header = (LINUX_BOOT_CACHE_HEADER *)Buffer;
+  if (  (BufferSize < sizeof (*Header))
+     || (Header->Magic != LINUX_BOOT_CACHE_MAGIC)
+     || (Header->Version != LINUX_BOOT_CACHE_VERSION)
+     || (Header->Size > BufferSize))
+  {
+    DEBUG ((DEBUG_INFO, "LNX: Ignoring invalid entry cache\n"));
+    FreePool (Buffer);
+    return;
+  }
+
+  Offset = sizeof (*Header);
+  for (Index = 0; Index < Header->RecordCount; ++Index) {
+    if (Header->Size - Offset < sizeof (*Record)) {
+      break;
+    }
+
+    Record = (LINUX_BOOT_CACHE_RECORD *)&Buffer[Offset];
+    if ((Record->Size < sizeof (*Record)) || (Record->Size > Header->Size - Offset)) {
+      break;
+    }
+
+    Record = AllocateCopyPool (Record->Size, Record);
+    if ((Record == NULL) || !AddCacheRecord (Record)) {
+      if (Record != NULL) {
+        FreePool (Record);
+      }
+
+      break;
+    }
+
+    Offset += Record->Size;
+  }
+
+  DEBUG ((DEBUG_INFO, "LNX: Loaded %u of %u cached partitions\n", Index, Header->RecordCount));
+
+  //
+  // Remember file contents to avoid rewriting them unchanged.
+  //
+  if ((Index == Header->RecordCount) && (Offset == Header->Size)) {
+    Sha256 (mCacheFileHash, Buffer, Offset);
+    mCacheFileHashValid = TRUE;
+  }
+
+  FreePool (Buffer);
+}
+
+STATIC
+VOID
+SaveCacheFile (
+  VOID
+  )
+{
+  EFI_STATUS               Status;
+  EFI_FILE_PROTOCOL        *Root;
+  CHAR16                   *Path;
+  UINT8                    *Buffer;
+  UINT32                   Size;
+  UINTN                    Index;
+  CACHE_RECORD_ITEM        *Item;
+  LINUX_BOOT_CACHE_HEADER  *Header;
+  UINT8                    Hash[SHA256_DIGEST_SIZE];
+
+  Size = sizeof (*Header);
+  for (Index = 0; Index < mCacheRecords->Count; ++Index) {
+    Item  = OcFlexArrayItemAt (mCacheRecords, Index);
+    Size += Item->Record->Size;
+  }
+
+  if (Size > LINUX_BOOT_CACHE_MAX_SIZE) {
+    return;
+  }
+
+  Buffer = AllocatePool (Size);
+  if (Buffer == NULL) {
+    return;
+  }
+
+  Header              = (LINUX_BOOT_CACHE_HEADER *)Buffer;
+  Header->Magic       = LINUX_BOOT_CACHE_MAGIC;
+  Header->Version     = LINUX_BOOT_CACHE_VERSION;
+  Header->Size        = Size;
+  Header->RecordCount = (UINT32)mCacheRecords->Count;
+
+  Size = sizeof (*Header);
+  for (Index = 0; Index < mCacheRecords->Count; ++Index) {
+    Item = OcFlexArrayItemAt (mCacheRecords, Index);
+    CopyMem (&Buffer[Size], Item->Record, Item->Record->Size);
+    Size += Item->Record->Size;
+  }
+
+  //
+  // Avoid writing to ESP when nothing has changed.
+  //
+  Sha256 (Hash, Buffer, Size);
+  if (mCacheFileHashValid && (CompareMem (Hash, mCacheFileHash, sizeof (Hash)) == 0)) {
+    DEBUG ((DEBUG_INFO, "LNX: Entry cache unchanged\n"));
+    FreePool (Buffer);
+    return;
+  }
+
+  Path   = GetCacheFilePath ();
+  Status = EFI_OUT_OF_RESOURCES;
+  if (Path != NULL) {
+    Status = gPickerContext->StorageContext->FileSystem->OpenVolume (gPickerContext->StorageContext->FileSystem, &Root);
+    if (!EFI_ERROR (Status)) {
+      Status = OcSetFileData (Root, Path, Buffer, Size);
+      Root->Close (Root);
+    }
+
+    FreePool (Path);
+  }
+
+  DEBUG ((DEBUG_INFO, "LNX: Saving entry cache (%u bytes) - %r\n", Size, Status));
+
+  if (!EFI_ERROR (Status)) {
+    CopyMem (mCacheFileHash, Hash, sizeof (Hash));
+    mCacheFileHashValid = TRUE;
+  }
+
+  FreePool (Buffer);
+}
+
+STATIC
+BOOLEAN
+EnsureCacheLoaded (
+  VOID
+  )
+{
+  if (mCacheRecords == NULL) {
+    mCacheRecords = OcFlexArrayInit (sizeof (CACHE_RECORD_ITEM), (OC_FLEX_ARRAY_FREE_ITEM)FreeCacheRecordItem);
+    if (mCacheRecords == NULL) {
+      return FALSE;
+    }
+  }
+
+  if (!mCacheLoaded) {
+    mCacheLoaded = TRUE;
+    if (CanPersistCache ()) {
+      LoadCacheFile ();
+    }
+  }
+
+  return TRUE;
+}
+
+STATIC
+UINTN
+SerializedStringSize (
+  IN CONST CHAR8  *String
+  )
+{
+  return sizeof (UINT32) + ((String == NULL) ? 0 : AsciiStrSize (String));
+}
+
+STATIC
+UINT8 *
+SerializeString (
+  IN OUT UINT8        *Walker,
+  IN     CONST CHAR8  *String
+  )
+{
+  UINT32  Size;
+
+  Size = (String == NULL) ? 0 : (UINT32)AsciiStrSize (String);
+  CopyMem (Walker, &Size, sizeof (Size));
+  Walker += sizeof (Size);
+  if (Size > 0) {
+    CopyMem (Walker, String, Size);
+    Walker += Size;
+  }
+
+  return Walker;
+}
+
+STATIC
+EFI_STATUS
+DeserializeString (
+  IN OUT UINT8  **Walker,
+  IN     UINT8  *End,
+  OUT    CHAR8  **String
+  )
+{
+  UINT32  Size;
+
+  *String = NULL;
+
+  if ((UINTN)(End - *Walker) < sizeof (Size)) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  CopyMem (&Size, *Walker, sizeof (Size));
+  *Walker += sizeof (Size);
+
+  if (Size == 0) {
+    return EFI_SUCCESS;
+  }
+
+  if (((UINTN)(End - *Walker) < Size) || ((*Walker)[Size - 1] != '\0')) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  *String = AllocateCopyPool (Size, *Walker);
+  if (*String == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  *Walker += Size;
+  return EFI_SUCCESS;
+}
+
+/**
+  Check that paths probed when generating cached entries still probe the same.
+**/
+STATIC
+EFI_STATUS
+VerifyCachedProbes (
+  IN     EFI_FILE_PROTOCOL        *RootDirectory,
+  IN     LINUX_BOOT_CACHE_RECORD  *Record,
+  IN OUT UINT8                    **Walker,
+  IN     UINT8                    *End
+  )
+{
+  UINT32  Index;
+  UINT8   Kind;
+  UINT32  Size;
+  CHAR16  *Path;
+
+  for (Index = 0; Index < Record->NumProbes; ++Index) {
+    if ((UINTN)(End - *Walker) < sizeof (Kind) + sizeof (Size)) {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    Kind     = **Walker;
+    *Walker += sizeof (Kind);
+    CopyMem (&Size, *Walker, sizeof (Size));
+    *Walker += sizeof (Size);
+
+    if (  (Size < sizeof (CHAR16))
+       || ((Size % sizeof (CHAR16)) != 0)
+       || ((UINTN)(End - *Walker) < Size))
+    {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    Path = AllocateCopyPool (Size, *Walker);
+    if (Path == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    *Walker += Size;
+
+    if ((Path[Size / sizeof (CHAR16) - 1] != CHAR_NULL) || (Path[0] != L'\\')) {
+      FreePool (Path);
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    if (GetProbeKind (RootDirectory, Path) != Kind) {
+      DEBUG ((DEBUG_INFO, "LNX: Cached entries outdated by %s\n", Path));
+      FreePool (Path);
+      return EFI_NOT_READY;
+    }
+
+    FreePool (Path);
+  }
+
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+InternalGetCachedEntries (
+  IN   EFI_FILE_PROTOCOL  *RootDirectory,
+  IN   CONST UINT8        *Fingerprint,
+  OUT  OC_PICKER_ENTRY    **Entries,
+  OUT  UINTN              *NumEntries
+  )
+{
+  EFI_STATUS               Status;
+  UINTN                    Index;
+  CACHE_RECORD_ITEM        *Item;
+  LINUX_BOOT_CACHE_RECORD  *Record;
+  OC_PICKER_ENTRY          *PickerEntries;
+  UINT8                    *Walker;
+  UINT8                    *End;
+
+  *Entries    = NULL;
+  *NumEntries = 0;
+
+  if (!EnsureCacheLoaded ()) {
+    return EFI_NOT_READY;
+  }
+
+  Record = NULL;
+  for (Index = 0; Index < mCacheRecords->Count; ++Index) {
+    Item = OcFlexArrayItemAt (mCacheRecords, Index);
+    if (CompareGuid (&Item->Record->Partuuid, &gPartuuid)) {
+      Record = Item->Record;
+      break;
+    }
+  }
+
+  if ((Record == NULL) || (CompareMem (Record->Fingerprint, Fingerprint, SHA256_DIGEST_SIZE) != 0)) {
+    return EFI_NOT_READY;
+  }
+
+  Walker = (UINT8 *)(Record + 1);
+  End    = (UINT8 *)Record + Record->Size;
+
+  Status = VerifyCachedProbes (RootDirectory, Record, &Walker, End);
+  if (EFI_ERROR (Status)) {
+    return EFI_NOT_READY;
+  }
+
+  //
+  // Partition is known to have no entries.
+  //
+  if (Record->NumEntries == 0) {
+    DEBUG ((DEBUG_INFO, "LNX: Using cached result - no entries\n"));
+    return EFI_NOT_FOUND;
+  }
+
+  if (Record->NumEntries > (UINTN)(End - Walker) / (sizeof (BOOLEAN) + 5 * sizeof (UINT32))) {
+    return EFI_NOT_READY;
+  }
+
+  PickerEntries = AllocateZeroPool (Record->NumEntries * sizeof (*PickerEntries));
+  if (PickerEntries == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Index = 0; (Index < Record->NumEntries) && !EFI_ERROR (Status); ++Index) {
+    if (Walker == End) {
+      Status = EFI_VOLUME_CORRUPTED;
+      break;
+    }
+
+    PickerEntries[Index].Auxiliary = *Walker != 0;
+    ++Walker;
+
+    Status = DeserializeString (&Walker, End, (CHAR8 **)&PickerEntries[Index].Id);
+    if (!EFI_ERROR (Status)) {
+      Status = DeserializeString (&Walker, End, (CHAR8 **)&PickerEntries[Index].Name);
+    }
+
+    if (!EFI_ERROR (Status)) {
+      Status = DeserializeString (&Walker, End, (CHAR8 **)&PickerEntries[Index].Path);
+    }
+
+    if (!EFI_ERROR (Status)) {
+      Status = DeserializeString (&Walker, End, (CHAR8 **)&PickerEntries[Index].Arguments);
+    }
+
+    if (!EFI_ERROR (Status)) {
+      Status = DeserializeString (&Walker, End, (CHAR8 **)&PickerEntries[Index].Flavour);
+    }
+
+    if (!EFI_ERROR (Status) && ((PickerEntries[Index].Id == NULL) || (PickerEntries[Index].Path == NULL))) {
+      Status = EFI_VOLUME_CORRUPTED;
+    }
+
+    PickerEntries[Index].RealPath = TRUE;
+    PickerEntries[Index].TextMode = FALSE;
+    PickerEntries[Index].Tool     = FALSE;
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "LNX: Invalid cached entries - %r\n", Status));
+    for (Index = 0; Index < Record->NumEntries; ++Index) {
+      InternalFreePickerEntry (&PickerEntries[Index]);
+    }
+
+    FreePool (PickerEntries);
+    return EFI_NOT_READY;
+  }
+
+  DEBUG ((DEBUG_INFO, "LNX: Using %u cached entries\n", Record->NumEntries));
+
+  *Entries    = PickerEntries;
+  *NumEntries = Record->NumEntries;
+  return EFI_SUCCESS;
+}
+
+VOID
+InternalSetCachedEntries (
+  IN   CONST UINT8      *Fingerprint,
+  IN   OC_PICKER_ENTRY  *Entries     OPTIONAL,
+  IN   UINTN            NumEntries
+  )
+{
+  LINUX_BOOT_CACHE_RECORD  *Record;
+  UINTN                    Size;
+  UINTN                    Index;
+  UINT8                    *Walker;
+  CACHE_PROBE_ITEM         *Probe;
+  UINT32                   PathSize;
+
+  //
+  // Entries depend on a probe which could not be recorded.
+  //
+  if (!mCacheProbesValid) {
+    DEBUG ((DEBUG_INFO, "LNX: Not caching entries with untracked probes\n"));
+    return;
+  }
+
+  if (!EnsureCacheLoaded ()) {
+    return;
+  }
+
+  Size = sizeof (*Record);
+  for (Index = 0; Index < mCacheProbes->Count; ++Index) {
+    Probe = OcFlexArrayItemAt (mCacheProbes, Index);
+    Size += sizeof (Probe->Kind) + sizeof (PathSize) + StrSize (Probe->Path);
+  }
+
+  for (Index = 0; Index < NumEntries; ++Index) {
+    Size += sizeof (BOOLEAN)
+            + SerializedStringSize (Entries[Index].Id)
+            + SerializedStringSize (Entries[Index].Name)
+            + SerializedStringSize (Entries[Index].Path)
+            + SerializedStringSize (Entries[Index].Arguments)
+            + SerializedStringSize (Entries[Index].Flavour);
+  }
+
+  if (Size > LINUX_BOOT_CACHE_MAX_SIZE) {
+    return;
+  }
+
+  Record = AllocatePool (Size);
+  if (Record == NULL) {
+    return;
+  }
+
+  CopyGuid (&Record->Partuuid, &gPartuuid);
+  CopyMem (Record->Fingerprint, Fingerprint, SHA256_DIGEST_SIZE);
+  Record->Size       = (UINT32)Size;
+  Record->NumProbes  = (UINT32)mCacheProbes->Count;
+  Record->NumEntries = (UINT32)NumEntries;
+
+  Walker = (UINT8 *)(Record + 1);
+  for (Index = 0; Index < mCacheProbes->Count; ++Index) {
+    Probe     = OcFlexArrayItemAt (mCacheProbes, Index);
+    *Walker++ = Probe->Kind;
+    PathSize  = (UINT32)StrSize (Probe->Path);
+    CopyMem (Walker, &PathSize, sizeof (PathSize));
+    Walker += sizeof (PathSize);
+    CopyMem (Walker, Probe->Path, PathSize);
+    Walker += PathSize;
+  }
+
+  for (Index = 0; Index < NumEntries; ++Index) {
+    *Walker++ = Entries[Index].Auxiliary ? 1 : 0;
+    Walker    = SerializeString (Walker, Entries[Index].Id);
+    Walker    = SerializeString (Walker, Entries[Index].Name);
+    Walker    = SerializeString (Walker, Entries[Index].Path);
+    Walker    = SerializeString (Walker, Entries[Index].Arguments);
+    Walker    = SerializeString (Walker, Entries[Index].Flavour);
+  }
+
+  if (!AddCacheRecord (Record)) {
+    FreePool (Record);
+    return;
+  }
+
+  if (CanPersistCache ()) {
+    SaveCacheFile ();
+  }
+}
@@ -19,6 +19,7 @@
 
 #include <Uefi.h>
 #include <Library/OcBootManagementLib.h>
+#include <Library/OcCryptoLib.h>
 #include <Library/OcMiscLib.h>
 
 #define IS_DIGIT(c)  ((c) >= '0' && (c) <= '9')
@@ -100,6 +101,13 @@
 */
 #define LINUX_BOOT_ADD_DEBUG_INFO  BIT15
 
+/*
+  Persist generated entries per PARTUUID to OpenLinuxBoot.cache in the
+  OpenCore directory, so that unchanged filesystems are not reparsed on
+  next boot. Never used when vault is enabled.
+*/
+#define LINUX_BOOT_PERSIST_CACHE  BIT16
+
 #define LINUX_BOOT_ALL  (           \
   LINUX_BOOT_SCAN_ESP             | \
   LINUX_BOOT_SCAN_XBOOTLDR        | \
@@ -112,7 +120,8 @@
   LINUX_BOOT_ADD_RW               | \
   LINUX_BOOT_ALLOW_CONF_AUTO_ROOT | \
   LINUX_BOOT_LOG_VERBOSE          | \
-  LINUX_BOOT_ADD_DEBUG_INFO       \
+  LINUX_BOOT_ADD_DEBUG_INFO       | \
+  LINUX_BOOT_PERSIST_CACHE        \
   )
 
 /*
@@ -372,6 +381,52 @@ InsertRootOption (
   IN           OC_FLEX_ARRAY  *Options
   );
 
+/*
+  Entry cache.
+*/
+VOID
+InternalInitEntryCache (
+  IN EFI_LOADED_IMAGE_PROTOCOL  *LoadedImage
+  );
+
+/*
+  Compute fingerprint of all inputs to entry generation on current filesystem.
+*/
+EFI_STATUS
+InternalComputeEntryFingerprint (
+  IN   EFI_FILE_PROTOCOL  *RootDirectory,
+  OUT  UINT8              *Fingerprint
+  );
+
+/*
+  Record presence and type of a path probed during entry generation, cached
+  entries are only reused while it probes the same.
+*/
+VOID
+InternalRecordEntryProbe (
+  IN   EFI_FILE_PROTOCOL  *Directory,
+  IN   CONST CHAR16       *Path
+  );
+
+/*
+  Returns EFI_NOT_READY when there is no valid cached result for current PARTUUID,
+  otherwise returns cached entries or EFI_NOT_FOUND when none were found.
+*/
+EFI_STATUS
+InternalGetCachedEntries (
+  IN   EFI_FILE_PROTOCOL  *RootDirectory,
+  IN   CONST UINT8        *Fingerprint,
+  OUT  OC_PICKER_ENTRY    **Entries,
+  OUT  UINTN              *NumEntries
+  );
+
+VOID
+InternalSetCachedEntries (
+  IN   CONST UINT8      *Fingerprint,
+  IN   OC_PICKER_ENTRY  *Entries     OPTIONAL,
+  IN   UINTN            NumEntries
+  );
+
 /*
   Sorts versions low to high.
 */
@@ -634,6 +634,7 @@ FindLoaderFile (
   UnicodeSPrintAsciiFormat (Path, MaxPathSize, "%a", *FileName);
   UnicodeUefiSlashes (Path);
 
+  InternalRecordEntryProbe (Directory, Path);
   Status = OcSafeFileOpen (Directory, &File, Path, EFI_FILE_MODE_READ, 0);
   if (!EFI_ERROR (Status)) {
     File->Close (File);
@@ -650,6 +651,7 @@ FindLoaderFile (
   UnicodeSPrintAsciiFormat (Path, MaxPathSize, "%s%a", DirName, *FileName);
   UnicodeUefiSlashes (Path);
 
+  InternalRecordEntryProbe (Directory, Path);
   Status = OcSafeFileOpen (Directory, &File, Path, EFI_FILE_MODE_READ, 0);
   if (!EFI_ERROR (Status)) {
     //
@@ -725,6 +727,7 @@ HasOstreeDir (
   EFI_STATUS         Status;
   EFI_FILE_PROTOCOL  *OstreeFile;
 
+  InternalRecordEntryProbe (Directory, OSTREE_DIR);
   Status = OcSafeFileOpen (Directory, &OstreeFile, OSTREE_DIR, EFI_FILE_MODE_READ, 0);
   if (EFI_ERROR (Status)) {
     return FALSE;
@@ -21,7 +21,7 @@
 
 #include <Protocol/OcBootEntry.h>
 
-UINTN  gLinuxBootFlags = LINUX_BOOT_ALL & ~(LINUX_BOOT_ADD_DEBUG_INFO | LINUX_BOOT_LOG_VERBOSE | LINUX_BOOT_ADD_RW);
+UINTN  gLinuxBootFlags = LINUX_BOOT_ALL & ~(LINUX_BOOT_ADD_DEBUG_INFO | LINUX_BOOT_LOG_VERBOSE | LINUX_BOOT_ADD_RW | LINUX_BOOT_PERSIST_CACHE);
 
 STATIC OC_FLEX_ARRAY  *mParsedLoadOptions;
 
@@ -105,6 +105,8 @@ OcGetLinuxBootEntries (
   EFI_FILE_PROTOCOL                *RootDirectory;
   UINT32                           FileSystemPolicy;
   CONST EFI_PARTITION_ENTRY        *PartitionEntry;
+  UINT8                            Fingerprint[SHA256_DIGEST_SIZE];
+  BOOLEAN                          UseCache;
 
   ASSERT (PickerContext != NULL);
   ASSERT (Entries     != NULL);
@@ -228,6 +230,18 @@ OcGetLinuxBootEntries (
     &gPartuuid
     ));
 
+  //
+  // Reuse previous result when nothing consulted during scan has changed.
+  //
+  UseCache = !EFI_ERROR (InternalComputeEntryFingerprint (RootDirectory, Fingerprint));
+  if (UseCache) {
+    Status = InternalGetCachedEntries (RootDirectory, Fingerprint, Entries, NumEntries);
+    if (Status != EFI_NOT_READY) {
+      RootDirectory->Close (RootDirectory);
+      return Status;
+    }
+  }
+
   //
   // Scan for boot loader spec & blscfg entries (Fedora-like).
   //
@@ -255,6 +269,10 @@ OcGetLinuxBootEntries (
                );
   }
 
+  if (UseCache && (!EFI_ERROR (Status) || (Status == EFI_NOT_FOUND))) {
+    InternalSetCachedEntries (Fingerprint, *Entries, EFI_ERROR (Status) ? 0 : *NumEntries);
+  }
+
   RootDirectory->Close (RootDirectory);
 
   return Status;
@@ -311,6 +329,8 @@ UefiMain (
     ASSERT (mParsedLoadOptions == NULL);
   }
 
+  InternalInitEntryCache (LoadedImage);
+
   if ((gLinuxBootFlags & LINUX_BOOT_ALLOW_AUTODETECT) != 0) {
     Status = InternalPreloadAutoOpts (mParsedLoadOptions);
 
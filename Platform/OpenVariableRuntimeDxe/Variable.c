@@ -794,6 +794,11 @@ Reclaim (
   }
 
 Done:
+  //
+  // Variable offsets are no longer valid.
+  //
+  InvalidateVariableIndex ();
+
   DoneStatus = EFI_SUCCESS;
   if (IsVolatile || mVariableModuleGlobal->VariableGlobal.EmuNvMode) {
     DoneStatus = SynchronizeRuntimeVariableCache (
@@ -15,6 +15,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 **/
 
 #include "Variable.h"
+#include "VariableRuntimeCache.h"
 
 #include <Protocol/VariablePolicy.h>
 #include <Library/VariablePolicyLib.h>
@@ -281,6 +282,7 @@ VariableClassAddressChangeEvent (
   EfiConvertPointer (0x0, (VOID **)&mVariableModuleGlobal);
   EfiConvertPointer (0x0, (VOID **)&mNvVariableCache);
   EfiConvertPointer (0x0, (VOID **)&mNvFvHeaderCache);
+  ConvertVariableIndexPointers ();
 
   if (mAuthContextOut.AddressPointer != NULL) {
     for (Index = 0; Index < mAuthContextOut.AddressPointerCount; Index++) {
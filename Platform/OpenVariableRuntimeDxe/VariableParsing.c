@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 **/
 
 #include "VariableParsing.h"
+#include "VariableRuntimeCache.h"
 
 /**
 
@@ -470,9 +471,20 @@ FindVariableEx (
 {
   VARIABLE_HEADER  *InDeletedVariable;
   VOID             *Point;
+  EFI_STATUS       Status;
 
   PtrTrack->InDeletedTransitionPtr = NULL;
 
+  //
+  // Named lookups are served by the hash index when the store is indexed.
+  //
+  if (VariableName[0] != 0) {
+    Status = FindVariableInIndex (VariableName, VendorGuid, IgnoreRtCheck, PtrTrack, AuthFormat);
+    if (Status != EFI_UNSUPPORTED) {
+      return Status;
+    }
+  }
+
   //
   // Find the variable by walk through HOB, volatile and non-volatile variable store.
   //
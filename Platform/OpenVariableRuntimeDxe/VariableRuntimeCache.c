@@ -156,3 +156,371 @@ SynchronizeRuntimeVariableCache (
 
   return EFI_SUCCESS;
 }
+
+///
+/// Hash index entry, referring to a variable header by its offset from the
+/// start of the variable store.
+///
+typedef struct {
+  UINT32    Offset;
+  UINT32    Next;
+} VARIABLE_INDEX_ENTRY;
+
+///
+/// Hash index of all variable headers within a variable store.
+/// Headers are indexed in store order up to IndexedEnd, later appended
+/// headers are indexed on the next lookup. Entry references are 1-based,
+/// 0 terminates bucket chains.
+///
+typedef struct {
+  VARIABLE_STORE_HEADER    *Store;
+  UINT32                   StoreSize;
+  UINT32                   IndexedEnd;
+  UINT32                   BucketCount;
+  UINT32                   EntryCount;
+  UINT32                   MaxEntries;
+  BOOLEAN                  Valid;
+  UINT32                   *Buckets;
+  VARIABLE_INDEX_ENTRY     *Entries;
+} VARIABLE_INDEX;
+
+STATIC VARIABLE_INDEX  mVariableIndex[VariableStoreTypeMax];
+
+/**
+  Compute the hash of a variable name and vendor GUID.
+
+  @param[in] Name      Variable name.
+  @param[in] NameSize  Variable name size in bytes, including the terminator.
+  @param[in] Guid      Vendor GUID.
+
+  @return Hash value.
+
+**/
+STATIC
+UINT32
+VariableIndexHash (
+  IN CONST CHAR16    *Name,
+  IN UINTN           NameSize,
+  IN CONST EFI_GUID  *Guid
+  )
+{
+  CONST UINT8  *Bytes;
+  UINTN        Index;
+  UINT32       Hash;
+
+  //
+  // FNV-1a.
+  //
+  Hash  = 0x811C9DC5U;
+  Bytes = (CONST UINT8 *)Name;
+  for (Index = 0; Index < NameSize; ++Index) {
+    Hash = (Hash ^ Bytes[Index]) * 0x01000193U;
+  }
+
+  Bytes = (CONST UINT8 *)Guid;
+  for (Index = 0; Index < sizeof (EFI_GUID); ++Index) {
+    Hash = (Hash ^ Bytes[Index]) * 0x01000193U;
+  }
+
+  return Hash;
+}
+
+/**
+  Get the index slot for the variable store starting at StartPtr.
+
+  The slot is (re)initialised when the store changed, allocating the tables
+  before ExitBootServices if needed.
+
+  @param[in] StartPtr  Start of the variables in the store.
+  @param[in] EndPtr    End of the variable store.
+
+  @return Index slot or NULL when the store is not indexed.
+
+**/
+STATIC
+VARIABLE_INDEX *
+GetVariableIndex (
+  IN VARIABLE_HEADER  *StartPtr,
+  IN VARIABLE_HEADER  *EndPtr
+  )
+{
+  VARIABLE_STORE_HEADER  *Stores[VariableStoreTypeMax];
+  VARIABLE_STORE_TYPE    Type;
+  VARIABLE_INDEX         *VarIndex;
+  UINT32                 MaxEntries;
+  UINT32                 BucketCount;
+
+  if (mVariableModuleGlobal == NULL) {
+    return NULL;
+  }
+
+  Stores[VariableStoreTypeVolatile] = (VARIABLE_STORE_HEADER *)(UINTN)mVariableModuleGlobal->VariableGlobal.VolatileVariableBase;
+  Stores[VariableStoreTypeHob]      = (VARIABLE_STORE_HEADER *)(UINTN)mVariableModuleGlobal->VariableGlobal.HobVariableBase;
+  Stores[VariableStoreTypeNv]       = mNvVariableCache;
+
+  for (Type = (VARIABLE_STORE_TYPE)0; Type < VariableStoreTypeMax; Type++) {
+    if ((Stores[Type] != NULL) && (GetStartPointer (Stores[Type]) == StartPtr)) {
+      break;
+    }
+  }
+
+  if ((Type == VariableStoreTypeMax) || (GetEndPointer (Stores[Type]) != EndPtr)) {
+    return NULL;
+  }
+
+  VarIndex = &mVariableIndex[Type];
+
+  if ((VarIndex->Store == Stores[Type]) && (VarIndex->StoreSize == Stores[Type]->Size)) {
+    return VarIndex->Valid ? VarIndex : NULL;
+  }
+
+  //
+  // Every variable takes at least a header, which bounds the entry count.
+  //
+  MaxEntries  = Stores[Type]->Size / sizeof (VARIABLE_HEADER) + 1;
+  BucketCount = (UINT32)GetPowerOfTwo32 (MAX (MaxEntries / 4, 64));
+
+  if ((VarIndex->Entries == NULL) || (VarIndex->MaxEntries < MaxEntries)) {
+    //
+    // No allocations are possible at runtime.
+    //
+    if (AtRuntime ()) {
+      return NULL;
+    }
+
+    if (VarIndex->Entries != NULL) {
+      FreePool (VarIndex->Entries);
+      FreePool (VarIndex->Buckets);
+      VarIndex->Entries = NULL;
+    }
+
+    VarIndex->Store   = NULL;
+    VarIndex->Entries = AllocateRuntimePool (MaxEntries * sizeof (VARIABLE_INDEX_ENTRY));
+    VarIndex->Buckets = AllocateRuntimePool (BucketCount * sizeof (UINT32));
+    if ((VarIndex->Entries == NULL) || (VarIndex->Buckets == NULL)) {
+      if (VarIndex->Entries != NULL) {
+        FreePool (VarIndex->Entries);
+        VarIndex->Entries = NULL;
+      }
+
+      if (VarIndex->Buckets != NULL) {
+        FreePool (VarIndex->Buckets);
+        VarIndex->Buckets = NULL;
+      }
+
+      return NULL;
+    }
+
+    VarIndex->MaxEntries  = MaxEntries;
+    VarIndex->BucketCount = BucketCount;
+  }
+
+  ZeroMem (VarIndex->Buckets, VarIndex->BucketCount * sizeof (UINT32));
+  VarIndex->Store      = Stores[Type];
+  VarIndex->StoreSize  = Stores[Type]->Size;
+  VarIndex->IndexedEnd = 0;
+  VarIndex->EntryCount = 0;
+  VarIndex->Valid      = TRUE;
+
+  return VarIndex;
+}
+
+/**
+  Index variable headers appended to the store since the last lookup.
+
+  @param[in,out] VarIndex    Index slot.
+  @param[in]     StartPtr    Start of the variables in the store.
+  @param[in]     EndPtr      End of the variable store.
+  @param[in]     AuthFormat  TRUE indicates authenticated variables are used.
+
+  @retval TRUE  The index is usable.
+
+**/
+STATIC
+BOOLEAN
+UpdateVariableIndex (
+  IN OUT VARIABLE_INDEX   *VarIndex,
+  IN     VARIABLE_HEADER  *StartPtr,
+  IN     VARIABLE_HEADER  *EndPtr,
+  IN     BOOLEAN          AuthFormat
+  )
+{
+  VARIABLE_HEADER  *Variable;
+  CHAR16           *Name;
+  UINTN            NameSize;
+  UINT32           Bucket;
+
+  for ( Variable = (VARIABLE_HEADER *)((UINTN)StartPtr + VarIndex->IndexedEnd)
+        ; IsValidVariableHeader (Variable, EndPtr)
+        ; Variable = GetNextVariablePtr (Variable, AuthFormat)
+        )
+  {
+    //
+    // Only names terminated exactly at their end can be matched by hash.
+    //
+    Name     = GetVariableNamePtr (Variable, AuthFormat);
+    NameSize = NameSizeOfVariable (Variable, AuthFormat);
+    if (  (NameSize < sizeof (CHAR16))
+       || ((NameSize % sizeof (CHAR16)) != 0)
+       || (StrnLenS (Name, NameSize / sizeof (CHAR16)) != NameSize / sizeof (CHAR16) - 1)
+       || (VarIndex->EntryCount == VarIndex->MaxEntries))
+    {
+      VarIndex->Valid = FALSE;
+      return FALSE;
+    }
+
+    Bucket = VariableIndexHash (Name, NameSize, GetVendorGuidPtr (Variable, AuthFormat)) & (VarIndex->BucketCount - 1);
+
+    VarIndex->Entries[VarIndex->EntryCount].Offset = (UINT32)((UINTN)Variable - (UINTN)StartPtr);
+    VarIndex->Entries[VarIndex->EntryCount].Next   = VarIndex->Buckets[Bucket];
+    VarIndex->Buckets[Bucket]                      = ++VarIndex->EntryCount;
+  }
+
+  VarIndex->IndexedEnd = (UINT32)((UINTN)Variable - (UINTN)StartPtr);
+
+  return TRUE;
+}
+
+/**
+  Find the variable in the specified variable store by its hash index.
+
+  Results match FindVariableEx for non-empty variable names.
+
+  @param[in]       VariableName        Name of the variable to be found
+  @param[in]       VendorGuid          Vendor GUID to be found.
+  @param[in]       IgnoreRtCheck       Ignore EFI_VARIABLE_RUNTIME_ACCESS attribute
+                                       check at runtime when searching variable.
+  @param[in, out]  PtrTrack            Variable Track Pointer structure that contains Variable Information.
+  @param[in]       AuthFormat          TRUE indicates authenticated variables are used.
+                                       FALSE indicates authenticated variables are not used.
+
+  @retval          EFI_SUCCESS         Variable found successfully
+  @retval          EFI_NOT_FOUND       Variable not found
+  @retval          EFI_UNSUPPORTED     The store is not indexed, a linear search is required.
+**/
+EFI_STATUS
+FindVariableInIndex (
+  IN     CHAR16                  *VariableName,
+  IN     EFI_GUID                *VendorGuid,
+  IN     BOOLEAN                 IgnoreRtCheck,
+  IN OUT VARIABLE_POINTER_TRACK  *PtrTrack,
+  IN     BOOLEAN                 AuthFormat
+  )
+{
+  VARIABLE_INDEX   *VarIndex;
+  VARIABLE_HEADER  *Variable;
+  VARIABLE_HEADER  *AddedVariable;
+  VARIABLE_HEADER  *InDeletedVariable;
+  UINTN            NameSize;
+  UINT32           Bucket;
+  UINT32           EntryRef;
+  UINT32           Pass;
+
+  ASSERT (VariableName[0] != 0);
+
+  VarIndex = GetVariableIndex (PtrTrack->StartPtr, PtrTrack->EndPtr);
+  if ((VarIndex == NULL) || !UpdateVariableIndex (VarIndex, PtrTrack->StartPtr, PtrTrack->EndPtr, AuthFormat)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  NameSize          = StrSize (VariableName);
+  Bucket            = VariableIndexHash (VariableName, NameSize, VendorGuid) & (VarIndex->BucketCount - 1);
+  AddedVariable     = NULL;
+  InDeletedVariable = NULL;
+
+  //
+  // Like the linear search, pick the first ADDED variable and the last
+  // IN_DELETED_TRANSITION variable before it (or at all when none was ADDED).
+  //
+  for (Pass = 0; Pass < 2; ++Pass) {
+    EntryRef = VarIndex->Buckets[Bucket];
+    while (EntryRef != 0) {
+      Variable = (VARIABLE_HEADER *)((UINTN)PtrTrack->StartPtr + VarIndex->Entries[EntryRef - 1].Offset);
+      EntryRef = VarIndex->Entries[EntryRef - 1].Next;
+
+      if (!IsValidVariableHeader (Variable, PtrTrack->EndPtr)) {
+        //
+        // The store was rewritten behind our back.
+        //
+        VarIndex->Valid = FALSE;
+        return EFI_UNSUPPORTED;
+      }
+
+      if ((Pass == 0) ? (Variable->State != VAR_ADDED) : (Variable->State != (VAR_IN_DELETED_TRANSITION & VAR_ADDED))) {
+        continue;
+      }
+
+      if ((Pass == 0) && (AddedVariable != NULL) && (Variable > AddedVariable)) {
+        continue;
+      }
+
+      if (  (Pass == 1)
+         && (  ((AddedVariable != NULL) && (Variable > AddedVariable))
+            || ((InDeletedVariable != NULL) && (Variable < InDeletedVariable))))
+      {
+        continue;
+      }
+
+      if (!IgnoreRtCheck && AtRuntime () && ((Variable->Attributes & EFI_VARIABLE_RUNTIME_ACCESS) == 0)) {
+        continue;
+      }
+
+      if (  (NameSizeOfVariable (Variable, AuthFormat) != NameSize)
+         || !CompareGuid (VendorGuid, GetVendorGuidPtr (Variable, AuthFormat))
+         || (CompareMem (VariableName, GetVariableNamePtr (Variable, AuthFormat), NameSize) != 0))
+      {
+        continue;
+      }
+
+      if (Pass == 0) {
+        AddedVariable = Variable;
+      } else {
+        InDeletedVariable = Variable;
+      }
+    }
+  }
+
+  if (AddedVariable != NULL) {
+    PtrTrack->CurrPtr                = AddedVariable;
+    PtrTrack->InDeletedTransitionPtr = InDeletedVariable;
+    return EFI_SUCCESS;
+  }
+
+  PtrTrack->CurrPtr                = InDeletedVariable;
+  PtrTrack->InDeletedTransitionPtr = NULL;
+  return (InDeletedVariable == NULL) ? EFI_NOT_FOUND : EFI_SUCCESS;
+}
+
+/**
+  Drop variable hash indices after variable stores were rewritten.
+
+**/
+VOID
+InvalidateVariableIndex (
+  VOID
+  )
+{
+  VARIABLE_STORE_TYPE  Type;
+
+  for (Type = (VARIABLE_STORE_TYPE)0; Type < VariableStoreTypeMax; Type++) {
+    mVariableIndex[Type].Store = NULL;
+  }
+}
+
+/**
+  Convert variable hash index pointers to virtual addresses.
+
+**/
+VOID
+ConvertVariableIndexPointers (
+  VOID
+  )
+{
+  VARIABLE_STORE_TYPE  Type;
+
+  for (Type = (VARIABLE_STORE_TYPE)0; Type < VariableStoreTypeMax; Type++) {
+    EfiConvertPointer (0x0, (VOID **)&mVariableIndex[Type].Store);
+    EfiConvertPointer (0x0, (VOID **)&mVariableIndex[Type].Buckets);
+    EfiConvertPointer (0x0, (VOID **)&mVariableIndex[Type].Entries);
+  }
+}
@@ -48,4 +48,48 @@ SynchronizeRuntimeVariableCache (
   IN  UINTN                   Length
   );
 
+/**
+  Find the variable in the specified variable store by its hash index.
+
+  Results match FindVariableEx for non-empty variable names.
+
+  @param[in]       VariableName        Name of the variable to be found
+  @param[in]       VendorGuid          Vendor GUID to be found.
+  @param[in]       IgnoreRtCheck       Ignore EFI_VARIABLE_RUNTIME_ACCESS attribute
+                                       check at runtime when searching variable.
+  @param[in, out]  PtrTrack            Variable Track Pointer structure that contains Variable Information.
+  @param[in]       AuthFormat          TRUE indicates authenticated variables are used.
+                                       FALSE indicates authenticated variables are not used.
+
+  @retval          EFI_SUCCESS         Variable found successfully
+  @retval          EFI_NOT_FOUND       Variable not found
+  @retval          EFI_UNSUPPORTED     The store is not indexed, a linear search is required.
+**/
+EFI_STATUS
+FindVariableInIndex (
+  IN     CHAR16                  *VariableName,
+  IN     EFI_GUID                *VendorGuid,
+  IN     BOOLEAN                 IgnoreRtCheck,
+  IN OUT VARIABLE_POINTER_TRACK  *PtrTrack,
+  IN     BOOLEAN                 AuthFormat
+  );
+
+/**
+  Drop variable hash indices after variable stores were rewritten.
+
+**/
+VOID
+InvalidateVariableIndex (
+  VOID
+  );
+
+/**
+  Convert variable hash index pointers to virtual addresses.
+
+**/
+VOID
+ConvertVariableIndexPointers (
+  VOID
+  );
+
 #endif
@@ -14,6 +14,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #include <Uefi.h>
 #include <PiDxe.h>
+#include <Library/BaseLib.h>
 #include <Library/PcdLib.h>
 #include <Library/UefiLib.h>
 #include <Library/MemoryAllocationLib.h>
@@ -26,6 +27,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #include <Library/OcMiscLib.h>
 #include <Library/PrintLib.h>
+#include <Library/TimerLib.h>
 #include <Library/UefiDriverEntryPoint.h>
 #include <Protocol/SimpleTextInEx.h>
 
@@ -70,6 +72,131 @@ TestRsa2048Sha256Verify (
   return Status;
 }
 
+/**
+  Number of signature verifications per benchmark.
+**/
+#define RSA_BENCH_ITERATIONS  100
+
+/**
+  Print the average duration of one verification.
+
+  @param[in] Name     Benchmark name.
+  @param[in] Elapsed  Performance counter ticks of all iterations.
+**/
+STATIC
+VOID
+PrintRsaBench (
+  IN CONST CHAR16  *Name,
+  IN UINT64        Elapsed
+  )
+{
+  Print (
+    L"%s: %Lu us per verification\n",
+    Name,
+    DivU64x32 (GetTimeInNanoSecond (Elapsed), RSA_BENCH_ITERATIONS * 1000)
+    );
+}
+
+EFI_STATUS
+EFIAPI
+BenchRsa2048Sha256Verify (
+  VOID
+  )
+{
+  UINT8                    DataSha256Hash[SHA256_DIGEST_SIZE];
+  UINT8                    Modulus[256];
+  CONST OC_RSA_PUBLIC_KEY  *PubKey;
+  OC_RSA_VERIFY_CONTEXT    Context;
+  BOOLEAN                  Verified;
+  UINT64                   Start;
+  UINTN                    Index;
+
+  Sha256 (
+    DataSha256Hash,
+    Rsa2048Sha256Sample.Data,
+    SIGNED_DATA_LEN
+    );
+
+  PubKey = (CONST OC_RSA_PUBLIC_KEY *)Rsa2048Sha256Sample.PublicKey;
+  ASSERT (PubKey->Hdr.NumQwords * sizeof (UINT64) == sizeof (Modulus));
+
+  //
+  // The key stores the modulus in little endian, raw moduli are big endian.
+  //
+  for (Index = 0; Index < sizeof (Modulus); ++Index) {
+    Modulus[Index] = ((CONST UINT8 *)PubKey->Data)[sizeof (Modulus) - 1 - Index];
+  }
+
+  Verified = TRUE;
+
+  Start = GetPerformanceCounter ();
+  for (Index = 0; Index < RSA_BENCH_ITERATIONS; ++Index) {
+    Verified &= RsaVerifySigHashFromKeyDynalloc (
+                  PubKey,
+                  Rsa2048Sha256Sample.Signature,
+                  sizeof (Rsa2048Sha256Sample.Signature),
+                  DataSha256Hash,
+                  sizeof (DataSha256Hash),
+                  OcSigHashTypeSha256
+                  );
+  }
+
+  PrintRsaBench (L"RSA-2048 key", GetPerformanceCounter () - Start);
+
+  if (!RsaVerifyContextInitFromKey (&Context, PubKey)) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Start = GetPerformanceCounter ();
+  for (Index = 0; Index < RSA_BENCH_ITERATIONS; ++Index) {
+    Verified &= RsaVerifySigHashFromContext (
+                  &Context,
+                  Rsa2048Sha256Sample.Signature,
+                  sizeof (Rsa2048Sha256Sample.Signature),
+                  DataSha256Hash,
+                  sizeof (DataSha256Hash),
+                  OcSigHashTypeSha256
+                  );
+  }
+
+  PrintRsaBench (L"RSA-2048 key context", GetPerformanceCounter () - Start);
+  RsaVerifyContextFree (&Context);
+
+  Start = GetPerformanceCounter ();
+  for (Index = 0; Index < RSA_BENCH_ITERATIONS; ++Index) {
+    if (!RsaVerifyContextInitFromData (&Context, Modulus, sizeof (Modulus), 0x10001)) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    RsaVerifyContextFree (&Context);
+  }
+
+  PrintRsaBench (L"RSA-2048 Montgomery parameters", GetPerformanceCounter () - Start);
+
+  Start = GetPerformanceCounter ();
+  for (Index = 0; Index < RSA_BENCH_ITERATIONS; ++Index) {
+    Verified &= RsaVerifySigDataFromData (
+                  Modulus,
+                  sizeof (Modulus),
+                  0x10001,
+                  Rsa2048Sha256Sample.Signature,
+                  sizeof (Rsa2048Sha256Sample.Signature),
+                  Rsa2048Sha256Sample.Data,
+                  SIGNED_DATA_LEN,
+                  OcSigHashTypeSha256
+                  );
+  }
+
+  PrintRsaBench (L"RSA-2048 modulus with SHA-256", GetPerformanceCounter () - Start);
+
+  if (!Verified) {
+    Print (L"Rsa2048Sha256 benchmark verifying failed!\n");
+    return EFI_INVALID_PARAMETER;
+  }
+
+  return EFI_SUCCESS;
+}
+
 EFI_STATUS
 EFIAPI
 TestAesCtr (
@@ -465,6 +592,15 @@ UefiDriverMain (
     Print (L"Rsa2048Sha256 passed!\n");
   }
 
+  //
+  // Benchmark Rsa2048Sha256 signature verification
+  //
+  Status = BenchRsa2048Sha256Verify ();
+  if (EFI_ERROR (Status)) {
+    Print (L"Rsa2048Sha256 benchmark failed!\n");
+    Failure = TRUE;
+  }
+
   if (Failure) {
     Print (L"Some tests failed\n");
     return EFI_INVALID_PARAMETER;
@@ -551,6 +687,17 @@ UefiAppMain (
     Print (L"Rsa2048Sha256 passed!\n");
   }
 
+  WaitForKeyPress (L"Press any key...");
+
+  //
+  // Benchmark Rsa2048Sha256 signature verification
+  //
+  Status = BenchRsa2048Sha256Verify ();
+  if (EFI_ERROR (Status)) {
+    Print (L"Rsa2048Sha256 benchmark failed!\n");
+    Failure = TRUE;
+  }
+
   WaitForKeyPress (L"Press any key to exit");
 
   if (Failure) {
@@ -0,0 +1,21 @@
+/** @file
+  Copyright (c) 2026, Acidanthera. All rights reserved.
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#ifndef USER_PARALLEL_H
+#define USER_PARALLEL_H
+
+/**
+  Override the number of workers reported by OcParallelGetWorkerCount,
+  regardless of the number of online processors. Has no effect on Windows,
+  where jobs always run serially.
+
+  @param[in]  Count   Number of workers, 0 to use one per online processor.
+**/
+VOID
+SetParallelWorkerCount (
+  IN UINTN  Count
+  );
+
+#endif // USER_PARALLEL_H
@@ -0,0 +1,45 @@
+/** @file
+  Copyright (c) 2026, Acidanthera. All rights reserved.
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#ifndef USER_TIME_H
+#define USER_TIME_H
+
+/**
+  Get current timestamp in milliseconds.
+
+  @return     Current timestamp in milliseconds.
+**/
+INT64
+GetCurrentTimestamp (
+  VOID
+  );
+
+/**
+  Get current timestamp in microseconds.
+
+  @return     Current timestamp in microseconds.
+**/
+INT64
+GetCurrentTimestampUs (
+  VOID
+  );
+
+/**
+  Print benchmark throughput in millions of units per second.
+
+  @param[in]  Name    Benchmark name.
+  @param[in]  Count   Number of processed units.
+  @param[in]  Unit    Unit abbreviation, e.g. B for bytes.
+  @param[in]  Time    Elapsed time in microseconds.
+**/
+VOID
+PrintThroughput (
+  IN CONST CHAR8  *Name,
+  IN UINT64       Count,
+  IN CONST CHAR8  *Unit,
+  IN UINT64       Time
+  );
+
+#endif // USER_TIME_H
@@ -37,6 +37,13 @@ STATIC UINTN   mPoolAllocationIndex;
 STATIC UINT64  mPageAllocationMask = MAX_UINT64;
 STATIC UINTN   mPageAllocationIndex;
 
+//
+// Counters and mask indices are updated atomically, as utilities built with
+// OcParallelLib allocate and free from several threads at once.
+//
+#define USER_MEMORY_INC(Var, Value)  __atomic_fetch_add (&(Var), (Value), __ATOMIC_RELAXED)
+#define USER_MEMORY_DEC(Var, Value)  __atomic_fetch_sub (&(Var), (Value), __ATOMIC_RELAXED)
+
 VOID
 ConfigureMemoryAllocations (
   IN     CONST UINT8  *Data,
@@ -190,11 +197,13 @@ PhaseAllocatePool (
 {
   VOID   *Buffer;
   UINTN  RequestedAllocationSize;
+  UINTN  Index;
 
   Buffer                  = NULL;
   RequestedAllocationSize = 0;
+  Index                   = USER_MEMORY_INC (mPoolAllocationIndex, 1) & 63U;
 
-  if (((mPoolAllocationMask & (1ULL << mPoolAllocationIndex)) != 0) && (AllocationSize + 7ULL > AllocationSize)) {
+  if (((mPoolAllocationMask & (1ULL << Index)) != 0) && (AllocationSize + 7ULL > AllocationSize)) {
     //
     // UEFI guarantees 8-byte alignment.
     //
@@ -214,9 +223,6 @@ PhaseAllocatePool (
     }
   }
 
-  ++mPoolAllocationIndex;
-  mPoolAllocationIndex &= 63ULL;
-
   DEBUG ((
     DEBUG_POOL,
     "UMEM: Allocating pool %u at 0x%p\n",
@@ -227,7 +233,7 @@ PhaseAllocatePool (
   ASSERT (((UINTN)Buffer & 7ULL) == 0);
 
   if (Buffer != NULL) {
-    ++mPoolAllocations;
+    USER_MEMORY_INC (mPoolAllocations, 1);
   }
 
   return Buffer;
@@ -245,13 +251,15 @@ InternalAllocatePagesAlign (
 {
   VOID   *Buffer;
   UINTN  RequestedAllocationSize;
+  UINTN  Index;
 
   ASSERT (Type == AllocateAnyPages);
 
   Buffer                  = NULL;
   RequestedAllocationSize = Pages * EFI_PAGE_SIZE;
+  Index                   = USER_MEMORY_INC (mPageAllocationIndex, 1) & 63U;
 
-  if (((mPageAllocationMask & (1ULL << mPageAllocationIndex)) != 0) &&
+  if (((mPageAllocationMask & (1ULL << Index)) != 0) &&
       ((Pages != 0) && (RequestedAllocationSize / Pages == EFI_PAGE_SIZE)))
   {
     //
@@ -278,9 +286,6 @@ InternalAllocatePagesAlign (
     }
   }
 
-  ++mPageAllocationIndex;
-  mPageAllocationIndex &= 63U;
-
   DEBUG ((
     DEBUG_PAGE,
     "UMEM: Allocating %u pages at 0x%p\n",
@@ -292,7 +297,7 @@ InternalAllocatePagesAlign (
     return EFI_NOT_FOUND;
   }
 
-  mPageAllocations += Pages;
+  USER_MEMORY_INC (mPageAllocations, Pages);
 
   *Memory = (UINTN)Buffer;
 
@@ -334,7 +339,7 @@ PhaseFreePool (
   //
   // Check that we are freeing buffer produced by our AllocatePool implementation
   //
-  if (mPoolAllocations == 0) {
+  if (USER_MEMORY_DEC (mPoolAllocations, 1) == 0) {
     DEBUG ((
       DEBUG_ERROR,
       "UMEM: Requested buffer to free allocated not by AllocatePool implementations \n"
@@ -342,8 +347,6 @@ PhaseFreePool (
     abort ();
   }
 
-  --mPoolAllocations;
-
   free (Buffer);
 }
 
@@ -356,6 +359,7 @@ PhaseFreePages (
 {
   VOID   *Buffer;
   UINTN  BytesToFree;
+  UINTN  Allocated;
 
   Buffer = (VOID *)(UINTN)Memory;
 
@@ -368,28 +372,27 @@ PhaseFreePages (
     Buffer
     ));
 
-  //
-  // Check that requested pages count to free not exceeds total
-  // allocated pages count
-  //
-  if (Pages > mPageAllocations) {
+  BytesToFree = Pages * EFI_PAGE_SIZE;
+  if ((Pages == 0) || (BytesToFree / Pages != EFI_PAGE_SIZE)) {
     DEBUG ((
       DEBUG_ERROR,
-      "UMEM: Requested pages count %u to free exceeds total allocated pages %u\n",
-      (UINT32)Pages,
-      (UINT32)mPageAllocations
+      "UMEM: Passed pages count %u proceeds unsigned integer overflow during BytesToFree multiplication\n",
+      (UINT32)Pages
       ));
     abort ();
   }
 
-  BytesToFree = Pages * EFI_PAGE_SIZE;
-  if ((Pages != 0) && (BytesToFree / Pages == EFI_PAGE_SIZE)) {
-    mPageAllocations -= Pages;
-  } else {
+  //
+  // Check that requested pages count to free not exceeds total
+  // allocated pages count
+  //
+  Allocated = USER_MEMORY_DEC (mPageAllocations, Pages);
+  if (Pages > Allocated) {
     DEBUG ((
       DEBUG_ERROR,
-      "UMEM: Passed pages count %u proceeds unsigned integer overflow during BytesToFree multiplication\n",
-      (UINT32)Pages
+      "UMEM: Requested pages count %u to free exceeds total allocated pages %u\n",
+      (UINT32)Pages,
+      (UINT32)Allocated
       ));
     abort ();
   }
@@ -0,0 +1,222 @@
+/** @file
+  Copyright (c) 2026, Acidanthera. All rights reserved.
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Uefi.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/SynchronizationLib.h>
+
+#include <OcParallelInternal.h>
+#include <UserParallel.h>
+
+#if !defined (_WIN32)
+  #include <pthread.h>
+  #include <unistd.h>
+#endif
+
+//
+// POSIX threads stand in for application processors, so that job scheduling
+// can be tested and benchmarked in userspace. Windows runs everything serially.
+//
+
+STATIC UINTN  mUserParallelWorkers;
+
+VOID
+SetParallelWorkerCount (
+  IN UINTN  Count
+  )
+{
+  mUserParallelWorkers = MIN (Count, OC_PARALLEL_MAX_WORKERS);
+}
+
+UINT32
+EFIAPI
+InterlockedIncrement (
+  IN volatile UINT32  *Value
+  )
+{
+  return __atomic_add_fetch (Value, 1, __ATOMIC_SEQ_CST);
+}
+
+UINTN
+OcParallelGetWorkerCount (
+  VOID
+  )
+{
+ #if defined (_WIN32)
+  return 1;
+ #else
+  long  Count;
+
+  if (mUserParallelWorkers != 0) {
+    return mUserParallelWorkers;
+  }
+
+  Count = sysconf (_SC_NPROCESSORS_ONLN);
+  if (Count < 1) {
+    return 1;
+  }
+
+  return MIN ((UINTN)Count, OC_PARALLEL_MAX_WORKERS);
+ #endif
+}
+
+#if !defined (_WIN32)
+
+typedef struct {
+  pthread_t               Thread;
+  OC_PARALLEL_FUNCTION    Function;
+  VOID                    *Context;
+} USER_PARALLEL_TASK;
+
+STATIC
+VOID *
+UserParallelJobThread (
+  VOID  *Buffer
+  )
+{
+  OC_PARALLEL_JOB  *Job;
+  UINT32           Worker;
+
+  Job    = Buffer;
+  Worker = InternalParallelClaimWorker (Job);
+  if (Worker < Job->NumWorkers) {
+    InternalParallelRunWorker (Job, Worker);
+  }
+
+  return NULL;
+}
+
+STATIC
+VOID *
+UserParallelTaskThread (
+  VOID  *Buffer
+  )
+{
+  USER_PARALLEL_TASK  *Task;
+
+  Task = Buffer;
+  Task->Function (Task->Context, 0, 0);
+  return NULL;
+}
+
+#endif
+
+VOID
+OcParallelFor (
+  IN     OC_PARALLEL_FUNCTION  Function,
+  IN OUT VOID                  *Context,
+  IN     UINTN                 Count,
+  IN     UINTN                 MaxWorkers
+  )
+{
+  OC_PARALLEL_JOB  Job;
+  UINTN            NumWorkers;
+  UINT32           Worker;
+
+ #if !defined (_WIN32)
+  pthread_t  Threads[OC_PARALLEL_MAX_WORKERS];
+  UINTN      NumThreads;
+  UINTN      Index;
+ #endif
+
+  ASSERT (Function != NULL);
+  ASSERT (Count <= MAX_UINT32);
+
+  if (Count == 0) {
+    return;
+  }
+
+  NumWorkers = OcParallelGetWorkerCount ();
+  if ((MaxWorkers != 0) && (MaxWorkers < NumWorkers)) {
+    NumWorkers = MaxWorkers;
+  }
+
+  if (Count < NumWorkers) {
+    NumWorkers = Count;
+  }
+
+  InternalParallelInitJob (&Job, Function, Context, (UINT32)Count, (UINT32)NumWorkers);
+
+  Worker = InternalParallelClaimWorker (&Job);
+  ASSERT (Worker == 0);
+
+ #if !defined (_WIN32)
+  NumThreads = 0;
+  for (Index = 1; Index < NumWorkers; ++Index) {
+    if (pthread_create (&Threads[NumThreads], NULL, UserParallelJobThread, &Job) != 0) {
+      break;
+    }
+
+    ++NumThreads;
+  }
+
+ #endif
+
+  InternalParallelRunWorker (&Job, Worker);
+
+ #if !defined (_WIN32)
+  for (Index = 0; Index < NumThreads; ++Index) {
+    pthread_join (Threads[Index], NULL);
+  }
+
+ #endif
+}
+
+VOID
+OcParallelStartTask (
+  IN     OC_PARALLEL_FUNCTION  Function,
+  IN OUT VOID                  *Context,
+  OUT    OC_PARALLEL_TASK      *Task
+  )
+{
+ #if !defined (_WIN32)
+  USER_PARALLEL_TASK  *Internal;
+ #endif
+
+  ASSERT (Function != NULL);
+  ASSERT (Task != NULL);
+
+  Task->Handle = NULL;
+
+ #if !defined (_WIN32)
+  Internal = AllocatePool (sizeof (*Internal));
+  if (Internal != NULL) {
+    Internal->Function = Function;
+    Internal->Context  = Context;
+    if (pthread_create (&Internal->Thread, NULL, UserParallelTaskThread, Internal) == 0) {
+      Task->Handle = Internal;
+      return;
+    }
+
+    FreePool (Internal);
+  }
+
+ #endif
+
+  Function (Context, 0, 0);
+}
+
+VOID
+OcParallelWaitTask (
+  IN OUT OC_PARALLEL_TASK  *Task
+  )
+{
+ #if !defined (_WIN32)
+  USER_PARALLEL_TASK  *Internal;
+
+  ASSERT (Task != NULL);
+
+  Internal = Task->Handle;
+  if (Internal == NULL) {
+    return;
+  }
+
+  pthread_join (Internal->Thread, NULL);
+  FreePool (Internal);
+  Task->Handle = NULL;
+ #endif
+}
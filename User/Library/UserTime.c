@@ -0,0 +1,60 @@
+/** @file
+  Copyright (c) 2026, Acidanthera. All rights reserved.
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/DebugLib.h>
+
+#include <UserTime.h>
+
+#include <sys/time.h>
+
+INT64
+GetCurrentTimestamp (
+  VOID
+  )
+{
+  struct timeval  Time;
+
+  //
+  // Get current time.
+  //
+  gettimeofday (&Time, NULL);
+  //
+  // Return milliseconds.
+  //
+  return Time.tv_sec * 1000LL + Time.tv_usec / 1000LL;
+}
+
+INT64
+GetCurrentTimestampUs (
+  VOID
+  )
+{
+  struct timeval  Time;
+
+  gettimeofday (&Time, NULL);
+  return Time.tv_sec * 1000000LL + Time.tv_usec;
+}
+
+VOID
+PrintThroughput (
+  IN CONST CHAR8  *Name,
+  IN UINT64       Count,
+  IN CONST CHAR8  *Unit,
+  IN UINT64       Time
+  )
+{
+  DEBUG ((
+    DEBUG_ERROR,
+    "%a: %Lu %a in %Lu us (%Lu M%a/s)\n",
+    Name,
+    Count,
+    Unit,
+    Time,
+    DivU64x64Remainder (Count, MAX (Time, 1), NULL),
+    Unit
+    ));
+}
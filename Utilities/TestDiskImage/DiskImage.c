@@ -8,14 +8,122 @@
 #include <Library/OcAppleRamDiskLib.h>
 #include <Library/OcAppleKeysLib.h>
 #include <Library/OcCompressionLib.h>
+#include <Library/BaseLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/DebugLib.h>
 
 #include <UserFile.h>
 #include <UserMemory.h>
+#include <UserTime.h>
+
+#include <stdlib.h>
 
 #define  NUM_EXTENTS  20
 
+STATIC
+VOID
+InitializeExtentTable (
+  OUT APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable,
+  IN  UINT8                        *Dmg,
+  IN  UINT32                       DmgSize
+  )
+{
+  UINT32  Index;
+
+  ExtentTable->Signature   = APPLE_RAM_DISK_EXTENT_SIGNATURE;
+  ExtentTable->Version     = APPLE_RAM_DISK_EXTENT_VERSION;
+  ExtentTable->Reserved    = 0;
+  ExtentTable->Signature2  = APPLE_RAM_DISK_EXTENT_SIGNATURE;
+  ExtentTable->ExtentCount = MIN (NUM_EXTENTS, ARRAY_SIZE (ExtentTable->Extents));
+
+  for (Index = 0; Index < ExtentTable->ExtentCount; ++Index) {
+    ExtentTable->Extents[Index].Start  = (UINTN)Dmg + (Index * (DmgSize / ExtentTable->ExtentCount));
+    ExtentTable->Extents[Index].Length = (DmgSize / ExtentTable->ExtentCount);
+  }
+
+  if (Index != 0) {
+    ExtentTable->Extents[Index - 1].Length += (DmgSize - (Index * (DmgSize / ExtentTable->ExtentCount)));
+  }
+}
+
+/**
+  Measure DMG decompression and checksum throughput.
+
+  @param[in]  Path        Disk Image path.
+  @param[in]  Iterations  Number of passes over the image.
+
+  @retval 0 on success.
+**/
+STATIC
+int
+BenchmarkDmg (
+  IN CONST CHAR8  *Path,
+  IN UINT32       Iterations
+  )
+{
+  int                          Status;
+  UINT8                        *Dmg;
+  UINT32                       DmgSize;
+  UINT8                        *UncompDmg;
+  UINT32                       UncompSize;
+  OC_APPLE_DISK_IMAGE_CONTEXT  DmgContext;
+  APPLE_RAM_DISK_EXTENT_TABLE  ExtentTable;
+  UINT32                       Index;
+  UINT32                       Checksum;
+  UINT64                       Start;
+
+  if ((Dmg = UserReadFile (Path, &DmgSize)) == NULL) {
+    DEBUG ((DEBUG_ERROR, "Read fail\n"));
+    return -1;
+  }
+
+  InitializeExtentTable (&ExtentTable, Dmg, DmgSize);
+
+  if (!OcAppleDiskImageInitializeContext (&DmgContext, &ExtentTable, DmgSize)) {
+    DEBUG ((DEBUG_ERROR, "DMG Context initialization error\n"));
+    FreePool (Dmg);
+    return -1;
+  }
+
+  Status     = -1;
+  UncompSize = (DmgContext.SectorCount * APPLE_DISK_IMAGE_SECTOR_SIZE);
+  UncompDmg  = AllocatePool (UncompSize);
+  if (UncompDmg == NULL) {
+    DEBUG ((DEBUG_ERROR, "DMG data allocation failed\n"));
+    goto Done;
+  }
+
+  Start = GetCurrentTimestampUs ();
+  for (Index = 0; Index < Iterations; ++Index) {
+    if (!OcAppleDiskImageRead (&DmgContext, 0, UncompSize, UncompDmg)) {
+      DEBUG ((DEBUG_ERROR, "DMG read error\n"));
+      goto Done;
+    }
+  }
+
+  PrintThroughput ("Decompress", MultU64x32 (UncompSize, Iterations), "B", GetCurrentTimestampUs () - Start);
+
+  Checksum = 0;
+  Start    = GetCurrentTimestampUs ();
+  for (Index = 0; Index < Iterations; ++Index) {
+    Checksum = Adler32 (UncompDmg, UncompSize);
+  }
+
+  PrintThroughput ("Adler32", MultU64x32 (UncompSize, Iterations), "B", GetCurrentTimestampUs () - Start);
+  DEBUG ((DEBUG_ERROR, "Checksum %08X\n", Checksum));
+
+  Status = 0;
+
+Done:
+  OcAppleDiskImageFreeContext (&DmgContext);
+  FreePool (Dmg);
+  if (UncompDmg != NULL) {
+    FreePool (UncompDmg);
+  }
+
+  return Status;
+}
+
 int
 ENTRY_POINT (
   int   argc,
@@ -33,7 +141,6 @@ ENTRY_POINT (
   BOOLEAN                      Result;
   OC_APPLE_DISK_IMAGE_CONTEXT  DmgContext;
   APPLE_RAM_DISK_EXTENT_TABLE  ExtentTable;
-  UINT32                       Index2;
   OC_APPLE_CHUNKLIST_CONTEXT   ChunklistContext;
 
   //
@@ -46,6 +153,15 @@ ENTRY_POINT (
     return -1;
   }
 
+  if (AsciiStrCmp (argv[1], "-b") == 0) {
+    if (argc < 3) {
+      DEBUG ((DEBUG_ERROR, "Usage: %a -b <dmg> [iterations]\n", argv[0]));
+      return -1;
+    }
+
+    return BenchmarkDmg (argv[2], argc > 3 ? MAX ((UINT32)atoi (argv[3]), 1) : 10);
+  }
+
   if ((argc % 2) != 1) {
     DEBUG ((DEBUG_ERROR, "Please provide a chunklist file for each DMG, enter \'n\' to skip\n"));
   }
@@ -61,20 +177,7 @@ ENTRY_POINT (
       goto ContinueDmgLoop;
     }
 
-    ExtentTable.Signature   = APPLE_RAM_DISK_EXTENT_SIGNATURE;
-    ExtentTable.Version     = APPLE_RAM_DISK_EXTENT_VERSION;
-    ExtentTable.Reserved    = 0;
-    ExtentTable.Signature2  = APPLE_RAM_DISK_EXTENT_SIGNATURE;
-    ExtentTable.ExtentCount = MIN (NUM_EXTENTS, ARRAY_SIZE (ExtentTable.Extents));
-
-    for (Index2 = 0; Index2 < ExtentTable.ExtentCount; ++Index2) {
-      ExtentTable.Extents[Index2].Start  = (UINTN)Dmg + (Index2 * (DmgSize / ExtentTable.ExtentCount));
-      ExtentTable.Extents[Index2].Length = (DmgSize / ExtentTable.ExtentCount);
-    }
-
-    if (Index2 != 0) {
-      ExtentTable.Extents[Index2 - 1].Length += (DmgSize - (Index2 * (DmgSize / ExtentTable.ExtentCount)));
-    }
+    InitializeExtentTable (&ExtentTable, Dmg, DmgSize);
 
     Result = OcAppleDiskImageInitializeContext (&DmgContext, &ExtentTable, DmgSize);
     if (!Result) {
@@ -0,0 +1,253 @@
+/** @file
+  Copyright (c) 2026, Acidanthera. All rights reserved.
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <IndustryStandard/AppleCompressedBinaryImage.h>
+#include <IndustryStandard/AppleFatBinaryImage.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcCompressionLib.h>
+#include <Library/OcMachoLib.h>
+
+#include <stdlib.h>
+
+#include <UserFile.h>
+#include <UserPseudoRandom.h>
+#include <UserTime.h>
+
+#include <zlib.h>
+
+//
+// Covers every alignment and tail length of the SIMD kernels
+// as well as Adler-32 reductions after NMAX bytes.
+//
+#define CHECKSUM_BUFFER_SIZE   (256U * 1024U)
+#define CHECKSUM_SHORT_LENGTH  512U
+
+STATIC
+UINT32
+ReferenceAdler32 (
+  IN CONST UINT8  *Buffer,
+  IN UINTN        Length
+  )
+{
+  UINT32  A;
+  UINT32  B;
+  UINTN   Index;
+
+  A = 1;
+  B = 0;
+  for (Index = 0; Index < Length; ++Index) {
+    A = (A + Buffer[Index]) % 65521;
+    B = (B + A) % 65521;
+  }
+
+  return (B << 16U) | A;
+}
+
+STATIC
+UINT32
+ReferenceCrc32 (
+  IN UINT32       Crc,
+  IN CONST UINT8  *Buffer,
+  IN UINTN        Length
+  )
+{
+  UINTN   Index;
+  UINT32  Bit;
+
+  Crc = ~Crc;
+  for (Index = 0; Index < Length; ++Index) {
+    Crc ^= Buffer[Index];
+    for (Bit = 0; Bit < 8; ++Bit) {
+      Crc = (Crc >> 1U) ^ (0xEDB88320U & (0U - (Crc & 1U)));
+    }
+  }
+
+  return ~Crc;
+}
+
+/**
+  Check that zlib checksums, which use SIMD kernels when available,
+  match bytewise reference implementations.
+
+  @retval 0 on success.
+**/
+STATIC
+int
+VerifyChecksums (
+  VOID
+  )
+{
+  STATIC CONST UINT32  LongLengths[] = { 5552, 5552 * 3 + 7, 65536, CHECKSUM_BUFFER_SIZE - 16 };
+
+  UINT8   *Buffer;
+  UINTN   Index;
+  UINTN   Offset;
+  UINTN   Length;
+  UINT32  Crc;
+  int     Result;
+
+  Buffer = AllocatePool (CHECKSUM_BUFFER_SIZE);
+  if (Buffer == NULL) {
+    return -1;
+  }
+
+  for (Index = 0; Index < CHECKSUM_BUFFER_SIZE; ++Index) {
+    Buffer[Index] = (UINT8)pseudo_random ();
+  }
+
+  //
+  // Start with all bytes set to 0xFF, the largest Adler-32 sums.
+  //
+  SetMem (Buffer, LongLengths[1], 0xFF);
+
+  Result = 0;
+  for (Offset = 0; Offset < 16 && Result == 0; ++Offset) {
+    for (Length = 0; Length <= CHECKSUM_SHORT_LENGTH + ARRAY_SIZE (LongLengths) && Result == 0; ++Length) {
+      Index = Length;
+      if (Length > CHECKSUM_SHORT_LENGTH) {
+        Index = LongLengths[Length - CHECKSUM_SHORT_LENGTH - 1];
+      }
+
+      if (Adler32 (&Buffer[Offset], (UINT32)Index) != ReferenceAdler32 (&Buffer[Offset], Index)) {
+        DEBUG ((DEBUG_ERROR, "Adler32 mismatch for %u bytes at %u\n", (UINT32)Index, (UINT32)Offset));
+        Result = -1;
+      }
+
+      //
+      // Chain from a non-initial value to cover the folding of the incoming CRC.
+      //
+      Crc = (UINT32)crc32 (0, Buffer, (UINT32)Offset);
+      if ((UINT32)crc32 (Crc, &Buffer[Offset], (UINT32)Index) != ReferenceCrc32 (Crc, &Buffer[Offset], Index)) {
+        DEBUG ((DEBUG_ERROR, "CRC32 mismatch for %u bytes at %u\n", (UINT32)Index, (UINT32)Offset));
+        Result = -1;
+      }
+    }
+  }
+
+  FreePool (Buffer);
+  return Result;
+}
+
+int
+ENTRY_POINT (
+  int   argc,
+  char  *argv[]
+  )
+{
+  UINT8             *Buffer;
+  UINT32            BufferSize;
+  UINT8             *Kernel;
+  UINT32            KernelSize;
+  MACH_COMP_HEADER  *CompHeader;
+  UINT32            CompressionType;
+  UINT32            CompressedSize;
+  UINT32            DecompressedSize;
+  UINT32            DecompressedHash;
+  UINT32            Iterations;
+  UINT32            Index;
+  UINT64            Start;
+  UINT64            Time;
+  int               Result;
+
+  if (argc < 2) {
+    DEBUG ((DEBUG_ERROR, "Usage: %a <path/to/prelinkedkernel> [iterations]\n", argv[0]));
+    return -1;
+  }
+
+  if (VerifyChecksums () != 0) {
+    return -1;
+  }
+
+  Iterations = argc > 2 ? MAX ((UINT32)atoi (argv[2]), 1) : 10;
+
+  if ((Buffer = UserReadFile (argv[1], &BufferSize)) == NULL) {
+    DEBUG ((DEBUG_ERROR, "Read fail\n"));
+    return -1;
+  }
+
+  //
+  // Older prelinkedkernels come as FAT binaries with a compressed x86_64 slice.
+  //
+  CompHeader = (MACH_COMP_HEADER *)Buffer;
+  if (EFI_ERROR (FatFilterArchitectureByType ((UINT8 **)&CompHeader, &BufferSize, MachCpuTypeX8664))) {
+    DEBUG ((DEBUG_ERROR, "No x86_64 slice\n"));
+    FreePool (Buffer);
+    return -1;
+  }
+
+  if (  (BufferSize < sizeof (MACH_COMP_HEADER))
+     || (CompHeader->Signature != MACH_COMPRESSED_BINARY_INVERT_SIGNATURE))
+  {
+    DEBUG ((DEBUG_ERROR, "Not a compressed kernel\n"));
+    FreePool (Buffer);
+    return -1;
+  }
+
+  CompressionType  = CompHeader->Compression;
+  CompressedSize   = SwapBytes32 (CompHeader->Compressed);
+  DecompressedSize = SwapBytes32 (CompHeader->Decompressed);
+  DecompressedHash = SwapBytes32 (CompHeader->Hash);
+
+  if (  (CompressedSize > BufferSize - sizeof (MACH_COMP_HEADER))
+     || (DecompressedSize == 0)
+     || (  (CompressionType != MACH_COMPRESSED_BINARY_INVERT_LZVN)
+        && (CompressionType != MACH_COMPRESSED_BINARY_INVERT_LZSS)))
+  {
+    DEBUG ((DEBUG_ERROR, "Invalid compressed kernel header\n"));
+    FreePool (Buffer);
+    return -1;
+  }
+
+  Kernel = AllocatePool (DecompressedSize);
+  if (Kernel == NULL) {
+    DEBUG ((DEBUG_ERROR, "Kernel allocation failed\n"));
+    FreePool (Buffer);
+    return -1;
+  }
+
+  KernelSize = 0;
+  Start      = GetCurrentTimestampUs ();
+  for (Index = 0; Index < Iterations; ++Index) {
+    if (CompressionType == MACH_COMPRESSED_BINARY_INVERT_LZVN) {
+      KernelSize = (UINT32)DecompressLZVN (Kernel, DecompressedSize, (UINT8 *)(CompHeader + 1), CompressedSize);
+    } else {
+      KernelSize = DecompressLZSS (Kernel, DecompressedSize, (UINT8 *)(CompHeader + 1), CompressedSize);
+    }
+  }
+
+  Time = MAX (GetCurrentTimestampUs () - Start, 1);
+
+  if (KernelSize != DecompressedSize) {
+    DEBUG ((DEBUG_ERROR, "Decompressed %u bytes out of %u\n", KernelSize, DecompressedSize));
+    FreePool (Kernel);
+    FreePool (Buffer);
+    return -1;
+  }
+
+  DEBUG ((
+    DEBUG_ERROR,
+    "%a: %u -> %u bytes, %u iterations in %Lu us (%Lu MB/s)\n",
+    CompressionType == MACH_COMPRESSED_BINARY_INVERT_LZVN ? "LZVN" : "LZSS",
+    CompressedSize,
+    DecompressedSize,
+    Iterations,
+    Time,
+    DivU64x64Remainder (MultU64x32 (DecompressedSize, Iterations), Time, NULL)
+    ));
+
+  Result = 0;
+  if (Adler32 (Kernel, KernelSize) != DecompressedHash) {
+    DEBUG ((DEBUG_ERROR, "Adler32 mismatch\n"));
+    Result = -1;
+  }
+
+  FreePool (Kernel);
+  FreePool (Buffer);
+  return Result;
+}
@@ -306,6 +306,157 @@ FeedMacho (
   return Code != 963;
 }
 
+/**
+  Check that load command lookups through the load command index return
+  the same commands, segments and sections as the linear walk.
+
+  @param[in] File  Mach-O file.
+  @param[in] Size  Mach-O file size.
+
+  @return 0 on success.
+**/
+STATIC
+int
+CheckMachoIndex (
+  IN OUT VOID    *File,
+  IN     UINT32  Size
+  )
+{
+  OC_MACHO_CONTEXT         Indexed;
+  OC_MACHO_CONTEXT         Linear;
+  MACH_HEADER_64           *Header;
+  MACH_LOAD_COMMAND_TYPE   CommandType;
+  MACH_LOAD_COMMAND        *IndexedCommand;
+  MACH_LOAD_COMMAND        *LinearCommand;
+  MACH_SEGMENT_COMMAND_64  *IndexedSegment;
+  MACH_SEGMENT_COMMAND_64  *LinearSegment;
+  MACH_SECTION_64          *IndexedSection;
+  MACH_SECTION_64          *LinearSection;
+  CHAR8                    SegmentName[sizeof (LinearSegment->SegmentName) + 1];
+  CHAR8                    SectionName[sizeof (LinearSection->SectionName) + 1];
+  UINT32                   Index;
+  UINT32                   Mismatches;
+
+  if (  !MachoInitializeContext64 (&Indexed, File, Size, 0, Size)
+     || !MachoInitializeContext64 (&Linear, File, Size, 0, Size))
+  {
+    DEBUG ((DEBUG_ERROR, "Mach-O index: not a 64-bit Mach-O\n"));
+    return -1;
+  }
+
+  //
+  // Mark the index of the current command layout unsupported, so that it is
+  // not rebuilt and every lookup walks the load commands.
+  //
+  Header                    = MachoGetMachHeader64 (&Linear);
+  Linear.Index.State        = OcMachoIndexUnsupported;
+  Linear.Index.NumCommands  = Header->NumCommands;
+  Linear.Index.CommandsSize = Header->CommandsSize;
+
+  Mismatches = 0;
+
+  for (Index = 0; Index < 2 * MACHO_INDEX_COMMAND_TYPES; ++Index) {
+    CommandType = Index % MACHO_INDEX_COMMAND_TYPES;
+    if (Index >= MACHO_INDEX_COMMAND_TYPES) {
+      CommandType |= MACH_LC_REQUIRE_DYLD;
+    }
+
+    IndexedCommand = NULL;
+    LinearCommand  = NULL;
+    do {
+      IndexedCommand = MachoGetNextCommand (&Indexed, CommandType, IndexedCommand);
+      LinearCommand  = MachoGetNextCommand (&Linear, CommandType, LinearCommand);
+      if (IndexedCommand != LinearCommand) {
+        DEBUG ((DEBUG_ERROR, "Mach-O index: command 0x%X mismatch\n", CommandType));
+        ++Mismatches;
+        break;
+      }
+    } while (LinearCommand != NULL);
+  }
+
+  if (Indexed.Index.State != OcMachoIndexValid) {
+    DEBUG ((DEBUG_ERROR, "Mach-O index: not indexed, lookups use the linear walk\n"));
+  }
+
+  IndexedSegment = NULL;
+  LinearSegment  = NULL;
+  while (TRUE) {
+    IndexedSegment = MachoGetNextSegment64 (&Indexed, IndexedSegment);
+    LinearSegment  = MachoGetNextSegment64 (&Linear, LinearSegment);
+    if (IndexedSegment != LinearSegment) {
+      DEBUG ((DEBUG_ERROR, "Mach-O index: segment mismatch\n"));
+      ++Mismatches;
+      break;
+    }
+
+    if (LinearSegment == NULL) {
+      break;
+    }
+
+    CopyMem (SegmentName, LinearSegment->SegmentName, sizeof (LinearSegment->SegmentName));
+    SegmentName[sizeof (LinearSegment->SegmentName)] = '\0';
+
+    if (MachoGetSegmentByName64 (&Indexed, SegmentName) != MachoGetSegmentByName64 (&Linear, SegmentName)) {
+      DEBUG ((DEBUG_ERROR, "Mach-O index: segment %a lookup mismatch\n", SegmentName));
+      ++Mismatches;
+    }
+
+    IndexedSection = NULL;
+    LinearSection  = NULL;
+    while (TRUE) {
+      IndexedSection = MachoGetNextSection64 (&Indexed, IndexedSegment, IndexedSection);
+      LinearSection  = MachoGetNextSection64 (&Linear, LinearSegment, LinearSection);
+      if (IndexedSection != LinearSection) {
+        DEBUG ((DEBUG_ERROR, "Mach-O index: section mismatch in %a\n", SegmentName));
+        ++Mismatches;
+        break;
+      }
+
+      if (LinearSection == NULL) {
+        break;
+      }
+
+      CopyMem (SectionName, LinearSection->SectionName, sizeof (LinearSection->SectionName));
+      SectionName[sizeof (LinearSection->SectionName)] = '\0';
+
+      if (  (MachoGetSectionByName64 (&Indexed, IndexedSegment, SectionName) != MachoGetSectionByName64 (&Linear, LinearSegment, SectionName))
+         || (MachoGetSegmentSectionByName64 (&Indexed, SegmentName, SectionName) != MachoGetSegmentSectionByName64 (&Linear, SegmentName, SectionName)))
+      {
+        DEBUG ((DEBUG_ERROR, "Mach-O index: section %a,%a lookup mismatch\n", SegmentName, SectionName));
+        ++Mismatches;
+      }
+    }
+  }
+
+  Index = 0;
+  do {
+    LinearSection = MachoGetSectionByIndex64 (&Linear, Index);
+    if (MachoGetSectionByIndex64 (&Indexed, Index) != LinearSection) {
+      DEBUG ((DEBUG_ERROR, "Mach-O index: section %u mismatch\n", Index));
+      ++Mismatches;
+      break;
+    }
+
+    ++Index;
+  } while (LinearSection != NULL);
+
+  if (  (MachoGetUuid (&Indexed) != MachoGetUuid (&Linear))
+     || (MachoGetVmSize (&Indexed) != MachoGetVmSize (&Linear))
+     || (MachoGetLastAddress (&Indexed) != MachoGetLastAddress (&Linear)))
+  {
+    DEBUG ((DEBUG_ERROR, "Mach-O index: UUID or address space mismatch\n"));
+    ++Mismatches;
+  }
+
+  if (Mismatches != 0) {
+    DEBUG ((DEBUG_ERROR, "Mach-O index: FAILED with %u mismatches\n", Mismatches));
+    return -1;
+  }
+
+  DEBUG ((DEBUG_ERROR, "Mach-O index: passed with %u sections\n", Index - 1));
+  return 0;
+}
+
 int
 ENTRY_POINT (
   int   argc,
@@ -320,6 +471,10 @@ ENTRY_POINT (
     return -1;
   }
 
+  if (CheckMachoIndex (Buffer, FileSize) != 0) {
+    return -1;
+  }
+
   return FeedMacho (Buffer, FileSize);
 }
 
@@ -0,0 +1,198 @@
+/** @file
+  Check that OcParallelFor runs every item exactly once on valid workers,
+  and that background tasks complete before OcParallelWaitTask returns.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcParallelLib.h>
+
+#include <UserParallel.h>
+
+#include <stdlib.h>
+
+typedef struct {
+  UINT32    *Hits;
+  UINTN     NumWorkers;
+  UINT64    WorkerMask;
+  UINT32    BadWorkers;
+  UINT32    BadAllocations;
+} PARALLEL_TEST_CONTEXT;
+
+STATIC
+VOID
+EFIAPI
+CountItem (
+  IN OUT VOID   *Context,
+  IN     UINTN  Index,
+  IN     UINTN  Worker
+  )
+{
+  PARALLEL_TEST_CONTEXT  *Test;
+  UINT8                  *Buffer;
+
+  Test = Context;
+
+  __atomic_add_fetch (&Test->Hits[Index], 1, __ATOMIC_RELAXED);
+
+  if (Worker >= Test->NumWorkers) {
+    __atomic_add_fetch (&Test->BadWorkers, 1, __ATOMIC_RELAXED);
+    return;
+  }
+
+  __atomic_or_fetch (&Test->WorkerMask, 1ULL << Worker, __ATOMIC_RELAXED);
+
+  //
+  // Jobs in userspace share the allocator, make sure it survives.
+  //
+  Buffer = AllocatePool (16 + Index % 256);
+  if (Buffer == NULL) {
+    __atomic_add_fetch (&Test->BadAllocations, 1, __ATOMIC_RELAXED);
+    return;
+  }
+
+  SetMem (Buffer, 16 + Index % 256, (UINT8)Index);
+  FreePool (Buffer);
+}
+
+/**
+  Run one job and check every item was processed once.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+TestParallelFor (
+  IN UINT32  Count,
+  IN UINTN   MaxWorkers
+  )
+{
+  PARALLEL_TEST_CONTEXT  Test;
+  UINT32                 Index;
+  UINT32                 Missed;
+  UINT32                 Repeated;
+  BOOLEAN                Result;
+
+  ZeroMem (&Test, sizeof (Test));
+
+  Test.Hits = AllocateZeroPool (MAX (Count, 1) * sizeof (*Test.Hits));
+  if (Test.Hits == NULL) {
+    DEBUG ((DEBUG_ERROR, "PAR: Out of memory\n"));
+    return FALSE;
+  }
+
+  Test.NumWorkers = OcParallelGetWorkerCount ();
+  if ((MaxWorkers != 0) && (MaxWorkers < Test.NumWorkers)) {
+    Test.NumWorkers = MaxWorkers;
+  }
+
+  OcParallelFor (CountItem, &Test, Count, MaxWorkers);
+
+  Missed   = 0;
+  Repeated = 0;
+  for (Index = 0; Index < Count; ++Index) {
+    if (Test.Hits[Index] == 0) {
+      ++Missed;
+    } else if (Test.Hits[Index] > 1) {
+      ++Repeated;
+    }
+  }
+
+  FreePool (Test.Hits);
+
+  Result = Missed == 0 && Repeated == 0 && Test.BadWorkers == 0 && Test.BadAllocations == 0;
+
+  DEBUG ((
+    Result ? DEBUG_VERBOSE : DEBUG_ERROR,
+    "PAR: %u items on %u of %u workers - %u missed, %u repeated, %u bad workers, %u bad allocations - %a\n",
+    Count,
+    (UINT32)BitFieldCountOnes64 (Test.WorkerMask, 0, 63),
+    (UINT32)Test.NumWorkers,
+    Missed,
+    Repeated,
+    Test.BadWorkers,
+    Test.BadAllocations,
+    Result ? "passed" : "FAILED"
+    ));
+
+  return Result;
+}
+
+/**
+  Run background task and check it completed.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+TestParallelTask (
+  VOID
+  )
+{
+  PARALLEL_TEST_CONTEXT  Test;
+  OC_PARALLEL_TASK       Task;
+  UINT32                 Hit;
+  BOOLEAN                Result;
+
+  ZeroMem (&Test, sizeof (Test));
+  Hit             = 0;
+  Test.Hits       = &Hit;
+  Test.NumWorkers = 1;
+
+  OcParallelStartTask (CountItem, &Test, &Task);
+  OcParallelWaitTask (&Task);
+
+  Result = Hit == 1 && Test.BadWorkers == 0 && Test.BadAllocations == 0 && Task.Handle == NULL;
+
+  DEBUG ((Result ? DEBUG_VERBOSE : DEBUG_ERROR, "PAR: Background task - %a\n", Result ? "passed" : "FAILED"));
+
+  return Result;
+}
+
+int
+ENTRY_POINT (
+  int   argc,
+  char  *argv[]
+  )
+{
+  STATIC CONST UINT32  mCounts[]     = { 0, 1, 2, 3, 7, 64, 1000, 100000 };
+  STATIC CONST UINTN   mMaxWorkers[] = { 0, 1, 2, 3, 64 };
+  UINTN                Workers;
+  UINTN                Round;
+  UINTN                CountIndex;
+  UINTN                WorkerIndex;
+  BOOLEAN              Result;
+
+  //
+  // Always run more than one worker, even on single processor machines.
+  //
+  Workers = argc > 1 ? (UINTN)atoi (argv[1]) : 8;
+  SetParallelWorkerCount (MAX (Workers, 2));
+
+  Result = TRUE;
+
+  for (Round = 0; Round < 16; ++Round) {
+    for (CountIndex = 0; CountIndex < ARRAY_SIZE (mCounts); ++CountIndex) {
+      for (WorkerIndex = 0; WorkerIndex < ARRAY_SIZE (mMaxWorkers); ++WorkerIndex) {
+        Result = TestParallelFor (mCounts[CountIndex], mMaxWorkers[WorkerIndex]) && Result;
+      }
+    }
+
+    Result = TestParallelTask () && Result;
+  }
+
+  DEBUG ((
+    DEBUG_ERROR,
+    "PAR: %u rounds on %u workers - %a\n",
+    (UINT32)Round,
+    (UINT32)OcParallelGetWorkerCount (),
+    Result ? "passed" : "FAILED"
+    ));
+
+  return Result ? 0 : -1;
+}
@@ -0,0 +1,160 @@
+/** @file
+  Check that ApplyPatchSet gives the same data and replacement counts as
+  applying every patch with ApplyPatch in order, for random overlapping
+  patches with Count, Skip and Limit set.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/OcMiscLib.h>
+
+//
+// Small alphabet makes patterns overlap and replacements create new matches.
+//
+#define PATCH_SET_ALPHABET     3
+#define PATCH_SET_DATA_SIZE    256
+#define PATCH_SET_MAX_PATCHES  8
+#define PATCH_SET_MAX_SIZE     4
+#define PATCH_SET_ROUNDS       20000
+
+typedef struct {
+  UINT8    Find[PATCH_SET_MAX_SIZE];
+  UINT8    Mask[PATCH_SET_MAX_SIZE];
+  UINT8    Replace[PATCH_SET_MAX_SIZE];
+  UINT8    ReplaceMask[PATCH_SET_MAX_SIZE];
+} PATCH_SET_DATA;
+
+STATIC UINT32  mPatchSetSeed = 0x4F435053;
+
+STATIC
+UINT32
+PatchSetRandom (
+  IN UINT32  Range
+  )
+{
+  mPatchSetSeed = mPatchSetSeed * 1103515245U + 12345U;
+  return (mPatchSetSeed >> 16U) % Range;
+}
+
+/**
+  Generate random patches and apply them both ways.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+TestPatchSetRound (
+  VOID
+  )
+{
+  PATCH_SET_DATA      PatchData[PATCH_SET_MAX_PATCHES];
+  OC_PATCH_SET_ENTRY  Patches[PATCH_SET_MAX_PATCHES];
+  UINT8               Data[PATCH_SET_DATA_SIZE];
+  UINT8               Expected[PATCH_SET_DATA_SIZE];
+  UINT32              ExpectedCount[PATCH_SET_MAX_PATCHES];
+  UINT32              PatchCount;
+  UINT32              DataSize;
+  UINT32              Index;
+  UINT32              Byte;
+  EFI_STATUS          Status;
+
+  DataSize   = PatchSetRandom (PATCH_SET_DATA_SIZE) + 1;
+  PatchCount = PatchSetRandom (PATCH_SET_MAX_PATCHES) + 1;
+
+  for (Index = 0; Index < DataSize; ++Index) {
+    Data[Index] = (UINT8)PatchSetRandom (PATCH_SET_ALPHABET);
+  }
+
+  for (Index = 0; Index < PatchCount; ++Index) {
+    ZeroMem (&Patches[Index], sizeof (Patches[Index]));
+    Patches[Index].PatternSize = PatchSetRandom (PATCH_SET_MAX_SIZE) + 1;
+
+    for (Byte = 0; Byte < Patches[Index].PatternSize; ++Byte) {
+      PatchData[Index].Find[Byte]        = (UINT8)PatchSetRandom (PATCH_SET_ALPHABET);
+      PatchData[Index].Mask[Byte]        = PatchSetRandom (4) == 0 ? 0x00 : 0xFF;
+      PatchData[Index].Replace[Byte]     = (UINT8)PatchSetRandom (PATCH_SET_ALPHABET);
+      PatchData[Index].ReplaceMask[Byte] = PatchSetRandom (4) == 0 ? 0x00 : 0xFF;
+    }
+
+    Patches[Index].Pattern     = PatchData[Index].Find;
+    Patches[Index].PatternMask = PatchSetRandom (2) == 0 ? NULL : PatchData[Index].Mask;
+    Patches[Index].Replace     = PatchData[Index].Replace;
+    Patches[Index].ReplaceMask = PatchSetRandom (2) == 0 ? NULL : PatchData[Index].ReplaceMask;
+    Patches[Index].Count       = PatchSetRandom (4);
+    Patches[Index].Skip        = PatchSetRandom (3);
+    Patches[Index].Limit       = PatchSetRandom (2) == 0 ? 0 : PatchSetRandom (PATCH_SET_DATA_SIZE);
+  }
+
+  //
+  // Apply patches one by one like ApplyBooterPatch does.
+  //
+  CopyMem (Expected, Data, DataSize);
+  for (Index = 0; Index < PatchCount; ++Index) {
+    ExpectedCount[Index] = ApplyPatch (
+                             Patches[Index].Pattern,
+                             Patches[Index].PatternMask,
+                             Patches[Index].PatternSize,
+                             Patches[Index].Replace,
+                             Patches[Index].ReplaceMask,
+                             Expected,
+                             (Patches[Index].Limit > 0) ? MIN (Patches[Index].Limit, DataSize) : DataSize,
+                             Patches[Index].Count,
+                             Patches[Index].Skip
+                             );
+  }
+
+  Status = ApplyPatchSet (Patches, PatchCount, Data, DataSize);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "PATCH: Patch set failed - %r\n", Status));
+    return FALSE;
+  }
+
+  if (CompareMem (Data, Expected, DataSize) != 0) {
+    DEBUG ((DEBUG_ERROR, "PATCH: Data mismatch for %u patches over %u bytes\n", PatchCount, DataSize));
+    return FALSE;
+  }
+
+  for (Index = 0; Index < PatchCount; ++Index) {
+    if (Patches[Index].ReplaceCount != ExpectedCount[Index]) {
+      DEBUG ((
+        DEBUG_ERROR,
+        "PATCH: Patch %u replaced %u times instead of %u\n",
+        Index,
+        Patches[Index].ReplaceCount,
+        ExpectedCount[Index]
+        ));
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+int
+ENTRY_POINT (
+  int   argc,
+  char  *argv[]
+  )
+{
+  UINT32   Round;
+  BOOLEAN  Result;
+
+  Result = TRUE;
+
+  for (Round = 0; Round < PATCH_SET_ROUNDS && Result; ++Round) {
+    Result = TestPatchSetRound ();
+  }
+
+  DEBUG ((
+    DEBUG_ERROR,
+    "PATCH: %u rounds - %a\n",
+    Round,
+    Result ? "passed" : "FAILED"
+    ));
+
+  return Result ? 0 : -1;
+}
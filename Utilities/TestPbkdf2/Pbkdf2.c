@@ -0,0 +1,261 @@
+/** @file
+  Check PBKDF2-HMAC-SHA512 password hashing against the test vector inputs
+  of RFC 6070 and RFC 7914, with SHA-512 outputs, and multi-lane hashes
+  against the XOR of consecutive PBKDF2 output blocks.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/OcCryptoLib.h>
+
+typedef struct {
+  CONST CHAR8    *Name;
+  CONST CHAR8    *Password;
+  UINT32         PasswordSize;
+  CONST CHAR8    *Salt;
+  UINT32         SaltSize;
+  UINT32         Iterations;
+  UINT32         Lanes;
+  UINT8          Hash[SHA512_DIGEST_SIZE];
+} PBKDF2_SAMPLE;
+
+STATIC CONST PBKDF2_SAMPLE  mPbkdf2Samples[] = {
+  {
+    "RFC 6070",
+    "password",
+    8,
+    "salt",
+    4,
+    1,
+    1,
+    {
+      0x86, 0x7F, 0x70, 0xCF, 0x1A, 0xDE, 0x02, 0xCF, 0xF3, 0x75, 0x25, 0x99, 0xA3, 0xA5, 0x3D, 0xC4,
+      0xAF, 0x34, 0xC7, 0xA6, 0x69, 0x81, 0x5A, 0xE5, 0xD5, 0x13, 0x55, 0x4E, 0x1C, 0x8C, 0xF2, 0x52,
+      0xC0, 0x2D, 0x47, 0x0A, 0x28, 0x5A, 0x05, 0x01, 0xBA, 0xD9, 0x99, 0xBF, 0xE9, 0x43, 0xC0, 0x8F,
+      0x05, 0x02, 0x35, 0xD7, 0xD6, 0x8B, 0x1D, 0xA5, 0x5E, 0x63, 0xF7, 0x3B, 0x60, 0xA5, 0x7F, 0xCE
+    }
+  },
+  {
+    "RFC 6070",
+    "password",
+    8,
+    "salt",
+    4,
+    2,
+    1,
+    {
+      0xE1, 0xD9, 0xC1, 0x6A, 0xA6, 0x81, 0x70, 0x8A, 0x45, 0xF5, 0xC7, 0xC4, 0xE2, 0x15, 0xCE, 0xB6,
+      0x6E, 0x01, 0x1A, 0x2E, 0x9F, 0x00, 0x40, 0x71, 0x3F, 0x18, 0xAE, 0xFD, 0xB8, 0x66, 0xD5, 0x3C,
+      0xF7, 0x6C, 0xAB, 0x28, 0x68, 0xA3, 0x9B, 0x9F, 0x78, 0x40, 0xED, 0xCE, 0x4F, 0xEF, 0x5A, 0x82,
+      0xBE, 0x67, 0x33, 0x5C, 0x77, 0xA6, 0x06, 0x8E, 0x04, 0x11, 0x27, 0x54, 0xF2, 0x7C, 0xCF, 0x4E
+    }
+  },
+  {
+    "RFC 6070",
+    "password",
+    8,
+    "salt",
+    4,
+    4096,
+    1,
+    {
+      0xD1, 0x97, 0xB1, 0xB3, 0x3D, 0xB0, 0x14, 0x3E, 0x01, 0x8B, 0x12, 0xF3, 0xD1, 0xD1, 0x47, 0x9E,
+      0x6C, 0xDE, 0xBD, 0xCC, 0x97, 0xC5, 0xC0, 0xF8, 0x7F, 0x69, 0x02, 0xE0, 0x72, 0xF4, 0x57, 0xB5,
+      0x14, 0x3F, 0x30, 0x60, 0x26, 0x41, 0xB3, 0xD5, 0x5C, 0xD3, 0x35, 0x98, 0x8C, 0xB3, 0x6B, 0x84,
+      0x37, 0x60, 0x60, 0xEC, 0xD5, 0x32, 0xE0, 0x39, 0xB7, 0x42, 0xA2, 0x39, 0x43, 0x4A, 0xF2, 0xD5
+    }
+  },
+  {
+    "RFC 6070",
+    "passwordPASSWORDpassword",
+    24,
+    "saltSALTsaltSALTsaltSALTsaltSALTsalt",
+    36,
+    4096,
+    1,
+    {
+      0x8C, 0x05, 0x11, 0xF4, 0xC6, 0xE5, 0x97, 0xC6, 0xAC, 0x63, 0x15, 0xD8, 0xF0, 0x36, 0x2E, 0x22,
+      0x5F, 0x3C, 0x50, 0x14, 0x95, 0xBA, 0x23, 0xB8, 0x68, 0xC0, 0x05, 0x17, 0x4D, 0xC4, 0xEE, 0x71,
+      0x11, 0x5B, 0x59, 0xF9, 0xE6, 0x0C, 0xD9, 0x53, 0x2F, 0xA3, 0x3E, 0x0F, 0x75, 0xAE, 0xFE, 0x30,
+      0x22, 0x5C, 0x58, 0x3A, 0x18, 0x6C, 0xD8, 0x2B, 0xD4, 0xDA, 0xEA, 0x97, 0x24, 0xA3, 0xD3, 0xB8
+    }
+  },
+  {
+    "RFC 6070",
+    "pass\0word",
+    9,
+    "sa\0lt",
+    5,
+    4096,
+    1,
+    {
+      0x9D, 0x9E, 0x9C, 0x4C, 0xD2, 0x1F, 0xE4, 0xBE, 0x24, 0xD5, 0xB8, 0x24, 0x4C, 0x75, 0x96, 0x65,
+      0xF3, 0x9D, 0x98, 0xFC, 0x12, 0xA9, 0xCA, 0x75, 0x9B, 0xB0, 0x21, 0xDB, 0x3C, 0xFA, 0xDF, 0x34,
+      0x58, 0x44, 0xAE, 0xBE, 0x70, 0xDD, 0x8B, 0x2F, 0x69, 0x66, 0xF2, 0x5F, 0x36, 0x13, 0xE1, 0x18,
+      0x7B, 0xBD, 0x24, 0xED, 0x2C, 0xA4, 0x3E, 0xD1, 0x3B, 0x24, 0x6E, 0x46, 0x75, 0xBE, 0x7A, 0xB9
+    }
+  },
+  {
+    "RFC 7914",
+    "passwd",
+    6,
+    "salt",
+    4,
+    1,
+    1,
+    {
+      0xC7, 0x43, 0x19, 0xD9, 0x94, 0x99, 0xFC, 0x3E, 0x90, 0x13, 0xAC, 0xFF, 0x59, 0x7C, 0x23, 0xC5,
+      0xBA, 0xF0, 0xA0, 0xBE, 0xC5, 0x63, 0x4C, 0x46, 0xB8, 0x35, 0x2B, 0x79, 0x3E, 0x32, 0x47, 0x23,
+      0xD5, 0x5C, 0xAA, 0x76, 0xB2, 0xB2, 0x5C, 0x43, 0x40, 0x2D, 0xCF, 0xDC, 0x06, 0xCD, 0xCF, 0x66,
+      0xF9, 0x5B, 0x7D, 0x04, 0x29, 0x42, 0x0B, 0x39, 0x52, 0x00, 0x06, 0x74, 0x9C, 0x51, 0xA0, 0x4E
+    }
+  },
+  {
+    "RFC 7914",
+    "Password",
+    8,
+    "NaCl",
+    4,
+    80000,
+    1,
+    {
+      0xE6, 0x33, 0x7D, 0x6F, 0xBE, 0xB6, 0x45, 0xC7, 0x94, 0xD4, 0xA9, 0xB5, 0xB7, 0x5B, 0x7B, 0x30,
+      0xDA, 0xC9, 0xAC, 0x50, 0x37, 0x6A, 0x91, 0xDF, 0x1F, 0x44, 0x60, 0xF6, 0x06, 0x0D, 0x5A, 0xDD,
+      0xB2, 0xC1, 0xFD, 0x1F, 0x84, 0x40, 0x9A, 0xBA, 0xCC, 0x67, 0xDE, 0x7E, 0xB4, 0x05, 0x6E, 0x6B,
+      0xB0, 0x6C, 0x2D, 0x82, 0xC3, 0xEF, 0x4C, 0xCD, 0x1B, 0xDE, 0xD0, 0xF6, 0x75, 0xED, 0x97, 0xC6
+    }
+  },
+  {
+    "Lanes",
+    "password",
+    8,
+    "salt",
+    4,
+    1000,
+    2,
+    {
+      0xC5, 0x1B, 0x29, 0x6F, 0x1B, 0xA6, 0x2E, 0xE6, 0x79, 0x03, 0x49, 0x18, 0xD8, 0x4F, 0xB9, 0x2E,
+      0x26, 0x40, 0xA8, 0xE3, 0xAF, 0x8F, 0x9B, 0x22, 0x9E, 0x3F, 0xB4, 0xF6, 0xE9, 0xAD, 0x00, 0x81,
+      0x03, 0x43, 0xA5, 0xDD, 0xDE, 0x93, 0x0F, 0x2A, 0xA3, 0x3C, 0xAB, 0x93, 0xD0, 0x98, 0x1F, 0xD1,
+      0x6C, 0xD1, 0xD6, 0x1D, 0x31, 0x49, 0xA0, 0xB7, 0xAC, 0x7E, 0xC8, 0x54, 0x1D, 0xD6, 0xEF, 0x7C
+    }
+  },
+  {
+    "Lanes",
+    "password",
+    8,
+    "salt",
+    4,
+    1000,
+    3,
+    {
+      0xBC, 0x4F, 0x6C, 0xA3, 0x68, 0xB2, 0xD2, 0x12, 0x6D, 0x84, 0xC3, 0x5A, 0x27, 0x9C, 0x25, 0xFD,
+      0x9F, 0x4D, 0x65, 0xA2, 0x4F, 0xEA, 0x78, 0x79, 0x80, 0xC8, 0xEB, 0x18, 0x4F, 0xAB, 0xC4, 0xB8,
+      0xB5, 0x08, 0x43, 0xFF, 0x29, 0x03, 0xEE, 0xEE, 0x3F, 0x01, 0x3A, 0xD4, 0x03, 0x9F, 0x8D, 0x5F,
+      0xB9, 0x60, 0x7D, 0x31, 0xB5, 0x82, 0x94, 0x65, 0xAA, 0x14, 0x41, 0x13, 0xBE, 0xF3, 0x53, 0xC6
+    }
+  }
+};
+
+/**
+  Check one sample with both hashing and verification.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+TestPbkdf2Sample (
+  IN CONST PBKDF2_SAMPLE  *Sample
+  )
+{
+  UINT8    Hash[SHA512_DIGEST_SIZE];
+  BOOLEAN  Result;
+
+  OcHashPasswordPbkdf2Sha512 (
+    (CONST UINT8 *)Sample->Password,
+    Sample->PasswordSize,
+    (CONST UINT8 *)Sample->Salt,
+    Sample->SaltSize,
+    Sample->Iterations,
+    Sample->Lanes,
+    Hash
+    );
+
+  Result = CompareMem (Hash, Sample->Hash, sizeof (Hash)) == 0;
+
+  Result = Result && OcVerifyPasswordPbkdf2Sha512 (
+                       (CONST UINT8 *)Sample->Password,
+                       Sample->PasswordSize,
+                       (CONST UINT8 *)Sample->Salt,
+                       Sample->SaltSize,
+                       Sample->Iterations,
+                       Sample->Lanes,
+                       Sample->Hash
+                       );
+
+  //
+  // Any other iteration count must not match.
+  //
+  Result = Result && !OcVerifyPasswordPbkdf2Sha512 (
+                        (CONST UINT8 *)Sample->Password,
+                        Sample->PasswordSize,
+                        (CONST UINT8 *)Sample->Salt,
+                        Sample->SaltSize,
+                        Sample->Iterations + 1,
+                        Sample->Lanes,
+                        Sample->Hash
+                        );
+
+  DEBUG ((
+    Result ? DEBUG_VERBOSE : DEBUG_ERROR,
+    "PBKDF2: %a %u iterations %u lanes - %a\n",
+    Sample->Name,
+    Sample->Iterations,
+    Sample->Lanes,
+    Result ? "passed" : "FAILED"
+    ));
+
+  return Result;
+}
+
+int
+ENTRY_POINT (
+  int   argc,
+  char  *argv[]
+  )
+{
+  UINT8    Hash[SHA512_DIGEST_SIZE];
+  UINTN    Index;
+  BOOLEAN  Result;
+
+  Result = TRUE;
+
+  for (Index = 0; Index < ARRAY_SIZE (mPbkdf2Samples); ++Index) {
+    Result = TestPbkdf2Sample (&mPbkdf2Samples[Index]) && Result;
+  }
+
+  //
+  // Unsupported parameters are rejected rather than hashed.
+  //
+  ZeroMem (Hash, sizeof (Hash));
+  if (  OcVerifyPasswordPbkdf2Sha512 ((CONST UINT8 *)"password", 8, (CONST UINT8 *)"salt", 4, 0, 1, Hash)
+     || OcVerifyPasswordPbkdf2Sha512 ((CONST UINT8 *)"password", 8, (CONST UINT8 *)"salt", 4, 1, 0, Hash)
+     || OcVerifyPasswordPbkdf2Sha512 ((CONST UINT8 *)"password", 8, (CONST UINT8 *)"salt", 4, 1, OC_PASSWORD_MAX_LANES + 1, Hash))
+  {
+    DEBUG ((DEBUG_ERROR, "PBKDF2: Unsupported parameters were accepted\n"));
+    Result = FALSE;
+  }
+
+  DEBUG ((
+    DEBUG_ERROR,
+    "PBKDF2: %u samples - %a\n",
+    (UINT32)ARRAY_SIZE (mPbkdf2Samples),
+    Result ? "passed" : "FAILED"
+    ));
+
+  return Result ? 0 : -1;
+}
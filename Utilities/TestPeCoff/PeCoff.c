@@ -8,6 +8,7 @@
 #include <Library/BaseMemoryLib.h>
 #include <Library/BaseOverflowLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/OcPeCoffExtLib.h>
 #include <Library/PeCoffLib2.h>
 #include <Library/DebugLib.h>
 #include <Library/UefiBootServicesTableLib.h>
@@ -22,6 +23,11 @@ STATIC UINT64  mHashesMask = MAX_UINT64;
 STATIC UINTN   mHashIndex  = 0;
 STATIC UINTN   mHashDependency;
 
+//
+// Apple image read chunk sizes, small ones put boundaries all over hashed regions.
+//
+STATIC CONST UINT32  mAppleHashChunkSizes[] = { 1, 3, 61, 509, 4093, BASE_1MB };
+
 STATIC
 BOOLEAN
 HashUpdate (
@@ -238,6 +244,76 @@ PeCoffTestLoadFull (
   return Status;
 }
 
+/**
+  Check that Apple image hash computed while reading the image in chunks
+  matches the one-shot hash.
+
+  @param[in]  FileBuffer  Image buffer.
+  @param[in]  FileSize    Size of the image.
+
+  @retval EFI_SUCCESS             Hashes match.
+  @retval EFI_UNSUPPORTED         Image is not Apple signed.
+  @retval EFI_SECURITY_VIOLATION  Hashes differ.
+**/
+STATIC
+EFI_STATUS
+PeCoffTestAppleHash (
+  IN  CONST VOID  *FileBuffer,
+  IN  UINT32      FileSize
+  )
+{
+  EFI_STATUS                    Status;
+  PE_COFF_LOADER_IMAGE_CONTEXT  Context;
+  PE_COFF_APPLE_HASH_CONTEXT    HashContext;
+  UINT8                         Hash[SHA256_DIGEST_SIZE];
+  UINT8                         StreamedHash[SHA256_DIGEST_SIZE];
+  UINT32                        HeaderSize;
+  UINT32                        Available;
+  UINTN                         Index;
+
+  Status = PeCoffInitializeContext (&Context, FileBuffer, FileSize, UefiImageOriginFv);
+  if (EFI_ERROR (Status)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Status = PeCoffAppleHashInit (&HashContext, FileBuffer, FileSize, FileSize);
+  if (EFI_ERROR (Status)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (HashContext.ExeHdrOffset != Context.ExeHdrOffset) {
+    return EFI_SECURITY_VIOLATION;
+  }
+
+  PeCoffHashAppleImage (&Context, HashContext.SecDirOffset, HashContext.SignedFileSize, Hash);
+
+  //
+  // First chunk ends right after the security directory, the smallest one with all headers.
+  //
+  HeaderSize = HashContext.SecDirOffset + sizeof (EFI_IMAGE_DATA_DIRECTORY);
+
+  for (Index = 0; Index < ARRAY_SIZE (mAppleHashChunkSizes); ++Index) {
+    Status = PeCoffAppleHashInit (&HashContext, FileBuffer, FileSize, HeaderSize);
+    if (EFI_ERROR (Status)) {
+      return EFI_SECURITY_VIOLATION;
+    }
+
+    Available = HeaderSize;
+    while (Available < FileSize) {
+      Available += MIN (FileSize - Available, mAppleHashChunkSizes[Index]);
+      PeCoffAppleHashUpdate (&HashContext, Available);
+    }
+
+    Sha256Final (&HashContext.HashContext, StreamedHash);
+    if (CompareMem (Hash, StreamedHash, sizeof (Hash)) != 0) {
+      DEBUG ((DEBUG_ERROR, "Apple hash mismatch for %u byte chunks\n", mAppleHashChunkSizes[Index]));
+      return EFI_SECURITY_VIOLATION;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
 int
 LLVMFuzzerTestOneInput (
   const uint8_t  *Data,
@@ -304,6 +380,13 @@ ENTRY_POINT (
     return 1;
   }
 
+  Status = PeCoffTestAppleHash (Image, ImageSize);
+  DEBUG ((DEBUG_ERROR, "Apple streamed hash - %r\n", Status));
+  if (Status == EFI_SECURITY_VIOLATION) {
+    FreePool (Image);
+    return 1;
+  }
+
   Status = LLVMFuzzerTestOneInput (Image, ImageSize);
   FreePool (Image);
   if (EFI_ERROR (Status)) {
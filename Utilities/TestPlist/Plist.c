@@ -0,0 +1,157 @@
+/** @file
+  Check that plist data decoded in place matches Base64Decode for valid,
+  padded and whitespace separated inputs, and that both reject invalid ones.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/OcXmlLib.h>
+#include <Library/PrintLib.h>
+
+typedef struct {
+  CONST CHAR8    *Name;
+  CONST CHAR8    *Data;
+  BOOLEAN        Valid;
+} PLIST_DATA_SAMPLE;
+
+STATIC CONST PLIST_DATA_SAMPLE  mPlistDataSamples[] = {
+  {
+    "Empty",
+    "",
+    TRUE
+  },
+  {
+    "Unpadded",
+    "SGVsbG8gd29ybGQh",
+    TRUE
+  },
+  {
+    "Single padding",
+    "SGVsbG8gd29ybGQ=",
+    TRUE
+  },
+  {
+    "Double padding",
+    "SGVsbG8gd29ybA==",
+    TRUE
+  },
+  {
+    "Full alphabet",
+    "++//Pr/+ABA=",
+    TRUE
+  },
+  {
+    "Spaces",
+    "SGVs bG8g d29y bA==",
+    TRUE
+  },
+  {
+    "Line breaks",
+    "\n\t\tAAECAwQFBgcICQoLDA0ODxAREhMU"
+    "\n\t\tFRYXGBkaGxwdHh8gISIjJCUmJygp"
+    "\r\n\t\tKissLS4v\n\t",
+    TRUE
+  },
+  {
+    "Invalid character",
+    "SGVs!G8gd29ybGQh",
+    FALSE
+  },
+  {
+    "Extra padding",
+    "SGVsbG8gd29yb===",
+    FALSE
+  },
+  {
+    "Data after padding",
+    "SGVsbG8=d29ybGQh",
+    FALSE
+  }
+};
+
+/**
+  Decode one sample with PlistDataValue and PlistDataValueInPlace.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+TestPlistDataSample (
+  IN CONST PLIST_DATA_SAMPLE  *Sample
+  )
+{
+  CHAR8         Plist[256];
+  UINT8         Expected[128];
+  UINT32        ExpectedSize;
+  BOOLEAN       ExpectedResult;
+  UINT8         *Data;
+  UINT32        DataSize;
+  BOOLEAN       DataResult;
+  XML_DOCUMENT  *Document;
+  XML_NODE      *Node;
+  BOOLEAN       Result;
+
+  AsciiSPrint (Plist, sizeof (Plist), "<plist version=\"1.0\"><data>%a</data></plist>", Sample->Data);
+
+  Document = XmlDocumentParse (Plist, (UINT32)AsciiStrLen (Plist), FALSE);
+  if (Document == NULL) {
+    DEBUG ((DEBUG_ERROR, "PLIST: %a - failed to parse\n", Sample->Name));
+    return FALSE;
+  }
+
+  Node = PlistDocumentRoot (Document);
+
+  //
+  // Decode with Base64Decode first, in place decoding overwrites the content.
+  //
+  ExpectedSize   = sizeof (Expected);
+  ExpectedResult = PlistDataValue (Node, Expected, &ExpectedSize);
+  DataResult     = PlistDataValueInPlace (Node, &Data, &DataSize);
+
+  Result = (ExpectedResult == Sample->Valid) && (DataResult == Sample->Valid);
+  if (Result && Sample->Valid) {
+    Result = (ExpectedSize == DataSize)
+             && ((DataSize == 0) || (CompareMem (Data, Expected, DataSize) == 0));
+  }
+
+  XmlDocumentFree (Document);
+
+  DEBUG ((
+    Result ? DEBUG_VERBOSE : DEBUG_ERROR,
+    "PLIST: %a %u bytes - %a\n",
+    Sample->Name,
+    DataSize,
+    Result ? "passed" : "FAILED"
+    ));
+
+  return Result;
+}
+
+int
+ENTRY_POINT (
+  int   argc,
+  char  *argv[]
+  )
+{
+  UINTN    Index;
+  BOOLEAN  Result;
+
+  Result = TRUE;
+
+  for (Index = 0; Index < ARRAY_SIZE (mPlistDataSamples); ++Index) {
+    Result = TestPlistDataSample (&mPlistDataSamples[Index]) && Result;
+  }
+
+  DEBUG ((
+    DEBUG_ERROR,
+    "PLIST: %u samples - %a\n",
+    (UINT32)ARRAY_SIZE (mPlistDataSamples),
+    Result ? "passed" : "FAILED"
+    ));
+
+  return Result ? 0 : -1;
+}
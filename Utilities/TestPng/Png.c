@@ -0,0 +1,404 @@
+/** @file
+  Copyright (c) 2026, Acidanthera. All rights reserved.
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcPngLib.h>
+
+#include <UserFile.h>
+#include <UserTime.h>
+
+#include <stdlib.h>
+
+/**
+  Decode PNG image the way OpenCanopy did before OcDecodePngBgra,
+  with lodepng RGBA output converted in a separate pass.
+**/
+STATIC
+EFI_STATUS
+DecodePngTwoPass (
+  IN  VOID     *Buffer,
+  IN  UINTN    Size,
+  IN  BOOLEAN  Premultiply,
+  OUT UINT8    **RawData,
+  OUT UINT32   *Width,
+  OUT UINT32   *Height
+  )
+{
+  EFI_STATUS  Status;
+  UINT8       *Pixel;
+  UINTN       Index;
+  UINT8       Red;
+
+  Status = OcDecodePng (Buffer, Size, (VOID **)RawData, Width, Height, NULL);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Pixel = *RawData;
+  for (Index = 0; Index < (UINTN)*Width * *Height; ++Index) {
+    Red = Pixel[0];
+    if (Premultiply) {
+      Pixel[0] = (UINT8)((Pixel[2] * Pixel[3]) / 0xFF);
+      Pixel[1] = (UINT8)((Pixel[1] * Pixel[3]) / 0xFF);
+      Pixel[2] = (UINT8)((Red * Pixel[3]) / 0xFF);
+    } else {
+      Pixel[0] = Pixel[2];
+      Pixel[2] = Red;
+    }
+
+    Pixel += 4;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Check that single pass decoding with and without SIMD kernels
+  matches two pass decoding.
+
+  @param[in]  Path  PNG image path.
+
+  @retval 0 on success.
+**/
+STATIC
+int
+VerifyPng (
+  IN CONST CHAR8  *Path
+  )
+{
+  UINT8       *Png;
+  UINT32      PngSize;
+  UINT8       *Expected;
+  UINT8       *Actual;
+  UINT32      Width;
+  UINT32      Height;
+  UINT32      ActualWidth;
+  UINT32      ActualHeight;
+  EFI_STATUS  Status;
+  UINT32      Premultiply;
+  UINT32      Simd;
+  int         Result;
+
+  if ((Png = UserReadFile (Path, &PngSize)) == NULL) {
+    DEBUG ((DEBUG_ERROR, "Read fail\n"));
+    return -1;
+  }
+
+  Result = 0;
+  for (Premultiply = 0; Premultiply < 2; ++Premultiply) {
+    Status = DecodePngTwoPass (Png, PngSize, Premultiply != 0, &Expected, &Width, &Height);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "%a: decode failure - %r\n", Path, Status));
+      Result = -1;
+      break;
+    }
+
+    for (Simd = 0; Simd < 2; ++Simd) {
+      InternalPngSetSimd (Simd != 0);
+      Status = OcDecodePngBgra (Png, PngSize, Premultiply != 0, (VOID **)&Actual, &ActualWidth, &ActualHeight);
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: BGRA decode failure (simd %u) - %r\n", Path, Simd, Status));
+        Result = -1;
+        continue;
+      }
+
+      if (  (Width != ActualWidth)
+         || (Height != ActualHeight)
+         || (CompareMem (Expected, Actual, (UINTN)Width * Height * sizeof (UINT32)) != 0))
+      {
+        DEBUG ((DEBUG_ERROR, "%a: BGRA decode mismatch (premultiply %u, simd %u)\n", Path, Premultiply, Simd));
+        Result = -1;
+      }
+
+      FreePool (Actual);
+    }
+
+    FreePool (Expected);
+  }
+
+  InternalPngSetSimd (TRUE);
+
+  if (Result == 0) {
+    DEBUG ((DEBUG_ERROR, "%a: %ux%u OK\n", Path, Width, Height));
+  }
+
+  FreePool (Png);
+  return Result;
+}
+
+/**
+  Measure two pass and single pass PNG decoding throughput,
+  the latter with and without SIMD kernels.
+
+  @param[in]  Path        PNG image path.
+  @param[in]  Iterations  Number of decodes.
+
+  @retval 0 on success.
+**/
+STATIC
+int
+BenchmarkPng (
+  IN CONST CHAR8  *Path,
+  IN UINT32       Iterations
+  )
+{
+  UINT8       *Png;
+  UINT32      PngSize;
+  UINT8       *Pixels;
+  UINT32      Width;
+  UINT32      Height;
+  UINT32      Index;
+  UINT64      Start;
+  EFI_STATUS  Status;
+
+  if ((Png = UserReadFile (Path, &PngSize)) == NULL) {
+    DEBUG ((DEBUG_ERROR, "Read fail\n"));
+    return -1;
+  }
+
+  Width  = 0;
+  Height = 0;
+  Status = EFI_SUCCESS;
+
+  Start = GetCurrentTimestampUs ();
+  for (Index = 0; Index < Iterations && !EFI_ERROR (Status); ++Index) {
+    Status = DecodePngTwoPass (Png, PngSize, TRUE, &Pixels, &Width, &Height);
+    if (!EFI_ERROR (Status)) {
+      FreePool (Pixels);
+    }
+  }
+
+  if (!EFI_ERROR (Status)) {
+    PrintThroughput ("Two pass", MultU64x32 ((UINT64)Width * Height, Iterations), "px", GetCurrentTimestampUs () - Start);
+  }
+
+  Start = GetCurrentTimestampUs ();
+  for (Index = 0; Index < Iterations && !EFI_ERROR (Status); ++Index) {
+    Status = OcDecodePngBgra (Png, PngSize, TRUE, (VOID **)&Pixels, &Width, &Height);
+    if (!EFI_ERROR (Status)) {
+      FreePool (Pixels);
+    }
+  }
+
+  if (!EFI_ERROR (Status)) {
+    PrintThroughput ("Single pass", MultU64x32 ((UINT64)Width * Height, Iterations), "px", GetCurrentTimestampUs () - Start);
+  }
+
+  InternalPngSetSimd (FALSE);
+
+  Start = GetCurrentTimestampUs ();
+  for (Index = 0; Index < Iterations && !EFI_ERROR (Status); ++Index) {
+    Status = OcDecodePngBgra (Png, PngSize, TRUE, (VOID **)&Pixels, &Width, &Height);
+    if (!EFI_ERROR (Status)) {
+      FreePool (Pixels);
+    }
+  }
+
+  if (!EFI_ERROR (Status)) {
+    PrintThroughput ("Single pass without SIMD", MultU64x32 ((UINT64)Width * Height, Iterations), "px", GetCurrentTimestampUs () - Start);
+  }
+
+  InternalPngSetSimd (TRUE);
+
+  FreePool (Png);
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Decode failure - %r\n", Status));
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+  Measure full and incremental PNG encoding speed and size.
+
+  @param[in]  Path        PNG image path used as the source picture.
+  @param[in]  Iterations  Number of encodes.
+
+  @retval 0 on success.
+**/
+STATIC
+int
+BenchmarkPngEncode (
+  IN CONST CHAR8  *Path,
+  IN UINT32       Iterations
+  )
+{
+  UINT8           *Png;
+  UINT32          PngSize;
+  UINT8           *Pixels;
+  UINT8           *Rgba;
+  UINT8           *Decoded;
+  UINT32          Width;
+  UINT32          Height;
+  UINT32          DecodedWidth;
+  UINT32          DecodedHeight;
+  UINTN           Index;
+  UINT32          Iteration;
+  UINT64          Start;
+  VOID            *Output;
+  UINTN           OutputSize;
+  OC_PNG_ENCODER  *Encoder;
+  EFI_STATUS      Status;
+
+  if ((Png = UserReadFile (Path, &PngSize)) == NULL) {
+    DEBUG ((DEBUG_ERROR, "Read fail\n"));
+    return -1;
+  }
+
+  Status = OcDecodePngBgra (Png, PngSize, FALSE, (VOID **)&Pixels, &Width, &Height);
+  FreePool (Png);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Decode failure - %r\n", Status));
+    return -1;
+  }
+
+  Rgba = AllocatePool ((UINTN)Width * Height * sizeof (UINT32));
+  if (Rgba == NULL) {
+    FreePool (Pixels);
+    return -1;
+  }
+
+  //
+  // Full encoder expects RGBA, as CrScreenshotDxe used to pass it.
+  //
+  for (Index = 0; Index < (UINTN)Width * Height; ++Index) {
+    Rgba[Index * 4]     = Pixels[Index * 4 + 2];
+    Rgba[Index * 4 + 1] = Pixels[Index * 4 + 1];
+    Rgba[Index * 4 + 2] = Pixels[Index * 4];
+    Rgba[Index * 4 + 3] = 0xFF;
+  }
+
+  OutputSize = 0;
+  Start      = GetCurrentTimestampUs ();
+  for (Iteration = 0; Iteration < Iterations && !EFI_ERROR (Status); ++Iteration) {
+    Status = OcEncodePng (Rgba, Width, Height, &Output, &OutputSize);
+    if (!EFI_ERROR (Status)) {
+      FreePool (Output);
+    }
+  }
+
+  if (!EFI_ERROR (Status)) {
+    PrintThroughput ("Full encode", MultU64x32 ((UINT64)Width * Height, Iterations), "px", GetCurrentTimestampUs () - Start);
+    DEBUG ((DEBUG_ERROR, "Full encode: %Lu bytes\n", (UINT64)OutputSize));
+  }
+
+  Output = NULL;
+  Start  = GetCurrentTimestampUs ();
+  for (Iteration = 0; Iteration < Iterations && !EFI_ERROR (Status); ++Iteration) {
+    if (Output != NULL) {
+      FreePool (Output);
+    }
+
+    Status = OcPngEncoderCreate (Pixels, Width, Height, 16, &Encoder);
+    if (!EFI_ERROR (Status)) {
+      do {
+        Status = OcPngEncoderStep (Encoder, &Output, &OutputSize);
+      } while (Status == EFI_NOT_READY);
+
+      OcPngEncoderFree (Encoder);
+    }
+  }
+
+  if (!EFI_ERROR (Status)) {
+    PrintThroughput ("Incremental encode", MultU64x32 ((UINT64)Width * Height, Iterations), "px", GetCurrentTimestampUs () - Start);
+    DEBUG ((DEBUG_ERROR, "Incremental encode: %Lu bytes\n", (UINT64)OutputSize));
+
+    //
+    // Incremental encoder drops alpha, compare colour only.
+    //
+    Status = OcDecodePngBgra (Output, OutputSize, FALSE, (VOID **)&Decoded, &DecodedWidth, &DecodedHeight);
+    if (!EFI_ERROR (Status)) {
+      if ((DecodedWidth != Width) || (DecodedHeight != Height)) {
+        Status = EFI_COMPROMISED_DATA;
+      }
+
+      for (Index = 0; Index < (UINTN)Width * Height && !EFI_ERROR (Status); ++Index) {
+        if (CompareMem (&Decoded[Index * 4], &Pixels[Index * 4], 3) != 0) {
+          Status = EFI_COMPROMISED_DATA;
+        }
+      }
+
+      FreePool (Decoded);
+    }
+
+    FreePool (Output);
+  }
+
+  FreePool (Rgba);
+  FreePool (Pixels);
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Encode failure - %r\n", Status));
+    return -1;
+  }
+
+  return 0;
+}
+
+int
+ENTRY_POINT (
+  int   argc,
+  char  *argv[]
+  )
+{
+  int  Index;
+  int  Result;
+
+  if (argc < 2) {
+    DEBUG ((DEBUG_ERROR, "Usage: %a <png>... | -b <png> [iterations] | -e <png> [iterations]\n", argv[0]));
+    return -1;
+  }
+
+  if (AsciiStrCmp (argv[1], "-e") == 0) {
+    if (argc < 3) {
+      DEBUG ((DEBUG_ERROR, "Usage: %a -e <png> [iterations]\n", argv[0]));
+      return -1;
+    }
+
+    return BenchmarkPngEncode (argv[2], argc > 3 ? MAX ((UINT32)atoi (argv[3]), 1) : 10);
+  }
+
+  if (AsciiStrCmp (argv[1], "-b") == 0) {
+    if (argc < 3) {
+      DEBUG ((DEBUG_ERROR, "Usage: %a -b <png> [iterations]\n", argv[0]));
+      return -1;
+    }
+
+    return BenchmarkPng (argv[2], argc > 3 ? MAX ((UINT32)atoi (argv[3]), 1) : 100);
+  }
+
+  Result = 0;
+  for (Index = 1; Index < argc; ++Index) {
+    if (VerifyPng (argv[Index]) != 0) {
+      Result = -1;
+    }
+  }
+
+  return Result;
+}
+
+int
+LLVMFuzzerTestOneInput (
+  const uint8_t  *Data,
+  size_t         Size
+  )
+{
+  VOID        *Pixels;
+  UINT32      Width;
+  UINT32      Height;
+  EFI_STATUS  Status;
+
+  Status = OcDecodePngBgra ((VOID *)Data, Size, TRUE, &Pixels, &Width, &Height);
+  if (!EFI_ERROR (Status)) {
+    FreePool (Pixels);
+  }
+
+  return 0;
+}
@@ -24,6 +24,7 @@
 #include <Library/OcMainLib.h>
 
 #include <UserFile.h>
+#include <UserParallel.h>
 
 #define  OC_USER_FULL_PATH_MAX_SIZE  256
 
@@ -334,17 +335,26 @@ WrapMain (
   UINT32   NewPrelinkedSize;
   UINT8    Sha384[48];
   BOOLEAN  Is32Bit;
+  UINT32   FixupWorkers;
+  UINT8    *CheckPrelinked;
+  UINT32   CheckPrelinkedSize;
 
   OC_CPU_INFO  DummyCpuInfo;
 
   OC_KERNEL_ADD_ENTRY  *Kext;
 
   if (argc < 2) {
-    DEBUG ((DEBUG_ERROR, "Usage: %a <path/to/OC/folder/> [path/to/kernel]\n\n", argv[0]));
+    DEBUG ((DEBUG_ERROR, "Usage: %a <path/to/OC/folder/> [path/to/kernel] [fixup workers]\n\n", argv[0]));
     return -1;
   }
 
   FileName = argc > 2 ? argv[2] : "/System/Library/PrelinkedKernels/prelinkedkernel";
+  //
+  // Process the kernel a second time with KC fixups of injected kexts indexed
+  // on this many workers, and compare the results. 1 disables the check.
+  //
+  FixupWorkers = argc > 3 ? (UINT32)AsciiStrDecimalToUintn (argv[3]) : 4;
+
   if ((mPrelinked = UserReadFile (FileName, &mPrelinkedSize)) == NULL) {
     DEBUG ((DEBUG_ERROR, "Read fail %a\n", FileName));
     return -1;
@@ -472,6 +482,18 @@ WrapMain (
     NewPrelinked,
     NewPrelinkedSize
     );
+
+  CheckPrelinked     = NULL;
+  CheckPrelinkedSize = NewPrelinkedSize;
+  if (FixupWorkers > 1) {
+    CheckPrelinked = AllocateCopyPool (AllocSize, NewPrelinked);
+    if (CheckPrelinked == NULL) {
+      FailedToProcess = TRUE;
+      return -1;
+    }
+  }
+
+  SetParallelWorkerCount (1);
   PrelinkedStatus = OcKernelProcessPrelinked (
                       &Config,
                       KernelVersion,
@@ -490,6 +512,31 @@ WrapMain (
 
   DEBUG ((DEBUG_INFO, "OC: Prelinked status - %r\n", PrelinkedStatus));
 
+  if (CheckPrelinked != NULL) {
+    SetParallelWorkerCount (FixupWorkers);
+    PrelinkedStatus = OcKernelProcessPrelinked (
+                        &Config,
+                        KernelVersion,
+                        FALSE,
+                        CheckPrelinked,
+                        &CheckPrelinkedSize,
+                        AllocSize,
+                        LinkedExpansion,
+                        ReservedExeSize
+                        );
+    if (  EFI_ERROR (PrelinkedStatus)
+       || (CheckPrelinkedSize != NewPrelinkedSize)
+       || (CompareMem (CheckPrelinked, NewPrelinked, NewPrelinkedSize) != 0))
+    {
+      DEBUG ((DEBUG_WARN, "[FAIL] Kernel differs with %u fixup workers - %r\n", FixupWorkers, PrelinkedStatus));
+      FailedToProcess = TRUE;
+    } else {
+      DEBUG ((DEBUG_WARN, "[OK] Kernel matches with %u fixup workers\n", FixupWorkers));
+    }
+
+    FreePool (CheckPrelinked);
+  }
+
   UserWriteFile ("out.bin", NewPrelinked, NewPrelinkedSize);
 
   FreePool (mPrelinked);
@@ -13,6 +13,7 @@
 **/
 
 #include <Library/DebugLib.h>
+#include <Library/OcTraceLib.h>
 
 VOID
 OcAppleImg4RegisterOverride (
@@ -23,3 +24,10 @@ OcAppleImg4RegisterOverride (
 {
   ASSERT (FALSE);
 }
+
+VOID
+OcTraceExportFile (
+  IN OC_TRACE_MILESTONE  Milestone
+  )
+{
+}
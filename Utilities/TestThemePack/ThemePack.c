@@ -0,0 +1,275 @@
+/** @file
+  Check that GuiThemePackValidate rejects truncated and malformed theme
+  packs, and that GuiThemePackGetImage ignores entries with stale sources.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Uefi.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcCompressionLib.h>
+
+#include "OpenCanopy.h"
+#include "ThemePack.h"
+
+#define TEST_IMAGE_WIDTH   2U
+#define TEST_IMAGE_HEIGHT  3U
+#define TEST_IMAGE_SIZE    (TEST_IMAGE_WIDTH * TEST_IMAGE_HEIGHT * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL))
+#define TEST_NUM_ENTRIES   2U
+#define TEST_TOC_SIZE      ALIGN_VALUE (sizeof (GUI_THEME_PACK_HEADER) + TEST_NUM_ENTRIES * sizeof (GUI_THEME_PACK_ENTRY), GUI_THEME_PACK_ALIGNMENT)
+#define TEST_PACK_SIZE     (TEST_TOC_SIZE + TEST_NUM_ENTRIES * ALIGN_VALUE (TEST_IMAGE_SIZE, GUI_THEME_PACK_ALIGNMENT))
+
+STATIC CONST UINT8  mSource[] = "Theme image source file";
+
+/**
+  Build a valid pack with two images at scale 1.
+
+  @param[out] Pack  Buffer of TEST_PACK_SIZE bytes.
+
+  @retval Entries of the built pack.
+**/
+STATIC
+GUI_THEME_PACK_ENTRY *
+BuildPack (
+  OUT UINT8  *Pack
+  )
+{
+  GUI_THEME_PACK_HEADER  *Header;
+  GUI_THEME_PACK_ENTRY   *Entries;
+  UINT32                 Index;
+
+  ZeroMem (Pack, TEST_PACK_SIZE);
+
+  Header             = (GUI_THEME_PACK_HEADER *)Pack;
+  Header->Signature  = GUI_THEME_PACK_SIGNATURE;
+  Header->Version    = GUI_THEME_PACK_VERSION;
+  Header->Scale      = 1;
+  Header->NumEntries = TEST_NUM_ENTRIES;
+
+  Entries = (GUI_THEME_PACK_ENTRY *)(Header + 1);
+  for (Index = 0; Index < TEST_NUM_ENTRIES; ++Index) {
+    AsciiStrCpyS (Entries[Index].Name, sizeof (Entries[Index].Name), Index == 0 ? "HardDrive" : "ExtHardDrive");
+    Entries[Index].Width          = TEST_IMAGE_WIDTH;
+    Entries[Index].Height         = TEST_IMAGE_HEIGHT;
+    Entries[Index].Flags          = GUI_THEME_PACK_PREMULTIPLIED;
+    Entries[Index].Offset         = TEST_TOC_SIZE + Index * ALIGN_VALUE (TEST_IMAGE_SIZE, GUI_THEME_PACK_ALIGNMENT);
+    Entries[Index].SourceSize     = sizeof (mSource);
+    Entries[Index].SourceChecksum = Adler32 (mSource, sizeof (mSource));
+    SetMem (Pack + Entries[Index].Offset, TEST_IMAGE_SIZE, (UINT8)(Index + 1));
+  }
+
+  return Entries;
+}
+
+/**
+  Report a single check.
+
+  @retval Result.
+**/
+STATIC
+BOOLEAN
+CheckResult (
+  IN CONST CHAR8  *Name,
+  IN EFI_STATUS   Status,
+  IN EFI_STATUS   Expected
+  )
+{
+  BOOLEAN  Result;
+
+  Result = Status == Expected;
+  DEBUG ((
+    Result ? DEBUG_VERBOSE : DEBUG_ERROR,
+    "TP: %a - %r, expected %r - %a\n",
+    Name,
+    Status,
+    Expected,
+    Result ? "passed" : "FAILED"
+    ));
+  return Result;
+}
+
+/**
+  Validate every truncation of a valid pack.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+TestTruncated (
+  VOID
+  )
+{
+  UINT8                 Pack[TEST_PACK_SIZE];
+  GUI_THEME_PACK_ENTRY  *Entries;
+  UINT32                PackEnd;
+  UINT32                Size;
+  UINT32                Accepted;
+  UINT32                Rejected;
+  BOOLEAN               Result;
+
+  Entries = BuildPack (Pack);
+  PackEnd = Entries[TEST_NUM_ENTRIES - 1].Offset + TEST_IMAGE_SIZE;
+
+  Accepted = 0;
+  Rejected = 0;
+  for (Size = 0; Size <= TEST_PACK_SIZE; ++Size) {
+    if (EFI_ERROR (GuiThemePackValidate (Pack, Size, 1))) {
+      ++Rejected;
+    } else if (Size < PackEnd) {
+      ++Accepted;
+    }
+  }
+
+  Result = Accepted == 0 && Rejected == PackEnd;
+  DEBUG ((
+    Result ? DEBUG_VERBOSE : DEBUG_ERROR,
+    "TP: Truncated packs - %u of %u accepted, %u rejected - %a\n",
+    Accepted,
+    PackEnd,
+    Rejected,
+    Result ? "passed" : "FAILED"
+    ));
+  return Result;
+}
+
+/**
+  Validate packs with corrupted headers and entries.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+TestMalformed (
+  VOID
+  )
+{
+  UINT8                  Pack[TEST_PACK_SIZE];
+  GUI_THEME_PACK_HEADER  *Header;
+  GUI_THEME_PACK_ENTRY   *Entries;
+  BOOLEAN                Result;
+
+  Header = (GUI_THEME_PACK_HEADER *)Pack;
+
+  Entries = BuildPack (Pack);
+  Result  = CheckResult ("Valid pack", GuiThemePackValidate (Pack, TEST_PACK_SIZE, 1), EFI_SUCCESS);
+
+  Entries[1].Offset = Entries[0].Offset + GUI_THEME_PACK_ALIGNMENT;
+  Result            = CheckResult ("Overlapping offsets", GuiThemePackValidate (Pack, TEST_PACK_SIZE, 1), EFI_SECURITY_VIOLATION) && Result;
+
+  Entries           = BuildPack (Pack);
+  Entries[1].Offset = Entries[0].Offset;
+  Result            = CheckResult ("Shared offsets", GuiThemePackValidate (Pack, TEST_PACK_SIZE, 1), EFI_SECURITY_VIOLATION) && Result;
+
+  Entries           = BuildPack (Pack);
+  Entries[0].Offset = Entries[1].Offset;
+  Entries[1].Offset = TEST_TOC_SIZE;
+  Result            = CheckResult ("Unsorted offsets", GuiThemePackValidate (Pack, TEST_PACK_SIZE, 1), EFI_SECURITY_VIOLATION) && Result;
+
+  Entries           = BuildPack (Pack);
+  Entries[0].Offset = TEST_TOC_SIZE - GUI_THEME_PACK_ALIGNMENT;
+  Result            = CheckResult ("Offset in table", GuiThemePackValidate (Pack, TEST_PACK_SIZE, 1), EFI_SECURITY_VIOLATION) && Result;
+
+  Entries           = BuildPack (Pack);
+  Entries[1].Offset = Entries[1].Offset + 4;
+  Result            = CheckResult ("Unaligned offset", GuiThemePackValidate (Pack, TEST_PACK_SIZE, 1), EFI_SECURITY_VIOLATION) && Result;
+
+  Entries          = BuildPack (Pack);
+  Entries[1].Width = MAX_UINT32;
+  Result           = CheckResult ("Huge image", GuiThemePackValidate (Pack, TEST_PACK_SIZE, 1), EFI_SECURITY_VIOLATION) && Result;
+
+  Entries = BuildPack (Pack);
+  SetMem (Entries[0].Name, sizeof (Entries[0].Name), 'A');
+  Result = CheckResult ("Unterminated name", GuiThemePackValidate (Pack, TEST_PACK_SIZE, 1), EFI_SECURITY_VIOLATION) && Result;
+
+  BuildPack (Pack);
+  Header->NumEntries = MAX_UINT32;
+  Result             = CheckResult ("Huge table", GuiThemePackValidate (Pack, TEST_PACK_SIZE, 1), EFI_SECURITY_VIOLATION) && Result;
+
+  BuildPack (Pack);
+  Header->Version = GUI_THEME_PACK_VERSION - 1;
+  Result          = CheckResult ("Old version", GuiThemePackValidate (Pack, TEST_PACK_SIZE, 1), EFI_UNSUPPORTED) && Result;
+
+  BuildPack (Pack);
+  Result = CheckResult ("Wrong scale", GuiThemePackValidate (Pack, TEST_PACK_SIZE, 2), EFI_UNSUPPORTED) && Result;
+
+  return Result;
+}
+
+/**
+  Look up images with current, changed and missing sources.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+TestSource (
+  VOID
+  )
+{
+  UINT8      Pack[TEST_PACK_SIZE];
+  UINT8      Changed[sizeof (mSource)];
+  GUI_IMAGE  Image;
+  BOOLEAN    Result;
+
+  BuildPack (Pack);
+  CopyMem (Changed, mSource, sizeof (Changed));
+  Changed[0] ^= 1;
+
+  Result = CheckResult (
+             "Current source",
+             GuiThemePackGetImage (&Image, Pack, "ExtHardDrive", mSource, sizeof (mSource), 1, 0, 0, FALSE, TRUE),
+             EFI_SUCCESS
+             );
+  Result = Result
+           && Image.Width == TEST_IMAGE_WIDTH
+           && Image.Height == TEST_IMAGE_HEIGHT
+           && (UINT8 *)Image.Buffer == Pack + TEST_TOC_SIZE + ALIGN_VALUE (TEST_IMAGE_SIZE, GUI_THEME_PACK_ALIGNMENT);
+
+  Result = CheckResult (
+             "Changed source",
+             GuiThemePackGetImage (&Image, Pack, "HardDrive", Changed, sizeof (Changed), 1, 0, 0, FALSE, TRUE),
+             EFI_UNSUPPORTED
+             ) && Result;
+
+  Result = CheckResult (
+             "Resized source",
+             GuiThemePackGetImage (&Image, Pack, "HardDrive", mSource, sizeof (mSource) - 1, 1, 0, 0, FALSE, TRUE),
+             EFI_UNSUPPORTED
+             ) && Result;
+
+  Result = CheckResult (
+             "Missing source",
+             GuiThemePackGetImage (&Image, Pack, "HardDrive", NULL, 0, 1, 0, 0, FALSE, TRUE),
+             EFI_UNSUPPORTED
+             ) && Result;
+
+  Result = CheckResult (
+             "Missing image",
+             GuiThemePackGetImage (&Image, Pack, "Tool", mSource, sizeof (mSource), 1, 0, 0, FALSE, TRUE),
+             EFI_NOT_FOUND
+             ) && Result;
+
+  return Result;
+}
+
+int
+ENTRY_POINT (
+  int   argc,
+  char  *argv[]
+  )
+{
+  BOOLEAN  Result;
+
+  Result = TestTruncated ();
+  Result = TestMalformed () && Result;
+  Result = TestSource () && Result;
+
+  DEBUG ((DEBUG_ERROR, "TP: Theme pack checks - %a\n", Result ? "passed" : "FAILED"));
+
+  return Result ? 0 : -1;
+}
@@ -0,0 +1,259 @@
+/** @file
+  Check trace formatting with nested and open spans, ring wrap,
+  and truncation to every buffer size.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcTraceLib.h>
+
+#include <UserTime.h>
+
+//
+// TraceTestReadTsc counts microseconds.
+//
+#define TRACE_TEST_FREQUENCY  1000000ULL
+
+#define TRACE_TEST_BUFFER_SIZE  BASE_64KB
+#define TRACE_TEST_GUARD_SIZE   64U
+#define TRACE_TEST_GUARD        0xA5U
+
+STATIC CONST CHAR8  mJsonHeader[] = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+STATIC CONST CHAR8  mJsonFooter[] = "\n]}\n";
+
+STATIC CHAR8  mBuffer[TRACE_TEST_BUFFER_SIZE + TRACE_TEST_GUARD_SIZE];
+
+/**
+  Replaces AsmReadTsc in OcTraceLib, which always returns 0 in userspace,
+  so that finished spans get non-zero and ordered timestamps.
+**/
+UINT64
+EFIAPI
+TraceTestReadTsc (
+  VOID
+  )
+{
+  return (UINT64)GetCurrentTimestampUs ();
+}
+
+STATIC
+UINTN
+CountSubstrings (
+  IN CONST CHAR8  *String,
+  IN CONST CHAR8  *Substring
+  )
+{
+  UINTN  Count;
+
+  Count = 0;
+  while ((String = AsciiStrStr (String, Substring)) != NULL) {
+    ++Count;
+    String += AsciiStrLen (Substring);
+  }
+
+  return Count;
+}
+
+/**
+  Format into a buffer of given size, surrounded by guard bytes.
+
+  @retval TRUE when the result is consistent and nothing was overwritten.
+**/
+STATIC
+BOOLEAN
+FormatGuarded (
+  IN  BOOLEAN  Json,
+  IN  UINTN    BufferSize,
+  OUT UINTN    *Size
+  )
+{
+  UINTN  Index;
+
+  ASSERT (BufferSize <= TRACE_TEST_BUFFER_SIZE);
+
+  SetMem (mBuffer, sizeof (mBuffer), TRACE_TEST_GUARD);
+
+  if (Json) {
+    *Size = OcTraceFormatJson (mBuffer, BufferSize, TRACE_TEST_FREQUENCY);
+  } else {
+    *Size = OcTraceFormatSummary (mBuffer, BufferSize, TRACE_TEST_FREQUENCY);
+  }
+
+  for (Index = BufferSize; Index < BufferSize + TRACE_TEST_GUARD_SIZE; ++Index) {
+    if ((UINT8)mBuffer[Index] != TRACE_TEST_GUARD) {
+      DEBUG ((DEBUG_ERROR, "TRC: %a overflow at %u of %u\n", Json ? "JSON" : "Summary", (UINT32)Index, (UINT32)BufferSize));
+      return FALSE;
+    }
+  }
+
+  if (BufferSize == 0) {
+    return *Size == 0;
+  }
+
+  if ((*Size >= BufferSize) || (AsciiStrLen (mBuffer) != *Size)) {
+    DEBUG ((DEBUG_ERROR, "TRC: %a size %u is wrong for %u\n", Json ? "JSON" : "Summary", (UINT32)*Size, (UINT32)BufferSize));
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+  Check that JSON has the header, the footer, and only whole events.
+**/
+STATIC
+BOOLEAN
+IsJsonComplete (
+  IN CONST CHAR8  *Json,
+  IN UINTN        Size
+  )
+{
+  return Size >= L_STR_LEN (mJsonHeader) + L_STR_LEN (mJsonFooter)
+         && AsciiStrnCmp (Json, mJsonHeader, L_STR_LEN (mJsonHeader)) == 0
+         && AsciiStrCmp (&Json[Size - L_STR_LEN (mJsonFooter)], mJsonFooter) == 0
+         && CountSubstrings (Json, "{") == CountSubstrings (Json, "}")
+         && CountSubstrings (Json, "\n{\"name\"") == CountSubstrings (Json, "\"tid\":1,\"ts\":");
+}
+
+STATIC
+BOOLEAN
+TestNested (
+  VOID
+  )
+{
+  OC_TRACE_ID  Outer;
+  OC_TRACE_ID  Inner;
+  OC_TRACE_ID  Open;
+  UINTN        Size;
+  BOOLEAN      Result;
+
+  Outer = OcTraceBegin ("Outer");
+  Inner = OcTraceBegin ("Inner");
+  OcTraceEnd (Inner);
+  OcTraceEnd (Outer);
+  Open = OcTraceBegin ("Open");
+
+  Result = FormatGuarded (TRUE, TRACE_TEST_BUFFER_SIZE, &Size)
+           && IsJsonComplete (mBuffer, Size)
+           && CountSubstrings (mBuffer, "\"ph\":\"X\"") == 2
+           && CountSubstrings (mBuffer, "\"ph\":\"B\"") == 1
+           && AsciiStrStr (mBuffer, "\"name\":\"Open\",\"cat\":\"OC\",\"ph\":\"B\"") != NULL;
+
+  Result = Result
+           && FormatGuarded (FALSE, OC_TRACE_SUMMARY_SIZE, &Size)
+           && AsciiStrnCmp (mBuffer, "Outer=", L_STR_LEN ("Outer=")) == 0
+           && AsciiStrStr (mBuffer, ";+Inner=") != NULL
+           && AsciiStrStr (mBuffer, "Open") == NULL;
+
+  OcTraceEnd (Open);
+
+  DEBUG ((DEBUG_ERROR, "TRC: Nested spans - %a\n", Result ? "passed" : "FAILED"));
+  return Result;
+}
+
+STATIC
+BOOLEAN
+TestWrap (
+  VOID
+  )
+{
+  OC_TRACE_ID  Id;
+  UINT32       Index;
+  UINTN        Size;
+  BOOLEAN      Result;
+
+  for (Index = 0; Index < OC_TRACE_MAX_EVENTS * 3 + 7; ++Index) {
+    Id = OcTraceBegin ((Index & 1) != 0 ? "Odd" : "Even");
+    OcTraceEnd (Id);
+  }
+
+  //
+  // Only the newest spans remain, and the summary is truncated.
+  //
+  Result = FormatGuarded (TRUE, TRACE_TEST_BUFFER_SIZE, &Size)
+           && IsJsonComplete (mBuffer, Size)
+           && CountSubstrings (mBuffer, "\"ph\":\"X\"") == OC_TRACE_MAX_EVENTS
+           && AsciiStrStr (mBuffer, "Outer") == NULL;
+
+  Result = Result
+           && FormatGuarded (FALSE, OC_TRACE_SUMMARY_SIZE, &Size)
+           && Size > OC_TRACE_SUMMARY_SIZE / 2
+           && mBuffer[Size - 1] == ';'
+           && CountSubstrings (mBuffer, "=") == CountSubstrings (mBuffer, ";");
+
+  DEBUG ((DEBUG_ERROR, "TRC: Ring wrap - %a\n", Result ? "passed" : "FAILED"));
+  return Result;
+}
+
+STATIC
+BOOLEAN
+TestTruncation (
+  VOID
+  )
+{
+  OC_TRACE_ID  Outer;
+  OC_TRACE_ID  Inner;
+  UINTN        FullJson;
+  UINTN        FullSummary;
+  UINTN        BufferSize;
+  UINTN        Size;
+  UINTN        PreviousSize;
+  BOOLEAN      Result;
+
+  Outer = OcTraceBegin ("Outer");
+  Inner = OcTraceBegin ("Inner");
+  OcTraceEnd (Inner);
+  OcTraceEnd (Outer);
+  OcTraceBegin ("Open");
+
+  Result = FormatGuarded (TRUE, TRACE_TEST_BUFFER_SIZE, &FullJson)
+           && FormatGuarded (FALSE, TRACE_TEST_BUFFER_SIZE, &FullSummary);
+
+  //
+  // Every buffer size must give whole events, growing with buffer size.
+  // Formatters need one spare byte to tell fitting output from truncated.
+  //
+  PreviousSize = 0;
+  for (BufferSize = 0; Result && BufferSize <= FullJson + 2; ++BufferSize) {
+    Result = FormatGuarded (TRUE, BufferSize, &Size)
+             && Size >= PreviousSize
+             && (Size == 0 || IsJsonComplete (mBuffer, Size))
+             && (BufferSize <= FullJson + 1 || Size == FullJson);
+    PreviousSize = Size;
+  }
+
+  PreviousSize = 0;
+  for (BufferSize = 0; Result && BufferSize <= FullSummary + 2; ++BufferSize) {
+    Result = FormatGuarded (FALSE, BufferSize, &Size)
+             && Size >= PreviousSize
+             && (Size == 0 || mBuffer[Size - 1] == ';')
+             && (BufferSize <= FullSummary + 1 || Size == FullSummary);
+    PreviousSize = Size;
+  }
+
+  DEBUG ((DEBUG_ERROR, "TRC: Truncation - %a\n", Result ? "passed" : "FAILED"));
+  return Result;
+}
+
+int
+ENTRY_POINT (
+  int   argc,
+  char  *argv[]
+  )
+{
+  BOOLEAN  Result;
+
+  //
+  // Spans are never removed, so run wrap test last.
+  //
+  Result = TestNested ();
+  Result = TestTruncation () && Result;
+  Result = TestWrap () && Result;
+
+  return Result ? 0 : -1;
+}
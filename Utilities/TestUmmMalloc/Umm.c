@@ -0,0 +1,411 @@
+/** @file
+  Stress and benchmark the built-in allocator by replaying allocation traces.
+
+  Trace lines are "a <slot> <size>" to allocate and "f <slot>" to free,
+  lines starting with '#' are ignored. Allocating into a busy slot frees
+  it first. Without a trace file a synthetic one is generated.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcMemoryLib.h>
+
+#include <UserFile.h>
+#include <UserTime.h>
+
+#include <stdlib.h>
+
+#define UMM_TEST_HEAP_SIZE  BASE_32MB
+#define UMM_TEST_SLOTS      65536U
+
+typedef struct {
+  UINT8     Free;
+  UINT16    Slot;
+  UINT32    Size;
+} UMM_TRACE_OP;
+
+typedef struct {
+  UINT8     *Ptr;
+  UINT32    Size;
+} UMM_TRACE_SLOT;
+
+STATIC UMM_TRACE_SLOT  mSlots[UMM_TEST_SLOTS];
+
+STATIC
+UINT8
+SlotPattern (
+  IN UINT32  Slot,
+  IN UINT32  Size
+  )
+{
+  return (UINT8)(Slot * 31U + Size);
+}
+
+/**
+  Free slot memory after checking that its contents survived.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+ReleaseSlot (
+  IN UINT32   Slot,
+  IN BOOLEAN  Verify
+  )
+{
+  UINT32   Index;
+  UINT8    Pattern;
+  BOOLEAN  Result;
+
+  Result = TRUE;
+
+  if (mSlots[Slot].Ptr == NULL) {
+    return Result;
+  }
+
+  if (Verify) {
+    Pattern = SlotPattern (Slot, mSlots[Slot].Size);
+    for (Index = 0; Index < mSlots[Slot].Size; ++Index) {
+      if (mSlots[Slot].Ptr[Index] != Pattern) {
+        DEBUG ((DEBUG_ERROR, "UMM: Slot %u of %u bytes corrupted at %u\n", Slot, mSlots[Slot].Size, Index));
+        Result = FALSE;
+        break;
+      }
+    }
+  }
+
+  if (!UmmFree (mSlots[Slot].Ptr)) {
+    DEBUG ((DEBUG_ERROR, "UMM: Slot %u free failed\n", Slot));
+    Result = FALSE;
+  }
+
+  mSlots[Slot].Ptr = NULL;
+  return Result;
+}
+
+/**
+  Replay trace on a fresh heap.
+
+  @param[in]  Ops       Trace operations.
+  @param[in]  OpCount   Number of trace operations.
+  @param[in]  Heap      Heap memory.
+  @param[in]  Verify    Fill allocations and check them on free.
+  @param[out] Failures  Number of failed allocations.
+
+  @retval TRUE when no corruption was found.
+**/
+STATIC
+BOOLEAN
+ReplayTrace (
+  IN  CONST UMM_TRACE_OP  *Ops,
+  IN  UINT32              OpCount,
+  IN  VOID                *Heap,
+  IN  BOOLEAN             Verify,
+  OUT UINT32              *Failures
+  )
+{
+  UINT32   Index;
+  UINT32   Slot;
+  BOOLEAN  Result;
+
+  Result    = TRUE;
+  *Failures = 0;
+
+  UmmSetHeap (Heap, UMM_TEST_HEAP_SIZE);
+  ZeroMem (mSlots, sizeof (mSlots));
+
+  for (Index = 0; Index < OpCount; ++Index) {
+    Slot   = Ops[Index].Slot;
+    Result = ReleaseSlot (Slot, Verify) && Result;
+
+    if (Ops[Index].Free) {
+      continue;
+    }
+
+    mSlots[Slot].Ptr  = UmmMalloc (Ops[Index].Size);
+    mSlots[Slot].Size = Ops[Index].Size;
+    if (mSlots[Slot].Ptr == NULL) {
+      ++(*Failures);
+      continue;
+    }
+
+    if (Verify) {
+      SetMem (mSlots[Slot].Ptr, mSlots[Slot].Size, SlotPattern (Slot, mSlots[Slot].Size));
+    }
+  }
+
+  return Result;
+}
+
+STATIC
+VOID
+PrintStatistics (
+  IN CONST CHAR8  *Stage
+  )
+{
+  UMM_STATISTICS  Statistics;
+
+  UmmGetStatistics (&Statistics);
+  DEBUG ((
+    DEBUG_ERROR,
+    "UMM: %a - allocated %u peak %u free %u largest %u fragmentation %u%% slabs %u slab free %u\n",
+    Stage,
+    Statistics.AllocatedSize,
+    Statistics.PeakAllocatedSize,
+    Statistics.FreeSize,
+    Statistics.LargestFreeSize,
+    Statistics.Fragmentation,
+    Statistics.SlabCount,
+    Statistics.SlabFreeSize
+    ));
+}
+
+/**
+  Skip blanks, then parse decimal number.
+**/
+STATIC
+UINT32
+ParseNumber (
+  IN OUT CONST CHAR8  **Line,
+  IN     CONST CHAR8  *End
+  )
+{
+  UINT32  Value;
+
+  while (*Line < End && (**Line == ' ' || **Line == '\t')) {
+    ++(*Line);
+  }
+
+  Value = 0;
+  while (*Line < End && **Line >= '0' && **Line <= '9') {
+    Value = Value * 10 + (UINT32)(**Line - '0');
+    ++(*Line);
+  }
+
+  return Value;
+}
+
+STATIC
+UMM_TRACE_OP *
+ParseTrace (
+  IN  CONST CHAR8  *Trace,
+  IN  UINT32       TraceSize,
+  OUT UINT32       *OpCount
+  )
+{
+  UMM_TRACE_OP  *Ops;
+  CONST CHAR8   *Line;
+  CONST CHAR8   *End;
+  UINT32        Count;
+  UINT32        Slot;
+  CHAR8         Type;
+
+  //
+  // Shortest operation is "f" followed by a newline.
+  //
+  Ops = AllocatePool ((TraceSize / 2 + 1) * sizeof (*Ops));
+  if (Ops == NULL) {
+    return NULL;
+  }
+
+  Count = 0;
+  Line  = Trace;
+  End   = Trace + TraceSize;
+
+  while (Line < End) {
+    Type = *Line;
+    if ((Type == 'a') || (Type == 'f')) {
+      ++Line;
+      Slot            = ParseNumber (&Line, End);
+      Ops[Count].Free = Type == 'f';
+      Ops[Count].Slot = (UINT16)(Slot % UMM_TEST_SLOTS);
+      Ops[Count].Size = Type == 'a' ? ParseNumber (&Line, End) : 0;
+      if (Ops[Count].Free || (Ops[Count].Size > 0)) {
+        ++Count;
+      }
+    }
+
+    while (Line < End && *Line != '\n') {
+      ++Line;
+    }
+
+    ++Line;
+  }
+
+  *OpCount = Count;
+  return Ops;
+}
+
+/**
+  Generate trace mostly made of small allocations with a bounded live set,
+  with occasional large ones.
+**/
+STATIC
+UMM_TRACE_OP *
+GenerateTrace (
+  IN  UINT32  OpCount
+  )
+{
+  UMM_TRACE_OP  *Ops;
+  UINT32        Index;
+  UINT32        Kind;
+
+  Ops = AllocatePool (OpCount * sizeof (*Ops));
+  if (Ops == NULL) {
+    return NULL;
+  }
+
+  srand (1);
+
+  for (Index = 0; Index < OpCount; ++Index) {
+    Kind            = (UINT32)rand () % 100;
+    Ops[Index].Slot = (UINT16)((UINT32)rand () % 8192U);
+    Ops[Index].Free = Kind < 40;
+    if (Kind < 40) {
+      Ops[Index].Size = 0;
+    } else if (Kind < 95) {
+      Ops[Index].Size = 1 + (UINT32)rand () % 256U;
+    } else {
+      Ops[Index].Size = 257 + (UINT32)rand () % 16384U;
+    }
+  }
+
+  return Ops;
+}
+
+int
+ENTRY_POINT (
+  int   argc,
+  char  *argv[]
+  )
+{
+  UMM_TRACE_OP  *Ops;
+  UINT32        OpCount;
+  UINT8         *Trace;
+  UINT32        TraceSize;
+  VOID          *Heap;
+  UINT32        Iterations;
+  UINT32        Index;
+  UINT32        Failures;
+  UINT32        Slot;
+  UINT64        Start;
+  UINT64        Time;
+  BOOLEAN       Result;
+  VOID          *Small[2];
+
+  if ((argc > 1) && (AsciiStrCmp (argv[1], "-") != 0)) {
+    if ((Trace = UserReadFile (argv[1], &TraceSize)) == NULL) {
+      DEBUG ((DEBUG_ERROR, "UMM: Failed to read %a\n", argv[1]));
+      return -1;
+    }
+
+    Ops = ParseTrace ((CONST CHAR8 *)Trace, TraceSize, &OpCount);
+    FreePool (Trace);
+  } else {
+    OpCount = 1000000;
+    Ops     = GenerateTrace (OpCount);
+  }
+
+  Iterations = argc > 2 ? MAX ((UINT32)atoi (argv[2]), 1) : 10;
+  Heap       = AllocatePool (UMM_TEST_HEAP_SIZE);
+  if ((Ops == NULL) || (Heap == NULL)) {
+    DEBUG ((DEBUG_ERROR, "UMM: Out of memory\n"));
+    return -1;
+  }
+
+  //
+  // Stress pass with contents verification, a foreign pointer free and
+  // a double free of a slab object, kept alive by its neighbour.
+  //
+  Result = ReplayTrace (Ops, OpCount, Heap, TRUE, &Failures);
+  PrintStatistics ("replayed");
+
+  if (UmmFree (&Index)) {
+    DEBUG ((DEBUG_ERROR, "UMM: Foreign pointer was freed\n"));
+    Result = FALSE;
+  }
+
+  Small[0] = UmmMalloc (24);
+  Small[1] = UmmMalloc (24);
+  if ((Small[0] != NULL) && (Small[1] != NULL) && UmmFree (Small[0]) && UmmFree (Small[0])) {
+    DEBUG ((DEBUG_ERROR, "UMM: Double free was accepted\n"));
+    Result = FALSE;
+  }
+
+  if (Small[1] != NULL) {
+    UmmFree (Small[1]);
+  }
+
+  for (Slot = 0; Slot < UMM_TEST_SLOTS; ++Slot) {
+    Result = ReleaseSlot (Slot, TRUE) && Result;
+  }
+
+  PrintStatistics ("released");
+  DEBUG ((DEBUG_ERROR, "UMM: %u operations, %u failed allocations, %a\n", OpCount, Failures, Result ? "passed" : "FAILED"));
+
+  //
+  // Benchmark passes without verification.
+  //
+  Start = GetCurrentTimestampUs ();
+  for (Index = 0; Index < Iterations; ++Index) {
+    ReplayTrace (Ops, OpCount, Heap, FALSE, &Failures);
+  }
+
+  Time = MAX (GetCurrentTimestampUs () - Start, 1);
+  DEBUG ((
+    DEBUG_ERROR,
+    "UMM: %u x %u operations in %Lu us (%Lu ns/op)\n",
+    Iterations,
+    OpCount,
+    Time,
+    DivU64x64Remainder (Time * 1000ULL, (UINT64)Iterations * OpCount, NULL)
+    ));
+
+  FreePool (Heap);
+  FreePool (Ops);
+
+  return Result ? 0 : -1;
+}
+
+int
+LLVMFuzzerTestOneInput (
+  const uint8_t  *Data,
+  size_t         Size
+  )
+{
+  STATIC VOID   *Heap;
+  UMM_TRACE_OP  *Ops;
+  UINT32        OpCount;
+  UINT32        Failures;
+  UINT32        Slot;
+
+  if (Heap == NULL) {
+    Heap = AllocatePool (UMM_TEST_HEAP_SIZE);
+    if (Heap == NULL) {
+      return 0;
+    }
+  }
+
+  Ops = ParseTrace ((CONST CHAR8 *)Data, (UINT32)Size, &OpCount);
+  if (Ops == NULL) {
+    return 0;
+  }
+
+  if (!ReplayTrace (Ops, OpCount, Heap, TRUE, &Failures)) {
+    abort ();
+  }
+
+  for (Slot = 0; Slot < UMM_TEST_SLOTS; ++Slot) {
+    if (!ReleaseSlot (Slot, TRUE)) {
+      abort ();
+    }
+  }
+
+  FreePool (Ops);
+  return 0;
+}
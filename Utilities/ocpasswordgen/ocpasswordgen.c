@@ -4,6 +4,7 @@
 **/
 
 #include <stdio.h>
+#include <stdlib.h>
 #ifdef _WIN32
   #include <conio.h>
 #else
@@ -11,9 +12,13 @@
   #include <unistd.h>
 #endif
 
+#include <Library/BaseLib.h>
+#include <Library/BaseOverflowLib.h>
 #include <Library/DebugLib.h>
 #include <Library/OcCryptoLib.h>
+#include <Library/OcParallelLib.h>
 #include <UserPseudoRandom.h>
+#include <UserTime.h>
 
 //
 // Signal Interrupt Control-C symbol
@@ -21,6 +26,11 @@
 #define CHAR_END_OF_TEXT  3
 #define CHAR_DELETE       127
 
+//
+// Minimum duration of a calibration run, in microseconds.
+//
+#define CALIBRATION_MIN_TIME  250000ULL
+
 #ifndef _WIN32
 
 /**
@@ -48,9 +58,90 @@ getch (
 
 #endif
 
+/**
+  Pick PBKDF2 iteration count taking roughly TargetMs to verify on this machine.
+
+  @param[in] TargetMs  Target unlock time in milliseconds.
+  @param[in] Lanes     Number of PBKDF2 lanes.
+
+  @return Iteration count.
+**/
+STATIC
+UINT32
+CalibrateIterations (
+  IN UINT32  TargetMs,
+  IN UINT32  Lanes
+  )
+{
+  STATIC CONST UINT8  Sample[] = "ocpasswordgen";
+  UINT8               Hash[SHA512_DIGEST_SIZE];
+  UINT32              Iterations;
+  UINT64              Elapsed;
+  UINT64              Result;
+
+  Iterations = 1000;
+  while (TRUE) {
+    Elapsed = GetCurrentTimestampUs ();
+    OcHashPasswordPbkdf2Sha512 (Sample, sizeof (Sample), Sample, sizeof (Sample), Iterations, Lanes, Hash);
+    Elapsed = MAX (GetCurrentTimestampUs () - Elapsed, 1);
+
+    if ((Elapsed >= CALIBRATION_MIN_TIME) || (Iterations > MAX_UINT32 / 2)) {
+      break;
+    }
+
+    Iterations *= 2;
+  }
+
+  //
+  // Divide first when the product does not fit, precision loss is negligible then.
+  //
+  if (BaseOverflowMulU64 ((UINT64)Iterations * TargetMs, 1000, &Result)) {
+    Result = DivU64x64Remainder ((UINT64)Iterations * TargetMs, Elapsed, NULL);
+    if (BaseOverflowMulU64 (Result, 1000, &Result)) {
+      Result = MAX_UINT64;
+    }
+  } else {
+    Result = DivU64x64Remainder (Result, Elapsed, NULL);
+  }
+
+  return (UINT32)MIN (MAX (Result, 1), MAX_UINT32);
+}
+
+/**
+  Parse a positive 32-bit option value.
+
+  @param[in]  String  Option value.
+  @param[out] Value   Parsed value.
+
+  @return TRUE on success.
+**/
+STATIC
+BOOLEAN
+ParseOptionValue (
+  IN  CONST char  *String,
+  OUT UINT32      *Value
+  )
+{
+  char           *End;
+  unsigned long  Result;
+
+  if (String == NULL) {
+    return FALSE;
+  }
+
+  Result = strtoul (String, &End, 0);
+  if ((*End != '\0') || (Result == 0) || (Result > MAX_UINT32)) {
+    return FALSE;
+  }
+
+  *Value = (UINT32)Result;
+  return TRUE;
+}
+
 int
 ENTRY_POINT (
-  void
+  int   argc,
+  char  *argv[]
   )
 {
   CHAR8   Char;
@@ -59,6 +150,74 @@ ENTRY_POINT (
   UINT32  Salt[4];
   UINT8   Index;
   UINT8   PasswordHash[SHA512_DIGEST_SIZE];
+  UINT32  TargetMs;
+  UINT32  Iterations;
+  UINT32  Lanes;
+  int     Arg;
+
+  TargetMs   = 0;
+  Iterations = 0;
+  Lanes      = 0;
+
+  for (Arg = 1; Arg < argc; Arg += 2) {
+    if (  (AsciiStrCmp (argv[Arg], "-t") == 0)
+       && ParseOptionValue (argv[Arg + 1], &TargetMs))
+    {
+      continue;
+    }
+
+    if (  (AsciiStrCmp (argv[Arg], "-i") == 0)
+       && ParseOptionValue (argv[Arg + 1], &Iterations))
+    {
+      continue;
+    }
+
+    if (  (AsciiStrCmp (argv[Arg], "-l") == 0)
+       && ParseOptionValue (argv[Arg + 1], &Lanes)
+       && (Lanes <= OC_PASSWORD_MAX_LANES))
+    {
+      continue;
+    }
+
+    printf (
+      "Usage: %s [-t <milliseconds> | -i <iterations>] [-l <lanes>]\n"
+      "  Without options, legacy iterated SHA-512 is used.\n"
+      "  -t  Calibrate PBKDF2 iterations for the target unlock time.\n"
+      "  -i  Use the given number of PBKDF2 iterations.\n"
+      "  -l  Use the given number of PBKDF2 lanes (1 to %u), defaults to 1.\n",
+      argv[0],
+      OC_PASSWORD_MAX_LANES
+      );
+    return EXIT_FAILURE;
+  }
+
+  if ((TargetMs != 0) || (Iterations != 0) || (Lanes != 0)) {
+    //
+    // Firmware without multiple processors verifies lanes one after another,
+    // so more lanes are only used on request.
+    //
+    if (Lanes == 0) {
+      Lanes = 1;
+    }
+
+    if (Iterations == 0) {
+      if (TargetMs == 0) {
+        TargetMs = 3000;
+      }
+
+      printf ("Calibrating for %u ms with %u lanes...\n", TargetMs, Lanes);
+      Iterations = CalibrateIterations (TargetMs, Lanes);
+
+      //
+      // Lanes run on host threads here, firmware may have fewer processors or
+      // none exposed at all, as well as a slower clock.
+      //
+      printf (
+        "Calibrated on this host with up to %u threads, unlock time in firmware may differ.\n",
+        (UINT32)MIN (OcParallelGetWorkerCount (), Lanes)
+        );
+    }
+  }
 
   printf ("Please enter your password: ");
 
@@ -91,13 +250,25 @@ ENTRY_POINT (
     Salt[Index] = pseudo_random ();
   }
 
-  OcHashPasswordSha512 (
-    Password,
-    PasswordLen,
-    (UINT8 *)Salt,
-    sizeof (Salt),
-    PasswordHash
-    );
+  if (Iterations != 0) {
+    OcHashPasswordPbkdf2Sha512 (
+      Password,
+      PasswordLen,
+      (UINT8 *)Salt,
+      sizeof (Salt),
+      Iterations,
+      Lanes,
+      PasswordHash
+      );
+  } else {
+    OcHashPasswordSha512 (
+      Password,
+      PasswordLen,
+      (UINT8 *)Salt,
+      sizeof (Salt),
+      PasswordHash
+      );
+  }
 
   printf ("\nPasswordHash: <");
   for (Index = 0; Index < sizeof (PasswordHash); ++Index) {
@@ -111,6 +282,10 @@ ENTRY_POINT (
 
   printf (">\n");
 
+  if (Iterations != 0) {
+    printf ("PasswordIterations: %u\nPasswordLanes: %u\n", Iterations, Lanes);
+  }
+
   SecureZeroMem (Password, sizeof (Password));
   SecureZeroMem (PasswordHash, sizeof (PasswordHash));
   SecureZeroMem (&PasswordLen, sizeof (PasswordLen));
@@ -50,7 +50,14 @@ extern UINTN           mGUIDMapsCount;
 
 /**
   Special check for UIScale under NVRAM and UEFI->Output.
+
+  @param[in]  Config    Configuration structure.
+
+  @retval TRUE if NVRAM->Add has valid UIScale.
 **/
-extern BOOLEAN  mHasNvramUIScale;
+BOOLEAN
+HasNvramUIScale (
+  IN  OC_GLOBAL_CONFIG  *Config
+  );
 
 #endif // OC_USER_UTILITIES_OCVALIDATE_NVRAM_KEY_INFO_H
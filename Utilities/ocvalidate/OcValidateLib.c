@@ -16,23 +16,6 @@
 #include "ocvalidate.h"
 #include "OcValidateLib.h"
 
-INT64
-GetCurrentTimestamp (
-  VOID
-  )
-{
-  struct timeval  Time;
-
-  //
-  // Get current time.
-  //
-  gettimeofday (&Time, NULL);
-  //
-  // Return milliseconds.
-  //
-  return Time.tv_sec * 1000LL + Time.tv_usec / 1000LL;
-}
-
 BOOLEAN
 AsciiFileSystemPathIsLegal (
   IN  CONST CHAR8  *Path
@@ -489,6 +472,112 @@ FindArrayDuplication (
   return ErrorCount;
 }
 
+UINT32
+FindArrayDuplicationByKey (
+  IN  VOID               *First,
+  IN  UINTN              Number,
+  IN  UINTN              Size,
+  IN  DUPLICATION_KEY    DupKey,
+  IN  DUPLICATION_CHECK  DupChecker
+  )
+{
+  UINT32       ErrorCount;
+  UINTN        Index;
+  UINTN        Index2;
+  UINTN        BucketCount;
+  UINTN        *Buckets;
+  UINTN        *Tails;
+  UINTN        *Next;
+  UINT32       Key;
+  CONST UINT8  *PrimaryEntry;
+  CONST UINT8  *SecondaryEntry;
+
+  if (Number < 2) {
+    return 0;
+  }
+
+  BucketCount = (UINTN)GetPowerOfTwo64 (Number) * 4;
+  Buckets     = AllocatePool (BucketCount * sizeof (*Buckets) * 2 + Number * sizeof (*Next));
+  if (Buckets == NULL) {
+    return FindArrayDuplication (First, Number, Size, DupChecker);
+  }
+
+  Tails = Buckets + BucketCount;
+  Next  = Tails + BucketCount;
+  SetMem (Buckets, BucketCount * sizeof (*Buckets), 0xFF);
+
+  //
+  // Chain entries with the same key bucket in ascending order,
+  // so that duplications are reported in the same order as by pairwise checks.
+  //
+  for (Index = 0; Index < Number; ++Index) {
+    Next[Index]  = MAX_UINTN;
+    PrimaryEntry = (UINT8 *)First + Size * Index;
+    if (!DupKey (PrimaryEntry, &Key)) {
+      continue;
+    }
+
+    Key &= BucketCount - 1;
+    if (Buckets[Key] == MAX_UINTN) {
+      Buckets[Key] = Index;
+    } else {
+      Next[Tails[Key]] = Index;
+    }
+
+    Tails[Key] = Index;
+  }
+
+  ErrorCount = 0;
+
+  for (Index = 0; Index < Number; ++Index) {
+    for (Index2 = Next[Index]; Index2 != MAX_UINTN; Index2 = Next[Index2]) {
+      PrimaryEntry   = (UINT8 *)First + Size * Index;
+      SecondaryEntry = (UINT8 *)First + Size * Index2;
+      if (DupChecker (PrimaryEntry, SecondaryEntry)) {
+        //
+        // DupChecker prints what is duplicated, and here the index is printed.
+        //
+        DEBUG ((DEBUG_WARN, "at Index %u and %u!\n", Index, Index2));
+        ++ErrorCount;
+      }
+    }
+  }
+
+  FreePool (Buckets);
+  return ErrorCount;
+}
+
+UINT32
+DuplicationKeyAddString (
+  IN  UINT32       Key,
+  IN  CONST CHAR8  *String
+  )
+{
+  //
+  // FNV-1a, with terminator included to separate accumulated strings.
+  //
+  if (Key == 0) {
+    Key = 2166136261U;
+  }
+
+  do {
+    Key ^= (UINT8)*String;
+    Key *= 16777619U;
+  } while (*String++ != '\0');
+
+  return Key;
+}
+
+BOOLEAN
+OcStringDuplicationKey (
+  IN  CONST VOID  *Entry,
+  OUT UINT32      *Key
+  )
+{
+  *Key = DuplicationKeyAddString (0, OC_BLOB_GET (*(CONST OC_STRING **)Entry));
+  return TRUE;
+}
+
 BOOLEAN
 StringIsDuplicated (
   IN  CONST CHAR8  *EntrySection,
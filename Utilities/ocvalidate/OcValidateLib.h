@@ -16,20 +16,10 @@
 #ifndef OC_USER_UTILITIES_OCVALIDATELIB_H
 #define OC_USER_UTILITIES_OCVALIDATELIB_H
 
-#include <sys/time.h>
-
 #include <Library/DevicePathLib.h>
 #include <Library/MemoryAllocationLib.h>
 
-/**
-  Get current timestamp in milliseconds.
-
-  @return     Current timestamp in milliseconds.
-**/
-INT64
-GetCurrentTimestamp (
-  VOID
-  );
+#include <UserTime.h>
 
 /**
   Check if a filesystem path contains only legal characters.
@@ -218,6 +208,71 @@ FindArrayDuplication (
   IN  DUPLICATION_CHECK  DupChecker
   );
 
+/**
+  Compute duplication key of one entry. Entries which are duplicated according
+  to the matching DUPLICATION_CHECK must have equal keys.
+
+  @param[in]   Entry       Entry to compute key for.
+  @param[out]  Key         Entry key.
+
+  @retval      TRUE        If Entry takes part in duplication checks (e.g. is enabled).
+**/
+typedef
+BOOLEAN
+(*DUPLICATION_KEY) (
+  IN  CONST VOID  *Entry,
+  OUT UINT32      *Key
+  );
+
+/**
+  Check if one array has duplicated entries, only comparing entries with equal keys.
+  Reports the same duplications in the same order as FindArrayDuplication.
+
+  @param[in]  First       Pointer to the first object of the array to be checked, converted to a VOID*.
+  @param[in]  Number      Number of elements in the array pointed to by First.
+  @param[in]  Size        Size in bytes of each element in the array.
+  @param[in]  DupKey      Pointer to a function computing entry key. See DUPLICATION_KEY for function prototype.
+  @param[in]  DupChecker  Pointer to a comparator function which returns TRUE if duplication is found. See DUPLICATION_CHECK for function prototype.
+
+  @return     Number of duplications detected, which are counted to the total number of errors discovered.
+**/
+UINT32
+FindArrayDuplicationByKey (
+  IN  VOID               *First,
+  IN  UINTN              Number,
+  IN  UINTN              Size,
+  IN  DUPLICATION_KEY    DupKey,
+  IN  DUPLICATION_CHECK  DupChecker
+  );
+
+/**
+  Accumulate string into duplication key.
+
+  @param[in]  Key         Current key, 0 for the first string.
+  @param[in]  String      String to be accumulated.
+
+  @return     Updated key.
+**/
+UINT32
+DuplicationKeyAddString (
+  IN  UINT32       Key,
+  IN  CONST CHAR8  *String
+  );
+
+/**
+  Duplication key of OC_STRING array entries, matching StringIsDuplicated.
+
+  @param[in]   Entry       Pointer to OC_STRING pointer.
+  @param[out]  Key         Entry key.
+
+  @retval      TRUE        Always.
+**/
+BOOLEAN
+OcStringDuplicationKey (
+  IN  CONST VOID  *Entry,
+  OUT UINT32      *Key
+  );
+
 /**
   Check if two strings are duplicated to each other. Used as a wrapper of AsciiStrCmp to print duplicated entries.
 
@@ -48,6 +48,33 @@ ACPIAddHasDuplication (
   return StringIsDuplicated ("ACPI->Add", ACPIAddPrimaryPathString, ACPIAddSecondaryPathString);
 }
 
+/**
+  Callback function to compute duplication key of one entry in ACPI->Add.
+
+  @param[in]   Entry       Entry to compute key for.
+  @param[out]  Key         Entry key.
+
+  @retval      TRUE        If Entry takes part in duplication checks.
+**/
+STATIC
+BOOLEAN
+ACPIAddDuplicationKey (
+  IN  CONST VOID  *Entry,
+  OUT UINT32      *Key
+  )
+{
+  CONST OC_ACPI_ADD_ENTRY  *ACPIAddEntry;
+
+  ACPIAddEntry = *(CONST OC_ACPI_ADD_ENTRY **)Entry;
+
+  if (!ACPIAddEntry->Enabled) {
+    return FALSE;
+  }
+
+  *Key = DuplicationKeyAddString (0, OC_BLOB_GET (&ACPIAddEntry->Path));
+  return TRUE;
+}
+
 STATIC
 UINT32
 CheckACPIAdd (
@@ -104,10 +131,11 @@ CheckACPIAdd (
   //
   // Check duplicated entries in ACPI->Add.
   //
-  ErrorCount += FindArrayDuplication (
+  ErrorCount += FindArrayDuplicationByKey (
                   Config->Acpi.Add.Values,
                   Config->Acpi.Add.Count,
                   sizeof (Config->Acpi.Add.Values[0]),
+                  ACPIAddDuplicationKey,
                   ACPIAddHasDuplication
                   );
 
@@ -116,10 +116,11 @@ CheckDevicePropertiesAdd (
     //
     // Check duplicated properties in DeviceProperties->Add[N].
     //
-    ErrorCount += FindArrayDuplication (
+    ErrorCount += FindArrayDuplicationByKey (
                     PropertyMap->Keys,
                     PropertyMap->Count,
                     sizeof (PropertyMap->Keys[0]),
+                    OcStringDuplicationKey,
                     DevPropsAddHasDuplication
                     );
   }
@@ -127,10 +128,11 @@ CheckDevicePropertiesAdd (
   //
   // Check duplicated entries in DeviceProperties->Add.
   //
-  ErrorCount += FindArrayDuplication (
+  ErrorCount += FindArrayDuplicationByKey (
                   Config->DeviceProperties.Add.Keys,
                   Config->DeviceProperties.Add.Count,
                   sizeof (Config->DeviceProperties.Add.Keys[0]),
+                  OcStringDuplicationKey,
                   DevPropsAddHasDuplication
                   );
 
@@ -179,10 +181,11 @@ CheckDevicePropertiesDelete (
     //
     // Check duplicated properties in DeviceProperties->Delete[N].
     //
-    ErrorCount += FindArrayDuplication (
+    ErrorCount += FindArrayDuplicationByKey (
                     Config->DeviceProperties.Delete.Values[DeviceIndex]->Values,
                     Config->DeviceProperties.Delete.Values[DeviceIndex]->Count,
                     sizeof (Config->DeviceProperties.Delete.Values[DeviceIndex]->Values[0]),
+                    OcStringDuplicationKey,
                     DevPropsDeleteHasDuplication
                     );
   }
@@ -190,10 +193,11 @@ CheckDevicePropertiesDelete (
   //
   // Check duplicated entries in DeviceProperties->Delete.
   //
-  ErrorCount += FindArrayDuplication (
+  ErrorCount += FindArrayDuplicationByKey (
                   Config->DeviceProperties.Delete.Keys,
                   Config->DeviceProperties.Delete.Count,
                   sizeof (Config->DeviceProperties.Delete.Keys[0]),
+                  OcStringDuplicationKey,
                   DevPropsDeleteHasDuplication
                   );
 
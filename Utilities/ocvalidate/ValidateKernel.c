@@ -51,6 +51,33 @@ KernelAddHasDuplication (
   return StringIsDuplicated ("Kernel->Add", KernelAddPrimaryBundlePathString, KernelAddSecondaryBundlePathString);
 }
 
+/**
+  Callback function to compute duplication key of one entry in Kernel->Add.
+
+  @param[in]   Entry       Entry to compute key for.
+  @param[out]  Key         Entry key.
+
+  @retval      TRUE        If Entry takes part in duplication checks.
+**/
+STATIC
+BOOLEAN
+KernelAddDuplicationKey (
+  IN  CONST VOID  *Entry,
+  OUT UINT32      *Key
+  )
+{
+  CONST OC_KERNEL_ADD_ENTRY  *KernelAddEntry;
+
+  KernelAddEntry = *(CONST OC_KERNEL_ADD_ENTRY **)Entry;
+
+  if (!KernelAddEntry->Enabled) {
+    return FALSE;
+  }
+
+  *Key = DuplicationKeyAddString (0, OC_BLOB_GET (&KernelAddEntry->BundlePath));
+  return TRUE;
+}
+
 /**
   Callback function to verify whether Identifier is duplicated in Kernel->Block.
 
@@ -83,6 +110,33 @@ KernelBlockHasDuplication (
   return StringIsDuplicated ("Kernel->Block", KernelBlockPrimaryIdentifierString, KernelBlockSecondaryIdentifierString);
 }
 
+/**
+  Callback function to compute duplication key of one entry in Kernel->Block.
+
+  @param[in]   Entry       Entry to compute key for.
+  @param[out]  Key         Entry key.
+
+  @retval      TRUE        If Entry takes part in duplication checks.
+**/
+STATIC
+BOOLEAN
+KernelBlockDuplicationKey (
+  IN  CONST VOID  *Entry,
+  OUT UINT32      *Key
+  )
+{
+  CONST OC_KERNEL_BLOCK_ENTRY  *KernelBlockEntry;
+
+  KernelBlockEntry = *(CONST OC_KERNEL_BLOCK_ENTRY **)Entry;
+
+  if (!KernelBlockEntry->Enabled) {
+    return FALSE;
+  }
+
+  *Key = DuplicationKeyAddString (0, OC_BLOB_GET (&KernelBlockEntry->Identifier));
+  return TRUE;
+}
+
 /**
   Callback function to verify whether BundlePath is duplicated in Kernel->Force.
 
@@ -118,6 +172,33 @@ KernelForceHasDuplication (
   return StringIsDuplicated ("Kernel->Force", KernelForcePrimaryBundlePathString, KernelForceSecondaryBundlePathString);
 }
 
+/**
+  Callback function to compute duplication key of one entry in Kernel->Force.
+
+  @param[in]   Entry       Entry to compute key for.
+  @param[out]  Key         Entry key.
+
+  @retval      TRUE        If Entry takes part in duplication checks.
+**/
+STATIC
+BOOLEAN
+KernelForceDuplicationKey (
+  IN  CONST VOID  *Entry,
+  OUT UINT32      *Key
+  )
+{
+  CONST OC_KERNEL_ADD_ENTRY  *KernelForceEntry;
+
+  KernelForceEntry = *(CONST OC_KERNEL_ADD_ENTRY **)Entry;
+
+  if (!KernelForceEntry->Enabled) {
+    return FALSE;
+  }
+
+  *Key = DuplicationKeyAddString (0, OC_BLOB_GET (&KernelForceEntry->BundlePath));
+  return TRUE;
+}
+
 STATIC
 UINT32
 CheckKernelAdd (
@@ -345,10 +426,11 @@ CheckKernelAdd (
   //
   // Check duplicated entries in Kernel->Add.
   //
-  ErrorCount += FindArrayDuplication (
+  ErrorCount += FindArrayDuplicationByKey (
                   Config->Kernel.Add.Values,
                   Config->Kernel.Add.Count,
                   sizeof (Config->Kernel.Add.Values[0]),
+                  KernelAddDuplicationKey,
                   KernelAddHasDuplication
                   );
 
@@ -430,10 +512,11 @@ CheckKernelBlock (
   //
   // Check duplicated entries in Kernel->Block.
   //
-  ErrorCount += FindArrayDuplication (
+  ErrorCount += FindArrayDuplicationByKey (
                   Config->Kernel.Block.Values,
                   Config->Kernel.Block.Count,
                   sizeof (Config->Kernel.Block.Values[0]),
+                  KernelBlockDuplicationKey,
                   KernelBlockHasDuplication
                   );
 
@@ -598,10 +681,11 @@ CheckKernelForce (
   //
   // Check duplicated entries in Kernel->Force.
   //
-  ErrorCount += FindArrayDuplication (
+  ErrorCount += FindArrayDuplicationByKey (
                   Config->Kernel.Force.Values,
                   Config->Kernel.Force.Count,
                   sizeof (Config->Kernel.Force.Values[0]),
+                  KernelForceDuplicationKey,
                   KernelForceHasDuplication
                   );
 
@@ -20,6 +20,7 @@
 #include <Library/BaseLib.h>
 #include <Library/OcBootManagementLib.h>
 #include <Library/OcConfigurationLib.h>
+#include <Library/OcCryptoLib.h>
 #include <Protocol/OcLog.h>
 
 /**
@@ -68,6 +69,34 @@ MiscEntriesHasDuplication (
   return FALSE;
 }
 
+/**
+  Callback function to compute duplication key of one entry in Misc->Entries.
+
+  @param[in]   Entry       Entry to compute key for.
+  @param[out]  Key         Entry key.
+
+  @retval      TRUE        If Entry takes part in duplication checks.
+**/
+STATIC
+BOOLEAN
+MiscEntriesDuplicationKey (
+  IN  CONST VOID  *Entry,
+  OUT UINT32      *Key
+  )
+{
+  CONST OC_MISC_TOOLS_ENTRY  *MiscEntriesEntry;
+
+  MiscEntriesEntry = *(CONST OC_MISC_TOOLS_ENTRY **)Entry;
+
+  if (!MiscEntriesEntry->Enabled) {
+    return FALSE;
+  }
+
+  *Key = DuplicationKeyAddString (0, OC_BLOB_GET (&MiscEntriesEntry->Arguments));
+  *Key = DuplicationKeyAddString (*Key, OC_BLOB_GET (&MiscEntriesEntry->Path));
+  return TRUE;
+}
+
 /**
   Callback function to verify whether Arguments and Path are duplicated in Misc->Tools.
 
@@ -116,6 +145,35 @@ MiscToolsHasDuplication (
   return FALSE;
 }
 
+/**
+  Callback function to compute duplication key of one entry in Misc->Tools.
+
+  @param[in]   Entry       Entry to compute key for.
+  @param[out]  Key         Entry key.
+
+  @retval      TRUE        If Entry takes part in duplication checks.
+**/
+STATIC
+BOOLEAN
+MiscToolsDuplicationKey (
+  IN  CONST VOID  *Entry,
+  OUT UINT32      *Key
+  )
+{
+  CONST OC_MISC_TOOLS_ENTRY  *MiscToolsEntry;
+
+  MiscToolsEntry = *(CONST OC_MISC_TOOLS_ENTRY **)Entry;
+
+  if (!MiscToolsEntry->Enabled) {
+    return FALSE;
+  }
+
+  *Key  = DuplicationKeyAddString (0, OC_BLOB_GET (&MiscToolsEntry->Arguments));
+  *Key  = DuplicationKeyAddString (*Key, OC_BLOB_GET (&MiscToolsEntry->Path));
+  *Key ^= MiscToolsEntry->FullNvramAccess ? 1U : 0U;
+  return TRUE;
+}
+
 /**
   Validate if SecureBootModel has allowed value.
 
@@ -504,10 +562,11 @@ CheckMiscEntries (
   //
   // Check duplicated entries in Entries.
   //
-  ErrorCount += FindArrayDuplication (
+  ErrorCount += FindArrayDuplicationByKey (
                   Config->Misc.Entries.Values,
                   Config->Misc.Entries.Count,
                   sizeof (Config->Misc.Entries.Values[0]),
+                  MiscEntriesDuplicationKey,
                   MiscEntriesHasDuplication
                   );
 
@@ -527,6 +586,7 @@ CheckMiscSecurity (
   CONST CHAR8  *AsciiDmgLoading;
   UINT32       ExposeSensitiveData;
   CONST CHAR8  *AsciiVault;
+  UINT32       PasswordLanes;
   UINT32       ScanPolicy;
   UINT32       AllowedScanPolicy;
   CONST CHAR8  *SecureBootModel;
@@ -570,6 +630,12 @@ CheckMiscSecurity (
     ++ErrorCount;
   }
 
+  PasswordLanes = Config->Misc.Security.PasswordLanes;
+  if (PasswordLanes > OC_PASSWORD_MAX_LANES) {
+    DEBUG ((DEBUG_WARN, "Misc->Security->PasswordLanes cannot exceed %u!\n", OC_PASSWORD_MAX_LANES));
+    ++ErrorCount;
+  }
+
   ScanPolicy        = Config->Misc.Security.ScanPolicy;
   AllowedScanPolicy = OC_SCAN_FILE_SYSTEM_LOCK | OC_SCAN_DEVICE_LOCK | OC_SCAN_DEVICE_BITS | OC_SCAN_FILE_SYSTEM_BITS;
   //
@@ -780,10 +846,11 @@ CheckMiscTools (
   //
   // Check duplicated entries in Tools.
   //
-  ErrorCount += FindArrayDuplication (
+  ErrorCount += FindArrayDuplicationByKey (
                   Config->Misc.Tools.Values,
                   Config->Misc.Tools.Count,
                   sizeof (Config->Misc.Tools.Values[0]),
+                  MiscToolsDuplicationKey,
                   MiscToolsHasDuplication
                   );
 
@@ -141,13 +141,6 @@ ValidateNvramKeyByGuid (
                 OC_BLOB_GET (VariableMap->Keys[VariableIndex])
                 ));
               ++ErrorCount;
-            } else {
-              //
-              // Special check for UIScale when it is valid.
-              //
-              if (AsciiStrCmp (OC_BLOB_GET (VariableMap->Keys[VariableIndex]), "UIScale") == 0) {
-                mHasNvramUIScale = TRUE;
-              }
             }
           }
         }
@@ -158,6 +151,54 @@ ValidateNvramKeyByGuid (
   return ErrorCount;
 }
 
+BOOLEAN
+HasNvramUIScale (
+  IN  OC_GLOBAL_CONFIG  *Config
+  )
+{
+  EFI_STATUS  Status;
+  GUID        Guid;
+  OC_ASSOC    *VariableMap;
+  UINT32      GuidIndex;
+  UINT32      VariableIndex;
+  UINTN       Index;
+  UINTN       Index2;
+
+  for (GuidIndex = 0; GuidIndex < Config->Nvram.Add.Count; ++GuidIndex) {
+    Status = AsciiStrToGuid (OC_BLOB_GET (Config->Nvram.Add.Keys[GuidIndex]), &Guid);
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    VariableMap = Config->Nvram.Add.Values[GuidIndex];
+
+    for (VariableIndex = 0; VariableIndex < VariableMap->Count; ++VariableIndex) {
+      if (AsciiStrCmp (OC_BLOB_GET (VariableMap->Keys[VariableIndex]), "UIScale") != 0) {
+        continue;
+      }
+
+      for (Index = 0; Index < mGUIDMapsCount; ++Index) {
+        if (!CompareGuid (&Guid, mGUIDMaps[Index].Guid)) {
+          continue;
+        }
+
+        for (Index2 = 0; Index2 < mGUIDMaps[Index].NvramKeyMapsCount; ++Index2) {
+          if (  (AsciiStrCmp (mGUIDMaps[Index].NvramKeyMaps[Index2].KeyName, "UIScale") == 0)
+             && mGUIDMaps[Index].NvramKeyMaps[Index2].KeyChecker (
+                                                        OC_BLOB_GET (VariableMap->Values[VariableIndex]),
+                                                        VariableMap->Values[VariableIndex]->Size
+                                                        ))
+          {
+            return TRUE;
+          }
+        }
+      }
+    }
+  }
+
+  return FALSE;
+}
+
 STATIC
 UINT32
 CheckNvramAdd (
@@ -203,10 +244,11 @@ CheckNvramAdd (
     //
     // Check duplicated properties in NVRAM->Add.
     //
-    ErrorCount += FindArrayDuplication (
+    ErrorCount += FindArrayDuplicationByKey (
                     VariableMap->Keys,
                     VariableMap->Count,
                     sizeof (VariableMap->Keys[0]),
+                    OcStringDuplicationKey,
                     NvramAddHasDuplication
                     );
 
@@ -219,10 +261,11 @@ CheckNvramAdd (
   //
   // Check duplicated entries in NVRAM->Add.
   //
-  ErrorCount += FindArrayDuplication (
+  ErrorCount += FindArrayDuplicationByKey (
                   Config->Nvram.Add.Keys,
                   Config->Nvram.Add.Count,
                   sizeof (Config->Nvram.Add.Keys[0]),
+                  OcStringDuplicationKey,
                   NvramAddHasDuplication
                   );
 
@@ -271,10 +314,11 @@ CheckNvramDelete (
     //
     // Check duplicated properties in NVRAM->Delete.
     //
-    ErrorCount += FindArrayDuplication (
+    ErrorCount += FindArrayDuplicationByKey (
                     Config->Nvram.Delete.Values[GuidIndex]->Values,
                     Config->Nvram.Delete.Values[GuidIndex]->Count,
                     sizeof (Config->Nvram.Delete.Values[GuidIndex]->Values[0]),
+                    OcStringDuplicationKey,
                     NvramDeleteHasDuplication
                     );
   }
@@ -282,10 +326,11 @@ CheckNvramDelete (
   //
   // Check duplicated entries in NVRAM->Delete.
   //
-  ErrorCount += FindArrayDuplication (
+  ErrorCount += FindArrayDuplicationByKey (
                   Config->Nvram.Delete.Keys,
                   Config->Nvram.Delete.Count,
                   sizeof (Config->Nvram.Delete.Keys[0]),
+                  OcStringDuplicationKey,
                   NvramDeleteHasDuplication
                   );
 
@@ -334,10 +379,11 @@ CheckNvramSchema (
     //
     // Check duplicated properties in NVRAM->LegacySchema.
     //
-    ErrorCount += FindArrayDuplication (
+    ErrorCount += FindArrayDuplicationByKey (
                     Config->Nvram.Legacy.Values[GuidIndex]->Values,
                     Config->Nvram.Legacy.Values[GuidIndex]->Count,
                     sizeof (Config->Nvram.Legacy.Values[GuidIndex]->Values[0]),
+                    OcStringDuplicationKey,
                     NvramLegacySchemaHasDuplication
                     );
   }
@@ -345,10 +391,11 @@ CheckNvramSchema (
   //
   // Check duplicated entries in NVRAM->LegacySchema.
   //
-  ErrorCount += FindArrayDuplication (
+  ErrorCount += FindArrayDuplicationByKey (
                   Config->Nvram.Legacy.Keys,
                   Config->Nvram.Legacy.Count,
                   sizeof (Config->Nvram.Legacy.Keys[0]),
+                  OcStringDuplicationKey,
                   NvramLegacySchemaHasDuplication
                   );
 
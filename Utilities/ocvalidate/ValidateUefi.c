@@ -48,6 +48,29 @@ UefiDriverHasDuplication (
   return StringIsDuplicated ("UEFI->Drivers", UefiDriverPrimaryString, UefiDriverSecondaryString);
 }
 
+/**
+  Callback function to compute duplication key of one driver in UEFI->Drivers.
+
+  @param[in]   Entry       Entry to compute key for.
+  @param[out]  Key         Entry key.
+
+  @retval      TRUE        If Entry takes part in duplication checks.
+**/
+STATIC
+BOOLEAN
+UefiDriverDuplicationKey (
+  IN  CONST VOID  *Entry,
+  OUT UINT32      *Key
+  )
+{
+  CONST OC_UEFI_DRIVER_ENTRY  *UefiDriverEntry;
+
+  UefiDriverEntry = *(CONST OC_UEFI_DRIVER_ENTRY **)Entry;
+
+  *Key = DuplicationKeyAddString (0, OC_BLOB_GET (&UefiDriverEntry->Path));
+  return TRUE;
+}
+
 /**
   Callback function to verify whether one UEFI ReservedMemory entry overlaps the other,
   in terms of Address and Size.
@@ -427,10 +450,11 @@ CheckUefiDrivers (
   //
   // Check duplicated Drivers.
   //
-  ErrorCount += FindArrayDuplication (
+  ErrorCount += FindArrayDuplicationByKey (
                   Config->Uefi.Drivers.Values,
                   Config->Uefi.Drivers.Count,
                   sizeof (Config->Uefi.Drivers.Values[0]),
+                  UefiDriverDuplicationKey,
                   UefiDriverHasDuplication
                   );
 
@@ -699,7 +723,7 @@ CheckUefiOutput (
     HasUefiOutputUIScale = TRUE;
   }
 
-  if (HasUefiOutputUIScale && mHasNvramUIScale) {
+  if (HasUefiOutputUIScale && HasNvramUIScale (Config)) {
     DEBUG ((DEBUG_WARN, "UIScale is set under both NVRAM and UEFI->Output!\n"));
     ++ErrorCount;
   }
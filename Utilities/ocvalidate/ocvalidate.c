@@ -15,19 +15,40 @@
 
 #include "ocvalidate.h"
 #include "OcValidateLib.h"
+#include "NvramKeyInfo.h"
 
 #include <Library/OcMainLib.h>
+#include <Library/OcParallelLib.h>
+#include <Library/OcStringLib.h>
+#include <Library/PrintLib.h>
+#include <Library/SortLib.h>
 
 #include <UserFile.h>
 
+#include <dirent.h>
+
+CONST CHAR8  *mConfigCheckNames[CONFIG_CHECK_COUNT] = {
+  "ACPI",
+  "Booter",
+  "DeviceProperties",
+  "Kernel",
+  "Misc",
+  "NVRAM",
+  "PlatformInfo",
+  "UEFI"
+};
+
 UINT32
-CheckConfig (
-  IN  OC_GLOBAL_CONFIG  *Config
+CheckConfigEx (
+  IN  OC_GLOBAL_CONFIG  *Config,
+  OUT UINT32            *CheckErrors  OPTIONAL,
+  OUT INT64             *CheckTimes   OPTIONAL
   )
 {
   UINT32               ErrorCount;
   UINT32               CurrErrorCount;
   UINTN                Index;
+  INT64                CheckTimeStart;
   STATIC CONFIG_CHECK  ConfigCheckers[] = {
     &CheckACPI,
     &CheckBooter,
@@ -39,6 +60,8 @@ CheckConfig (
     &CheckUefi
   };
 
+  STATIC_ASSERT (ARRAY_SIZE (ConfigCheckers) == CONFIG_CHECK_COUNT, "Checker names are out of sync");
+
   ErrorCount     = 0;
   CurrErrorCount = 0;
 
@@ -46,8 +69,17 @@ CheckConfig (
   // Pass config structure to all checkers.
   //
   for (Index = 0; Index < ARRAY_SIZE (ConfigCheckers); ++Index) {
+    CheckTimeStart = GetCurrentTimestampUs ();
     CurrErrorCount = ConfigCheckers[Index](Config);
 
+    if (CheckErrors != NULL) {
+      CheckErrors[Index] = CurrErrorCount;
+    }
+
+    if (CheckTimes != NULL) {
+      CheckTimes[Index] = GetCurrentTimestampUs () - CheckTimeStart;
+    }
+
     if (CurrErrorCount != 0) {
       //
       // Print an extra newline on error.
@@ -60,6 +92,377 @@ CheckConfig (
   return ErrorCount;
 }
 
+UINT32
+CheckConfig (
+  IN  OC_GLOBAL_CONFIG  *Config
+  )
+{
+  return CheckConfigEx (Config, NULL, NULL);
+}
+
+/**
+  Result of validating one config in batch mode.
+**/
+typedef struct {
+  CONST CHAR8    *FileName;
+  CONST CHAR8    *Status;
+  UINT32         SerialisationErrors;
+  UINT32         ErrorCount;
+  UINT32         CheckErrors[CONFIG_CHECK_COUNT];
+  INT64          CheckTimes[CONFIG_CHECK_COUNT];
+  INT64          Time;
+} BATCH_RESULT;
+
+/**
+  Batch mode worker validating one config. Runs on any thread.
+
+  @param[in,out]  Context   Array of batch results.
+  @param[in]      Index     Config index.
+  @param[in]      Worker    Unused.
+**/
+STATIC
+VOID
+EFIAPI
+BatchValidateConfig (
+  IN OUT VOID   *Context,
+  IN     UINTN  Index,
+  IN     UINTN  Worker
+  )
+{
+  BATCH_RESULT      *Result;
+  UINT8             *ConfigFileBuffer;
+  UINT32            ConfigFileSize;
+  OC_GLOBAL_CONFIG  Config;
+  EFI_STATUS        Status;
+  INT64             TimeStart;
+
+  Result    = &((BATCH_RESULT *)Context)[Index];
+  TimeStart = GetCurrentTimestampUs ();
+
+  ConfigFileBuffer = UserReadFile (Result->FileName, &ConfigFileSize);
+  if (ConfigFileBuffer == NULL) {
+    Result->Status = "read_error";
+  } else {
+    Status = OcConfigurationInit (&Config, ConfigFileBuffer, ConfigFileSize, &Result->SerialisationErrors);
+    if (EFI_ERROR (Status)) {
+      Result->Status = "invalid";
+    } else {
+      Result->ErrorCount = Result->SerialisationErrors + CheckConfigEx (&Config, Result->CheckErrors, Result->CheckTimes);
+      Result->Status     = "ok";
+      OcConfigurationFree (&Config);
+    }
+
+    FreePool (ConfigFileBuffer);
+  }
+
+  //
+  // Time is reported for every result, including failed ones.
+  //
+  Result->Time = GetCurrentTimestampUs () - TimeStart;
+}
+
+/**
+  Print string as JSON string literal.
+
+  @param[in]  String    String to print.
+**/
+STATIC
+VOID
+BatchPrintJsonString (
+  IN  CONST CHAR8  *String
+  )
+{
+  putchar ('"');
+  for (; *String != '\0'; ++String) {
+    if ((*String == '"') || (*String == '\\')) {
+      printf ("\\%c", *String);
+    } else if ((UINT8)*String < ' ') {
+      printf ("\\u%04x", (UINT8)*String);
+    } else {
+      putchar (*String);
+    }
+  }
+
+  putchar ('"');
+}
+
+/**
+  Print batch result as a JSON line.
+
+  @param[in]  Result    Batch result.
+**/
+STATIC
+VOID
+BatchPrintResult (
+  IN  CONST BATCH_RESULT  *Result
+  )
+{
+  UINTN  Index;
+
+  printf ("{\"path\":");
+  BatchPrintJsonString (Result->FileName);
+  printf (
+    ",\"status\":\"%s\",\"errors\":%u,\"serialisation_errors\":%u,\"time_us\":%lld,\"checks\":{",
+    Result->Status,
+    Result->ErrorCount,
+    Result->SerialisationErrors,
+    (long long)Result->Time
+    );
+
+  for (Index = 0; Index < CONFIG_CHECK_COUNT; ++Index) {
+    printf (
+      "%s\"%s\":{\"errors\":%u,\"time_us\":%lld}",
+      Index > 0 ? "," : "",
+      mConfigCheckNames[Index],
+      Result->CheckErrors[Index],
+      (long long)Result->CheckTimes[Index]
+      );
+  }
+
+  printf ("}}\n");
+}
+
+/**
+  Compare config file names for sorting.
+
+  @param[in]  Buffer1   Pointer to first file name.
+  @param[in]  Buffer2   Pointer to second file name.
+
+  @return Comparison result as in AsciiStrCmp.
+**/
+STATIC
+INTN
+EFIAPI
+BatchCompareFileName (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  return AsciiStrCmp (*(CONST CHAR8 **)Buffer1, *(CONST CHAR8 **)Buffer2);
+}
+
+/**
+  Append config path to batch file list, growing it as needed.
+
+  @param[in,out]  FileNames     File name list.
+  @param[in,out]  FileCount     Number of file names in the list.
+  @param[in,out]  FileCapacity  Capacity of the list.
+  @param[in]      FileName      File name to append, owned by the list.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+BatchAddFile (
+  IN OUT CHAR8  ***FileNames,
+  IN OUT UINTN  *FileCount,
+  IN OUT UINTN  *FileCapacity,
+  IN     CHAR8  *FileName
+  )
+{
+  CHAR8  **NewFileNames;
+  UINTN  NewCapacity;
+
+  if (*FileCount == *FileCapacity) {
+    NewCapacity  = MAX (*FileCapacity * 2, 64);
+    NewFileNames = ReallocatePool (
+                     *FileCapacity * sizeof (**FileNames),
+                     NewCapacity * sizeof (**FileNames),
+                     *FileNames
+                     );
+    if (NewFileNames == NULL) {
+      return FALSE;
+    }
+
+    *FileNames    = NewFileNames;
+    *FileCapacity = NewCapacity;
+  }
+
+  (*FileNames)[(*FileCount)++] = FileName;
+  return TRUE;
+}
+
+/**
+  Collect config paths from a file or directory argument.
+  Directories contribute all files with .plist suffix, in sorted order.
+
+  @param[in]      Path          File or directory path.
+  @param[in,out]  FileNames     File name list.
+  @param[in,out]  FileCount     Number of file names in the list.
+  @param[in,out]  FileCapacity  Capacity of the list.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+BatchCollectFiles (
+  IN     CONST CHAR8  *Path,
+  IN OUT CHAR8        ***FileNames,
+  IN OUT UINTN        *FileCount,
+  IN OUT UINTN        *FileCapacity
+  )
+{
+  DIR            *Dir;
+  struct dirent  *Entry;
+  UINTN          FirstIndex;
+  UINTN          PathLength;
+  UINTN          NameLength;
+  UINTN          Size;
+  CHAR8          *FileName;
+
+  PathLength = AsciiStrLen (Path);
+
+  Dir = opendir (Path);
+  if (Dir == NULL) {
+    FileName = AllocateCopyPool (PathLength + 1, Path);
+    if (FileName == NULL) {
+      return FALSE;
+    }
+
+    if (!BatchAddFile (FileNames, FileCount, FileCapacity, FileName)) {
+      FreePool (FileName);
+      return FALSE;
+    }
+
+    return TRUE;
+  }
+
+  FirstIndex = *FileCount;
+
+  while ((Entry = readdir (Dir)) != NULL) {
+    NameLength = AsciiStrLen (Entry->d_name);
+    if (  (NameLength <= L_STR_LEN (".plist"))
+       || (AsciiStrCmp (&Entry->d_name[NameLength - L_STR_LEN (".plist")], ".plist") != 0))
+    {
+      continue;
+    }
+
+    Size     = PathLength + NameLength + 2;
+    FileName = AllocatePool (Size);
+    if (FileName == NULL) {
+      closedir (Dir);
+      return FALSE;
+    }
+
+    AsciiSPrint (FileName, Size, "%a/%a", Path, Entry->d_name);
+    if (!BatchAddFile (FileNames, FileCount, FileCapacity, FileName)) {
+      FreePool (FileName);
+      closedir (Dir);
+      return FALSE;
+    }
+  }
+
+  closedir (Dir);
+
+  PerformQuickSort (
+    &(*FileNames)[FirstIndex],
+    *FileCount - FirstIndex,
+    sizeof (**FileNames),
+    BatchCompareFileName
+    );
+
+  return TRUE;
+}
+
+/**
+  Print command line usage.
+
+  @param[in]  Name    Program name.
+**/
+STATIC
+VOID
+PrintUsage (
+  IN  CONST CHAR8  *Name
+  )
+{
+  DEBUG ((DEBUG_ERROR, "Usage: %a <path/to/config.plist>\n", Name));
+  DEBUG ((DEBUG_ERROR, "       %a --batch [--jobs N] <path/to/config.plist | path/to/directory>...\n\n", Name));
+}
+
+/**
+  Validate many configs in parallel, printing one JSON line per config.
+
+  @param[in]  argc    Number of arguments, including program name and --batch.
+  @param[in]  argv    Arguments, including program name and --batch.
+
+  @return 0 when all configs have no issues.
+**/
+STATIC
+int
+BatchMain (
+  IN  int   argc,
+  IN  char  *argv[]
+  )
+{
+  CHAR8         **FileNames;
+  UINTN         FileCount;
+  UINTN         FileCapacity;
+  UINTN         MaxWorkers;
+  BATCH_RESULT  *Results;
+  UINTN         Index;
+  int           ExitCode;
+
+  FileNames    = NULL;
+  FileCount    = 0;
+  FileCapacity = 0;
+  MaxWorkers   = 0;
+
+  for (Index = 2; Index < (UINTN)argc; ++Index) {
+    if (AsciiStrCmp (argv[Index], "--jobs") == 0) {
+      if (Index + 1 == (UINTN)argc) {
+        PrintUsage (argv[0]);
+        return -1;
+      }
+
+      MaxWorkers = (UINTN)AsciiStrDecimalToUint64 (argv[++Index]);
+      continue;
+    }
+
+    if (!BatchCollectFiles (argv[Index], &FileNames, &FileCount, &FileCapacity)) {
+      DEBUG ((DEBUG_ERROR, "Failed to collect configs from %a\n", argv[Index]));
+      return -1;
+    }
+  }
+
+  if (FileCount == 0) {
+    DEBUG ((DEBUG_ERROR, "No configs to validate\n"));
+    return -1;
+  }
+
+  Results = AllocateZeroPool (FileCount * sizeof (*Results));
+  if (Results == NULL) {
+    return -1;
+  }
+
+  for (Index = 0; Index < FileCount; ++Index) {
+    Results[Index].FileName = FileNames[Index];
+  }
+
+  //
+  // Detailed diagnostics from concurrent checkers would interleave,
+  // only the summary is printed. Rerun single mode for details.
+  //
+  PcdGet32 (PcdFixedDebugPrintErrorLevel) = 0;
+  PcdGet32 (PcdDebugPrintErrorLevel)      = 0;
+
+  OcParallelFor (BatchValidateConfig, Results, FileCount, MaxWorkers);
+
+  ExitCode = 0;
+  for (Index = 0; Index < FileCount; ++Index) {
+    BatchPrintResult (&Results[Index]);
+    if ((AsciiStrCmp (Results[Index].Status, "ok") != 0) || (Results[Index].ErrorCount != 0)) {
+      ExitCode = EXIT_FAILURE;
+    }
+
+    FreePool (FileNames[Index]);
+  }
+
+  FreePool (Results);
+  FreePool (FileNames);
+
+  return ExitCode;
+}
+
 int
 ENTRY_POINT (
   int   argc,
@@ -83,13 +486,20 @@ ENTRY_POINT (
   PcdGet32 (PcdFixedDebugPrintErrorLevel) |= DEBUG_INFO;
   PcdGet32 (PcdDebugPrintErrorLevel)      |= DEBUG_INFO;
 
+  //
+  // Batch mode prints machine-readable output only.
+  //
+  if ((argc > 1) && (AsciiStrCmp (argv[1], "--batch") == 0)) {
+    return BatchMain (argc, argv);
+  }
+
   DEBUG ((DEBUG_ERROR, "\nNOTE: This version of ocvalidate is only compatible with OpenCore version %a!\n\n", OPEN_CORE_VERSION));
 
   //
   // Print usage.
   //
   if (argc != 2) {
-    DEBUG ((DEBUG_ERROR, "Usage: %a <path/to/config.plist>\n\n", argv[0]));
+    PrintUsage (argv[0]);
     return -1;
   }
 
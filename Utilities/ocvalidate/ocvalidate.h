@@ -124,6 +124,16 @@ CheckUefi (
   IN  OC_GLOBAL_CONFIG  *Config
   );
 
+/**
+  Number of section checkers run by CheckConfig.
+**/
+#define CONFIG_CHECK_COUNT  8
+
+/**
+  Section names of checkers run by CheckConfig, in order.
+**/
+extern CONST CHAR8  *mConfigCheckNames[CONFIG_CHECK_COUNT];
+
 /**
   Validate OpenCore Configuration overall, by calling each checker above.
 
@@ -136,4 +146,21 @@ CheckConfig (
   IN  OC_GLOBAL_CONFIG  *Config
   );
 
+/**
+  Validate OpenCore Configuration overall, by calling each checker above,
+  and record per-section statistics.
+
+  @param[in]   Config        Configuration structure.
+  @param[out]  CheckErrors   Number of errors per section, optional.
+  @param[out]  CheckTimes    Time spent per section in microseconds, optional.
+
+  @return     Number of errors detected overall.
+**/
+UINT32
+CheckConfigEx (
+  IN  OC_GLOBAL_CONFIG  *Config,
+  OUT UINT32            *CheckErrors  OPTIONAL,
+  OUT INT64             *CheckTimes   OPTIONAL
+  );
+
 #endif // OC_USER_UTILITIES_OCVALIDATE_H
@@ -0,0 +1,358 @@
+/** @file
+  Build pre-decoded OpenCanopy theme packs.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-3-Clause
+**/
+
+#include <Uefi.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/BaseOverflowLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcCompressionLib.h>
+#include <Library/PrintLib.h>
+#include <Library/SortLib.h>
+
+#include <UserFile.h>
+
+#include <dirent.h>
+
+#include "OpenCanopy.h"
+#include "ThemePack.h"
+
+#define THEME_PACK_MAX_ENTRIES  256U
+
+typedef struct {
+  CHAR8        Name[GUI_THEME_PACK_NAME_SIZE];
+  GUI_IMAGE    Image;
+  UINT32       Flags;
+  UINT32       SourceSize;
+  UINT32       SourceChecksum;
+} THEME_PACK_IMAGE;
+
+STATIC
+INTN
+EFIAPI
+ThemePackCompareName (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  return AsciiStrCmp (*(CONST CHAR8 *CONST *)Buffer1, *(CONST CHAR8 *CONST *)Buffer2);
+}
+
+/**
+  Collect sorted .icns file names without extension from a theme directory.
+
+  @param[in]  Path    Theme directory.
+  @param[out] Names   Array of THEME_PACK_MAX_ENTRIES names to fill.
+
+  @retval Number of names, or MAX_UINT32 on failure.
+**/
+STATIC
+UINT32
+ThemePackListIcons (
+  IN  CONST CHAR8  *Path,
+  OUT CHAR8        *Names[THEME_PACK_MAX_ENTRIES]
+  )
+{
+  DIR            *Dir;
+  struct dirent  *Entry;
+  UINTN          NameLength;
+  UINT32         Count;
+
+  Dir = opendir (Path);
+  if (Dir == NULL) {
+    DEBUG ((DEBUG_ERROR, "Cannot open theme directory %a!\n", Path));
+    return MAX_UINT32;
+  }
+
+  Count = 0;
+  while ((Entry = readdir (Dir)) != NULL) {
+    NameLength = AsciiStrLen (Entry->d_name);
+    if (  (NameLength <= L_STR_LEN (".icns"))
+       || (AsciiStrCmp (&Entry->d_name[NameLength - L_STR_LEN (".icns")], ".icns") != 0))
+    {
+      continue;
+    }
+
+    NameLength -= L_STR_LEN (".icns");
+    if (NameLength >= GUI_THEME_PACK_NAME_SIZE) {
+      DEBUG ((DEBUG_WARN, "Skipping %a with too long name\n", Entry->d_name));
+      continue;
+    }
+
+    if (Count == THEME_PACK_MAX_ENTRIES) {
+      DEBUG ((DEBUG_WARN, "Skipping %a over %u images\n", Entry->d_name, THEME_PACK_MAX_ENTRIES));
+      continue;
+    }
+
+    Names[Count] = AllocateZeroPool (GUI_THEME_PACK_NAME_SIZE);
+    if (Names[Count] == NULL) {
+      break;
+    }
+
+    CopyMem (Names[Count], Entry->d_name, NameLength);
+    ++Count;
+  }
+
+  closedir (Dir);
+
+  PerformQuickSort (Names, Count, sizeof (*Names), ThemePackCompareName);
+  return Count;
+}
+
+/**
+  Compute the aligned end of an image stored at Offset in a theme pack.
+
+  @param[in]  Image       Decoded image.
+  @param[in]  Offset      Aligned image offset.
+  @param[out] NextOffset  Aligned offset past the image.
+
+  @retval FALSE on overflow.
+**/
+STATIC
+BOOLEAN
+ThemePackNextOffset (
+  IN  CONST GUI_IMAGE  *Image,
+  IN  UINT32           Offset,
+  OUT UINT32           *NextOffset
+  )
+{
+  UINT32  ImageSize;
+
+  if (  BaseOverflowMulU32 (Image->Width, Image->Height, &ImageSize)
+     || BaseOverflowMulU32 (ImageSize, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL), &ImageSize)
+     || BaseOverflowAddU32 (Offset, ImageSize, &Offset)
+     || BaseOverflowAddU32 (Offset, GUI_THEME_PACK_ALIGNMENT - 1, &Offset))
+  {
+    return FALSE;
+  }
+
+  *NextOffset = Offset & ~(GUI_THEME_PACK_ALIGNMENT - 1);
+  return TRUE;
+}
+
+/**
+  Serialise decoded images into a theme pack.
+
+  @param[in]  Images      Decoded images.
+  @param[in]  NumImages   Number of decoded images.
+  @param[in]  Scale       User interface scale.
+  @param[out] PackSize    Resulting pack size.
+
+  @retval Allocated pack or NULL.
+**/
+STATIC
+UINT8 *
+ThemePackBuild (
+  IN  CONST THEME_PACK_IMAGE  *Images,
+  IN  UINT32                  NumImages,
+  IN  UINT8                   Scale,
+  OUT UINT32                  *PackSize
+  )
+{
+  UINT8                  *Pack;
+  GUI_THEME_PACK_HEADER  *Header;
+  GUI_THEME_PACK_ENTRY   *Entries;
+  UINT32                 Index;
+  UINT32                 TocSize;
+  UINT32                 Offset;
+  UINT32                 NextOffset;
+
+  if (  BaseOverflowMulAddU32 (NumImages, sizeof (GUI_THEME_PACK_ENTRY), sizeof (GUI_THEME_PACK_HEADER), &TocSize)
+     || BaseOverflowAddU32 (TocSize, GUI_THEME_PACK_ALIGNMENT - 1, &TocSize))
+  {
+    DEBUG ((DEBUG_ERROR, "Too many images to pack\n"));
+    return NULL;
+  }
+
+  TocSize &= ~(GUI_THEME_PACK_ALIGNMENT - 1);
+
+  Offset = TocSize;
+  for (Index = 0; Index < NumImages; ++Index) {
+    if (!ThemePackNextOffset (&Images[Index].Image, Offset, &Offset)) {
+      DEBUG ((DEBUG_ERROR, "Theme pack exceeds 4 GB at %a\n", Images[Index].Name));
+      return NULL;
+    }
+  }
+
+  Pack = AllocateZeroPool (Offset);
+  if (Pack == NULL) {
+    return NULL;
+  }
+
+  *PackSize = Offset;
+
+  Header             = (GUI_THEME_PACK_HEADER *)Pack;
+  Header->Signature  = GUI_THEME_PACK_SIGNATURE;
+  Header->Version    = GUI_THEME_PACK_VERSION;
+  Header->Scale      = Scale;
+  Header->NumEntries = NumImages;
+
+  Entries = (GUI_THEME_PACK_ENTRY *)(Header + 1);
+  Offset  = TocSize;
+  for (Index = 0; Index < NumImages; ++Index) {
+    ThemePackNextOffset (&Images[Index].Image, Offset, &NextOffset);
+
+    CopyMem (Entries[Index].Name, Images[Index].Name, sizeof (Entries[Index].Name));
+    Entries[Index].Width          = Images[Index].Image.Width;
+    Entries[Index].Height         = Images[Index].Image.Height;
+    Entries[Index].Flags          = Images[Index].Flags;
+    Entries[Index].Offset         = Offset;
+    Entries[Index].SourceSize     = Images[Index].SourceSize;
+    Entries[Index].SourceChecksum = Images[Index].SourceChecksum;
+    CopyMem (
+      Pack + Offset,
+      Images[Index].Image.Buffer,
+      Images[Index].Image.Width * Images[Index].Image.Height * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+      );
+
+    Offset = NextOffset;
+  }
+
+  return Pack;
+}
+
+/**
+  Decode all theme images at one scale and write the pack.
+
+  @retval 0 on success.
+**/
+STATIC
+int
+ThemePackWrite (
+  IN CONST CHAR8  *ThemePath,
+  IN CONST CHAR8  *FontPath  OPTIONAL,
+  IN CHAR8        **Names,
+  IN UINT32       NumNames,
+  IN UINT8        Scale
+  )
+{
+  EFI_STATUS        Status;
+  THEME_PACK_IMAGE  *Images;
+  UINT32            NumImages;
+  UINT32            Index;
+  CHAR8             FilePath[1024];
+  UINT8             *FileData;
+  UINT32            FileSize;
+  UINT8             *Pack;
+  UINT32            PackSize;
+  int               Result;
+
+  Images = AllocateZeroPool ((NumNames + 1) * sizeof (*Images));
+  if (Images == NULL) {
+    return -1;
+  }
+
+  NumImages = 0;
+  for (Index = 0; Index < NumNames; ++Index) {
+    AsciiSPrint (FilePath, sizeof (FilePath), "%a/%a.icns", ThemePath, Names[Index]);
+    FileData = UserReadFile (FilePath, &FileSize);
+    if (FileData == NULL) {
+      continue;
+    }
+
+    Status = GuiIcnsToImageIcon (
+               &Images[NumImages].Image,
+               FileData,
+               FileSize,
+               Scale,
+               0,
+               0,
+               FALSE
+               );
+    Images[NumImages].SourceSize     = FileSize;
+    Images[NumImages].SourceChecksum = Adler32 (FileData, FileSize);
+    FreePool (FileData);
+
+    //
+    // Legacy it32 icons need target dimensions to decode, leave them
+    // to be decoded at runtime.
+    //
+    if (EFI_ERROR (Status) || (Images[NumImages].Image.Width == 0) || (Images[NumImages].Image.Height == 0)) {
+      DEBUG ((DEBUG_WARN, "Skipping %a at %ux - %r\n", Names[Index], Scale, Status));
+      if (!EFI_ERROR (Status)) {
+        FreePool (Images[NumImages].Image.Buffer);
+      }
+
+      continue;
+    }
+
+    CopyMem (Images[NumImages].Name, Names[Index], GUI_THEME_PACK_NAME_SIZE);
+    Images[NumImages].Flags = GUI_THEME_PACK_PREMULTIPLIED;
+    ++NumImages;
+  }
+
+  if (FontPath != NULL) {
+    AsciiSPrint (FilePath, sizeof (FilePath), "%a/Font_%ux.png", FontPath, Scale);
+    FileData = UserReadFile (FilePath, &FileSize);
+    if (FileData != NULL) {
+      Status                           = GuiPngToImage (&Images[NumImages].Image, FileData, FileSize, FALSE);
+      Images[NumImages].SourceSize     = FileSize;
+      Images[NumImages].SourceChecksum = Adler32 (FileData, FileSize);
+      FreePool (FileData);
+      if (!EFI_ERROR (Status)) {
+        AsciiStrCpyS (Images[NumImages].Name, GUI_THEME_PACK_NAME_SIZE, "Font");
+        Images[NumImages].Flags = 0;
+        ++NumImages;
+      } else {
+        DEBUG ((DEBUG_WARN, "Skipping %a - %r\n", FilePath, Status));
+      }
+    }
+  }
+
+  Result = -1;
+  Pack   = ThemePackBuild (Images, NumImages, Scale, &PackSize);
+  if (Pack != NULL) {
+    AsciiSPrint (FilePath, sizeof (FilePath), "%a/" GUI_THEME_PACK_FILE_NAME, ThemePath, Scale);
+    UserWriteFile (FilePath, Pack, PackSize);
+    DEBUG ((DEBUG_ERROR, "Wrote %a with %u images (%u bytes)\n", FilePath, NumImages, PackSize));
+    FreePool (Pack);
+    Result = 0;
+  }
+
+  for (Index = 0; Index < NumImages; ++Index) {
+    FreePool (Images[Index].Image.Buffer);
+  }
+
+  FreePool (Images);
+  return Result;
+}
+
+int
+ENTRY_POINT (
+  int   argc,
+  char  *argv[]
+  )
+{
+  CHAR8   *Names[THEME_PACK_MAX_ENTRIES];
+  UINT32  NumNames;
+  UINT32  Index;
+  int     Result;
+
+  if ((argc != 2) && (argc != 3)) {
+    DEBUG ((DEBUG_ERROR, "Usage: %a <theme directory> [font directory]\n", argv[0]));
+    DEBUG ((DEBUG_ERROR, "Writes Theme_1x.pack and Theme_2x.pack to the theme directory.\n"));
+    return -1;
+  }
+
+  NumNames = ThemePackListIcons (argv[1], Names);
+  if (NumNames == MAX_UINT32) {
+    return -1;
+  }
+
+  Result = ThemePackWrite (argv[1], argc == 3 ? argv[2] : NULL, Names, NumNames, 1);
+  if (Result == 0) {
+    Result = ThemePackWrite (argv[1], argc == 3 ? argv[2] : NULL, Names, NumNames, 2);
+  }
+
+  for (Index = 0; Index < NumNames; ++Index) {
+    FreePool (Names[Index]);
+  }
+
+  return Result;
+}